@@ -0,0 +1,572 @@
+/**
+ * @file agents.c
+ *
+ * @brief Moteur à agents mobiles : les personnes se déplacent entre les
+ * tours au lieu d'occuper une case fixe.
+ *
+ * Chaque Personne de la population est un agent : l'agent k a pour domicile
+ * la case k, et les Statistique, l'affichage et les rasters restent ceux de
+ * la population (l'état de l'agent k est montré à son domicile). Au début
+ * de chaque tour, les agents se déplacent :
+ * - MOBILITE_MARCHE : un pas vers l'une des 4 cases voisines avec la
+ *   probabilité chance_pas (un pas hors de la grille est annulé) ;
+ * - MOBILITE_TRAJET : au tour t, au domicile si t mod periode < periode / 2,
+ *   au travail sinon (case tirée à la création, à distance_travail au plus).
+ * Un agent MORT ou en quarantaine ne bouge pas.
+ *
+ * Les contacts d'un agent sont les agents de sa case et des 4 cases
+ * voisines. Une liste de cases (hachage spatial sur la grille) est
+ * reconstruite à chaque tour par un tri par comptage parallèle : chaque
+ * thread déplace sa tranche d'agents, puis compte par case les agents de sa
+ * bande de cases (histogramme de la taille de la bande), en déduit le rang
+ * de chaque case après les bandes précédentes, et range ces agents par
+ * indice croissant. Les compteurs de chaque case (contagieux libres ou en
+ * quarantaine, VACCINE) sont faits par la même bande. Les threads sont créés
+ * avec le moteur et synchronisés par barrières, comme dans bandes.c.
+ *
+ * Le balayage des états reste séquentiel, avec le générateur de la
+ * simulation, et suit la loi de jouerTourTransition : k agents contagieux
+ * compatibles (même statut de quarantaine) infectent un SAIN avec
+ * 1 - (1 - lambda)^k, un agent VACCINE dans le voisinage vaccine. Les
+ * déplacements tirent dans un générateur par bloc de AGENTS_BLOC agents :
+ * la trajectoire d'une graine ne dépend pas du nombre de threads. Une
+ * quarantaine enferme les agents des cases à distance (de Manhattan)
+ * cordon_sanitaire au plus de la case du MALADE.
+ *
+ * Usage:
+ * ```
+ * struct ParametresAgents parametres_agents = {
+ *     .mobilite = MOBILITE_MARCHE, .chance_pas = 1};
+ * struct Agents *agents = creerAgents(population, &parametres,
+ *                                     &parametres_agents, 4, &aleatoire);
+ * for (...) {
+ *   jouerTourAgents(agents, &aleatoire);
+ *   struct Statistique stats = getStatistique(population);
+ * }
+ * detruireAgents(agents);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "agents.h"
+
+/**
+ * @brief Case de l'agent au tour donné (MOBILITE_TRAJET).
+ *
+ * @param agents Moteur.
+ * @param k Agent.
+ * @param tour Tour.
+ * @return uint32_t Case domicile ou travail.
+ */
+static uint32_t caseTrajet(const struct Agents *agents, unsigned long k,
+                           unsigned long tour) {
+  const unsigned int periode = agents->parametres_agents.periode;
+  return tour % periode < periode / 2 ? (uint32_t)k : agents->travail[k];
+}
+
+/**
+ * @brief Recalcule les transitions SAIN jusqu'à nb agents contagieux.
+ *
+ * Au-delà de NB_VOISINS, la table de transition est recalculée avec
+ * lambda_k = 1 - (1 - lambda)^k : son entrée à un voisin contagieux est
+ * celle de k agents.
+ *
+ * @param agents Moteur.
+ * @param nb Nombre d'entrées voulues.
+ */
+static void calculerSain(struct Agents *agents, unsigned long nb) {
+  agents->sain = (struct Transition(*)[2])realloc(
+      agents->sain, nb * sizeof(struct Transition[2]));
+  for (unsigned long k = 0; k < nb; k++) {
+    if (k <= NB_VOISINS) {
+      memcpy(agents->sain[k], agents->table.transitions[SAIN][k],
+             sizeof(struct Transition[2]));
+      continue;
+    }
+    struct Parametres parametres = agents->table.parametres;
+    parametres.lambda = 1 - pow(1 - parametres.lambda, (double)k);
+    struct TableTransition table;
+    initTableTransition(&table, &parametres);
+    memcpy(agents->sain[k], table.transitions[SAIN][1],
+           sizeof(struct Transition[2]));
+  }
+  agents->nb_sain = nb;
+}
+
+/**
+ * @brief Déplace les agents de la tranche.
+ *
+ * @param tache Tâche.
+ */
+static void deplacer(struct TacheAgents *tache) {
+  const struct Agents *agents = tache->agents;
+  const struct Population *population = agents->population;
+  const struct Personne *personnes = population->personnes;
+  const unsigned long *expirations = population->zones.expirations;
+  const unsigned long present = population->tour;
+  const unsigned long cote = population->cote;
+  const double chance_pas = agents->parametres_agents.chance_pas;
+  uint32_t *positions = agents->positions;
+  struct Aleatoire aleatoire;
+
+  for (unsigned long k = tache->debut; k < tache->fin; k++) {
+    if (k % AGENTS_BLOC == 0)
+      initAleatoire(&aleatoire, agents->graine + k / AGENTS_BLOC);
+    const struct Personne *personne = &personnes[k];
+    if (personne->state == MORT || expirations[personne->zone] > present)
+      continue;
+    if (agents->travail) {
+      positions[k] = caseTrajet(agents, k, present);
+      continue;
+    }
+    const double u = aleatoireUniforme(&aleatoire);
+    if (u >= chance_pas) continue;
+    // Le même tirage choisit la direction
+    const unsigned long i = positions[k] / cote;
+    const unsigned long j = positions[k] % cote;
+    switch ((int)(u / chance_pas * 4)) {
+      case 0:
+        if (j > 0) positions[k]--;
+        break;
+      case 1:
+        if (j < cote - 1) positions[k]++;
+        break;
+      case 2:
+        if (i > 0) positions[k] -= (uint32_t)cote;
+        break;
+      default:
+        if (i < cote - 1) positions[k] += (uint32_t)cote;
+        break;
+    }
+  }
+}
+
+/**
+ * @brief Compte par case les agents (tous) posés dans la bande.
+ *
+ * @param tache Tâche.
+ */
+static void compterBande(struct TacheAgents *tache) {
+  const struct Agents *agents = tache->agents;
+  const uint32_t *positions = agents->positions;
+  const unsigned long case_debut = tache->case_debut;
+  const unsigned long taille = tache->case_fin - case_debut;
+  uint32_t *histogramme = tache->histogramme;
+  memset(histogramme, 0, taille * sizeof(uint32_t));
+  for (unsigned long k = 0; k < agents->nb_agents; k++) {
+    const unsigned long c = positions[k] - case_debut;  // Hors bande : grand
+    if (c < taille) histogramme[c]++;
+  }
+  tache->nb = 0;
+  for (unsigned long c = 0; c < taille; c++) tache->nb += histogramme[c];
+}
+
+/**
+ * @brief Rang de chaque case de la bande (après les bandes précédentes),
+ * puis range les agents de la bande dans ordre par indice croissant.
+ *
+ * @param tache Tâche.
+ */
+static void ranger(struct TacheAgents *tache) {
+  const struct Agents *agents = tache->agents;
+  const uint32_t *positions = agents->positions;
+  const unsigned long case_debut = tache->case_debut;
+  const unsigned long taille = tache->case_fin - case_debut;
+  uint32_t *histogramme = tache->histogramme;
+  unsigned long rang = 0;
+  for (const struct TacheAgents *t = agents->taches; t < tache; t++)
+    rang += t->nb;
+  for (unsigned long c = 0; c < taille; c++) {
+    agents->debuts[case_debut + c] = (uint32_t)rang;
+    const uint32_t nb = histogramme[c];
+    histogramme[c] = (uint32_t)rang;
+    rang += nb;
+  }
+  for (unsigned long k = 0; k < agents->nb_agents; k++) {
+    const unsigned long c = positions[k] - case_debut;
+    if (c < taille) agents->ordre[histogramme[c]++] = (uint32_t)k;
+  }
+}
+
+/**
+ * @brief Compte les agents contagieux et VACCINE de chaque case de la bande.
+ *
+ * La fin de chaque case dans ordre est lue dans l'histogramme rangé : la
+ * tâche ne lit pas debuts hors de sa bande.
+ *
+ * @param tache Tâche.
+ */
+static void compter(struct TacheAgents *tache) {
+  const struct Agents *agents = tache->agents;
+  const struct Population *population = agents->population;
+  const struct Personne *personnes = population->personnes;
+  const unsigned long *expirations = population->zones.expirations;
+  const unsigned long present = population->tour;
+  for (unsigned long c = tache->case_debut; c < tache->case_fin; c++) {
+    struct CaseAgents *compteurs = &agents->cases[c];
+    const uint32_t fin = tache->histogramme[c - tache->case_debut];
+    memset(compteurs, 0, sizeof(struct CaseAgents));
+    for (uint32_t n = agents->debuts[c]; n < fin; n++) {
+      const struct Personne *personne = &personnes[agents->ordre[n]];
+      if (personne->state == MALADE || personne->state == INCUBE)
+        compteurs->contagieux[expirations[personne->zone] > present]++;
+      else if (personne->state == VACCINE)
+        compteurs->vaccines++;
+    }
+  }
+}
+
+/**
+ * @brief Part d'une tâche dans le tri : déplacer sa tranche, puis compter,
+ * ranger et compter les agents de sa bande.
+ *
+ * @param tache Tâche.
+ */
+static void trierTache(struct TacheAgents *tache) {
+  struct Agents *agents = tache->agents;
+  deplacer(tache);
+  if (agents->nb_taches > 1) pthread_barrier_wait(&agents->deplaces);
+  compterBande(tache);
+  if (agents->nb_taches > 1) pthread_barrier_wait(&agents->comptes);
+  ranger(tache);
+  compter(tache);
+}
+
+/**
+ * @brief Boucle du thread d'une tâche : un tri par départ, jusqu'à l'arrêt.
+ *
+ * @param argument struct TacheAgents*.
+ * @return void* NULL.
+ */
+static void *executerTache(void *argument) {
+  struct TacheAgents *tache = (struct TacheAgents *)argument;
+  struct Agents *agents = tache->agents;
+  for (;;) {
+    pthread_barrier_wait(&agents->depart);
+    if (agents->arret) return NULL;
+    trierTache(tache);
+    pthread_barrier_wait(&agents->arrivee);
+  }
+}
+
+/**
+ * @brief Déplace les agents et reconstruit la liste de cases (tri par
+ * comptage, une bande de cases par tâche).
+ *
+ * @param agents Moteur.
+ */
+static void trierAgents(struct Agents *agents) {
+  if (agents->nb_taches == 1) {
+    trierTache(&agents->taches[0]);
+    return;
+  }
+  pthread_barrier_wait(&agents->depart);
+  pthread_barrier_wait(&agents->arrivee);
+}
+
+/**
+ * @brief Créer le moteur à agents.
+ *
+ * Les agents partent de leur domicile. En MOBILITE_TRAJET, la case travail
+ * de chaque agent est tirée uniformément dans le carré de côté
+ * 2 distance_travail + 1 centré sur son domicile, dans la grille.
+ *
+ * @param population Population des agents (non possédée, doit survivre au
+ * moteur).
+ * @param parametres Paramètres communs (copiés).
+ * @param parametres_agents Paramètres de déplacement (copiés).
+ * @param nb_taches Nombre de tâches du déplacement et du tri, un thread
+ * par tâche s'il y en a plus d'une.
+ * @param aleatoire Générateur des cases travail.
+ * @return struct Agents* Moteur, ou NULL si la grille dépasse 2^32 cases
+ * ou si les paramètres de déplacement sont invalides.
+ */
+struct Agents *creerAgents(struct Population *population,
+                           const struct Parametres *parametres,
+                           const struct ParametresAgents *parametres_agents,
+                           unsigned int nb_taches,
+                           struct Aleatoire *aleatoire) {
+  const unsigned long cote = population->cote;
+  const unsigned long nb_agents = cote * cote;
+  if (!nb_agents || nb_agents > UINT32_MAX) return NULL;
+  if (parametres_agents->mobilite == MOBILITE_MARCHE &&
+      !(parametres_agents->chance_pas >= 0 &&
+        parametres_agents->chance_pas <= 1))
+    return NULL;
+  if (parametres_agents->mobilite == MOBILITE_TRAJET &&
+      parametres_agents->periode < 2)
+    return NULL;
+
+  struct Agents *agents = (struct Agents *)malloc(sizeof(struct Agents));
+  agents->population = population;
+  agents->parametres_agents = *parametres_agents;
+  agents->sain = NULL;
+  agents->nb_agents = nb_agents;
+  agents->positions = (uint32_t *)malloc(nb_agents * sizeof(uint32_t));
+  agents->travail = NULL;
+  agents->debuts = (uint32_t *)malloc((nb_agents + 1) * sizeof(uint32_t));
+  agents->debuts[nb_agents] = (uint32_t)nb_agents;  // Tous les agents rangés
+  agents->ordre = (uint32_t *)malloc(nb_agents * sizeof(uint32_t));
+  agents->cases =
+      (struct CaseAgents *)malloc(nb_agents * sizeof(struct CaseAgents));
+  parametrerAgents(agents, parametres);
+
+  if (parametres_agents->mobilite == MOBILITE_TRAJET) {
+    const long rayon = parametres_agents->distance_travail < cote
+                           ? (long)parametres_agents->distance_travail
+                           : (long)cote;
+    agents->travail = (uint32_t *)malloc(nb_agents * sizeof(uint32_t));
+    for (unsigned long k = 0; k < nb_agents; k++) {
+      long i, j;
+      do {
+        i = (long)(k / cote) +
+            (long)(aleatoireEntier(aleatoire) % (uint64_t)(2 * rayon + 1)) -
+            rayon;
+        j = (long)(k % cote) +
+            (long)(aleatoireEntier(aleatoire) % (uint64_t)(2 * rayon + 1)) -
+            rayon;
+      } while (i < 0 || j < 0 || i >= (long)cote || j >= (long)cote);
+      agents->travail[k] = (uint32_t)(i * (long)cote + j);
+    }
+  }
+
+  // Tranches d'agents alignées sur les blocs, bandes de cases
+  const unsigned long nb_blocs = (nb_agents + AGENTS_BLOC - 1) / AGENTS_BLOC;
+  if (!nb_taches) nb_taches = 1;
+  if (nb_taches > nb_blocs) nb_taches = (unsigned int)nb_blocs;
+  agents->nb_taches = nb_taches;
+  agents->taches =
+      (struct TacheAgents *)malloc(nb_taches * sizeof(struct TacheAgents));
+  for (unsigned int t = 0; t < nb_taches; t++) {
+    struct TacheAgents *tache = &agents->taches[t];
+    tache->agents = agents;
+    tache->debut = nb_blocs * t / nb_taches * AGENTS_BLOC;
+    tache->fin = nb_blocs * (t + 1) / nb_taches * AGENTS_BLOC;
+    if (tache->fin > nb_agents) tache->fin = nb_agents;
+    tache->case_debut = nb_agents * t / nb_taches;
+    tache->case_fin = nb_agents * (t + 1) / nb_taches;
+    tache->histogramme = (uint32_t *)malloc(
+        (tache->case_fin - tache->case_debut) * sizeof(uint32_t));
+  }
+  agents->arret = 0;
+  if (nb_taches > 1) {
+    pthread_barrier_init(&agents->depart, NULL, nb_taches + 1);
+    pthread_barrier_init(&agents->deplaces, NULL, nb_taches);
+    pthread_barrier_init(&agents->comptes, NULL, nb_taches);
+    pthread_barrier_init(&agents->arrivee, NULL, nb_taches + 1);
+    for (unsigned int t = 0; t < nb_taches; t++)
+      if (pthread_create(&agents->taches[t].thread, NULL, executerTache,
+                         &agents->taches[t])) {
+        printf("Erreur: Thread de la tâche %u non créé.\n", t);
+        exit(1);
+      }
+  }
+  chargerAgents(agents);
+  return agents;
+}
+
+/**
+ * @brief Change les paramètres communs (bifurcation) : les transitions sont
+ * recalculées, les positions gardées.
+ *
+ * @param agents Moteur.
+ * @param parametres Paramètres (copiés).
+ */
+void parametrerAgents(struct Agents *agents,
+                      const struct Parametres *parametres) {
+  initTableTransition(&agents->table, parametres);
+  calculerSain(agents, NB_VOISINS + 1);
+}
+
+/**
+ * @brief Replace les agents à leur case du tour courant, après un
+ * changement de la population (réplicat).
+ *
+ * MOBILITE_MARCHE : au domicile ; MOBILITE_TRAJET : domicile ou travail
+ * selon le tour.
+ *
+ * @param agents Moteur.
+ */
+void chargerAgents(struct Agents *agents) {
+  const unsigned long tour = agents->population->tour;
+  for (unsigned long k = 0; k < agents->nb_agents; k++)
+    agents->positions[k] =
+        agents->travail ? caseTrajet(agents, k, tour) : (uint32_t)k;
+}
+
+/**
+ * @brief Met en quarantaine les agents proches d'une case.
+ *
+ * @param agents Moteur.
+ * @param centre Case du MALADE.
+ * @param zone Zone neuve (creerZone).
+ * @param tour Tour écrit dans le raster de quarantaine.
+ */
+static void mettreEnQuarantaineAgents(struct Agents *agents, uint32_t centre,
+                                      uint32_t zone, uint16_t tour) {
+  const struct Population *population = agents->population;
+  const long cote = (long)population->cote;
+  const int cordon_sanitaire = agents->table.parametres.cordon_sanitaire;
+  const long cordon = cordon_sanitaire > 0 ? cordon_sanitaire : 0;
+  uint16_t *raster_quarantaine = population->rasters[RASTER_QUARANTAINE];
+  const long ci = centre / cote, cj = centre % cote;
+  for (long i = ci - cordon; i <= ci + cordon; i++) {
+    if (i < 0 || i >= cote) continue;
+    const long reste = cordon - labs(i - ci);
+    for (long j = cj - reste; j <= cj + reste; j++) {
+      if (j < 0 || j >= cote) continue;
+      const uint32_t c = (uint32_t)(i * cote + j);
+      for (uint32_t n = agents->debuts[c]; n < agents->debuts[c + 1]; n++) {
+        const uint32_t a = agents->ordre[n];
+        struct Personne *tampon = &population->tampon[a];
+        tampon->zone = zone;
+        tampon->cordon_sanitaire =
+            (int)(reste - labs(j - cj));  // Distance restante au bord
+        if (raster_quarantaine && raster_quarantaine[a] == RASTER_JAMAIS)
+          raster_quarantaine[a] = tour;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Joue un tour : déplacements, liste de cases, puis transitions.
+ *
+ * @param agents Moteur.
+ * @param aleatoire Générateur aléatoire propre à la simulation.
+ */
+void jouerTourAgents(struct Agents *agents, struct Aleatoire *aleatoire) {
+  struct Population *population = agents->population;
+  const unsigned long cote = population->cote;
+  const struct Parametres *parametres = &agents->table.parametres;
+  agents->graine = aleatoireEntier(aleatoire);
+  trierAgents(agents);
+
+  preparerTampon(population);
+  const struct Personne *personnes = population->personnes;
+  struct Personne *tampons = population->tampon;
+  const unsigned long present = population->tour;
+  const unsigned long *expirations = population->zones.expirations;
+  population->tour++;
+  const uint16_t tour = getTourRaster(population);
+  uint16_t *const raster_infection = population->rasters[RASTER_INFECTION];
+  uint16_t *const raster_mort = population->rasters[RASTER_MORT];
+  const struct CaseAgents *cases = agents->cases;
+
+  for (unsigned long k = 0; k < agents->nb_agents; k++) {
+    const struct Personne *personne = &personnes[k];
+    struct Personne *tampon = &tampons[k];
+    const enum State state = personne->state;
+    if (state == INCUBE) {
+      // Décompte déterministe, sans tirage
+      if (personne->duree_incube == 0)
+        tampon->state = MALADE;
+      else
+        tampon->duree_incube--;
+      continue;
+    }
+    if (state == MORT || state == VACCINE) continue;
+
+    // Agents contagieux de même statut et VACCINE, dans la case et ses 4
+    // voisines, utiles à SAIN et IMMUNISE seulement
+    const struct Transition *transition =
+        &agents->table.transitions[MALADE][0][0];
+    if (state != MALADE) {
+      const uint32_t c = agents->positions[k];
+      const int statut = expirations[personne->zone] > present;
+      const unsigned long i = c / cote, j = c % cote;
+      unsigned long nb = cases[c].contagieux[statut];
+      uint32_t vaccines = cases[c].vaccines;
+      if (j > 0) {
+        nb += cases[c - 1].contagieux[statut];
+        vaccines += cases[c - 1].vaccines;
+      }
+      if (j < cote - 1) {
+        nb += cases[c + 1].contagieux[statut];
+        vaccines += cases[c + 1].vaccines;
+      }
+      if (i > 0) {
+        nb += cases[c - cote].contagieux[statut];
+        vaccines += cases[c - cote].vaccines;
+      }
+      if (i < cote - 1) {
+        nb += cases[c + cote].contagieux[statut];
+        vaccines += cases[c + cote].vaccines;
+      }
+      if (state == SAIN) {
+        if (nb >= agents->nb_sain)
+          calculerSain(agents, nb + 1 > 2 * agents->nb_sain
+                                   ? nb + 1
+                                   : 2 * agents->nb_sain);
+        transition = &agents->sain[nb][vaccines != 0];
+      } else {
+        transition = &agents->table.transitions[state][0][vaccines != 0];
+      }
+    }
+
+    // Une recherche et au plus un tirage
+    unsigned char issue = transition->issues[0];
+    if (transition->nb_issues > 1) {
+      const double u = aleatoireUniforme(aleatoire);
+      int n = 0;
+      while (n < transition->nb_issues - 1 && u >= transition->seuils[n]) n++;
+      issue = transition->issues[n];
+    }
+
+    if (issue & ISSUE_QUARANTAINE &&
+        expirations[tampon->zone] <= present + 1) {
+      const uint32_t zone =
+          creerZone(population, parametres->duree_quarantaine);
+      expirations = population->zones.expirations;  // Réallouée
+      if (zone)
+        mettreEnQuarantaineAgents(agents, agents->positions[k], zone, tour);
+    }
+    const enum State nouveau = (enum State)(issue & ~ISSUE_QUARANTAINE);
+    if (nouveau == state) continue;
+    tampon->state = nouveau;
+    if (nouveau == INCUBE) {
+      tampon->duree_incube = parametres->duree_incube;
+      if (raster_infection) raster_infection[k] = tour;
+    } else if (nouveau == MORT && raster_mort) {
+      raster_mort[k] = tour;
+    }
+  }
+
+  echangerTampon(population);  // Appliquer les changements
+}
+
+/**
+ * @brief Arrête les threads et libère le moteur (pas la population).
+ *
+ * @param agents Moteur.
+ */
+void detruireAgents(struct Agents *agents) {
+  if (agents->nb_taches > 1) {
+    agents->arret = 1;
+    pthread_barrier_wait(&agents->depart);
+    for (unsigned int t = 0; t < agents->nb_taches; t++)
+      pthread_join(agents->taches[t].thread, NULL);
+    pthread_barrier_destroy(&agents->depart);
+    pthread_barrier_destroy(&agents->deplaces);
+    pthread_barrier_destroy(&agents->comptes);
+    pthread_barrier_destroy(&agents->arrivee);
+  }
+  for (unsigned int t = 0; t < agents->nb_taches; t++)
+    free(agents->taches[t].histogramme);
+  free(agents->taches);
+  free(agents->sain);
+  free(agents->positions);
+  free(agents->travail);
+  free(agents->debuts);
+  free(agents->ordre);
+  free(agents->cases);
+  free(agents);
+}
@@ -0,0 +1,209 @@
+#if !defined(AGENTS_H)
+#define AGENTS_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "aleatoire.h"
+#include "jouer_un_tour.h"
+#include "population.h"
+#include "transition.h"
+
+/**
+ * @brief Agents par bloc d'un même générateur de déplacement : les
+ * déplacements ne dépendent pas du nombre de threads.
+ */
+#define AGENTS_BLOC 4096
+
+/**
+ * @brief Déplacement des agents entre deux tours.
+ */
+enum Mobilite {
+  MOBILITE_MARCHE,  // Marche aléatoire : un pas vers une case voisine
+  MOBILITE_TRAJET   // Aller-retour entre la case domicile et la case travail
+};
+
+/**
+ * @brief Paramètres de déplacement des agents.
+ */
+struct ParametresAgents {
+  /**
+   * @brief Loi de déplacement.
+   */
+  enum Mobilite mobilite;
+  /**
+   * @brief MOBILITE_MARCHE : probabilité de faire un pas à chaque tour.
+   */
+  double chance_pas;
+  /**
+   * @brief MOBILITE_TRAJET : distance maximale (Tchebychev) entre domicile
+   * et travail.
+   */
+  unsigned long distance_travail;
+  /**
+   * @brief MOBILITE_TRAJET : tours d'un aller-retour, la première moitié au
+   * domicile (2 au moins).
+   */
+  unsigned int periode;
+};
+
+/**
+ * @brief Case de la grille des agents : compteurs lus par le balayage.
+ */
+struct CaseAgents {
+  /**
+   * @brief Agents contagieux (MALADE ou INCUBE) [hors quarantaine, en
+   * quarantaine].
+   */
+  uint32_t contagieux[2];
+  /**
+   * @brief Nombre d'agents VACCINE.
+   */
+  uint32_t vaccines;
+};
+
+/**
+ * @brief Part d'un thread : une tranche d'agents (déplacement, tri) et une
+ * bande de cases (compteurs).
+ */
+struct TacheAgents {
+  /**
+   * @brief Moteur auquel appartient la tâche.
+   */
+  struct Agents *agents;
+  /**
+   * @brief Premier agent de la tranche (multiple de AGENTS_BLOC).
+   */
+  unsigned long debut;
+  /**
+   * @brief Agent après le dernier.
+   */
+  unsigned long fin;
+  /**
+   * @brief Première case de la bande.
+   */
+  unsigned long case_debut;
+  /**
+   * @brief Case après la dernière.
+   */
+  unsigned long case_fin;
+  /**
+   * @brief Agents de chaque case de la bande, puis rang d'écriture de
+   * chaque case dans ordre, et enfin fin de la case dans ordre
+   * (case_fin - case_debut entrées).
+   */
+  uint32_t *histogramme;
+  /**
+   * @brief Agents dans les cases de la bande ce tour.
+   */
+  unsigned long nb;
+  /**
+   * @brief Thread de la tâche (plus d'une tâche seulement).
+   */
+  pthread_t thread;
+};
+
+/**
+ * @brief Moteur à agents mobiles.
+ *
+ * Chaque Personne de la population est un agent ; l'agent k a pour domicile
+ * la case k (ligne par ligne) et se déplace sur une grille de même côté. Les
+ * contacts d'un agent sont les agents de sa case et des 4 cases voisines,
+ * retrouvés par une liste de cases (hachage spatial) reconstruite à chaque
+ * tour par un tri par comptage.
+ */
+struct Agents {
+  /**
+   * @brief Population des agents (non possédée) : états, incubations et
+   * zones, indexés par agent.
+   */
+  struct Population *population;
+  /**
+   * @brief Paramètres de déplacement (copie).
+   */
+  struct ParametresAgents parametres_agents;
+  /**
+   * @brief Transitions de la loi commune (même table que
+   * jouerTourTransition).
+   */
+  struct TableTransition table;
+  /**
+   * @brief Transitions SAIN à k agents contagieux, [k][voisin VACCINE],
+   * calculées à la demande au-delà de NB_VOISINS.
+   */
+  struct Transition (*sain)[2];
+  /**
+   * @brief Nombre d'entrées de sain.
+   */
+  unsigned long nb_sain;
+  /**
+   * @brief Nombre d'agents, et de cases (cote*cote).
+   */
+  unsigned long nb_agents;
+  /**
+   * @brief Case de chaque agent.
+   */
+  uint32_t *positions;
+  /**
+   * @brief MOBILITE_TRAJET : case travail de chaque agent, NULL sinon.
+   */
+  uint32_t *travail;
+  /**
+   * @brief Agents de la case c : ordre[debuts[c]] à ordre[debuts[c + 1] - 1]
+   * (nb_agents + 1 entrées).
+   */
+  uint32_t *debuts;
+  /**
+   * @brief Agents triés par case, par indice croissant dans une case.
+   */
+  uint32_t *ordre;
+  /**
+   * @brief Compteurs de chaque case.
+   */
+  struct CaseAgents *cases;
+  /**
+   * @brief Graine des générateurs de déplacement du tour.
+   */
+  uint64_t graine;
+  /**
+   * @brief Nombre de tâches (et de threads s'il y en a plus d'une).
+   */
+  unsigned int nb_taches;
+  /**
+   * @brief Tâches.
+   */
+  struct TacheAgents *taches;
+  /**
+   * @brief Vrai : les threads s'arrêtent au prochain départ.
+   */
+  char arret;
+  /**
+   * @brief Barrière de départ d'un tri (threads et appelant).
+   */
+  pthread_barrier_t depart;
+  /**
+   * @brief Barrière après les déplacements (threads).
+   */
+  pthread_barrier_t deplaces;
+  /**
+   * @brief Barrière après le comptage des bandes (threads).
+   */
+  pthread_barrier_t comptes;
+  /**
+   * @brief Barrière de fin d'un tri (threads et appelant).
+   */
+  pthread_barrier_t arrivee;
+};
+
+struct Agents *creerAgents(struct Population *population,
+                           const struct Parametres *parametres,
+                           const struct ParametresAgents *parametres_agents,
+                           unsigned int nb_taches,
+                           struct Aleatoire *aleatoire);
+void parametrerAgents(struct Agents *agents,
+                      const struct Parametres *parametres);
+void chargerAgents(struct Agents *agents);
+void jouerTourAgents(struct Agents *agents, struct Aleatoire *aleatoire);
+void detruireAgents(struct Agents *agents);
+
+#endif  // AGENTS_H
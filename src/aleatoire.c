@@ -0,0 +1,130 @@
+/**
+ * @file aleatoire.c
+ *
+ * @brief Générateur pseudo-aléatoire réentrant.
+ *
+ * Fonctionnalités :
+ * - Initialiser un générateur à partir d'une graine
+ * - Tirer un entier 64 bits
+ * - Tirer un réel uniforme dans [0, 1)
+ * - Tirer une loi binomiale
+ *
+ * Usage:
+ * ```
+ * struct Aleatoire aleatoire;
+ * initAleatoire(&aleatoire, 42);
+ * double nb_aleatoire = aleatoireUniforme(&aleatoire);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <math.h>
+
+#include "aleatoire.h"
+
+/**
+ * @brief Rotation à gauche de k bits.
+ */
+static inline uint64_t rotation(const uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+/**
+ * @brief Initialise le générateur à partir d'une graine (via splitmix64).
+ *
+ * Deux générateurs initialisés avec la même graine produisent la même suite.
+ *
+ * @param aleatoire Générateur à initialiser.
+ * @param graine Graine.
+ */
+void initAleatoire(struct Aleatoire *aleatoire, uint64_t graine) {
+  for (int i = 0; i < 4; i++) {
+    uint64_t z = (graine += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    aleatoire->etat[i] = z ^ (z >> 31);
+  }
+}
+
+/**
+ * @brief Tire un entier 64 bits uniforme.
+ *
+ * @param aleatoire Générateur.
+ * @return uint64_t Entier aléatoire.
+ */
+uint64_t aleatoireEntier(struct Aleatoire *aleatoire) {
+  uint64_t *s = aleatoire->etat;
+  const uint64_t resultat = rotation(s[1] * 5, 7) * 9;
+  const uint64_t t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotation(s[3], 45);
+
+  return resultat;
+}
+
+/**
+ * @brief Tire un réel uniforme dans [0, 1) (53 bits de précision).
+ *
+ * @param aleatoire Générateur.
+ * @return double Réel aléatoire.
+ */
+double aleatoireUniforme(struct Aleatoire *aleatoire) {
+  return (aleatoireEntier(aleatoire) >> 11) * 0x1.0p-53;
+}
+
+/**
+ * @brief Tire un réel de loi normale centrée réduite (Box-Muller).
+ *
+ * @param aleatoire Générateur.
+ * @return double Réel.
+ */
+double aleatoireNormale(struct Aleatoire *aleatoire) {
+  const double u = 1 - aleatoireUniforme(aleatoire);
+  const double v = aleatoireUniforme(aleatoire);
+  return sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+/**
+ * @brief Tire le nombre de succès parmi n essais de probabilité p.
+ *
+ * Coût O(n * p) par sauts géométriques quand n * p est petit, O(1) sinon
+ * (approximation normale, bornée à [0, n]).
+ *
+ * @param aleatoire Générateur.
+ * @param n Nombre d'essais.
+ * @param p Probabilité de succès d'un essai.
+ * @return unsigned long Nombre de succès.
+ */
+unsigned long aleatoireBinomial(struct Aleatoire *aleatoire, unsigned long n,
+                                double p) {
+  if (!n || p <= 0) return 0;
+  if (p >= 1) return n;
+  if (p > 0.5) return n - aleatoireBinomial(aleatoire, n, 1 - p);
+
+  const double moyenne = n * p;
+  if (moyenne < 20) {
+    // Sauts géométriques entre deux succès
+    const double log_echec = log1p(-p);
+    unsigned long succes = 0;
+    double position = 0;
+    for (;;) {
+      position += floor(log(1 - aleatoireUniforme(aleatoire)) / log_echec) + 1;
+      if (position > n) return succes;
+      succes++;
+    }
+  }
+
+  const double normale = aleatoireNormale(aleatoire);
+  const double tirage = floor(moyenne + sqrt(moyenne * (1 - p)) * normale + 0.5);
+  if (tirage < 0) return 0;
+  if (tirage > n) return n;
+  return (unsigned long)tirage;
+}
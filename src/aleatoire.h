@@ -0,0 +1,26 @@
+#if !defined(ALEATOIRE_H)
+#define ALEATOIRE_H
+
+#include <stdint.h>
+
+/**
+ * @brief Générateur pseudo-aléatoire réentrant (xoshiro256**).
+ *
+ * Chaque simulation possède le sien, contrairement à rand() qui partage un
+ * état global entre tous les appelants.
+ */
+struct Aleatoire {
+  /**
+   * @brief Etat interne du générateur.
+   */
+  uint64_t etat[4];
+};
+
+void initAleatoire(struct Aleatoire *aleatoire, uint64_t graine);
+uint64_t aleatoireEntier(struct Aleatoire *aleatoire);
+double aleatoireUniforme(struct Aleatoire *aleatoire);
+double aleatoireNormale(struct Aleatoire *aleatoire);
+unsigned long aleatoireBinomial(struct Aleatoire *aleatoire, unsigned long n,
+                                double p);
+
+#endif  // ALEATOIRE_H
@@ -0,0 +1,273 @@
+/**
+ * @file bandes.c
+ *
+ * @brief Bitboard joué en bandes de lignes, un thread par bande.
+ *
+ * Fonctionnalités :
+ * - Premier contact : chaque thread écrit lui-même sa bande, placée sur son
+ *   nœud NUMA par le noyau Linux
+ * - Epinglage optionnel du thread k sur le cœur k
+ * - Diagnostic NUMA : mémoire des plans par nœud, nœud de chaque bande
+ *
+ * Un tour : chaque thread prépare les contagieux de sa bande, attend les
+ * autres (une bande lit les lignes de bord de ses voisines), puis joue sa
+ * bande avec son propre générateur. Même loi que jouerTourBitboard.
+ *
+ * Usage:
+ * ```
+ * struct Bandes *bandes =
+ *     creerBandes(population, &parametres, 16, BANDES_EPINGLER, 42);
+ * afficherNumaBandes(bandes, stdout);
+ * for (...) jouerTourBandes(bandes);
+ * synchroniserBitboard(bandes->bitboard);
+ * detruireBandes(bandes);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "bandes.h"
+
+/**
+ * @brief Nombre maximal de nœuds NUMA affichés.
+ */
+#define MAX_NOEUDS 64
+
+/**
+ * @brief Epingle le thread appelant sur un cœur (modulo les cœurs en ligne).
+ *
+ * @param indice Indice du thread.
+ */
+static void epinglerThread(unsigned int indice) {
+  const long nb_coeurs = sysconf(_SC_NPROCESSORS_ONLN);
+  cpu_set_t coeurs;
+  CPU_ZERO(&coeurs);
+  CPU_SET(indice % (nb_coeurs > 0 ? (unsigned long)nb_coeurs : 1), &coeurs);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &coeurs);
+}
+
+/**
+ * @brief Boucle d'un thread : exécute les ordres jusqu'à ORDRE_ARRETER.
+ *
+ * @param argument struct Bande*.
+ * @return void* NULL.
+ */
+static void *executerBande(void *argument) {
+  struct Bande *bande = (struct Bande *)argument;
+  struct Bandes *bandes = bande->bandes;
+  if (bandes->options & BANDES_EPINGLER) epinglerThread(bande->indice);
+  for (;;) {
+    pthread_barrier_wait(&bandes->depart);
+    switch (bandes->ordre) {
+      case ORDRE_ARRETER:
+        return NULL;
+      case ORDRE_CHARGER:
+        bande->coeur = sched_getcpu();
+        if (!(bandes->options & BANDES_CONTACT_PRINCIPAL))
+          chargerLignesBitboard(bandes->bitboard, bande->debut, bande->fin);
+        break;
+      case ORDRE_JOUER:
+        preparerLignesBitboard(bandes->bitboard, bande->debut, bande->fin);
+        pthread_barrier_wait(&bandes->contagieux);
+        jouerLignesBitboard(bandes->bitboard, &bande->aleatoire, bandes->tour,
+                            bande->debut, bande->fin);
+        break;
+    }
+    pthread_barrier_wait(&bandes->arrivee);
+  }
+}
+
+/**
+ * @brief Donne un ordre aux threads et attend qu'il soit exécuté.
+ *
+ * @param bandes Bandes.
+ * @param ordre Ordre.
+ */
+static void ordonner(struct Bandes *bandes, enum OrdreBandes ordre) {
+  bandes->ordre = ordre;
+  pthread_barrier_wait(&bandes->depart);
+  if (ordre != ORDRE_ARRETER) pthread_barrier_wait(&bandes->arrivee);
+}
+
+/**
+ * @brief Créer les bandes d'un bitboard et leurs threads.
+ *
+ * Les plans sont alloués sans être touchés, puis chaque thread charge sa
+ * bande (sauf avec BANDES_CONTACT_PRINCIPAL).
+ *
+ * @param population Population (non possédée, doit survivre aux bandes).
+ * @param parametres Paramètres (copiés).
+ * @param nb_bandes Nombre de bandes, ramené entre 1 et cote.
+ * @param options Combinaison de enum OptionBandes.
+ * @param graine Graine des générateurs des bandes.
+ * @return struct Bandes* Bandes, NULL si la quarantaine est active.
+ */
+struct Bandes *creerBandes(struct Population *population,
+                           const struct Parametres *parametres,
+                           unsigned int nb_bandes, unsigned int options,
+                           uint64_t graine) {
+  struct Bitboard *bitboard = allouerBitboard(population, parametres);
+  if (!bitboard) return NULL;
+  const unsigned long cote = population->cote;
+  if (nb_bandes < 1) nb_bandes = 1;
+  if (nb_bandes > cote) nb_bandes = (unsigned int)cote;
+
+  struct Bandes *bandes = (struct Bandes *)malloc(sizeof(struct Bandes));
+  bandes->bitboard = bitboard;
+  bandes->nb_bandes = nb_bandes;
+  bandes->options = options;
+  bandes->tour = 0;
+  bandes->bande = (struct Bande *)malloc(nb_bandes * sizeof(struct Bande));
+  pthread_barrier_init(&bandes->depart, NULL, nb_bandes + 1);
+  pthread_barrier_init(&bandes->contagieux, NULL, nb_bandes);
+  pthread_barrier_init(&bandes->arrivee, NULL, nb_bandes + 1);
+  for (unsigned int k = 0; k < nb_bandes; k++) {
+    struct Bande *bande = &bandes->bande[k];
+    bande->bandes = bandes;
+    bande->indice = k;
+    bande->debut = k * cote / nb_bandes;
+    bande->fin = (k + 1) * cote / nb_bandes;
+    bande->coeur = -1;
+    if (pthread_create(&bande->thread, NULL, executerBande, bande)) {
+      printf("Erreur: Thread de la bande %u non créé.\n", k);
+      exit(1);
+    }
+  }
+  chargerBandes(bandes, graine);
+  return bandes;
+}
+
+/**
+ * @brief Recharge les bandes depuis la grille de la population.
+ *
+ * @param bandes Bandes.
+ * @param graine Graine des générateurs des bandes.
+ */
+void chargerBandes(struct Bandes *bandes, uint64_t graine) {
+  struct Bitboard *bitboard = bandes->bitboard;
+  dimensionnerCompteursBitboard(bitboard);
+  if (bandes->options & BANDES_CONTACT_PRINCIPAL)
+    chargerLignesBitboard(bitboard, 0, bitboard->population->cote);
+  // Un générateur par bande, graines tirées d'un générateur commun
+  struct Aleatoire aleatoire;
+  initAleatoire(&aleatoire, graine);
+  for (unsigned int k = 0; k < bandes->nb_bandes; k++)
+    initAleatoire(&bandes->bande[k].aleatoire, aleatoireEntier(&aleatoire));
+  ordonner(bandes, ORDRE_CHARGER);
+}
+
+/**
+ * @brief Joue un tour, toutes les bandes en parallèle.
+ *
+ * @param bandes Bandes.
+ */
+void jouerTourBandes(struct Bandes *bandes) {
+  struct Population *population = bandes->bitboard->population;
+  population->tour++;
+  bandes->tour = getTourRaster(population);
+  ordonner(bandes, ORDRE_JOUER);
+  terminerTourBitboard(bandes->bitboard);
+}
+
+/**
+ * @brief Compte les pages d'une zone par nœud NUMA.
+ *
+ * @param zone Début de la zone.
+ * @param taille Octets.
+ * @param pages Pages par nœud, MAX_NOEUDS éléments (incrémentés).
+ * @return int 0, ou -1 si move_pages n'est pas disponible.
+ */
+static int compterPages(const void *zone, size_t taille,
+                        unsigned long *pages) {
+  const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  const uintptr_t debut = (uintptr_t)zone & ~(uintptr_t)(page - 1);
+  const size_t nb = ((uintptr_t)zone + taille - debut + page - 1) / page;
+  void **adresses = (void **)malloc(nb * sizeof(void *));
+  int *noeuds = (int *)malloc(nb * sizeof(int));
+  for (size_t k = 0; k < nb; k++) adresses[k] = (void *)(debut + k * page);
+  // move_pages sans destination : nœud actuel de chaque page
+  const long retour =
+      syscall(SYS_move_pages, 0, nb, adresses, NULL, noeuds, 0);
+  if (!retour)
+    for (size_t k = 0; k < nb; k++)
+      if (noeuds[k] >= 0 && noeuds[k] < MAX_NOEUDS) pages[noeuds[k]]++;
+  free(adresses);
+  free(noeuds);
+  return retour ? -1 : 0;
+}
+
+/**
+ * @brief Affiche la mémoire des plans par nœud NUMA et le placement des
+ * bandes (option --numa).
+ *
+ * @param bandes Bandes.
+ * @param flux Flux de sortie.
+ */
+void afficherNumaBandes(const struct Bandes *bandes, FILE *flux) {
+  const struct Bitboard *bitboard = bandes->bitboard;
+  const unsigned long cote = bitboard->population->cote;
+  const size_t taille_plan = cote * bitboard->mots * sizeof(uint64_t);
+  unsigned long pages[MAX_NOEUDS] = {0};
+  int erreur = compterPages(bitboard->plans, (VACCINE + 1) * taille_plan,
+                            pages);
+  erreur |= compterPages(bitboard->tampon, (VACCINE + 1) * taille_plan, pages);
+  erreur |= compterPages(bitboard->contagieux, taille_plan, pages);
+  if (bitboard->nb_bits)
+    erreur |= compterPages(bitboard->compteurs,
+                           bitboard->nb_bits * taille_plan, pages);
+  if (erreur) {
+    fprintf(flux, "NUMA: move_pages indisponible (%s)\n", strerror(errno));
+    return;
+  }
+
+  const double mio = (double)sysconf(_SC_PAGESIZE) / (1024 * 1024);
+  fprintf(flux, "NUMA: %u bandes%s%s\n", bandes->nb_bandes,
+          bandes->options & BANDES_EPINGLER ? ", épinglées" : "",
+          bandes->options & BANDES_CONTACT_PRINCIPAL
+              ? ", chargées par le thread principal"
+              : ", premier contact par bande");
+  for (int noeud = 0; noeud < MAX_NOEUDS; noeud++)
+    if (pages[noeud])
+      fprintf(flux, "  nœud %d : %.1f Mio\n", noeud, pages[noeud] * mio);
+  for (unsigned int k = 0; k < bandes->nb_bandes; k++) {
+    const struct Bande *bande = &bandes->bande[k];
+    unsigned long noeuds[MAX_NOEUDS] = {0};
+    compterPages(bitboard->plans + bande->debut * bitboard->mots,
+                 (bande->fin - bande->debut) * bitboard->mots *
+                     sizeof(uint64_t),
+                 noeuds);
+    int noeud = 0;
+    for (int n = 1; n < MAX_NOEUDS; n++)
+      if (noeuds[n] > noeuds[noeud]) noeud = n;
+    fprintf(flux, "  bande %u (lignes %lu-%lu) : cœur %d, nœud %d\n", k,
+            bande->debut, bande->fin - 1, bande->coeur, noeud);
+  }
+}
+
+/**
+ * @brief Arrête les threads et libère les bandes et leur bitboard.
+ *
+ * @param bandes Bandes.
+ */
+void detruireBandes(struct Bandes *bandes) {
+  ordonner(bandes, ORDRE_ARRETER);
+  for (unsigned int k = 0; k < bandes->nb_bandes; k++)
+    pthread_join(bandes->bande[k].thread, NULL);
+  pthread_barrier_destroy(&bandes->depart);
+  pthread_barrier_destroy(&bandes->contagieux);
+  pthread_barrier_destroy(&bandes->arrivee);
+  detruireBitboard(bandes->bitboard);
+  free(bandes->bande);
+  free(bandes);
+}
@@ -0,0 +1,111 @@
+#if !defined(BANDES_H)
+#define BANDES_H
+
+#include <pthread.h>
+#include <stdio.h>
+
+#include "bitboard.h"
+
+/**
+ * @brief Options de creerBandes.
+ */
+enum OptionBandes {
+  BANDES_EPINGLER = 1,  // Thread k épinglé sur le cœur k (modulo les cœurs)
+  BANDES_CONTACT_PRINCIPAL = 2  // Plans écrits par l'appelant (comparaison)
+};
+
+/**
+ * @brief Ordre donné aux threads des bandes.
+ */
+enum OrdreBandes { ORDRE_CHARGER, ORDRE_JOUER, ORDRE_ARRETER };
+
+/**
+ * @brief Bande de lignes d'un bitboard, jouée par un thread.
+ */
+struct Bande {
+  /**
+   * @brief Bandes auxquelles appartient la bande.
+   */
+  struct Bandes *bandes;
+  /**
+   * @brief Indice de la bande.
+   */
+  unsigned int indice;
+  /**
+   * @brief Première ligne.
+   */
+  unsigned long debut;
+  /**
+   * @brief Ligne après la dernière.
+   */
+  unsigned long fin;
+  /**
+   * @brief Générateur propre à la bande.
+   */
+  struct Aleatoire aleatoire;
+  /**
+   * @brief Cœur sur lequel le thread a chargé sa bande (-1 si inconnu).
+   */
+  int coeur;
+  /**
+   * @brief Thread de la bande.
+   */
+  pthread_t thread;
+};
+
+/**
+ * @brief Bitboard découpé en bandes de lignes, une par thread.
+ *
+ * Chaque thread charge lui-même sa bande (premier contact) : sur une machine
+ * NUMA, les pages de la bande sont placées sur le nœud du thread qui la
+ * jouera, et seules les lignes de bord sont lues sur un autre nœud.
+ */
+struct Bandes {
+  /**
+   * @brief Bitboard joué (possédé).
+   */
+  struct Bitboard *bitboard;
+  /**
+   * @brief Nombre de bandes (et de threads).
+   */
+  unsigned int nb_bandes;
+  /**
+   * @brief Combinaison de enum OptionBandes.
+   */
+  unsigned int options;
+  /**
+   * @brief Bandes, nb_bandes éléments.
+   */
+  struct Bande *bande;
+  /**
+   * @brief Ordre en cours, lu par les threads après depart.
+   */
+  enum OrdreBandes ordre;
+  /**
+   * @brief Tour écrit dans les rasters par ORDRE_JOUER.
+   */
+  uint16_t tour;
+  /**
+   * @brief Barrière de départ d'un ordre (threads et appelant).
+   */
+  pthread_barrier_t depart;
+  /**
+   * @brief Barrière entre la préparation des contagieux et le tour.
+   */
+  pthread_barrier_t contagieux;
+  /**
+   * @brief Barrière de fin d'un ordre (threads et appelant).
+   */
+  pthread_barrier_t arrivee;
+};
+
+struct Bandes *creerBandes(struct Population *population,
+                           const struct Parametres *parametres,
+                           unsigned int nb_bandes, unsigned int options,
+                           uint64_t graine);
+void chargerBandes(struct Bandes *bandes, uint64_t graine);
+void jouerTourBandes(struct Bandes *bandes);
+void afficherNumaBandes(const struct Bandes *bandes, FILE *flux);
+void detruireBandes(struct Bandes *bandes);
+
+#endif  // BANDES_H
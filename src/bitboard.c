@@ -0,0 +1,444 @@
+/**
+ * @file bitboard.c
+ *
+ * @brief Moteur en plans de bits, 64 cases par opération.
+ *
+ * Chaque état est un plan de bits ; infection et propagation du vaccin sont
+ * calculées par décalages et opérations logiques sur des mots de 64 cases.
+ * Les tirages (MORT, IMMUNISE, découverte du vaccin, contagion si
+ * lambda < 1) sont des masques de Bernoulli : 64 tirages indépendants en
+ * quelques nombres aléatoires. Avec lambda = 1, la contagion ne tire rien.
+ *
+ * Même loi que jouerTourParametres (à 2^-53 près, précision de
+ * aleatoireUniforme), mais pas les mêmes tirages. La quarantaine (cordon
+ * sanitaire récursif, dépendant de l'ordre de parcours) n'est pas prise en
+ * charge : voir bitboardCompatible.
+ *
+ * Chaque tour se découpe en plages de lignes (preparerLignesBitboard puis
+ * jouerLignesBitboard) pour les bandes de bandes.c.
+ *
+ * Usage:
+ * ```
+ * struct Bitboard *bitboard = creerBitboard(population, &parametres);
+ * if (!bitboard) ...;  // quarantaine : jouerTourParametres
+ * for (...) jouerTourBitboard(bitboard, &aleatoire);
+ * synchroniserBitboard(bitboard);  // la grille de population est à jour
+ * detruireBitboard(bitboard);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitboard.h"
+
+/**
+ * @brief Nombre de plans d'états.
+ */
+#define NB_PLANS (VACCINE + 1)
+
+/**
+ * @brief Ligne i du plan p d'un tableau de plans.
+ */
+#define LIGNE(tableau, p, i) \
+  ((tableau) + ((unsigned long)(p) * cote + (i)) * mots)
+
+/**
+ * @brief Masque dont chaque bit vaut 1 avec la probabilité p, indépendamment.
+ *
+ * Chaque bit compare un nombre uniforme, tiré bit à bit, au développement
+ * binaire de p : un mot aléatoire par bit de p, jusqu'à ce que les 64 cases
+ * soient décidées (une dizaine de mots en moyenne).
+ *
+ * @param aleatoire Générateur.
+ * @param p Probabilité.
+ * @return uint64_t Masque.
+ */
+static uint64_t masqueBernoulli(struct Aleatoire *aleatoire, double p) {
+  if (p <= 0) return 0;
+  if (p >= 1) return ~(uint64_t)0;
+  uint64_t masque = 0, indecis = ~(uint64_t)0;
+  for (int k = 0; k < 64 && indecis && p > 0; k++) {
+    const uint64_t bits = aleatoireEntier(aleatoire);
+    p *= 2;  // Bit k de p
+    if (p >= 1) {
+      masque |= indecis & ~bits;  // Bit tiré 0 < 1 : inférieur à p
+      indecis &= bits;
+      p -= 1;
+    } else {
+      indecis &= ~bits;  // Bit tiré 1 > 0 : supérieur à p
+    }
+  }
+  return masque;
+}
+
+/**
+ * @brief Cases dont le voisin de gauche (j - 1) est dans le plan.
+ */
+static inline uint64_t voisinGauche(const uint64_t *ligne, unsigned long w) {
+  return ligne[w] << 1 | (w ? ligne[w - 1] >> 63 : 0);
+}
+
+/**
+ * @brief Cases dont le voisin de droite (j + 1) est dans le plan.
+ */
+static inline uint64_t voisinDroite(const uint64_t *ligne, unsigned long w,
+                                    unsigned long mots) {
+  return ligne[w] >> 1 | (w + 1 < mots ? ligne[w + 1] << 63 : 0);
+}
+
+/**
+ * @brief Vrai si le moteur s'applique : pas de quarantaine.
+ *
+ * @param parametres Paramètres de la simulation.
+ * @param population Population au début de la simulation.
+ * @return char Booléen.
+ */
+char bitboardCompatible(const struct Parametres *parametres,
+                        const struct Population *population) {
+  return !(getExtensions(parametres, population) & EXTENSION_QUARANTAINE);
+}
+
+/**
+ * @brief Alloue un bitboard sans toucher ses plans.
+ *
+ * Les pages des plans ne sont placées qu'à la première écriture : sur une
+ * machine NUMA, le thread qui charge une ligne (chargerLignesBitboard) la
+ * place sur son nœud. Charger ensuite toutes les lignes avant de jouer.
+ *
+ * @param population Population (non possédée, doit survivre au bitboard).
+ * @param parametres Paramètres (copiés).
+ * @return struct Bitboard* Bitboard, NULL si la quarantaine est active.
+ */
+struct Bitboard *allouerBitboard(struct Population *population,
+                                 const struct Parametres *parametres) {
+  if (!bitboardCompatible(parametres, population)) return NULL;
+  const unsigned long cote = population->cote;
+  struct Bitboard *bitboard =
+      (struct Bitboard *)malloc(sizeof(struct Bitboard));
+  bitboard->population = population;
+  bitboard->parametres = *parametres;
+  bitboard->mots = (cote + CASES_PAR_MOT - 1) / CASES_PAR_MOT;
+  const unsigned long taille_plan = cote * bitboard->mots;
+  bitboard->plans =
+      (uint64_t *)malloc(NB_PLANS * taille_plan * sizeof(uint64_t));
+  bitboard->tampon =
+      (uint64_t *)malloc(NB_PLANS * taille_plan * sizeof(uint64_t));
+  bitboard->contagieux = (uint64_t *)malloc(taille_plan * sizeof(uint64_t));
+  bitboard->compteurs = NULL;
+  bitboard->nb_bits = 0;
+  if (!bitboard->plans || !bitboard->tampon || !bitboard->contagieux) {
+    printf("Erreur: Bitboard, plus de mémoire.\n");
+    exit(1);
+  }
+  dimensionnerCompteursBitboard(bitboard);
+  return bitboard;
+}
+
+/**
+ * @brief Créer un bitboard attaché à une population, et la charger.
+ *
+ * @param population Population (non possédée, doit survivre au bitboard).
+ * @param parametres Paramètres (copiés).
+ * @return struct Bitboard* Bitboard, NULL si la quarantaine est active.
+ */
+struct Bitboard *creerBitboard(struct Population *population,
+                               const struct Parametres *parametres) {
+  struct Bitboard *bitboard = allouerBitboard(population, parametres);
+  if (bitboard) chargerLignesBitboard(bitboard, 0, population->cote);
+  return bitboard;
+}
+
+/**
+ * @brief Choisit le nombre de plans du compteur d'incubation et les alloue.
+ *
+ * Le compteur doit contenir duree_incube et les compteurs de la grille. Les
+ * plans sont réalloués seulement si ce nombre change.
+ *
+ * @param bitboard Bitboard.
+ */
+void dimensionnerCompteursBitboard(struct Bitboard *bitboard) {
+  const struct Population *population = bitboard->population;
+  const unsigned long cote = population->cote, mots = bitboard->mots;
+  unsigned int maximum = bitboard->parametres.duree_incube;
+  for (unsigned long k = 0; k < cote * cote; k++)
+    if ((unsigned int)population->personnes[k].duree_incube > maximum)
+      maximum = (unsigned int)population->personnes[k].duree_incube;
+  unsigned int nb_bits = 0;
+  while (nb_bits < 32 && maximum >> nb_bits) nb_bits++;
+  if (nb_bits != bitboard->nb_bits || !bitboard->compteurs) {
+    free(bitboard->compteurs);
+    bitboard->nb_bits = nb_bits;
+    bitboard->compteurs = (uint64_t *)malloc(
+        ((unsigned long)nb_bits * cote * mots + 1) * sizeof(uint64_t));
+  }
+}
+
+/**
+ * @brief Recharge les plans depuis la grille de la population.
+ *
+ * A appeler après toute modification de la grille hors du bitboard
+ * (copierPopulation, reinitialiserSimulation).
+ *
+ * @param bitboard Bitboard.
+ */
+void chargerBitboard(struct Bitboard *bitboard) {
+  dimensionnerCompteursBitboard(bitboard);
+  chargerLignesBitboard(bitboard, 0, bitboard->population->cote);
+}
+
+/**
+ * @brief Charge les lignes [debut, fin) de tous les plans (tampon compris).
+ *
+ * Première écriture de ces lignes : appelée par le thread qui les jouera.
+ * Les compteurs doivent être dimensionnés (dimensionnerCompteursBitboard).
+ *
+ * @param bitboard Bitboard.
+ * @param debut Première ligne.
+ * @param fin Ligne après la dernière.
+ */
+void chargerLignesBitboard(struct Bitboard *bitboard, unsigned long debut,
+                           unsigned long fin) {
+  const struct Population *population = bitboard->population;
+  const unsigned long cote = population->cote, mots = bitboard->mots;
+  const unsigned long taille = (fin - debut) * mots * sizeof(uint64_t);
+  for (int p = 0; p < NB_PLANS; p++) {
+    memset(LIGNE(bitboard->plans, p, debut), 0, taille);
+    memset(LIGNE(bitboard->tampon, p, debut), 0, taille);
+  }
+  memset(LIGNE(bitboard->contagieux, 0, debut), 0, taille);
+  for (unsigned int b = 0; b < bitboard->nb_bits; b++)
+    memset(LIGNE(bitboard->compteurs, b, debut), 0, taille);
+  for (unsigned long i = debut; i < fin; i++) {
+    for (unsigned long j = 0; j < cote; j++) {
+      const struct Personne *personne = &population->grille_de_personnes[i][j];
+      const uint64_t bit = (uint64_t)1 << (j % CASES_PAR_MOT);
+      const unsigned long w = j / CASES_PAR_MOT;
+      LIGNE(bitboard->plans, personne->state, i)[w] |= bit;
+      for (unsigned int b = 0; b < bitboard->nb_bits; b++)
+        if ((unsigned int)personne->duree_incube >> b & 1)
+          LIGNE(bitboard->compteurs, b, i)[w] |= bit;
+    }
+  }
+}
+
+/**
+ * @brief Joue un tour sur les plans (même loi que jouerTourParametres).
+ *
+ * La grille de la population n'est pas modifiée (voir
+ * synchroniserBitboard) ; son tour et ses rasters le sont.
+ *
+ * @param bitboard Bitboard.
+ * @param aleatoire Générateur aléatoire propre à la simulation.
+ */
+void jouerTourBitboard(struct Bitboard *bitboard, struct Aleatoire *aleatoire) {
+  struct Population *population = bitboard->population;
+  population->tour++;
+  const uint16_t tour = getTourRaster(population);
+  preparerLignesBitboard(bitboard, 0, population->cote);
+  jouerLignesBitboard(bitboard, aleatoire, tour, 0, population->cote);
+  terminerTourBitboard(bitboard);
+}
+
+/**
+ * @brief Plan des contagieux (MALADE ou INCUBE) des lignes [debut, fin).
+ *
+ * Toutes les lignes doivent être préparées avant d'en jouer une : une ligne
+ * lit les contagieux de ses voisines.
+ *
+ * @param bitboard Bitboard.
+ * @param debut Première ligne.
+ * @param fin Ligne après la dernière.
+ */
+void preparerLignesBitboard(struct Bitboard *bitboard, unsigned long debut,
+                            unsigned long fin) {
+  const unsigned long cote = bitboard->population->cote;
+  const unsigned long mots = bitboard->mots;
+  const uint64_t *malade = LIGNE(bitboard->plans, MALADE, 0);
+  const uint64_t *incube = LIGNE(bitboard->plans, INCUBE, 0);
+  for (unsigned long k = debut * mots; k < fin * mots; k++)
+    bitboard->contagieux[k] = malade[k] | incube[k];
+}
+
+/**
+ * @brief Joue les lignes [debut, fin) d'un tour dans le tampon.
+ *
+ * Des plages disjointes peuvent être jouées en parallèle, chacune avec son
+ * générateur : une ligne n'écrit que ses propres cases.
+ *
+ * @param bitboard Bitboard.
+ * @param aleatoire Générateur de la plage.
+ * @param tour Tour écrit dans les rasters.
+ * @param debut Première ligne.
+ * @param fin Ligne après la dernière.
+ */
+void jouerLignesBitboard(struct Bitboard *bitboard, struct Aleatoire *aleatoire,
+                         uint16_t tour, unsigned long debut,
+                         unsigned long fin) {
+  struct Population *population = bitboard->population;
+  const unsigned long cote = population->cote, mots = bitboard->mots;
+  const unsigned int nb_bits = bitboard->nb_bits;
+  const double beta = bitboard->parametres.beta;
+  const double gamma = bitboard->parametres.gamma;
+  const double lambda = bitboard->parametres.lambda;
+  const double chance_vaccin = bitboard->parametres.chance_decouverte_vaccin;
+  const unsigned int duree_incube = bitboard->parametres.duree_incube;
+  uint16_t *const raster_infection = population->rasters[RASTER_INFECTION];
+  uint16_t *const raster_mort = population->rasters[RASTER_MORT];
+
+  for (unsigned long i = debut; i < fin; i++) {
+    const uint64_t *sain = LIGNE(bitboard->plans, SAIN, i);
+    const uint64_t *ligne_malade = LIGNE(bitboard->plans, MALADE, i);
+    const uint64_t *mort = LIGNE(bitboard->plans, MORT, i);
+    const uint64_t *immunise = LIGNE(bitboard->plans, IMMUNISE, i);
+    const uint64_t *ligne_incube = LIGNE(bitboard->plans, INCUBE, i);
+    const uint64_t *vaccine = LIGNE(bitboard->plans, VACCINE, i);
+    const uint64_t *contagieux = LIGNE(bitboard->contagieux, 0, i);
+    const uint64_t *haut = i ? contagieux - mots : NULL;
+    const uint64_t *bas = i + 1 < cote ? contagieux + mots : NULL;
+    const uint64_t *vaccine_haut = i ? vaccine - mots : NULL;
+    const uint64_t *vaccine_bas = i + 1 < cote ? vaccine + mots : NULL;
+
+    for (unsigned long w = 0; w < mots; w++) {
+      const uint64_t s = sain[w], m = ligne_malade[w], n = ligne_incube[w];
+      uint64_t vers_vaccin = 0, infection = 0, morts = 0, gueris = 0;
+
+      // SAIN et IMMUNISE : découverte du vaccin, puis voisin VACCINE
+      const uint64_t candidats = s | immunise[w];
+      if (candidats) {
+        const uint64_t voisin_vaccine =
+            voisinGauche(vaccine, w) | voisinDroite(vaccine, w, mots) |
+            (vaccine_haut ? vaccine_haut[w] : 0) |
+            (vaccine_bas ? vaccine_bas[w] : 0);
+        vers_vaccin =
+            candidats &
+            (voisin_vaccine | masqueBernoulli(aleatoire, chance_vaccin));
+      }
+
+      // SAIN : infection par chaque voisin contagieux avec la chance lambda
+      const uint64_t exposes = s & ~vers_vaccin;
+      if (exposes) {
+        const uint64_t voisins[4] = {voisinGauche(contagieux, w),
+                                     voisinDroite(contagieux, w, mots),
+                                     haut ? haut[w] : 0, bas ? bas[w] : 0};
+        for (int d = 0; d < 4; d++)
+          if (exposes & voisins[d])
+            infection |= voisins[d] & masqueBernoulli(aleatoire, lambda);
+        infection &= exposes;
+      }
+
+      // MALADE : MORT, sinon IMMUNISE
+      if (m) {
+        morts = m & masqueBernoulli(aleatoire, beta);
+        gueris = m & ~morts & masqueBernoulli(aleatoire, gamma);
+      }
+
+      // INCUBE : compteur nul -> MALADE, sinon décrément bit à bit
+      uint64_t fin_incubation = n;
+      if (n | infection) {
+        for (unsigned int b = 0; b < nb_bits; b++)
+          fin_incubation &= ~LIGNE(bitboard->compteurs, b, i)[w];
+        uint64_t retenue = n & ~fin_incubation;
+        for (unsigned int b = 0; b < nb_bits; b++) {
+          uint64_t *compteur = &LIGNE(bitboard->compteurs, b, i)[w];
+          const uint64_t ancien = *compteur;
+          *compteur = (ancien ^ retenue) & ~infection;
+          if (duree_incube >> b & 1) *compteur |= infection;
+          retenue &= ~ancien;
+        }
+      }
+
+      LIGNE(bitboard->tampon, SAIN, i)[w] = exposes & ~infection;
+      LIGNE(bitboard->tampon, MALADE, i)[w] =
+          (m & ~morts & ~gueris) | fin_incubation;
+      LIGNE(bitboard->tampon, MORT, i)[w] = mort[w] | morts;
+      LIGNE(bitboard->tampon, IMMUNISE, i)[w] =
+          (immunise[w] & ~vers_vaccin) | gueris;
+      LIGNE(bitboard->tampon, INCUBE, i)[w] = (n & ~fin_incubation) | infection;
+      LIGNE(bitboard->tampon, VACCINE, i)[w] = vaccine[w] | vers_vaccin;
+
+      // Rasters : une écriture par changement d'état
+      if (raster_infection)
+        for (uint64_t x = infection; x; x &= x - 1)
+          raster_infection[i * cote + w * CASES_PAR_MOT +
+                           __builtin_ctzll(x)] = tour;
+      if (raster_mort)
+        for (uint64_t x = morts; x; x &= x - 1)
+          raster_mort[i * cote + w * CASES_PAR_MOT + __builtin_ctzll(x)] =
+              tour;
+    }
+  }
+
+}
+
+/**
+ * @brief Applique le tour : le tampon devient les plans courants.
+ *
+ * @param bitboard Bitboard.
+ */
+void terminerTourBitboard(struct Bitboard *bitboard) {
+  uint64_t *plans = bitboard->plans;
+  bitboard->plans = bitboard->tampon;
+  bitboard->tampon = plans;
+}
+
+/**
+ * @brief Statistique du tour courant, par comptage de bits.
+ *
+ * @param bitboard Bitboard.
+ * @return struct Statistique Statistique.
+ */
+struct Statistique getStatistiqueBitboard(const struct Bitboard *bitboard) {
+  const unsigned long taille = bitboard->population->cote * bitboard->mots;
+  long effectifs[NB_PLANS] = {0};
+  for (int p = 0; p < NB_PLANS; p++)
+    for (unsigned long k = 0; k < taille; k++)
+      effectifs[p] += __builtin_popcountll(bitboard->plans[p * taille + k]);
+  struct Statistique statistique = {
+      effectifs[IMMUNISE], effectifs[SAIN],   effectifs[MORT],
+      effectifs[MALADE],   effectifs[INCUBE], effectifs[VACCINE]};
+  return statistique;
+}
+
+/**
+ * @brief Recopie les plans dans la grille de la population.
+ *
+ * @param bitboard Bitboard.
+ */
+void synchroniserBitboard(const struct Bitboard *bitboard) {
+  struct Population *population = bitboard->population;
+  const unsigned long cote = population->cote, mots = bitboard->mots;
+  for (unsigned long i = 0; i < cote; i++) {
+    for (unsigned long j = 0; j < cote; j++) {
+      struct Personne *personne = &population->grille_de_personnes[i][j];
+      const unsigned long w = j / CASES_PAR_MOT;
+      const unsigned int bit = j % CASES_PAR_MOT;
+      for (int p = 0; p < NB_PLANS; p++)
+        if (LIGNE(bitboard->plans, p, i)[w] >> bit & 1)
+          personne->state = (enum State)p;
+      unsigned int compteur = 0;
+      for (unsigned int b = 0; b < bitboard->nb_bits; b++)
+        compteur |= (unsigned int)(LIGNE(bitboard->compteurs, b, i)[w] >>
+                                   bit & 1) << b;
+      personne->duree_incube = (int)compteur;
+    }
+  }
+}
+
+/**
+ * @brief Libère le bitboard (pas la population).
+ *
+ * @param bitboard Bitboard.
+ */
+void detruireBitboard(struct Bitboard *bitboard) {
+  free(bitboard->plans);
+  free(bitboard->tampon);
+  free(bitboard->contagieux);
+  free(bitboard->compteurs);
+  free(bitboard);
+}
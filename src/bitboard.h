@@ -0,0 +1,83 @@
+#if !defined(BITBOARD_H)
+#define BITBOARD_H
+
+#include <stdint.h>
+
+#include "aleatoire.h"
+#include "jouer_un_tour.h"
+#include "population.h"
+#include "statistique.h"
+
+/**
+ * @brief Nombre de cases par mot d'un plan.
+ */
+#define CASES_PAR_MOT 64
+
+/**
+ * @brief Grille en plans de bits : un bit par case et par état.
+ *
+ * Chaque ligne de la grille tient en mots de 64 cases (les bits au-delà de
+ * cote sont nuls). La propagation entre voisins se fait par décalages et
+ * opérations logiques, 64 cases à la fois. Le compteur d'incubation est
+ * découpé en plans de bits (bit b de chaque compteur dans le plan b).
+ *
+ * Le bitboard est attaché à une Population qu'il ne possède pas : il en
+ * écrit les rasters et le tour, et synchroniserBitboard y recopie la grille.
+ */
+struct Bitboard {
+  /**
+   * @brief Population attachée (non possédée).
+   */
+  struct Population *population;
+  /**
+   * @brief Paramètres (copie).
+   */
+  struct Parametres parametres;
+  /**
+   * @brief Mots de 64 cases par ligne.
+   */
+  unsigned long mots;
+  /**
+   * @brief Nombre de plans du compteur d'incubation.
+   */
+  unsigned int nb_bits;
+  /**
+   * @brief Plans des états [enum State][ligne][mot] au temps t.
+   */
+  uint64_t *plans;
+  /**
+   * @brief Plans du temps t+1, échangés avec plans à chaque tour.
+   */
+  uint64_t *tampon;
+  /**
+   * @brief Plan des cases contagieuses (MALADE ou INCUBE) du tour en cours.
+   */
+  uint64_t *contagieux;
+  /**
+   * @brief Plans du compteur d'incubation [bit][ligne][mot].
+   */
+  uint64_t *compteurs;
+};
+
+char bitboardCompatible(const struct Parametres *parametres,
+                        const struct Population *population);
+struct Bitboard *allouerBitboard(struct Population *population,
+                                 const struct Parametres *parametres);
+struct Bitboard *creerBitboard(struct Population *population,
+                               const struct Parametres *parametres);
+void dimensionnerCompteursBitboard(struct Bitboard *bitboard);
+void chargerBitboard(struct Bitboard *bitboard);
+void chargerLignesBitboard(struct Bitboard *bitboard, unsigned long debut,
+                           unsigned long fin);
+void jouerTourBitboard(struct Bitboard *bitboard, struct Aleatoire *aleatoire);
+void preparerLignesBitboard(struct Bitboard *bitboard, unsigned long debut,
+                            unsigned long fin);
+void jouerLignesBitboard(struct Bitboard *bitboard, struct Aleatoire *aleatoire,
+                         uint16_t tour, unsigned long debut,
+                         unsigned long fin);
+void terminerTourBitboard(struct Bitboard *bitboard);
+struct Statistique getStatistiqueBitboard(const struct Bitboard *bitboard);
+void synchroniserBitboard(const struct Bitboard *bitboard);
+void detruireBitboard(struct Bitboard *bitboard);
+
+#endif  // BITBOARD_H
@@ -0,0 +1,157 @@
+/**
+ * @file branches.c
+ *
+ * @brief Variantes d'un préfixe commun, en processus parallèles.
+ *
+ * Le préfixe (par exemple 60 tours sans intervention) est simulé une seule
+ * fois. Chaque variante est un processus fils (fork) : la grille, les plans
+ * et la série du préfixe sont partagés en copie sur écriture, seules
+ * les pages modifiées par la variante sont copiées par le noyau Linux. Le
+ * fils bifurque (bifurquerSimulation), joue ses tours, écrit son résultat
+ * dans une zone partagée et son fichier de données.
+ *
+ * Toutes les variantes reçoivent la même graine (nombres aléatoires
+ * communs) : l'écart entre deux variantes vient de leurs paramètres.
+ *
+ * Usage:
+ * ```
+ * avancerSimulation(simulation, 60);  // Préfixe commun
+ * struct Variante variantes[3] = {{parametres_q0, "q0.txt"}, ...};
+ * struct ResultatVariante resultats[3];
+ * brancherSimulation(simulation, variantes, 3, 4, 200, 42, resultats);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "branches.h"
+
+/**
+ * @brief Joue une variante dans le processus fils, puis le termine.
+ *
+ * @param simulation Copie privée (copie sur écriture) du préfixe.
+ * @param variante Variante.
+ * @param n_tours Tours après le préfixe.
+ * @param graine Graine.
+ * @param resultat Résultat, en mémoire partagée avec le parent.
+ */
+static void jouerVariante(struct Simulation *simulation,
+                          const struct Variante *variante,
+                          unsigned long n_tours, unsigned long graine,
+                          struct ResultatVariante *resultat) {
+  // Le serveur de métriques n'existe que dans le parent
+  attacherMetriquesSimulation(simulation, NULL);
+  bifurquerSimulation(simulation, &variante->parametres, graine);
+  avancerSimulation(simulation, n_tours);
+  const struct Serie *serie = getSerieSimulation(simulation);
+  if (variante->fichier_data) exporterSerie(serie, variante->fichier_data);
+  resultat->tours = serie->tours - 1;
+  resultat->finale = serie->derniere;
+  resultat->indicateurs = serie->indicateurs;
+  resultat->taux_attaque = tauxAttaqueSerie(serie);
+  resultat->statut = 0;
+  fflush(NULL);
+  _exit(0);  // Sans atexit ni tampons hérités du parent
+}
+
+/**
+ * @brief Joue chaque variante à partir de l'état du préfixe.
+ *
+ * Le préfixe n'est pas modifié. Au plus nb_paralleles processus tournent en
+ * même temps. Les threads des bandes, des contacts sur plusieurs bandes et
+ * des agents sur plusieurs tâches ne survivent pas à fork : refusés.
+ *
+ * @param prefixe Simulation après le préfixe commun.
+ * @param variantes Variantes, nb_variantes éléments.
+ * @param nb_variantes Nombre de variantes.
+ * @param nb_paralleles Processus simultanés (au moins 1).
+ * @param n_tours Tours joués par chaque variante après le préfixe.
+ * @param graine Graine commune des variantes.
+ * @param resultats Résultats, nb_variantes éléments.
+ * @return int 0, ou -1 si des threads sont actifs, si un processus n'a pas
+ * pu être créé ou si une variante a échoué (statut -1).
+ */
+int brancherSimulation(const struct Simulation *prefixe,
+                       const struct Variante *variantes,
+                       unsigned int nb_variantes, unsigned int nb_paralleles,
+                       unsigned long n_tours, unsigned long graine,
+                       struct ResultatVariante *resultats) {
+  const struct Contacts *contacts = getContactsSimulation(prefixe);
+  const struct Agents *agents = getAgentsSimulation(prefixe);
+  if (getBandesSimulation(prefixe) ||
+      (contacts && contacts->nb_tampons > 1) ||
+      (agents && agents->nb_taches > 1))
+    return -1;
+  if (!nb_variantes) return 0;
+  if (nb_paralleles < 1) nb_paralleles = 1;
+  const size_t taille = nb_variantes * sizeof(struct ResultatVariante);
+  struct ResultatVariante *partages =
+      (struct ResultatVariante *)mmap(NULL, taille, PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (partages == MAP_FAILED) return -1;
+  for (unsigned int k = 0; k < nb_variantes; k++) partages[k].statut = -1;
+
+  if (nb_paralleles > nb_variantes) nb_paralleles = nb_variantes;
+  // Fils en cours, dans l'ordre de lancement : seuls ceux-ci sont attendus,
+  // pas les autres fils de l'appelant
+  pid_t *fils_en_cours = (pid_t *)malloc(nb_paralleles * sizeof(pid_t));
+  if (!fils_en_cours) {
+    munmap(partages, taille);
+    return -1;
+  }
+
+  fflush(NULL);  // Rien d'hérité à réécrire par les fils
+  int erreur = 0;
+  unsigned int lances = 0, en_cours = 0;
+  while (lances < nb_variantes || en_cours) {
+    if (lances < nb_variantes && en_cours < nb_paralleles && !erreur) {
+      const pid_t fils = fork();
+      if (!fils)
+        // Le fils modifie sa propre copie : le préfixe du parent ne change pas
+        jouerVariante((struct Simulation *)prefixe, &variantes[lances],
+                      n_tours, graine, &partages[lances]);
+      if (fils < 0) {
+        erreur = 1;
+      } else {
+        fils_en_cours[en_cours++] = fils;
+        lances++;
+      }
+      continue;
+    }
+    if (!en_cours) break;
+    // Un fils déjà terminé, sinon le plus ancien
+    unsigned int k = 0;
+    int statut;
+    pid_t termine = 0;
+    for (; k < en_cours && termine <= 0; k++)
+      termine = waitpid(fils_en_cours[k], &statut, WNOHANG);
+    if (termine <= 0) {
+      k = 1;
+      termine = waitpid(fils_en_cours[0], &statut, 0);
+    }
+    if (termine > 0 || errno != EINTR) {
+      // Terminé, ou perdu (ECHILD) : ne plus l'attendre
+      memmove(&fils_en_cours[k - 1], &fils_en_cours[k],
+              (en_cours - k) * sizeof(pid_t));
+      en_cours--;
+    }
+  }
+  free(fils_en_cours);
+
+  for (unsigned int k = 0; k < nb_variantes; k++) {
+    resultats[k] = partages[k];
+    if (resultats[k].statut) erreur = 1;
+  }
+  munmap(partages, taille);
+  return erreur ? -1 : 0;
+}
@@ -0,0 +1,53 @@
+#if !defined(BRANCHES_H)
+#define BRANCHES_H
+
+#include "simulation.h"
+
+/**
+ * @brief Variante jouée à partir du préfixe commun.
+ */
+struct Variante {
+  /**
+   * @brief Paramètres de la variante (quarantaine, cordon, vaccin...).
+   */
+  struct Parametres parametres;
+  /**
+   * @brief Fichier de données de la variante (préfixe compris), NULL pour
+   * aucun.
+   */
+  const char *fichier_data;
+};
+
+/**
+ * @brief Résultat d'une variante, écrit par son processus.
+ */
+struct ResultatVariante {
+  /**
+   * @brief 0 si la variante s'est terminée normalement, -1 sinon.
+   */
+  int statut;
+  /**
+   * @brief Nombre total de tours (préfixe compris, tour 0 exclu).
+   */
+  unsigned long tours;
+  /**
+   * @brief Statistique du dernier tour.
+   */
+  struct Statistique finale;
+  /**
+   * @brief Indicateurs du tableau de bord (préfixe compris).
+   */
+  struct Indicateurs indicateurs;
+  /**
+   * @brief Taux d'attaque final.
+   */
+  double taux_attaque;
+};
+
+int brancherSimulation(const struct Simulation *prefixe,
+                       const struct Variante *variantes,
+                       unsigned int nb_variantes, unsigned int nb_paralleles,
+                       unsigned long n_tours, unsigned long graine,
+                       struct ResultatVariante *resultats);
+
+#endif  // BRANCHES_H
@@ -0,0 +1,487 @@
+/**
+ * @file calibration.c
+ *
+ * @brief Calibration bayésienne approchée (ABC-SMC) de beta, gamma et lambda.
+ *
+ * Fonctionnalités :
+ * - Loi a priori uniforme sur chaque inconnue
+ * - Génération 0 : candidats tirés de la loi a priori ; générations
+ *   suivantes : particule de la génération précédente (selon son poids)
+ *   perturbée par un noyau gaussien, poids d'importance de Toni et al.
+ * - Seuil de chaque génération : quantile des distances de la précédente
+ * - Abandon précoce : la distance partielle ne fait que croître, un candidat
+ *   est abandonné dès qu'elle dépasse le seuil, sans jouer la fin
+ * - Candidats simulés en parallèle, une Simulation réutilisée par thread
+ *   (reinitialiserSimulation puis bifurquerSimulation)
+ *
+ * La distance compare, à chaque tour observé, les parts de la population
+ * MALADE + INCUBE, MORT et IMMUNISE : racine de la moyenne par tour de la
+ * somme des carrés des écarts. Une simulation éteinte garde son dernier
+ * tour jusqu'à la fin des observations.
+ *
+ * La particule k de chaque génération a son propre générateur : le
+ * résultat ne dépend pas du nombre de threads.
+ *
+ * Usage:
+ * ```
+ * struct Calibration calibration = {.observations = importer("data.txt"),
+ *                                   .initiale = population, ...};
+ * struct Posterieure *posterieure = calibrer(&calibration);
+ * exporterPosterieure(posterieure, "posterieure.txt");
+ * detruirePosterieure(posterieure);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "calibration.h"
+
+/**
+ * @brief Génération en cours, partagée par les threads.
+ */
+struct Generation {
+  /**
+   * @brief Problème.
+   */
+  const struct Calibration *calibration;
+  /**
+   * @brief Numéro de la génération.
+   */
+  unsigned int numero;
+  /**
+   * @brief Seuil d'acceptation (INFINITY : tout est accepté).
+   */
+  double seuil;
+  /**
+   * @brief Génération précédente, NULL pour la génération 0.
+   */
+  const struct Particule *precedentes;
+  /**
+   * @brief Poids cumulés des précédentes (tirage d'un parent).
+   */
+  const double *cumul;
+  /**
+   * @brief Ecart-type du noyau de perturbation, par enum Inconnue.
+   */
+  double noyau[NB_INCONNUES];
+  /**
+   * @brief Particules acceptées, remplies par les threads.
+   */
+  struct Particule *particules;
+  /**
+   * @brief Prochaine particule à remplir.
+   */
+  atomic_uint prochaine;
+  /**
+   * @brief Candidats tirés, comptés contre simulations_max.
+   */
+  atomic_ulong essais;
+  /**
+   * @brief Candidats simulés.
+   */
+  atomic_ulong simulations;
+  /**
+   * @brief Candidats abandonnés.
+   */
+  atomic_ulong abandons;
+  /**
+   * @brief Tours joués.
+   */
+  atomic_ulong tours_joues;
+  /**
+   * @brief Tours de l'horizon observé, sommés sur les candidats.
+   */
+  atomic_ulong tours_sans_abandon;
+  /**
+   * @brief Vrai si simulations_max est atteint : génération incomplète.
+   */
+  atomic_int epuisee;
+};
+
+/**
+ * @brief Carré de l'écart entre un tour simulé et un tour observé.
+ *
+ * @param observe Statistique observée.
+ * @param simule Statistique simulée.
+ * @param population_totale Population des observations.
+ * @return double Somme des carrés des écarts des parts.
+ */
+static double ecart(const struct Statistique *observe,
+                    const struct Statistique *simule,
+                    double population_totale) {
+  const double cas = (double)(simule->nb_MALADE + simule->nb_INCUBE -
+                              observe->nb_MALADE - observe->nb_INCUBE);
+  const double morts = (double)(simule->nb_MORT - observe->nb_MORT);
+  const double immunises =
+      (double)(simule->nb_IMMUNISE - observe->nb_IMMUNISE);
+  return (cas * cas + morts * morts + immunises * immunises) /
+         (population_totale * population_totale);
+}
+
+/**
+ * @brief Distance entre une série simulée et les observations.
+ *
+ * @param observations Série observée.
+ * @param simulee Série simulée ; si elle est plus courte, son dernier tour
+ * est répété.
+ * @return double Distance (racine de l'écart moyen par tour).
+ */
+double distanceCalibration(const struct Data *observations,
+                           const struct Data *simulee) {
+  double somme = 0;
+  for (unsigned long t = 0; t < observations->tours; t++) {
+    const unsigned long s = t < simulee->tours ? t : simulee->tours - 1;
+    somme += ecart(observations->liste_statistiques[t],
+                   simulee->liste_statistiques[s],
+                   (double)observations->population_totale);
+  }
+  return sqrt(somme / observations->tours);
+}
+
+/**
+ * @brief Vrai si theta est dans le support de la loi a priori.
+ */
+static int dansBornes(const struct Calibration *calibration,
+                      const double theta[NB_INCONNUES]) {
+  for (int d = 0; d < NB_INCONNUES; d++)
+    if (theta[d] < calibration->minimum[d] ||
+        theta[d] > calibration->maximum[d])
+      return 0;
+  return 1;
+}
+
+/**
+ * @brief Propose un candidat : loi a priori en génération 0, parent
+ * perturbé ensuite (redessiné tant qu'il sort des bornes).
+ *
+ * @param generation Génération.
+ * @param aleatoire Générateur de la particule.
+ * @param theta Candidat.
+ */
+static void proposer(const struct Generation *generation,
+                     struct Aleatoire *aleatoire, double theta[NB_INCONNUES]) {
+  const struct Calibration *calibration = generation->calibration;
+  if (!generation->precedentes) {
+    for (int d = 0; d < NB_INCONNUES; d++)
+      theta[d] = calibration->minimum[d] +
+                 (calibration->maximum[d] - calibration->minimum[d]) *
+                     aleatoireUniforme(aleatoire);
+    return;
+  }
+  do {
+    // Parent tiré selon les poids (recherche dichotomique sur le cumul)
+    const unsigned int n = calibration->nb_particules;
+    const double u = aleatoireUniforme(aleatoire) * generation->cumul[n - 1];
+    unsigned int bas = 0, haut = n - 1;
+    while (bas < haut) {
+      const unsigned int milieu = (bas + haut) / 2;
+      if (generation->cumul[milieu] > u)
+        haut = milieu;
+      else
+        bas = milieu + 1;
+    }
+    for (int d = 0; d < NB_INCONNUES; d++)
+      theta[d] = generation->precedentes[bas].theta[d] +
+                 generation->noyau[d] * aleatoireNormale(aleatoire);
+  } while (!dansBornes(calibration, theta));
+}
+
+/**
+ * @brief Simule un candidat, abandonné dès que la distance partielle dépasse
+ * le seuil.
+ *
+ * @param generation Génération.
+ * @param simulation Simulation du thread.
+ * @param theta Candidat.
+ * @param graine Graine de la simulation.
+ * @param distance Distance, si le candidat est accepté.
+ * @param tours_joues Tours joués (incrémentés).
+ * @return int 1 si accepté, 0 si abandonné.
+ */
+static int simulerCandidat(const struct Generation *generation,
+                           struct Simulation *simulation,
+                           const double theta[NB_INCONNUES],
+                           unsigned long graine, double *distance,
+                           unsigned long *tours_joues) {
+  const struct Calibration *calibration = generation->calibration;
+  const struct Data *observations = calibration->observations;
+  struct Parametres parametres = calibration->parametres;
+  parametres.beta = theta[INCONNUE_BETA];
+  parametres.gamma = theta[INCONNUE_GAMMA];
+  parametres.lambda = theta[INCONNUE_LAMBDA];
+  reinitialiserSimulation(simulation, calibration->initiale, graine);
+  bifurquerSimulation(simulation, &parametres, graine);
+  const struct Serie *serie = getSerieSimulation(simulation);
+
+  const double population_totale = (double)observations->population_totale;
+  const double limite =
+      generation->seuil * generation->seuil * observations->tours;
+  double somme = 0;
+  for (unsigned long t = 0; t < observations->tours; t++) {
+    if (t) *tours_joues += avancerSimulation(simulation, 1);
+    somme += ecart(observations->liste_statistiques[t],
+                   &serie->derniere,
+                   population_totale);
+    if (somme > limite) return 0;
+  }
+  *distance = sqrt(somme / observations->tours);
+  return 1;
+}
+
+/**
+ * @brief Thread : remplit des particules jusqu'à la fin de la génération.
+ *
+ * @param argument struct Generation*.
+ * @return void* NULL.
+ */
+static void *executerGeneration(void *argument) {
+  struct Generation *generation = (struct Generation *)argument;
+  const struct Calibration *calibration = generation->calibration;
+  struct Population *population = creerPopulation(calibration->initiale->cote);
+  copierPopulation(population, calibration->initiale);
+  struct Simulation *simulation =
+      creerSimulation(&calibration->parametres, population, 0);
+  unsigned long simulations = 0, abandons = 0, tours_joues = 0;
+  const unsigned long horizon = calibration->observations->tours - 1;
+
+  int epuisee = 0;
+  while (!epuisee) {
+    const unsigned int k = atomic_fetch_add(&generation->prochaine, 1);
+    if (k >= calibration->nb_particules) break;
+    struct Aleatoire aleatoire;
+    initAleatoire(&aleatoire, calibration->graine +
+                                  ((uint64_t)generation->numero << 32) + k);
+    for (;;) {
+      epuisee = atomic_load(&generation->epuisee) ||
+                (calibration->simulations_max &&
+                 atomic_fetch_add(&generation->essais, 1) >=
+                     calibration->simulations_max);
+      if (epuisee) {
+        atomic_store(&generation->epuisee, 1);
+        break;
+      }
+      double theta[NB_INCONNUES], distance;
+      proposer(generation, &aleatoire, theta);
+      simulations++;
+      if (simulerCandidat(generation, simulation, theta,
+                          aleatoireEntier(&aleatoire), &distance,
+                          &tours_joues)) {
+        struct Particule *particule = &generation->particules[k];
+        memcpy(particule->theta, theta, sizeof(theta));
+        particule->distance = distance;
+        break;
+      }
+      abandons++;
+    }
+  }
+  atomic_fetch_add(&generation->simulations, simulations);
+  atomic_fetch_add(&generation->abandons, abandons);
+  atomic_fetch_add(&generation->tours_joues, tours_joues);
+  atomic_fetch_add(&generation->tours_sans_abandon, simulations * horizon);
+  detruireSimulation(simulation);
+  return NULL;
+}
+
+/**
+ * @brief Compare deux distances (qsort).
+ */
+static int comparerDistances(const void *a, const void *b) {
+  const double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Poids d'importance des particules d'une génération t > 0.
+ *
+ * w_i = 1 / somme_j w_j K(theta_i - theta_j), la loi a priori étant
+ * uniforme ; poids normalisés.
+ *
+ * @param generation Génération complète.
+ */
+static void ponderer(struct Generation *generation) {
+  const unsigned int n = generation->calibration->nb_particules;
+  double total = 0;
+  for (unsigned int i = 0; i < n; i++) {
+    struct Particule *particule = &generation->particules[i];
+    if (!generation->precedentes) {
+      particule->poids = 1;
+    } else {
+      double densite = 0;
+      for (unsigned int j = 0; j < n; j++) {
+        const struct Particule *parent = &generation->precedentes[j];
+        double noyau = parent->poids;
+        for (int d = 0; d < NB_INCONNUES; d++) {
+          if (generation->noyau[d] <= 0) continue;
+          const double z =
+              (particule->theta[d] - parent->theta[d]) / generation->noyau[d];
+          noyau *= exp(-z * z / 2) / generation->noyau[d];
+        }
+        densite += noyau;
+      }
+      particule->poids = densite > 0 ? 1 / densite : 0;
+    }
+    total += particule->poids;
+  }
+  for (unsigned int i = 0; i < n; i++)
+    generation->particules[i].poids =
+        total > 0 ? generation->particules[i].poids / total : 1.0 / n;
+}
+
+/**
+ * @brief Moyenne et écart-type pondérés de chaque inconnue.
+ *
+ * @param posterieure Loi a posteriori.
+ * @param moyenne Moyennes.
+ * @param ecart_type Ecarts-types.
+ */
+void moyennePosterieure(const struct Posterieure *posterieure,
+                        double moyenne[NB_INCONNUES],
+                        double ecart_type[NB_INCONNUES]) {
+  for (int d = 0; d < NB_INCONNUES; d++) {
+    double somme = 0, carres = 0;
+    for (unsigned int i = 0; i < posterieure->nb_particules; i++) {
+      const struct Particule *particule = &posterieure->particules[i];
+      somme += particule->poids * particule->theta[d];
+      carres += particule->poids * particule->theta[d] * particule->theta[d];
+    }
+    moyenne[d] = somme;
+    ecart_type[d] = sqrt(fmax(carres - somme * somme, 0));
+  }
+}
+
+/**
+ * @brief Calibre beta, gamma et lambda par ABC-SMC avec abandon précoce.
+ *
+ * S'arrête après nb_generations, ou dès qu'une génération dépasse
+ * simulations_max : la loi a posteriori est alors celle de la dernière
+ * génération complète.
+ *
+ * @param calibration Problème.
+ * @return struct Posterieure* Loi a posteriori, NULL si aucune génération
+ * n'est complète ou si les observations sont vides.
+ */
+struct Posterieure *calibrer(const struct Calibration *calibration) {
+  const unsigned int n = calibration->nb_particules;
+  if (!n || !calibration->observations->tours) return NULL;
+  const unsigned int nb_threads =
+      calibration->nb_threads ? calibration->nb_threads : 1;
+  struct Particule *precedentes = NULL;
+  struct Particule *particules =
+      (struct Particule *)malloc(n * sizeof(struct Particule));
+  double *cumul = (double *)malloc(n * sizeof(double));
+  double *distances = (double *)malloc(n * sizeof(double));
+  pthread_t *threads = (pthread_t *)malloc(nb_threads * sizeof(pthread_t));
+  struct Posterieure *posterieure =
+      (struct Posterieure *)calloc(1, sizeof(struct Posterieure));
+  posterieure->nb_particules = n;
+
+  double seuil = calibration->seuil_initial > 0 ? calibration->seuil_initial
+                                                : INFINITY;
+  double noyau[NB_INCONNUES] = {0};
+  for (unsigned int g = 0; g < calibration->nb_generations; g++) {
+    struct Generation generation = {.calibration = calibration,
+                                    .numero = g,
+                                    .seuil = seuil,
+                                    .precedentes = precedentes,
+                                    .cumul = cumul,
+                                    .particules = particules};
+    memcpy(generation.noyau, noyau, sizeof(noyau));
+    atomic_init(&generation.prochaine, 0);
+    atomic_init(&generation.essais, 0);
+    atomic_init(&generation.simulations, 0);
+    atomic_init(&generation.abandons, 0);
+    atomic_init(&generation.tours_joues, 0);
+    atomic_init(&generation.tours_sans_abandon, 0);
+    atomic_init(&generation.epuisee, 0);
+    for (unsigned int t = 0; t < nb_threads; t++)
+      pthread_create(&threads[t], NULL, executerGeneration, &generation);
+    for (unsigned int t = 0; t < nb_threads; t++)
+      pthread_join(threads[t], NULL);
+    posterieure->simulations += atomic_load(&generation.simulations);
+    posterieure->abandons += atomic_load(&generation.abandons);
+    posterieure->tours_joues += atomic_load(&generation.tours_joues);
+    posterieure->tours_sans_abandon +=
+        atomic_load(&generation.tours_sans_abandon);
+    if (atomic_load(&generation.epuisee)) break;
+
+    ponderer(&generation);
+    posterieure->generations = g + 1;
+    posterieure->seuil = seuil;
+    if (isinf(seuil)) {
+      posterieure->seuil = 0;
+      for (unsigned int i = 0; i < n; i++)
+        posterieure->seuil = fmax(posterieure->seuil, particules[i].distance);
+    }
+
+    // Génération suivante : seuil au quantile, noyau de variance 2 Var(theta)
+    for (unsigned int i = 0; i < n; i++) distances[i] = particules[i].distance;
+    qsort(distances, n, sizeof(double), comparerDistances);
+    seuil = distances[(unsigned int)(calibration->quantile * (n - 1))];
+    struct Posterieure courante = {.particules = particules,
+                                   .nb_particules = n};
+    double moyenne[NB_INCONNUES];
+    moyennePosterieure(&courante, moyenne, noyau);
+    for (int d = 0; d < NB_INCONNUES; d++) noyau[d] *= sqrt(2);
+    double total = 0;
+    for (unsigned int i = 0; i < n; i++)
+      cumul[i] = total += particules[i].poids;
+    struct Particule *echange = precedentes;
+    precedentes = particules;
+    particules = echange ? echange
+                         : (struct Particule *)malloc(
+                               n * sizeof(struct Particule));
+  }
+
+  free(particules);
+  free(cumul);
+  free(distances);
+  free(threads);
+  if (!posterieure->generations) {
+    free(precedentes);
+    free(posterieure);
+    return NULL;
+  }
+  posterieure->particules = precedentes;
+  return posterieure;
+}
+
+/**
+ * @brief Ecrit les particules : beta gamma lambda poids distance.
+ *
+ * @param posterieure Loi a posteriori.
+ * @param fichier Nom du fichier.
+ * @return int 0, ou -1 si le fichier n'a pas pu être écrit.
+ */
+int exporterPosterieure(const struct Posterieure *posterieure,
+                        const char *fichier) {
+  FILE *file = fopen(fichier, "w");
+  if (!file) return -1;
+  fprintf(file, "# beta gamma lambda poids distance\n");
+  for (unsigned int i = 0; i < posterieure->nb_particules; i++) {
+    const struct Particule *particule = &posterieure->particules[i];
+    fprintf(file, "%.6f %.6f %.6f %.6e %.6e\n",
+            particule->theta[INCONNUE_BETA], particule->theta[INCONNUE_GAMMA],
+            particule->theta[INCONNUE_LAMBDA], particule->poids,
+            particule->distance);
+  }
+  return fclose(file) ? -1 : 0;
+}
+
+/**
+ * @brief Libère une loi a posteriori.
+ *
+ * @param posterieure Loi a posteriori.
+ */
+void detruirePosterieure(struct Posterieure *posterieure) {
+  free(posterieure->particules);
+  free(posterieure);
+}
@@ -0,0 +1,135 @@
+#if !defined(CALIBRATION_H)
+#define CALIBRATION_H
+
+#include "simulation.h"
+
+/**
+ * @brief Paramètres calibrés.
+ */
+enum Inconnue { INCONNUE_BETA, INCONNUE_GAMMA, INCONNUE_LAMBDA, NB_INCONNUES };
+
+/**
+ * @brief Problème de calibration ABC-SMC.
+ */
+struct Calibration {
+  /**
+   * @brief Série observée (format de exporter), tour 0 compris.
+   */
+  const struct Data *observations;
+  /**
+   * @brief Condition initiale des simulations candidates (non modifiée).
+   */
+  const struct Population *initiale;
+  /**
+   * @brief Paramètres fixes ; beta, gamma et lambda sont remplacés par
+   * chaque candidat.
+   */
+  struct Parametres parametres;
+  /**
+   * @brief Borne basse de la loi a priori uniforme, par enum Inconnue.
+   */
+  double minimum[NB_INCONNUES];
+  /**
+   * @brief Borne haute de la loi a priori uniforme, par enum Inconnue.
+   */
+  double maximum[NB_INCONNUES];
+  /**
+   * @brief Nombre de particules acceptées par génération.
+   */
+  unsigned int nb_particules;
+  /**
+   * @brief Nombre de générations (1 : rejet simple au seuil_initial).
+   */
+  unsigned int nb_generations;
+  /**
+   * @brief Seuil de la génération 0, 0 pour accepter tous ses candidats.
+   *
+   * Avec nb_generations = 1 : rejet ABC simple, avec abandon précoce.
+   */
+  double seuil_initial;
+  /**
+   * @brief Quantile des distances acceptées donnant le seuil suivant.
+   */
+  double quantile;
+  /**
+   * @brief Simulations au plus par génération (0 : pas de limite).
+   */
+  unsigned long simulations_max;
+  /**
+   * @brief Threads simulant les candidats.
+   */
+  unsigned int nb_threads;
+  /**
+   * @brief Graine : même résultat quel que soit nb_threads.
+   */
+  unsigned long graine;
+};
+
+/**
+ * @brief Particule de la loi a posteriori.
+ */
+struct Particule {
+  /**
+   * @brief Valeurs, par enum Inconnue.
+   */
+  double theta[NB_INCONNUES];
+  /**
+   * @brief Poids d'importance, normalisé sur la génération.
+   */
+  double poids;
+  /**
+   * @brief Distance aux observations.
+   */
+  double distance;
+};
+
+/**
+ * @brief Résultat d'une calibration : dernière génération complète.
+ */
+struct Posterieure {
+  /**
+   * @brief Particules acceptées, nb_particules éléments.
+   */
+  struct Particule *particules;
+  /**
+   * @brief Nombre de particules.
+   */
+  unsigned int nb_particules;
+  /**
+   * @brief Nombre de générations complètes.
+   */
+  unsigned int generations;
+  /**
+   * @brief Seuil d'acceptation de la dernière génération.
+   */
+  double seuil;
+  /**
+   * @brief Candidats simulés, toutes générations.
+   */
+  unsigned long simulations;
+  /**
+   * @brief Candidats abandonnés en cours de route.
+   */
+  unsigned long abandons;
+  /**
+   * @brief Tours réellement joués.
+   */
+  unsigned long tours_joues;
+  /**
+   * @brief Tours de l'horizon observé sommés sur les candidats : ce qu'ils
+   * auraient joué au plus sans abandon.
+   */
+  unsigned long tours_sans_abandon;
+};
+
+double distanceCalibration(const struct Data *observations,
+                           const struct Data *simulee);
+struct Posterieure *calibrer(const struct Calibration *calibration);
+void moyennePosterieure(const struct Posterieure *posterieure,
+                        double moyenne[NB_INCONNUES],
+                        double ecart_type[NB_INCONNUES]);
+int exporterPosterieure(const struct Posterieure *posterieure,
+                        const char *fichier);
+void detruirePosterieure(struct Posterieure *posterieure);
+
+#endif  // CALIBRATION_H
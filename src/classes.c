@@ -0,0 +1,263 @@
+/**
+ * @file classes.c
+ *
+ * @brief Moteur à classes de risque : paramètres hétérogènes par case.
+ *
+ * Chaque case porte un octet, l'indice de sa classe (âge, comorbidité...)
+ * dans une petite table : beta, gamma et lambda par classe, les autres
+ * paramètres communs. Les transitions de chaque classe sont précalculées
+ * comme dans transition.c, mais seules celles qui dépendent de la classe
+ * (SAIN, MALADE, IMMUNISE) sont gardées : toutes les tables tiennent dans
+ * le cache L1, à côté de la carte des classes lue au fil de la grille.
+ *
+ * Lambda est la susceptibilité de la case SAIN : la probabilité d'infection
+ * ne dépend que de sa classe et de ses voisins contagieux. Beta et gamma
+ * sont ceux de la classe du MALADE.
+ *
+ * Les effectifs de chaque classe sont comptés pendant le tour, au moment où
+ * le nouvel état de la case est connu : aucun parcours de plus pour les
+ * Statistique.
+ *
+ * Usage:
+ * ```
+ * struct ParametresClasse valeurs[NB_CLASSES_MAX];
+ * int nb_classes = lireTableClasses("classes.txt", valeurs);
+ * uint8_t *carte = lireCarteClasses("classes.pgm", population->cote);
+ * struct Classes *classes =
+ *     creerClasses(population, &parametres, valeurs, nb_classes, carte);
+ * for (...) jouerTourClasses(classes, &aleatoire);
+ * struct Statistique ages = getStatistiqueClasse(classes, 2);
+ * detruireClasses(classes);  // libère la carte
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "classes.h"
+#include "condition_initiale.h"
+
+/**
+ * @brief Lit la table des classes : une ligne "beta gamma lambda" par
+ * classe, dans l'ordre des indices.
+ *
+ * Les lignes vides et les commentaires (#) sont ignorés.
+ *
+ * Usage:
+ * ```
+ * # beta  gamma  lambda
+ * 0.01    0.2    0.5     # 0 : moins de 20 ans
+ * 0.05    0.1    0.8     # 1 : plus de 65 ans
+ * ```
+ *
+ * @param fichier Nom du fichier.
+ * @param valeurs Paramètres de chaque classe.
+ * @return int Nombre de classes, -1 si le fichier est invalide.
+ */
+int lireTableClasses(const char *fichier,
+                     struct ParametresClasse valeurs[NB_CLASSES_MAX]) {
+  FILE *file = fopen(fichier, "r");
+  if (!file) return -1;
+  char ligne[256];
+  int nb_classes = 0;
+  while (fgets(ligne, sizeof(ligne), file)) {
+    char *commentaire = strchr(ligne, '#');
+    if (commentaire) *commentaire = '\0';
+    char reste;
+    if (sscanf(ligne, " %c", &reste) != 1) continue;  // Ligne vide
+    struct ParametresClasse lus;
+    if (nb_classes == NB_CLASSES_MAX ||
+        sscanf(ligne, "%lf %lf %lf %c", &lus.beta, &lus.gamma, &lus.lambda,
+               &reste) != 3 ||
+        lus.beta < 0 || lus.beta > 1 || lus.gamma < 0 || lus.gamma > 1 ||
+        lus.lambda < 0 || lus.lambda > 1) {
+      fclose(file);
+      return -1;
+    }
+    valeurs[nb_classes++] = lus;
+  }
+  fclose(file);
+  return nb_classes ? nb_classes : -1;
+}
+
+/**
+ * @brief Lit la carte des classes : un octet par case, même format que la
+ * condition initiale (PGM P5 ou octets bruts).
+ *
+ * @param fichier Nom du fichier.
+ * @param cote Côté attendu de la grille.
+ * @return uint8_t* Carte cote*cote (malloc), NULL si invalide.
+ */
+uint8_t *lireCarteClasses(const char *fichier, unsigned long cote) {
+  return chargerCarteOctets(fichier, cote);
+}
+
+/**
+ * @brief Créer le moteur à classes de risque.
+ *
+ * Usage:
+ * ```
+ * struct ParametresClasse valeurs[2] = {{0.01, 0.2, 0.5}, {0.05, 0.1, 0.8}};
+ * uint8_t *carte = (uint8_t *)calloc(cote * cote, 1);  // Tout en classe 0
+ * struct Classes *classes =
+ *     creerClasses(population, &parametres, valeurs, 2, carte);
+ * ```
+ *
+ * @param population Population (non possédée, doit survivre au moteur).
+ * @param parametres Paramètres communs.
+ * @param valeurs Paramètres de chaque classe (copiés).
+ * @param nb_classes Nombre de classes (1 à NB_CLASSES_MAX).
+ * @param carte Classe de chaque case, cote*cote octets (malloc), possédée
+ * par le moteur en cas de succès.
+ * @return struct Classes* Moteur, NULL si une case porte une classe
+ * inconnue.
+ */
+struct Classes *creerClasses(struct Population *population,
+                             const struct Parametres *parametres,
+                             const struct ParametresClasse *valeurs,
+                             unsigned int nb_classes, uint8_t *carte) {
+  if (!nb_classes || nb_classes > NB_CLASSES_MAX) return NULL;
+  const unsigned long taille = population->cote * population->cote;
+  for (unsigned long k = 0; k < taille; k++)
+    if (carte[k] >= nb_classes) return NULL;
+
+  struct Classes *classes = (struct Classes *)malloc(sizeof(struct Classes));
+  classes->population = population;
+  classes->nb_classes = nb_classes;
+  memcpy(classes->valeurs, valeurs,
+         nb_classes * sizeof(struct ParametresClasse));
+  classes->carte = carte;
+  parametrerClasses(classes, parametres);
+  chargerClasses(classes);
+  return classes;
+}
+
+/**
+ * @brief Recalcule les transitions de chaque classe pour d'autres
+ * paramètres communs (bifurcation).
+ *
+ * @param classes Moteur.
+ * @param parametres Paramètres communs (copiés).
+ */
+void parametrerClasses(struct Classes *classes,
+                       const struct Parametres *parametres) {
+  classes->parametres = *parametres;
+  struct TableTransition table;
+  for (unsigned int c = 0; c < classes->nb_classes; c++) {
+    struct Parametres parametres_classe = *parametres;
+    parametres_classe.beta = classes->valeurs[c].beta;
+    parametres_classe.gamma = classes->valeurs[c].gamma;
+    parametres_classe.lambda = classes->valeurs[c].lambda;
+    initTableTransition(&table, &parametres_classe);
+    classes->tables[c] = table.compacte;
+  }
+}
+
+/**
+ * @brief Recompte les effectifs de chaque classe (condition initiale
+ * rechargée dans la population).
+ *
+ * @param classes Moteur.
+ */
+void chargerClasses(struct Classes *classes) {
+  const struct Population *population = classes->population;
+  const unsigned long taille = population->cote * population->cote;
+  memset(classes->effectifs, 0, sizeof(classes->effectifs));
+  for (unsigned long k = 0; k < taille; k++)
+    classes->effectifs[classes->carte[k]][population->personnes[k].state]++;
+}
+
+/**
+ * @brief Joue un tour (même loi que jouerTourTransition, transitions de la
+ * classe de chaque case).
+ *
+ * Avec une seule classe de mêmes beta, gamma et lambda, mêmes tirages que
+ * jouerTourTransition : même trajectoire pour une même graine.
+ *
+ * @param classes Moteur.
+ * @param aleatoire Générateur aléatoire propre à la simulation.
+ */
+void jouerTourClasses(struct Classes *classes, struct Aleatoire *aleatoire) {
+  memset(classes->effectifs, 0, sizeof(classes->effectifs));
+  balayerTables(classes->population, &classes->parametres, classes->tables,
+                classes->carte, classes->effectifs, aleatoire);
+}
+
+/**
+ * @brief Statistique d'une classe au tour courant, sans parcours.
+ *
+ * @param classes Moteur.
+ * @param classe Indice de la classe.
+ * @return struct Statistique Statistique de la classe.
+ */
+struct Statistique getStatistiqueClasse(const struct Classes *classes,
+                                        unsigned int classe) {
+  const long *effectifs = classes->effectifs[classe];
+  const struct Statistique statistique = {
+      effectifs[IMMUNISE], effectifs[SAIN],   effectifs[MORT],
+      effectifs[MALADE],   effectifs[INCUBE], effectifs[VACCINE]};
+  return statistique;
+}
+
+/**
+ * @brief Statistique de toute la population au tour courant, sans parcours.
+ *
+ * @param classes Moteur.
+ * @return struct Statistique Somme des Statistique des classes.
+ */
+struct Statistique getStatistiqueClasses(const struct Classes *classes) {
+  struct Statistique statistique = {0, 0, 0, 0, 0, 0};
+  for (unsigned int c = 0; c < classes->nb_classes; c++) {
+    const struct Statistique classe = getStatistiqueClasse(classes, c);
+    statistique.nb_IMMUNISE += classe.nb_IMMUNISE;
+    statistique.nb_SAIN += classe.nb_SAIN;
+    statistique.nb_MORT += classe.nb_MORT;
+    statistique.nb_MALADE += classe.nb_MALADE;
+    statistique.nb_INCUBE += classe.nb_INCUBE;
+    statistique.nb_VACCINE += classe.nb_VACCINE;
+  }
+  return statistique;
+}
+
+/**
+ * @brief Ecrit le tableau des classes au tour courant : effectifs et
+ * mortalité (MORT parmi les infectés) de chaque classe.
+ *
+ * @param classes Moteur.
+ * @param file Fichier ouvert en écriture.
+ */
+void ecrireClasses(const struct Classes *classes, FILE *file) {
+  fprintf(file,
+          "-------------------------------------------------------------------"
+          "\n"
+          "| Cl. |  SAIN   | MALADE  |  MORT   |  IMMU   |"
+          "  VACC   | Mortalité |\n"
+          "| --- | ------- | ------- | ------- | ------- |"
+          " ------- | --------- |\n");
+  for (unsigned int c = 0; c < classes->nb_classes; c++) {
+    const struct Statistique stats = getStatistiqueClasse(classes, c);
+    const long infectes =
+        stats.nb_INCUBE + stats.nb_MALADE + stats.nb_MORT + stats.nb_IMMUNISE;
+    fprintf(file, "| %3u | %7li | %7li | %7li | %7li | %7li | %7.2lf %% |\n",
+            c, stats.nb_SAIN, stats.nb_MALADE, stats.nb_MORT,
+            stats.nb_IMMUNISE, stats.nb_VACCINE,
+            infectes ? (double)stats.nb_MORT * 100 / infectes : 0.);
+  }
+  fprintf(file,
+          "-------------------------------------------------------------------"
+          "\n");
+}
+
+/**
+ * @brief Libère le moteur et sa carte (pas la population).
+ *
+ * @param classes Moteur.
+ */
+void detruireClasses(struct Classes *classes) {
+  free(classes->carte);
+  free(classes);
+}
@@ -0,0 +1,95 @@
+#if !defined(CLASSES_H)
+#define CLASSES_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "aleatoire.h"
+#include "jouer_un_tour.h"
+#include "population.h"
+#include "statistique.h"
+#include "transition.h"
+
+/**
+ * @brief Nombre maximal de classes de risque : toutes les tables tiennent
+ * dans le cache L1 (NB_CLASSES_MAX x sizeof(struct TableCase) < 12 Kio).
+ */
+#define NB_CLASSES_MAX 16
+
+/**
+ * @brief Paramètres propres à une classe de risque (âge, comorbidité...).
+ *
+ * Les autres paramètres (quarantaine, vaccin, incubation) sont communs.
+ */
+struct ParametresClasse {
+  /**
+   * @brief Probabilité d'un MALADE de la classe de mourir.
+   */
+  double beta;
+  /**
+   * @brief Probabilité d'un MALADE de la classe de guérir.
+   */
+  double gamma;
+  /**
+   * @brief Probabilité d'un SAIN de la classe d'être contaminé par un voisin
+   * (susceptibilité).
+   */
+  double lambda;
+};
+
+/**
+ * @brief Moteur à classes de risque : un octet de classe par case.
+ *
+ * Même loi que jouerTourTransition, avec les transitions de la classe de
+ * chaque case. Les Statistique par classe sont comptées pendant le tour.
+ */
+struct Classes {
+  /**
+   * @brief Population jouée (non possédée).
+   */
+  struct Population *population;
+  /**
+   * @brief Paramètres communs (copie) ; beta, gamma et lambda sont ignorés.
+   */
+  struct Parametres parametres;
+  /**
+   * @brief Nombre de classes (1 à NB_CLASSES_MAX).
+   */
+  unsigned int nb_classes;
+  /**
+   * @brief Paramètres de chaque classe (copie).
+   */
+  struct ParametresClasse valeurs[NB_CLASSES_MAX];
+  /**
+   * @brief Transitions précalculées de chaque classe.
+   */
+  struct TableCase tables[NB_CLASSES_MAX];
+  /**
+   * @brief Classe de chaque case, cote*cote octets ligne par ligne
+   * (possédée).
+   */
+  uint8_t *carte;
+  /**
+   * @brief Effectifs [classe][enum State] du tour courant.
+   */
+  long effectifs[NB_CLASSES_MAX][VACCINE + 1];
+};
+
+int lireTableClasses(const char *fichier,
+                     struct ParametresClasse valeurs[NB_CLASSES_MAX]);
+uint8_t *lireCarteClasses(const char *fichier, unsigned long cote);
+struct Classes *creerClasses(struct Population *population,
+                             const struct Parametres *parametres,
+                             const struct ParametresClasse *valeurs,
+                             unsigned int nb_classes, uint8_t *carte);
+void parametrerClasses(struct Classes *classes,
+                       const struct Parametres *parametres);
+void chargerClasses(struct Classes *classes);
+void jouerTourClasses(struct Classes *classes, struct Aleatoire *aleatoire);
+struct Statistique getStatistiqueClasse(const struct Classes *classes,
+                                        unsigned int classe);
+struct Statistique getStatistiqueClasses(const struct Classes *classes);
+void ecrireClasses(const struct Classes *classes, FILE *file);
+void detruireClasses(struct Classes *classes);
+
+#endif  // CLASSES_H
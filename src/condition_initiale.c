@@ -0,0 +1,243 @@
+/**
+ * @file condition_initiale.c
+ *
+ * @brief Charger une population initiale depuis un raster.
+ *
+ * Une cellule = un octet : l'enum State dans les bits de poids faible, et
+ * OCTET_QUARANTAINE si la personne est en quarantaine. Les zones inhabitées
+ * sont codées MORT (inertes, affichées vides).
+ *
+ * Formats acceptés :
+ * - PGM binaire (P5, maxval <= 255), carré.
+ * - Carte d'octets brute, dont la taille est un carré parfait.
+ *
+ * Le fichier est projeté en mémoire (mmap) et parcouru une seule fois. Les
+ * cellules SAIN hors quarantaine (octet nul) ne sont pas écrites : la grille
+ * sort de calloc déjà SAIN, et les pages correspondantes ne sont pas touchées.
+ *
+ * Usage:
+ * ```
+ * struct Population *population =
+ *     chargerConditionInitiale("scenario.pgm", &parametres);
+ * if (!population) exit(1);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "condition_initiale.h"
+
+/**
+ * @brief Encode une Personne sur un octet.
+ *
+ * @param population Population de la Personne (zones et tour courant).
+ * @param personne Personne de population->personnes.
+ * @return unsigned char state | OCTET_QUARANTAINE si en quarantaine.
+ */
+unsigned char encoderPersonne(const struct Population *population,
+                              const struct Personne *personne) {
+  return (unsigned char)personne->state |
+         (enQuarantaine(population, personne) ? OCTET_QUARANTAINE : 0);
+}
+
+/**
+ * @brief Lit un entier décimal d'un en-tête PNM, en sautant les commentaires.
+ *
+ * @param octets Début du fichier.
+ * @param taille Taille du fichier.
+ * @param position Position courante, avancée après l'entier.
+ * @param valeur Entier lu.
+ * @return int 0 si OK, -1 sinon.
+ */
+static int lireEntierEntete(const unsigned char *octets, size_t taille,
+                            size_t *position, unsigned long *valeur) {
+  size_t i = *position;
+  while (i < taille && (octets[i] == ' ' || octets[i] == '\t' ||
+                        octets[i] == '\n' || octets[i] == '\r' ||
+                        octets[i] == '#')) {
+    if (octets[i] == '#')
+      while (i < taille && octets[i] != '\n') i++;
+    else
+      i++;
+  }
+  if (i >= taille || octets[i] < '0' || octets[i] > '9') return -1;
+  *valeur = 0;
+  while (i < taille && octets[i] >= '0' && octets[i] <= '9')
+    *valeur = *valeur * 10 + (octets[i++] - '0');
+  *position = i;
+  return 0;
+}
+
+/**
+ * @brief Décode l'en-tête d'un raster carré d'octets (PGM P5 ou brut).
+ *
+ * @param octets Fichier projeté.
+ * @param taille Taille du fichier.
+ * @param cote Côté de la grille.
+ * @param debut Position du premier octet de cellule.
+ * @return int 0 si OK, -1 sinon.
+ */
+static int lireEntete(const unsigned char *octets, size_t taille,
+                      unsigned long *cote, size_t *debut) {
+  if (taille >= 2 && octets[0] == 'P' && octets[1] == '5') {
+    unsigned long largeur, hauteur, maxval;
+    size_t position = 2;
+    if (lireEntierEntete(octets, taille, &position, &largeur) ||
+        lireEntierEntete(octets, taille, &position, &hauteur) ||
+        lireEntierEntete(octets, taille, &position, &maxval))
+      return -1;
+    // Un seul blanc sépare l'en-tête des données
+    if (largeur != hauteur || maxval > 255 || position >= taille) return -1;
+    *cote = largeur;
+    *debut = position + 1;
+  } else {
+    *cote = (unsigned long)sqrt((double)taille);
+    while (*cote * *cote > taille) (*cote)--;
+    while ((*cote + 1) * (*cote + 1) <= taille) (*cote)++;
+    *debut = 0;
+  }
+  if (*debut + *cote * *cote != taille) return -1;
+  return 0;
+}
+
+/**
+ * @brief Créer une population depuis un raster (PGM P5 ou octets bruts).
+ *
+ * Les INCUBE reçoivent parametres->duree_incube. Les cellules en quarantaine
+ * forment une seule zone, levée après parametres->duree_quarantaine tours.
+ *
+ * @param fichier Nom du fichier.
+ * @param parametres Paramètres de la simulation.
+ * @return struct Population* Population, NULL si le fichier est invalide.
+ */
+struct Population *chargerConditionInitiale(
+    const char *fichier, const struct Parametres *parametres) {
+  int fd = open(fichier, O_RDONLY);
+  if (fd < 0) return NULL;
+  struct stat infos;
+  if (fstat(fd, &infos) || infos.st_size == 0) {
+    close(fd);
+    return NULL;
+  }
+  const size_t taille = (size_t)infos.st_size;
+  const unsigned char *octets =
+      (const unsigned char *)mmap(NULL, taille, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (octets == MAP_FAILED) return NULL;
+  madvise((void *)octets, taille, MADV_SEQUENTIAL);
+
+  unsigned long cote;
+  size_t debut;
+  if (lireEntete(octets, taille, &cote, &debut)) {
+    munmap((void *)octets, taille);
+    return NULL;
+  }
+
+  struct Population *population = creerPopulation(cote);
+  struct Personne *personnes = population->personnes;
+  const unsigned char *cellules = octets + debut;
+  const unsigned long n = cote * cote;
+  uint32_t zone = 0;  // Créée à la première cellule en quarantaine
+  unsigned long k = 0;
+  while (k < n) {
+    // Saut rapide des cellules SAIN, 8 octets à la fois
+    if (k + 8 <= n) {
+      uint64_t mot;
+      memcpy(&mot, cellules + k, sizeof(mot));
+      if (!mot) {
+        k += 8;
+        continue;
+      }
+    }
+    const unsigned char octet = cellules[k];
+    if (octet) {
+      const unsigned char state = octet & ~OCTET_QUARANTAINE;
+      if (state > VACCINE) {
+        munmap((void *)octets, taille);
+        detruirePopulation(population);
+        return NULL;
+      }
+      personnes[k].state = (enum State)state;
+      if (state == INCUBE) personnes[k].duree_incube = parametres->duree_incube;
+      if (octet & OCTET_QUARANTAINE) {
+        if (!zone) zone = creerZone(population, parametres->duree_quarantaine);
+        personnes[k].zone = zone;
+      }
+    }
+    k++;
+  }
+
+  munmap((void *)octets, taille);
+  return population;
+}
+
+/**
+ * @brief Lit une carte d'un octet par case (classes, poids...), au format
+ * de la condition initiale.
+ *
+ * @param fichier Nom du fichier (PGM P5 ou octets bruts).
+ * @param cote Côté attendu de la grille.
+ * @return uint8_t* Carte cote*cote (malloc), NULL si invalide.
+ */
+uint8_t *chargerCarteOctets(const char *fichier, unsigned long cote) {
+  int fd = open(fichier, O_RDONLY);
+  if (fd < 0) return NULL;
+  struct stat infos;
+  if (fstat(fd, &infos) || infos.st_size == 0) {
+    close(fd);
+    return NULL;
+  }
+  const size_t taille = (size_t)infos.st_size;
+  const unsigned char *octets =
+      (const unsigned char *)mmap(NULL, taille, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (octets == MAP_FAILED) return NULL;
+
+  unsigned long cote_carte;
+  size_t debut;
+  uint8_t *carte = NULL;
+  if (!lireEntete(octets, taille, &cote_carte, &debut) &&
+      cote_carte == cote) {
+    carte = (uint8_t *)malloc(cote * cote);
+    memcpy(carte, octets + debut, cote * cote);
+  }
+  munmap((void *)octets, taille);
+  return carte;
+}
+
+/**
+ * @brief Exporte la population au format PGM (P5), relisible par
+ * chargerConditionInitiale.
+ *
+ * @param population Population.
+ * @param fichier Nom du fichier.
+ * @return int 0 si OK, -1 sinon.
+ */
+int exporterConditionInitiale(const struct Population *population,
+                              const char *fichier) {
+  FILE *file = fopen(fichier, "wb");
+  if (!file) return -1;
+  const unsigned long n = population->cote * population->cote;
+  unsigned char ligne[4096];
+  fprintf(file, "P5\n%lu %lu\n255\n", population->cote, population->cote);
+  for (unsigned long k = 0; k < n; k += sizeof(ligne)) {
+    unsigned long taille = n - k < sizeof(ligne) ? n - k : sizeof(ligne);
+    for (unsigned long i = 0; i < taille; i++)
+      ligne[i] = encoderPersonne(population, &population->personnes[k + i]);
+    fwrite(ligne, 1, taille, file);
+  }
+  fclose(file);
+  return 0;
+}
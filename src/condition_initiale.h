@@ -0,0 +1,24 @@
+#if !defined(CONDITION_INITIALE_H)
+#define CONDITION_INITIALE_H
+
+#include <stdint.h>
+
+#include "jouer_un_tour.h"
+#include "population.h"
+
+/**
+ * @brief Bit de quarantaine dans l'octet d'une cellule.
+ *
+ * Les bits de poids faible contiennent l'enum State.
+ */
+#define OCTET_QUARANTAINE 0x80
+
+uint8_t *chargerCarteOctets(const char *fichier, unsigned long cote);
+unsigned char encoderPersonne(const struct Population *population,
+                              const struct Personne *personne);
+struct Population *chargerConditionInitiale(const char *fichier,
+                                            const struct Parametres *parametres);
+int exporterConditionInitiale(const struct Population *population,
+                              const char *fichier);
+
+#endif  // CONDITION_INITIALE_H
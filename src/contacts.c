@@ -0,0 +1,383 @@
+/**
+ * @file contacts.c
+ *
+ * @brief Contacts lointains (petit monde) : voyages entre régions éloignées.
+ *
+ * Chaque case contagieuse (MALADE ou INCUBE, hors quarantaine) contacte à
+ * chaque tour K cases lointaines, en plus de ses 4 voisins. La case visée
+ * suit une loi :
+ * - CONTACTS_DISTANCE : une case à distance r (Tchebychev) avec une
+ *   probabilité en r^-exposant, jusqu'au rayon ; la distance est tirée dans
+ *   une table d'alias, puis la case uniformément sur l'anneau de 8r cases
+ *   (un contact qui sort de la grille est perdu) ;
+ * - CONTACTS_POIDS : une case selon une carte de poids (villes, gares...),
+ *   tirée dans une table d'alias de cote*cote cases.
+ * Chaque tirage coûte O(1). Un contact infecte une case SAIN hors
+ * quarantaine avec la probabilité lambda.
+ *
+ * Le balayage lit seulement la grille du tour t, découpée en bandes de
+ * lignes : chaque bande a son thread, son générateur et son tampon de
+ * cases visées, sans verrou. Les threads sont créés avec la couche et
+ * réveillés à chaque tour par des barrières, comme dans bandes.c. Les
+ * tampons sont fusionnés après le tour du moteur (t -> t+1) : une case
+ * visée encore SAIN au tour t+1 devient INCUBE. Le double tampon du moteur
+ * n'est pas touché pendant son tour.
+ *
+ * Usage:
+ * ```
+ * struct ParametresContacts parametres_contacts = {
+ *     .nb_contacts = 2, .loi = CONTACTS_DISTANCE, .exposant = 2,
+ *     .rayon = 1000};
+ * struct Contacts *contacts = creerContacts(&parametres_contacts, cote, 4);
+ * for (...) {
+ *   collecterContacts(contacts, population, parametres.lambda, &aleatoire);
+ *   jouerTourParametres(population, &parametres, &aleatoire);
+ *   fusionnerContacts(contacts, population, &parametres);
+ * }
+ * detruireContacts(contacts);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "contacts.h"
+
+/**
+ * @brief Construit une table d'alias (méthode de Vose).
+ *
+ * Usage:
+ * ```
+ * const double poids[3] = {1, 2, 7};
+ * struct Alias alias;
+ * initAlias(&alias, poids, 3);
+ * uint32_t indice = tirerAlias(&alias, &aleatoire);  // 2 avec p = 0.7
+ * libererAlias(&alias);
+ * ```
+ *
+ * @param alias Table à construire.
+ * @param poids Poids positifs ou nuls de chaque indice.
+ * @param taille Nombre d'indices.
+ * @return int 0 si OK, -1 si aucun poids n'est positif (rien n'est alloué).
+ */
+int initAlias(struct Alias *alias, const double *poids, uint32_t taille) {
+  double somme = 0;
+  for (uint32_t i = 0; i < taille; i++) {
+    if (poids[i] < 0) return -1;
+    somme += poids[i];
+  }
+  if (!taille || !(somme > 0)) return -1;
+
+  alias->taille = taille;
+  alias->seuils = (double *)malloc(taille * sizeof(double));
+  alias->alias = (uint32_t *)malloc(taille * sizeof(uint32_t));
+  // Indices sous la moyenne (petits) et au-dessus (grands)
+  uint32_t *petits = (uint32_t *)malloc(taille * sizeof(uint32_t));
+  uint32_t *grands = (uint32_t *)malloc(taille * sizeof(uint32_t));
+  uint32_t nb_petits = 0, nb_grands = 0;
+  for (uint32_t i = 0; i < taille; i++) {
+    alias->seuils[i] = poids[i] * taille / somme;
+    alias->alias[i] = i;
+    if (alias->seuils[i] < 1)
+      petits[nb_petits++] = i;
+    else
+      grands[nb_grands++] = i;
+  }
+  // Chaque petit est complété par un grand, qui perd ce qu'il donne
+  while (nb_petits && nb_grands) {
+    const uint32_t petit = petits[--nb_petits];
+    const uint32_t grand = grands[nb_grands - 1];
+    alias->alias[petit] = grand;
+    alias->seuils[grand] -= 1 - alias->seuils[petit];
+    if (alias->seuils[grand] < 1) {
+      nb_grands--;
+      petits[nb_petits++] = grand;
+    }
+  }
+  // Restes des arrondis : probabilité 1
+  while (nb_grands) alias->seuils[grands[--nb_grands]] = 1;
+  while (nb_petits) alias->seuils[petits[--nb_petits]] = 1;
+  free(petits);
+  free(grands);
+  return 0;
+}
+
+/**
+ * @brief Tire un indice selon les poids de la table, un seul tirage.
+ *
+ * @param alias Table.
+ * @param aleatoire Générateur aléatoire.
+ * @return uint32_t Indice.
+ */
+uint32_t tirerAlias(const struct Alias *alias, struct Aleatoire *aleatoire) {
+  const double u = aleatoireUniforme(aleatoire) * alias->taille;
+  uint32_t i = (uint32_t)u;
+  if (i >= alias->taille) i = alias->taille - 1;
+  return u - i < alias->seuils[i] ? i : alias->alias[i];
+}
+
+/**
+ * @brief Libère une table d'alias.
+ *
+ * @param alias Table.
+ */
+void libererAlias(struct Alias *alias) {
+  free(alias->seuils);
+  free(alias->alias);
+}
+
+/**
+ * @brief Case visée par un contact de la case (i, j).
+ *
+ * @param contacts Couche.
+ * @param i, j Case contagieuse.
+ * @param aleatoire Générateur de la bande.
+ * @return long Indice de la case visée, -1 si elle sort de la grille.
+ */
+static long viser(const struct Contacts *contacts, unsigned long i,
+                  unsigned long j, struct Aleatoire *aleatoire) {
+  if (contacts->parametres.loi == CONTACTS_POIDS)
+    return (long)tirerAlias(&contacts->alias, aleatoire);
+
+  // Anneau de distance r : 4 côtés de 2r cases
+  const long r = (long)tirerAlias(&contacts->alias, aleatoire) + 1;
+  const long m = (long)(aleatoireEntier(aleatoire) % (uint64_t)(8 * r));
+  const long t = m % (2 * r);
+  long di, dj;
+  switch (m / (2 * r)) {
+    case 0:
+      di = -r, dj = -r + t;
+      break;
+    case 1:
+      di = -r + t, dj = r;
+      break;
+    case 2:
+      di = r, dj = r - t;
+      break;
+    default:
+      di = r - t, dj = -r;
+      break;
+  }
+  const long x = (long)i + di, y = (long)j + dj;
+  const long cote = (long)contacts->cote;
+  if (x < 0 || x >= cote || y < 0 || y >= cote) return -1;
+  return x * cote + y;
+}
+
+/**
+ * @brief Ajoute une case visée au tampon.
+ *
+ * @param tampon Tampon de la bande.
+ * @param cible Indice de la case.
+ */
+static void ajouterCible(struct TamponContacts *tampon, unsigned long cible) {
+  if (tampon->nb_cibles == tampon->capacite) {
+    tampon->capacite = tampon->capacite ? 2 * tampon->capacite : 64;
+    tampon->cibles = (unsigned long *)realloc(
+        tampon->cibles, tampon->capacite * sizeof(unsigned long));
+  }
+  tampon->cibles[tampon->nb_cibles++] = cible;
+}
+
+/**
+ * @brief Balaye une bande de lignes du tour t.
+ *
+ * @param tampon Tampon de la bande.
+ */
+static void balayer(struct TamponContacts *tampon) {
+  const struct Contacts *contacts = tampon->contacts;
+  const struct Population *population = contacts->population;
+  const unsigned long cote = contacts->cote;
+  tampon->nb_cibles = 0;
+  for (unsigned long i = tampon->debut; i < tampon->fin; i++) {
+    for (unsigned long j = 0; j < cote; j++) {
+      const struct Personne *source = &population->personnes[i * cote + j];
+      if ((source->state != MALADE && source->state != INCUBE) ||
+          enQuarantaine(population, source))
+        continue;
+      for (unsigned int c = 0; c < contacts->parametres.nb_contacts; c++) {
+        const long cible = viser(contacts, i, j, &tampon->aleatoire);
+        if (cible < 0) continue;
+        const struct Personne *personne = &population->personnes[cible];
+        if (personne->state != SAIN || enQuarantaine(population, personne))
+          continue;
+        if (contacts->lambda < 1 &&
+            aleatoireUniforme(&tampon->aleatoire) >= contacts->lambda)
+          continue;
+        ajouterCible(tampon, (unsigned long)cible);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Boucle du thread d'une bande : un balayage par départ, jusqu'à
+ * l'arrêt.
+ *
+ * @param argument struct TamponContacts* de la bande.
+ * @return void* NULL.
+ */
+static void *executerTampon(void *argument) {
+  struct TamponContacts *tampon = (struct TamponContacts *)argument;
+  struct Contacts *contacts = tampon->contacts;
+  for (;;) {
+    pthread_barrier_wait(&contacts->depart);
+    if (contacts->arret) return NULL;
+    balayer(tampon);
+    pthread_barrier_wait(&contacts->arrivee);
+  }
+}
+
+/**
+ * @brief Créer une couche de contacts lointains.
+ *
+ * @param parametres Paramètres (copiés ; les poids sont lus ici seulement).
+ * @param cote Longueur d'un côté de la grille.
+ * @param nb_tampons Nombre de bandes de lignes, au plus cote ; un thread
+ * par bande s'il y en a plus d'une.
+ * @return struct Contacts* Couche, NULL si la loi est vide (rayon nul, aucun
+ * poids positif) ou la grille trop grande pour CONTACTS_POIDS (2^32 cases).
+ */
+struct Contacts *creerContacts(const struct ParametresContacts *parametres,
+                               unsigned long cote, unsigned int nb_tampons) {
+  struct Contacts *contacts =
+      (struct Contacts *)malloc(sizeof(struct Contacts));
+  contacts->parametres = *parametres;
+  contacts->parametres.poids = NULL;
+  contacts->cote = cote;
+  int erreur = -1;
+  if (parametres->loi == CONTACTS_DISTANCE) {
+    // Anneau de 8r cases, chacune de poids r^-exposant
+    const unsigned long rayon =
+        parametres->rayon < cote ? parametres->rayon : cote - 1;
+    contacts->parametres.rayon = rayon;
+    if (rayon && rayon <= UINT32_MAX) {
+      double *poids = (double *)malloc(rayon * sizeof(double));
+      for (unsigned long r = 1; r <= rayon; r++)
+        poids[r - 1] = 8. * r * pow((double)r, -parametres->exposant);
+      erreur = initAlias(&contacts->alias, poids, (uint32_t)rayon);
+      free(poids);
+    }
+  } else if (cote * cote <= UINT32_MAX) {
+    double *poids = (double *)malloc(cote * cote * sizeof(double));
+    for (unsigned long k = 0; k < cote * cote; k++)
+      poids[k] = parametres->poids[k];
+    erreur = initAlias(&contacts->alias, poids, (uint32_t)(cote * cote));
+    free(poids);
+  }
+  if (erreur) {
+    free(contacts);
+    return NULL;
+  }
+
+  if (!nb_tampons) nb_tampons = 1;
+  if (nb_tampons > cote) nb_tampons = (unsigned int)cote;
+  contacts->nb_tampons = nb_tampons;
+  contacts->tampons = (struct TamponContacts *)calloc(
+      nb_tampons, sizeof(struct TamponContacts));
+  for (unsigned int b = 0; b < nb_tampons; b++) {
+    struct TamponContacts *tampon = &contacts->tampons[b];
+    tampon->contacts = contacts;
+    tampon->debut = cote * b / nb_tampons;
+    tampon->fin = cote * (b + 1) / nb_tampons;
+  }
+  contacts->population = NULL;
+  contacts->infections = 0;
+  contacts->arret = 0;
+  if (nb_tampons > 1) {
+    pthread_barrier_init(&contacts->depart, NULL, nb_tampons + 1);
+    pthread_barrier_init(&contacts->arrivee, NULL, nb_tampons + 1);
+    for (unsigned int b = 0; b < nb_tampons; b++)
+      if (pthread_create(&contacts->tampons[b].thread, NULL, executerTampon,
+                         &contacts->tampons[b])) {
+        printf("Erreur: Thread de la bande %u non créé.\n", b);
+        exit(1);
+      }
+  }
+  return contacts;
+}
+
+/**
+ * @brief Tire les contacts lointains du tour t, avant le tour du moteur.
+ *
+ * Les générateurs des bandes sont ré-ensemencés par aleatoire : pour un même
+ * nombre de bandes, la trajectoire ne dépend pas de l'ordre des threads.
+ *
+ * @param contacts Couche.
+ * @param population Grille au tour t (lue seulement).
+ * @param lambda Probabilité de transmission d'un contact.
+ * @param aleatoire Générateur de la simulation.
+ */
+void collecterContacts(struct Contacts *contacts,
+                       const struct Population *population, double lambda,
+                       struct Aleatoire *aleatoire) {
+  contacts->population = population;
+  contacts->lambda = lambda;
+  for (unsigned int b = 0; b < contacts->nb_tampons; b++)
+    initAleatoire(&contacts->tampons[b].aleatoire, aleatoireEntier(aleatoire));
+  if (contacts->nb_tampons == 1) {
+    balayer(&contacts->tampons[0]);
+    return;
+  }
+  pthread_barrier_wait(&contacts->depart);
+  pthread_barrier_wait(&contacts->arrivee);
+}
+
+/**
+ * @brief Applique les contacts lointains après le tour du moteur.
+ *
+ * Une case visée encore SAIN au tour t+1 devient INCUBE (raster d'infection
+ * compris) ; une case visée plusieurs fois n'est infectée qu'une fois.
+ *
+ * @param contacts Couche, tampons remplis par collecterContacts.
+ * @param population Grille au tour t+1.
+ * @param parametres Paramètres (duree_incube).
+ * @return unsigned long Nombre d'infections lointaines.
+ */
+unsigned long fusionnerContacts(struct Contacts *contacts,
+                                struct Population *population,
+                                const struct Parametres *parametres) {
+  uint16_t *const raster_infection = population->rasters[RASTER_INFECTION];
+  const uint16_t tour = getTourRaster(population);
+  unsigned long infections = 0;
+  for (unsigned int b = 0; b < contacts->nb_tampons; b++) {
+    const struct TamponContacts *tampon = &contacts->tampons[b];
+    for (unsigned long c = 0; c < tampon->nb_cibles; c++) {
+      const unsigned long cible = tampon->cibles[c];
+      struct Personne *personne = &population->personnes[cible];
+      if (personne->state != SAIN) continue;
+      personne->state = INCUBE;
+      personne->duree_incube = parametres->duree_incube;
+      if (raster_infection) raster_infection[cible] = tour;
+      infections++;
+    }
+  }
+  contacts->infections = infections;
+  return infections;
+}
+
+/**
+ * @brief Arrête les threads, libère la couche et ses tampons.
+ *
+ * @param contacts Couche.
+ */
+void detruireContacts(struct Contacts *contacts) {
+  if (contacts->nb_tampons > 1) {
+    contacts->arret = 1;
+    pthread_barrier_wait(&contacts->depart);
+    for (unsigned int b = 0; b < contacts->nb_tampons; b++)
+      pthread_join(contacts->tampons[b].thread, NULL);
+    pthread_barrier_destroy(&contacts->depart);
+    pthread_barrier_destroy(&contacts->arrivee);
+  }
+  for (unsigned int b = 0; b < contacts->nb_tampons; b++)
+    free(contacts->tampons[b].cibles);
+  free(contacts->tampons);
+  libererAlias(&contacts->alias);
+  free(contacts);
+}
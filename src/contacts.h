@@ -0,0 +1,171 @@
+#if !defined(CONTACTS_H)
+#define CONTACTS_H
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include "aleatoire.h"
+#include "jouer_un_tour.h"
+#include "population.h"
+
+/**
+ * @brief Loi de la case visée par un contact lointain.
+ */
+enum LoiContacts {
+  CONTACTS_DISTANCE,  // Case à distance r avec une probabilité en r^-exposant
+  CONTACTS_POIDS      // Case tirée selon une carte de poids (villes...)
+};
+
+/**
+ * @brief Table d'alias (méthode de Walker-Vose) : tirage d'un indice selon
+ * des poids en O(1), un seul nombre uniforme.
+ */
+struct Alias {
+  /**
+   * @brief Nombre d'indices.
+   */
+  uint32_t taille;
+  /**
+   * @brief Probabilité de garder l'indice tiré, par indice.
+   */
+  double *seuils;
+  /**
+   * @brief Indice rendu sinon, par indice.
+   */
+  uint32_t *alias;
+};
+
+/**
+ * @brief Paramètres de la couche de contacts lointains.
+ */
+struct ParametresContacts {
+  /**
+   * @brief Contacts lointains de chaque case contagieuse par tour (K).
+   */
+  unsigned int nb_contacts;
+  /**
+   * @brief Loi de la case visée.
+   */
+  enum LoiContacts loi;
+  /**
+   * @brief CONTACTS_DISTANCE : exposant de la décroissance avec la distance.
+   */
+  double exposant;
+  /**
+   * @brief CONTACTS_DISTANCE : distance maximale (distance de Tchebychev).
+   */
+  unsigned long rayon;
+  /**
+   * @brief CONTACTS_POIDS : poids de chaque case, cote*cote (non possédés,
+   * lus par creerContacts seulement).
+   */
+  const uint8_t *poids;
+};
+
+/**
+ * @brief Tampon des infections lointaines d'une bande de lignes, rempli par
+ * son thread pendant le balayage.
+ */
+struct TamponContacts {
+  /**
+   * @brief Couche à laquelle appartient le tampon.
+   */
+  struct Contacts *contacts;
+  /**
+   * @brief Première ligne de la bande.
+   */
+  unsigned long debut;
+  /**
+   * @brief Ligne après la dernière.
+   */
+  unsigned long fin;
+  /**
+   * @brief Générateur de la bande, ré-ensemencé à chaque tour.
+   */
+  struct Aleatoire aleatoire;
+  /**
+   * @brief Cases visées (indices ligne par ligne), gardées d'un tour à
+   * l'autre.
+   */
+  unsigned long *cibles;
+  /**
+   * @brief Nombre de cases visées ce tour.
+   */
+  unsigned long nb_cibles;
+  /**
+   * @brief Capacité de cibles.
+   */
+  unsigned long capacite;
+  /**
+   * @brief Thread de la bande (plus d'une bande seulement).
+   */
+  pthread_t thread;
+};
+
+/**
+ * @brief Couche de contacts lointains (petit monde), ajoutée au tour de
+ * n'importe quel moteur qui joue la grille de personnes.
+ */
+struct Contacts {
+  /**
+   * @brief Paramètres (copie, poids non gardés).
+   */
+  struct ParametresContacts parametres;
+  /**
+   * @brief Longueur d'un côté de la grille.
+   */
+  unsigned long cote;
+  /**
+   * @brief CONTACTS_DISTANCE : indice r - 1 de la distance r ;
+   * CONTACTS_POIDS : indice de la case.
+   */
+  struct Alias alias;
+  /**
+   * @brief Probabilité de transmission d'un contact, lambda du balayage en
+   * cours.
+   */
+  double lambda;
+  /**
+   * @brief Population du balayage en cours (non possédée).
+   */
+  const struct Population *population;
+  /**
+   * @brief Nombre de bandes (et de threads).
+   */
+  unsigned int nb_tampons;
+  /**
+   * @brief Tampons, un par bande.
+   */
+  struct TamponContacts *tampons;
+  /**
+   * @brief Infections lointaines du dernier tour.
+   */
+  unsigned long infections;
+  /**
+   * @brief Vrai : les threads s'arrêtent au prochain départ.
+   */
+  char arret;
+  /**
+   * @brief Barrière de départ d'un balayage (threads et appelant).
+   */
+  pthread_barrier_t depart;
+  /**
+   * @brief Barrière de fin d'un balayage (threads et appelant).
+   */
+  pthread_barrier_t arrivee;
+};
+
+int initAlias(struct Alias *alias, const double *poids, uint32_t taille);
+uint32_t tirerAlias(const struct Alias *alias, struct Aleatoire *aleatoire);
+void libererAlias(struct Alias *alias);
+struct Contacts *creerContacts(const struct ParametresContacts *parametres,
+                               unsigned long cote, unsigned int nb_tampons);
+void collecterContacts(struct Contacts *contacts,
+                       const struct Population *population, double lambda,
+                       struct Aleatoire *aleatoire);
+unsigned long fusionnerContacts(struct Contacts *contacts,
+                                struct Population *population,
+                                const struct Parametres *parametres);
+void detruireContacts(struct Contacts *contacts);
+
+#endif  // CONTACTS_H
@@ -0,0 +1,232 @@
+/**
+ * @file film.c
+ *
+ * @brief Export de la grille en suite d'images PPM/PGM.
+ *
+ * Les images sont écrites directement depuis les Personne dans un fichier
+ * projeté en mémoire (mmap), dimensionné à l'avance. Une image peut être
+ * prise tous les k tours et la grille réduite (bloc moyenné en un pixel)
+ * pour les très grandes grilles.
+ *
+ * Usage:
+ * ```
+ * struct Film *film = creerFilm("film.ppm", IMAGE_PPM, cote, 1, 1, 101);
+ * ajouterImageFilm(film, population);  // Tour 0
+ * for (...) {
+ *   jouerTour(...);
+ *   ajouterImageFilm(film, population);
+ * }
+ * fermerFilm(film);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "condition_initiale.h"
+#include "film.h"
+
+/**
+ * @brief Couleurs des états, proches de la palette du terminal.
+ *
+ * VACCINE est plus orangé que IMMUNISE (tous deux jaunes au terminal, où le
+ * caractère les distingue).
+ */
+static const unsigned char PALETTE[6][3] = {
+    {220, 220, 220},  // SAIN : texte par défaut
+    {205, 0, 0},      // MALADE : rouge
+    {0, 0, 0},        // MORT : vide
+    {205, 205, 0},    // IMMUNISE : jaune
+    {205, 0, 205},    // INCUBE : violet
+    {230, 150, 0}};   // VACCINE : jaune orangé
+
+/**
+ * @brief Couleur de la quarantaine (vert du terminal).
+ */
+static const unsigned char VERT[3] = {0, 205, 0};
+
+/**
+ * @brief Remplit film->couleurs pour chaque octet encoderPersonne.
+ *
+ * Une Personne en quarantaine prend la moyenne de sa couleur et du vert.
+ *
+ * @param film Film.
+ */
+static void preparerCouleurs(struct Film *film) {
+  for (int octet = 0; octet < 256; octet++) {
+    int state = octet & ~OCTET_QUARANTAINE;
+    if (state > VACCINE) state = MORT;
+    unsigned char rgb[3];
+    for (int c = 0; c < 3; c++)
+      rgb[c] = octet & OCTET_QUARANTAINE
+                   ? (unsigned char)((PALETTE[state][c] + VERT[c]) / 2)
+                   : PALETTE[state][c];
+    if (film->format == IMAGE_PPM)
+      memcpy(film->couleurs[octet], rgb, 3);
+    else
+      film->couleurs[octet][0] =
+          (unsigned char)((299 * rgb[0] + 587 * rgb[1] + 114 * rgb[2]) / 1000);
+  }
+}
+
+/**
+ * @brief Créer un film et dimensionner son fichier.
+ *
+ * @param fichier Nom du fichier.
+ * @param format IMAGE_PPM ou IMAGE_PGM.
+ * @param cote Longueur d'un côté de la grille.
+ * @param reduction Côté d'un bloc de cellules par pixel (1 : pas de
+ * réduction).
+ * @param chaque Une image tous les chaque tours.
+ * @param nb_images_max Nombre d'images prévues.
+ * @return struct Film* Film, NULL si un paramètre est nul ou si le fichier
+ * n'a pas pu être créé.
+ */
+struct Film *creerFilm(const char *fichier, enum FormatImage format,
+                       unsigned long cote, unsigned long reduction,
+                       unsigned long chaque, unsigned long nb_images_max) {
+  if (!cote || !reduction || !chaque || !nb_images_max) return NULL;
+  struct Film *film = (struct Film *)malloc(sizeof(struct Film));
+  film->format = format;
+  film->cote = cote;
+  film->reduction = reduction;
+  film->largeur = (cote + reduction - 1) / reduction;
+  film->chaque = chaque;
+  film->tours = 0;
+  film->nb_images = 0;
+  film->nb_images_max = nb_images_max;
+  char entete[64];
+  film->taille_entete =
+      (size_t)snprintf(entete, sizeof(entete), "P%c\n%lu %lu\n255\n",
+                       format == IMAGE_PPM ? '6' : '5', film->largeur,
+                       film->largeur);
+  const size_t canaux = format == IMAGE_PPM ? 3 : 1;
+  film->taille_image =
+      film->taille_entete + canaux * film->largeur * film->largeur;
+  film->taille_carte = film->taille_image * nb_images_max;
+  film->sommes = (unsigned long *)malloc(sizeof(unsigned long) * canaux *
+                                         film->largeur);
+  preparerCouleurs(film);
+
+  film->fd = open(fichier, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (film->fd < 0) {
+    free(film->sommes);
+    free(film);
+    return NULL;
+  }
+  if (ftruncate(film->fd, (off_t)film->taille_carte) ||
+      (film->carte = (unsigned char *)mmap(NULL, film->taille_carte,
+                                           PROT_READ | PROT_WRITE, MAP_SHARED,
+                                           film->fd, 0)) == MAP_FAILED) {
+    close(film->fd);
+    free(film->sommes);
+    free(film);
+    return NULL;
+  }
+  madvise(film->carte, film->taille_carte, MADV_SEQUENTIAL);
+  return film;
+}
+
+/**
+ * @brief Ecrit les pixels d'une image réduite : moyenne de chaque bloc.
+ *
+ * @param film Film.
+ * @param population Population.
+ * @param pixels Destination.
+ */
+static void ecrirePixelsReduits(struct Film *film,
+                                const struct Population *population,
+                                unsigned char *pixels) {
+  const unsigned long cote = film->cote, reduction = film->reduction;
+  const size_t canaux = film->format == IMAGE_PPM ? 3 : 1;
+  for (unsigned long ligne = 0; ligne < film->largeur; ligne++) {
+    const unsigned long debut = ligne * reduction;
+    const unsigned long fin =
+        debut + reduction < cote ? debut + reduction : cote;
+    memset(film->sommes, 0, sizeof(unsigned long) * canaux * film->largeur);
+    for (unsigned long i = debut; i < fin; i++) {
+      const struct Personne *personnes = population->personnes + i * cote;
+      unsigned long *somme = film->sommes;
+      for (unsigned long j = 0; j < cote; somme += canaux) {
+        const unsigned long fin_bloc =
+            j + reduction < cote ? j + reduction : cote;
+        for (; j < fin_bloc; j++) {
+          const unsigned char *couleur =
+              film->couleurs[encoderPersonne(population, &personnes[j])];
+          for (size_t c = 0; c < canaux; c++) somme[c] += couleur[c];
+        }
+      }
+    }
+    for (unsigned long colonne = 0; colonne < film->largeur; colonne++) {
+      const unsigned long largeur_bloc =
+          (colonne + 1) * reduction < cote ? reduction
+                                           : cote - colonne * reduction;
+      const unsigned long nb = (fin - debut) * largeur_bloc;
+      for (size_t c = 0; c < canaux; c++)
+        *pixels++ =
+            (unsigned char)(film->sommes[colonne * canaux + c] / nb);
+    }
+  }
+}
+
+/**
+ * @brief Présente un tour au film : une image est écrite tous les chaque
+ * tours.
+ *
+ * @param film Film.
+ * @param population Population de même cote que le film.
+ * @return int 1 si une image est écrite, 0 si le tour est sauté, -1 si le
+ * film est plein.
+ */
+int ajouterImageFilm(struct Film *film, const struct Population *population) {
+  if (film->tours++ % film->chaque) return 0;
+  if (film->nb_images == film->nb_images_max) return -1;
+
+  unsigned char *image = film->carte + film->nb_images * film->taille_image;
+  snprintf((char *)image, film->taille_entete + 1, "P%c\n%lu %lu\n255\n",
+           film->format == IMAGE_PPM ? '6' : '5', film->largeur,
+           film->largeur);
+  unsigned char *pixels = image + film->taille_entete;
+  if (film->reduction > 1) {
+    ecrirePixelsReduits(film, population, pixels);
+  } else if (film->format == IMAGE_PPM) {
+    const unsigned long n = film->cote * film->cote;
+    for (unsigned long k = 0; k < n; k++, pixels += 3)
+      memcpy(pixels,
+             film->couleurs[encoderPersonne(population,
+                                            &population->personnes[k])],
+             3);
+  } else {
+    const unsigned long n = film->cote * film->cote;
+    for (unsigned long k = 0; k < n; k++)
+      pixels[k] = film->couleurs[encoderPersonne(
+          population, &population->personnes[k])][0];
+  }
+  film->nb_images++;
+  return 1;
+}
+
+/**
+ * @brief Ferme le film : le fichier est réduit aux images écrites.
+ *
+ * @param film Film.
+ * @return int 0, ou -1 si le fichier n'a pas pu être finalisé.
+ */
+int fermerFilm(struct Film *film) {
+  int ok = !munmap(film->carte, film->taille_carte);
+  if (film->nb_images < film->nb_images_max)
+    ok = !ftruncate(film->fd, (off_t)(film->nb_images * film->taille_image)) &&
+         ok;
+  ok = !close(film->fd) && ok;
+  free(film->sommes);
+  free(film);
+  return ok ? 0 : -1;
+}
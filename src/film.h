@@ -0,0 +1,92 @@
+#if !defined(FILM_H)
+#define FILM_H
+
+#include <stddef.h>
+
+#include "population.h"
+
+/**
+ * @brief Format des images d'un Film.
+ */
+enum FormatImage {
+  IMAGE_PPM,  // P6, couleurs du terminal
+  IMAGE_PGM   // P5, niveaux de gris
+};
+
+/**
+ * @brief Suite d'images PPM/PGM concaténées dans un fichier projeté.
+ *
+ * Le fichier est dimensionné à la création pour nb_images_max images ; chaque
+ * image est écrite directement dans la projection, sans tampon
+ * intermédiaire. Lisible par ex. avec `ffmpeg -f image2pipe -i film.ppm`.
+ */
+struct Film {
+  /**
+   * @brief Descripteur du fichier.
+   */
+  int fd;
+  /**
+   * @brief Projection du fichier.
+   */
+  unsigned char *carte;
+  /**
+   * @brief Taille de la projection.
+   */
+  size_t taille_carte;
+  /**
+   * @brief Taille d'une image, en-tête compris.
+   */
+  size_t taille_image;
+  /**
+   * @brief Taille de l'en-tête d'une image.
+   */
+  size_t taille_entete;
+  /**
+   * @brief Format des images.
+   */
+  enum FormatImage format;
+  /**
+   * @brief Longueur d'un côté de la grille.
+   */
+  unsigned long cote;
+  /**
+   * @brief Côté d'un bloc de cellules moyenné en un pixel.
+   */
+  unsigned long reduction;
+  /**
+   * @brief Longueur d'un côté de l'image, en pixels.
+   */
+  unsigned long largeur;
+  /**
+   * @brief Une image tous les chaque tours.
+   */
+  unsigned long chaque;
+  /**
+   * @brief Nombre de tours présentés à ajouterImageFilm.
+   */
+  unsigned long tours;
+  /**
+   * @brief Nombre d'images écrites.
+   */
+  unsigned long nb_images;
+  /**
+   * @brief Nombre d'images prévues à la création.
+   */
+  unsigned long nb_images_max;
+  /**
+   * @brief Couleur (1 ou 3 octets) de chaque octet encoderPersonne.
+   */
+  unsigned char couleurs[256][3];
+  /**
+   * @brief Sommes d'une ligne de pixels (réduction > 1).
+   */
+  unsigned long *sommes;
+};
+
+struct Film *creerFilm(const char *fichier, enum FormatImage format,
+                       unsigned long cote, unsigned long reduction,
+                       unsigned long chaque, unsigned long nb_images_max);
+int ajouterImageFilm(struct Film *film, const struct Population *population);
+int fermerFilm(struct Film *film);
+
+#endif  // FILM_H
@@ -0,0 +1,206 @@
+/**
+ * @file graphique_flux.c
+ *
+ * @brief Graphique ASCII incrémental, pour suivre une simulation en direct.
+ *
+ * Contrairement à graphique(), il n'a pas besoin de tout l'historique Data :
+ * une Statistique est ajoutée à chaque tour et le graphique peut être rendu
+ * à tout moment, en une seule écriture.
+ *
+ * Usage:
+ * ```
+ * struct GraphiqueFlux *graphique = creerGraphiqueFlux(20, 80, cote * cote);
+ * for (...) {
+ *   jouerTour(...);
+ *   ajouterGraphiqueFlux(graphique, getStatistique(population));
+ *   rendreGraphiqueFlux(graphique, stdout, 1);  // Suivi en direct
+ * }
+ * exporterGraphiqueFlux(graphique, "graphique.txt");
+ * detruireGraphiqueFlux(graphique);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "graphique_flux.h"
+
+/**
+ * @brief Longueur maximale d'un caractère coloré ("\e[33m$\e[0m").
+ */
+#define TAILLE_CARACTERE 10
+
+/**
+ * @brief Créer un graphique vide.
+ *
+ * @param hauteur Hauteur du graphique.
+ * @param limite Nombre maximum de colonnes.
+ * @param population_totale Population totale.
+ * @return struct GraphiqueFlux* Graphique.
+ */
+struct GraphiqueFlux *creerGraphiqueFlux(unsigned long hauteur,
+                                         unsigned long limite,
+                                         unsigned long population_totale) {
+  struct GraphiqueFlux *graphique =
+      (struct GraphiqueFlux *)malloc(sizeof(struct GraphiqueFlux));
+  graphique->hauteur = hauteur;
+  graphique->limite = limite;
+  graphique->population_totale = population_totale;
+  graphique->tours_par_colonne = 1;
+  graphique->nb_colonnes = 0;
+  graphique->tours_derniere_colonne = 0;
+  graphique->colonnes =
+      (struct Statistique *)calloc(limite, sizeof(struct Statistique));
+  graphique->rendu = (char *)malloc(hauteur * (limite * TAILLE_CARACTERE + 1));
+  return graphique;
+}
+
+/**
+ * @brief Fusionne les colonnes deux à deux (tours_par_colonne double).
+ *
+ * @param graphique Graphique dont toutes les colonnes sont pleines.
+ */
+static void fusionnerColonnes(struct GraphiqueFlux *graphique) {
+  struct Statistique *colonnes = graphique->colonnes;
+  for (unsigned long i = 0; i < graphique->nb_colonnes / 2; i++) {
+    colonnes[i].nb_IMMUNISE =
+        colonnes[2 * i].nb_IMMUNISE + colonnes[2 * i + 1].nb_IMMUNISE;
+    colonnes[i].nb_SAIN = colonnes[2 * i].nb_SAIN + colonnes[2 * i + 1].nb_SAIN;
+    colonnes[i].nb_MORT = colonnes[2 * i].nb_MORT + colonnes[2 * i + 1].nb_MORT;
+    colonnes[i].nb_MALADE =
+        colonnes[2 * i].nb_MALADE + colonnes[2 * i + 1].nb_MALADE;
+    colonnes[i].nb_INCUBE =
+        colonnes[2 * i].nb_INCUBE + colonnes[2 * i + 1].nb_INCUBE;
+    colonnes[i].nb_VACCINE =
+        colonnes[2 * i].nb_VACCINE + colonnes[2 * i + 1].nb_VACCINE;
+  }
+  // Nombre impair : la dernière colonne devient une colonne à moitié pleine
+  if (graphique->nb_colonnes % 2) {
+    colonnes[graphique->nb_colonnes / 2] = colonnes[graphique->nb_colonnes - 1];
+    graphique->tours_derniere_colonne = graphique->tours_par_colonne;
+  } else {
+    graphique->tours_derniere_colonne = 2 * graphique->tours_par_colonne;
+  }
+  graphique->nb_colonnes = (graphique->nb_colonnes + 1) / 2;
+  memset(colonnes + graphique->nb_colonnes, 0,
+         sizeof(struct Statistique) *
+             (graphique->limite - graphique->nb_colonnes));
+  graphique->tours_par_colonne *= 2;
+}
+
+/**
+ * @brief Ajoute la Statistique d'un tour.
+ *
+ * @param graphique Graphique.
+ * @param stats Statistique du tour.
+ */
+void ajouterGraphiqueFlux(struct GraphiqueFlux *graphique,
+                          struct Statistique stats) {
+  if (!graphique->limite) return;
+  const char pleine =
+      graphique->tours_derniere_colonne == graphique->tours_par_colonne;
+  if (pleine && graphique->nb_colonnes == graphique->limite)
+    fusionnerColonnes(graphique);
+  // Nouvelle colonne
+  if (!graphique->nb_colonnes ||
+      graphique->tours_derniere_colonne == graphique->tours_par_colonne) {
+    graphique->nb_colonnes++;
+    graphique->tours_derniere_colonne = 0;
+  }
+  struct Statistique *colonne = &graphique->colonnes[graphique->nb_colonnes - 1];
+  colonne->nb_IMMUNISE += stats.nb_IMMUNISE;
+  colonne->nb_SAIN += stats.nb_SAIN;
+  colonne->nb_MORT += stats.nb_MORT;
+  colonne->nb_MALADE += stats.nb_MALADE;
+  colonne->nb_INCUBE += stats.nb_INCUBE;
+  colonne->nb_VACCINE += stats.nb_VACCINE;
+  graphique->tours_derniere_colonne++;
+}
+
+/**
+ * @brief Ecrit le graphique dans file, en une seule écriture.
+ *
+ * Même lecture que graphique() :
+ * - IMMUNISE = '*', VACCINE = '$', SAIN = '.', INCUBE = 'u', MALADE = 'o',
+ *   MORT = ' '.
+ *
+ * @param graphique Graphique.
+ * @param file Fichier (stdout pour le terminal).
+ * @param couleur Booléen, si les caractères sont colorés (terminal).
+ */
+void rendreGraphiqueFlux(struct GraphiqueFlux *graphique, FILE *file,
+                         char couleur) {
+  const unsigned long hauteur = graphique->hauteur;
+  const unsigned long limite = graphique->limite;
+  const unsigned long pop_tot = graphique->population_totale;
+  // Caractère de chaque case, ' ' par défaut
+  const char *cases_couleur[] = {"\e[33m$\e[0m", "\e[33m*\e[0m", ".",
+                                 "\e[31mo\e[0m", "\e[35mu\e[0m"};
+  const char cases[] = {'$', '*', '.', 'o', 'u'};
+  char *rendu = graphique->rendu;
+  unsigned long taille = 0;
+
+  for (unsigned long ligne = 0; ligne < hauteur; ligne++) {
+    for (unsigned long j = 0; j < limite; j++) {
+      int etat = -1;
+      if (j < graphique->nb_colonnes && pop_tot) {
+        const struct Statistique *colonne = &graphique->colonnes[j];
+        const unsigned long tours = j == graphique->nb_colonnes - 1
+                                        ? graphique->tours_derniere_colonne
+                                        : graphique->tours_par_colonne;
+        // Ratio normalizé, dans l'ordre d'empilement de graphique()
+        const long sommes[] = {colonne->nb_VACCINE, colonne->nb_IMMUNISE,
+                               colonne->nb_SAIN, colonne->nb_MALADE,
+                               colonne->nb_INCUBE};
+        unsigned long curseur = 0;
+        for (int e = 0; e < 5 && etat < 0; e++) {
+          curseur += sommes[e] * hauteur / tours / pop_tot;
+          if (ligne < curseur) etat = e;
+        }
+      }
+      if (etat < 0) {
+        rendu[taille++] = ' ';
+      } else if (couleur) {
+        const size_t longueur = strlen(cases_couleur[etat]);
+        memcpy(rendu + taille, cases_couleur[etat], longueur);
+        taille += longueur;
+      } else {
+        rendu[taille++] = cases[etat];
+      }
+    }
+    rendu[taille++] = '\n';
+  }
+  fwrite(rendu, 1, taille, file);
+}
+
+/**
+ * @brief Exporte le graphique (sans couleur) dans fichier_graph.
+ *
+ * @param graphique Graphique.
+ * @param fichier_graph Nom du fichier à écrire.
+ */
+void exporterGraphiqueFlux(struct GraphiqueFlux *graphique,
+                           const char *fichier_graph) {
+  FILE *file = fopen(fichier_graph, "w");
+  if (!file) {
+    printf("Erreur: Le fichier n'a pas pu être ouvert.\n");
+    exit(1);
+  }
+  rendreGraphiqueFlux(graphique, file, 0);
+  fclose(file);
+}
+
+/**
+ * @brief Libère le graphique.
+ *
+ * @param graphique Graphique.
+ */
+void detruireGraphiqueFlux(struct GraphiqueFlux *graphique) {
+  free(graphique->colonnes);
+  free(graphique->rendu);
+  free(graphique);
+}
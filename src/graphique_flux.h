@@ -0,0 +1,61 @@
+#if !defined(GRAPHIQUE_FLUX_H)
+#define GRAPHIQUE_FLUX_H
+
+#include <stdio.h>
+
+#include "statistique.h"
+
+/**
+ * @brief Graphique ASCII construit au fil des tours.
+ *
+ * Chaque colonne cumule tours_par_colonne Statistique. Quand les limite
+ * colonnes sont pleines, les colonnes sont fusionnées deux à deux : la
+ * mémoire ne dépend pas de la durée de la simulation.
+ */
+struct GraphiqueFlux {
+  /**
+   * @brief Hauteur du graphique.
+   */
+  unsigned long hauteur;
+  /**
+   * @brief Nombre maximum de colonnes.
+   */
+  unsigned long limite;
+  /**
+   * @brief Population totale, pour normaliser.
+   */
+  unsigned long population_totale;
+  /**
+   * @brief Nombre de tours cumulés dans une colonne pleine.
+   */
+  unsigned long tours_par_colonne;
+  /**
+   * @brief Nombre de colonnes commencées.
+   */
+  unsigned long nb_colonnes;
+  /**
+   * @brief Nombre de tours cumulés dans la dernière colonne.
+   */
+  unsigned long tours_derniere_colonne;
+  /**
+   * @brief Sommes des Statistique de chaque colonne (limite cases).
+   */
+  struct Statistique *colonnes;
+  /**
+   * @brief Tampon de rendu (hauteur lignes de limite caractères colorés).
+   */
+  char *rendu;
+};
+
+struct GraphiqueFlux *creerGraphiqueFlux(unsigned long hauteur,
+                                         unsigned long limite,
+                                         unsigned long population_totale);
+void ajouterGraphiqueFlux(struct GraphiqueFlux *graphique,
+                          struct Statistique stats);
+void rendreGraphiqueFlux(struct GraphiqueFlux *graphique, FILE *file,
+                         char couleur);
+void exporterGraphiqueFlux(struct GraphiqueFlux *graphique,
+                           const char *fichier_graph);
+void detruireGraphiqueFlux(struct GraphiqueFlux *graphique);
+
+#endif  // GRAPHIQUE_FLUX_H
@@ -0,0 +1,531 @@
+/**
+ * @file hors_memoire.c
+ *
+ * @brief Moteur hors mémoire : grilles plus grandes que la RAM.
+ *
+ * Les deux grilles (tour t, tour t+1) sont des fichiers projetés en mémoire
+ * (mmap partagé) et parcourues ligne par ligne. La ligne i ne lit que les
+ * lignes i-1, i et i+1 du tour t : par bandes de lignes, la bande suivante
+ * est préchargée (MADV_WILLNEED) et les lignes qui ne seront plus lues ni
+ * écrites pendant ce tour sont rendues (MADV_DONTNEED ; le noyau Linux
+ * écrit les pages modifiées dans le fichier). La mémoire résidente reste de
+ * l'ordre d'une fenêtre de lignes : le débit est borné par le disque, pas
+ * par la RAM. L'ancien contenu du fichier du tour t+1 est effacé en début de
+ * tour (FALLOC_FL_PUNCH_HOLE) : ses pages ne sont pas relues avant d'être
+ * réécrites.
+ *
+ * Comme le tampon du noyau, la grille du tour t+1 est une copie du tour t
+ * modifiée au fil du parcours : chaque ligne y est recopiée
+ * cordon_sanitaire lignes en avance, avant que la quarantaine puisse
+ * l'atteindre.
+ *
+ * Différences avec jouerTourParametres :
+ * - la quarantaine est limitée à la boîte du cordon (cordon_sanitaire cases
+ *   autour du MALADE dans chaque direction), même en suivant une chaîne de
+ *   MALADE ou de MORT : elle reste dans la fenêtre ;
+ * - une case garde le tour de levée de sa quarantaine, pas sa zone ;
+ * - pas de rasters.
+ * Sans quarantaine, mêmes tirages dans le même ordre : même trajectoire que
+ * jouerTourParametres pour une même graine.
+ *
+ * Usage:
+ * ```
+ * struct HorsMemoire *hors_memoire =
+ *     creerHorsMemoire("grille.bin", 1000000, &parametres, 256 << 20);
+ * infecterHorsMemoire(hors_memoire, 500000, 500000);
+ * for (...) jouerTourHorsMemoire(hors_memoire, &aleatoire);
+ * detruireHorsMemoire(hors_memoire);  // grille.bin : dernier tour
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#define _GNU_SOURCE  // fallocate
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "hors_memoire.h"
+
+/**
+ * @brief Nombre d'états.
+ */
+#define NB_ETATS (VACCINE + 1)
+
+/**
+ * @brief Suffixe du fichier de la grille du tour suivant.
+ */
+#define SUFFIXE_SUIVANT ".suivant"
+
+/**
+ * @brief Ajoute delta à l'effectif d'un état.
+ *
+ * @param statistique Statistique.
+ * @param state Etat.
+ * @param delta +1 ou -1.
+ */
+static void compter(struct Statistique *statistique, enum State state,
+                    long delta) {
+  switch (state) {
+    case SAIN:
+      statistique->nb_SAIN += delta;
+      break;
+    case MALADE:
+      statistique->nb_MALADE += delta;
+      break;
+    case MORT:
+      statistique->nb_MORT += delta;
+      break;
+    case IMMUNISE:
+      statistique->nb_IMMUNISE += delta;
+      break;
+    case INCUBE:
+      statistique->nb_INCUBE += delta;
+      break;
+    case VACCINE:
+      statistique->nb_VACCINE += delta;
+      break;
+  }
+}
+
+/**
+ * @brief Conseille le noyau Linux sur les lignes [debut, fin) d'une grille.
+ *
+ * MADV_WILLNEED élargit la plage aux pages qui la touchent ; MADV_DONTNEED
+ * la réduit aux pages qu'elle contient entièrement.
+ *
+ * @param hors_memoire Moteur.
+ * @param grille Grille projetée.
+ * @param debut Première ligne.
+ * @param fin Ligne suivant la dernière (bornée par cote).
+ * @param conseil MADV_WILLNEED ou MADV_DONTNEED.
+ */
+static void conseillerLignes(const struct HorsMemoire *hors_memoire,
+                             struct CaseDisque *grille, unsigned long debut,
+                             unsigned long fin, int conseil) {
+  const unsigned long cote = hors_memoire->cote;
+  if (fin > cote) fin = cote;
+  if (debut >= fin) return;
+  const unsigned long page = (unsigned long)sysconf(_SC_PAGESIZE);
+  const unsigned long ligne = cote * sizeof(struct CaseDisque);
+  unsigned long a = debut * ligne, b = fin * ligne;
+  if (conseil == MADV_DONTNEED) {
+    a = (a + page - 1) / page * page;
+    b = b / page * page;
+  } else {
+    a = a / page * page;
+  }
+  if (a < b) madvise((char *)grille + a, b - a, conseil);
+}
+
+/**
+ * @brief Ouvre (en le vidant) un fichier de grille et le projette.
+ *
+ * @param hors_memoire Moteur.
+ * @param g Indice de la grille.
+ * @return int 0, -1 si le fichier n'a pas pu être créé ou projeté.
+ */
+static int ouvrirGrille(struct HorsMemoire *hors_memoire, int g) {
+  const size_t taille =
+      hors_memoire->cote * hors_memoire->cote * sizeof(struct CaseDisque);
+  const int descripteur =
+      open(hors_memoire->fichiers[g], O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (descripteur < 0) return -1;
+  // Fichier creux : des zéros, soit une grille SAIN sans quarantaine
+  void *grille = ftruncate(descripteur, (off_t)taille)
+                     ? MAP_FAILED
+                     : mmap(NULL, taille, PROT_READ | PROT_WRITE, MAP_SHARED,
+                            descripteur, 0);
+  if (grille == MAP_FAILED) {
+    close(descripteur);
+    return -1;
+  }
+  madvise(grille, taille, MADV_SEQUENTIAL);
+  hors_memoire->descripteurs[g] = descripteur;
+  hors_memoire->grilles[g] = (struct CaseDisque *)grille;
+  return 0;
+}
+
+/**
+ * @brief Vrai si le moteur s'applique : l'incubation tient sur 16 bits.
+ *
+ * @param parametres Paramètres de la simulation.
+ * @return char Booléen.
+ */
+char horsMemoireCompatible(const struct Parametres *parametres) {
+  return parametres->duree_incube <= UINT16_MAX &&
+         parametres->cordon_sanitaire >= 0;
+}
+
+/**
+ * @brief Créer le moteur et ses deux fichiers : une grille SAIN.
+ *
+ * Les fichiers fichier et fichier.suivant sont créés (ou vidés) ; ils ne
+ * sont écrits qu'au fil des tours, sans occuper la RAM.
+ *
+ * @param fichier Chemin de la grille.
+ * @param cote Longueur d'un côté de la grille.
+ * @param parametres Paramètres (copiés).
+ * @param octets_fenetre Mémoire visée pour une bande de lignes des deux
+ * grilles (au moins une ligne).
+ * @return struct HorsMemoire* Moteur, NULL si les fichiers n'ont pas pu être
+ * créés ou si horsMemoireCompatible refuse les paramètres.
+ */
+struct HorsMemoire *creerHorsMemoire(const char *fichier, unsigned long cote,
+                                     const struct Parametres *parametres,
+                                     unsigned long octets_fenetre) {
+  if (!cote || !horsMemoireCompatible(parametres)) return NULL;
+  struct HorsMemoire *hors_memoire =
+      (struct HorsMemoire *)malloc(sizeof(struct HorsMemoire));
+  hors_memoire->parametres = *parametres;
+  hors_memoire->cote = cote;
+  hors_memoire->tour = 0;
+  hors_memoire->courant = 0;
+  hors_memoire->lignes_bande =
+      octets_fenetre / (2 * cote * sizeof(struct CaseDisque));
+  if (!hors_memoire->lignes_bande) hors_memoire->lignes_bande = 1;
+  hors_memoire->fichiers[0] = (char *)malloc(strlen(fichier) + 1);
+  strcpy(hors_memoire->fichiers[0], fichier);
+  hors_memoire->fichiers[1] =
+      (char *)malloc(strlen(fichier) + sizeof(SUFFIXE_SUIVANT));
+  sprintf(hors_memoire->fichiers[1], "%s%s", fichier, SUFFIXE_SUIVANT);
+  const unsigned long boite =
+      2 * (unsigned long)parametres->cordon_sanitaire + 1;
+  hors_memoire->passages =
+      (uint32_t *)calloc(boite * boite, sizeof(uint32_t));
+  hors_memoire->cordons = (int *)malloc(boite * boite * sizeof(int));
+  hors_memoire->remplissage = 0;
+  if (!hors_memoire->passages || !hors_memoire->cordons) {
+    printf("Erreur: Hors mémoire, plus de mémoire.\n");
+    exit(1);
+  }
+  if (ouvrirGrille(hors_memoire, 0)) {
+    hors_memoire->grilles[0] = NULL;
+    hors_memoire->grilles[1] = NULL;
+    detruireHorsMemoire(hors_memoire);
+    return NULL;
+  }
+  if (ouvrirGrille(hors_memoire, 1)) {
+    hors_memoire->grilles[1] = NULL;
+    unlink(hors_memoire->fichiers[0]);
+    detruireHorsMemoire(hors_memoire);
+    return NULL;
+  }
+  memset(&hors_memoire->statistique, 0, sizeof(struct Statistique));
+  hors_memoire->statistique.nb_SAIN = (long)(cote * cote);
+  return hors_memoire;
+}
+
+/**
+ * @brief Patient zero : la case (x, y) devient MALADE.
+ *
+ * @param hors_memoire Moteur.
+ * @param x
+ * @param y
+ */
+void infecterHorsMemoire(struct HorsMemoire *hors_memoire, unsigned long x,
+                         unsigned long y) {
+  struct CaseDisque *personne =
+      &hors_memoire->grilles[hors_memoire->courant][x * hors_memoire->cote +
+                                                    y];
+  compter(&hors_memoire->statistique, (enum State)personne->state, -1);
+  compter(&hors_memoire->statistique, MALADE, 1);
+  personne->state = MALADE;
+}
+
+/**
+ * @brief Recopie une Population (même cote) dans la grille courante.
+ *
+ * Le tour et la fin de quarantaine de chaque case (expiration de sa zone)
+ * sont repris.
+ *
+ * @param hors_memoire Moteur.
+ * @param population Population.
+ * @return int 0, -1 si les cotes diffèrent ou si une incubation dépasse 16
+ * bits.
+ */
+int chargerHorsMemoire(struct HorsMemoire *hors_memoire,
+                       const struct Population *population) {
+  const unsigned long cote = hors_memoire->cote;
+  if (population->cote != cote) return -1;
+  struct CaseDisque *grille = hors_memoire->grilles[hors_memoire->courant];
+  long effectifs[NB_ETATS] = {0};
+  for (unsigned long k = 0; k < cote * cote; k++) {
+    const struct Personne *personne = &population->personnes[k];
+    if (personne->duree_incube < 0 || personne->duree_incube > UINT16_MAX)
+      return -1;
+    grille[k].state = (uint16_t)personne->state;
+    grille[k].duree_incube = (uint16_t)personne->duree_incube;
+    grille[k].fin_quarantaine =
+        (uint32_t)population->zones.expirations[personne->zone];
+    effectifs[personne->state]++;
+  }
+  hors_memoire->tour = population->tour;
+  struct Statistique statistique = {
+      effectifs[IMMUNISE], effectifs[SAIN],   effectifs[MORT],
+      effectifs[MALADE],   effectifs[INCUBE], effectifs[VACCINE]};
+  hors_memoire->statistique = statistique;
+  return 0;
+}
+
+/**
+ * @brief Met la case (x, y) en quarantaine et étend le cordon, dans la boîte
+ * du cordon autour de (ox, oy) seulement.
+ *
+ * Même parcours (nord, sud, ouest, est) et même marquage que
+ * mettreEnQuarantaineRaster, sur la grille du tour suivant.
+ *
+ * @param hors_memoire Moteur.
+ * @param suivante Grille du tour suivant.
+ * @param x
+ * @param y
+ * @param ox, oy MALADE à l'origine de la quarantaine.
+ * @param cordon_sanitaire Distance restante du cordon.
+ * @param fin Tour de levée de la quarantaine.
+ */
+static void quarantaine(struct HorsMemoire *hors_memoire,
+                        struct CaseDisque *suivante, unsigned long x,
+                        unsigned long y, unsigned long ox, unsigned long oy,
+                        int cordon_sanitaire, uint32_t fin) {
+  const unsigned long cote = hors_memoire->cote;
+  const long rayon = hors_memoire->parametres.cordon_sanitaire;
+  const unsigned long largeur = 2 * (unsigned long)rayon + 1;
+  const unsigned long b = (x + rayon - ox) * largeur + (y + rayon - oy);
+  hors_memoire->passages[b] = hors_memoire->remplissage;
+  hors_memoire->cordons[b] = cordon_sanitaire;
+  suivante[x * cote + y].fin_quarantaine = fin;
+
+  // Voisins nord, sud, ouest, est ; décalage dans la boîte
+  const long dx[4] = {-1, 1, 0, 0}, dy[4] = {0, 0, -1, 1};
+  for (int v = 0; v < 4; v++) {
+    const long nx = (long)x + dx[v], ny = (long)y + dy[v];
+    if (nx < 0 || ny < 0 || nx >= (long)cote || ny >= (long)cote) continue;
+    if (labs(nx - (long)ox) > rayon || labs(ny - (long)oy) > rayon) continue;
+    const unsigned long nb = (unsigned long)(nx + rayon - (long)ox) * largeur +
+                             (unsigned long)(ny + rayon - (long)oy);
+    const int marque = hors_memoire->passages[nb] == hors_memoire->remplissage
+                           ? hors_memoire->cordons[nb]
+                           : 0;
+    if (marque >= cordon_sanitaire) continue;
+    const uint16_t state = suivante[nx * (long)cote + ny].state;
+    if (state == MALADE || state == MORT)
+      quarantaine(hors_memoire, suivante, (unsigned long)nx,
+                  (unsigned long)ny, ox, oy, cordon_sanitaire, fin);
+    else if (cordon_sanitaire > 0)
+      quarantaine(hors_memoire, suivante, (unsigned long)nx,
+                  (unsigned long)ny, ox, oy, cordon_sanitaire - 1, fin);
+  }
+}
+
+/**
+ * @brief Joue la ligne i, avec les tirages du noyau.
+ *
+ * @param hors_memoire Moteur.
+ * @param grille Grille du tour courant.
+ * @param suivante Grille du tour suivant (ligne i déjà recopiée).
+ * @param i Ligne.
+ * @param present Tour avant ce tour.
+ * @param aleatoire Générateur.
+ */
+static void jouerLigne(struct HorsMemoire *hors_memoire,
+                       const struct CaseDisque *grille,
+                       struct CaseDisque *suivante, unsigned long i,
+                       unsigned long present, struct Aleatoire *aleatoire) {
+  const unsigned long cote = hors_memoire->cote;
+  const struct Parametres *parametres = &hors_memoire->parametres;
+  // Levée des quarantaines de ce tour (les plus anciennes sont levées avant)
+  const uint32_t fin = (uint32_t)(present + 1 + parametres->duree_quarantaine);
+  for (unsigned long j = 0; j < cote; j++) {
+    const unsigned long k = i * cote + j;
+    const struct CaseDisque *personne = &grille[k];
+    // Déjà en quarantaine et remise en quarantaine avant son passage : un
+    // tour de moins, comme raccourcirZone
+    if (suivante[k].fin_quarantaine == fin &&
+        personne->fin_quarantaine > present)
+      suivante[k].fin_quarantaine = fin - 1;
+    const unsigned long voisins[4] = {k - 1, k + 1, k - cote, k + cote};
+    const char existe[4] = {j > 0, j < cote - 1, i > 0, i < cote - 1};
+    switch (personne->state) {
+      case SAIN:
+      case IMMUNISE: {
+        // Vaccination par découverte du vaccin (pas de tirage si nulle)
+        if (parametres->chance_decouverte_vaccin > 0 &&
+            aleatoireUniforme(aleatoire) <
+                parametres->chance_decouverte_vaccin) {
+          suivante[k].state = VACCINE;
+          break;
+        }
+        // Vaccination par propagation
+        char vaccine = 0;
+        for (int v = 0; v < 4; v++)
+          vaccine |= existe[v] && grille[voisins[v]].state == VACCINE;
+        if (vaccine) {
+          suivante[k].state = VACCINE;
+          break;
+        }
+        if (personne->state == IMMUNISE) break;
+
+        // Infection : voisins contagieux ensemble (libres ou en quarantaine)
+        const char libre = personne->fin_quarantaine <= present;
+        int voisin = 0;
+        for (int v = 0; v < 4; v++) {
+          if (!existe[v]) continue;
+          const struct CaseDisque *autre = &grille[voisins[v]];
+          voisin += (autre->state == MALADE || autre->state == INCUBE) &&
+                    (autre->fin_quarantaine <= present) == libre;
+        }
+        for (; voisin > 0; voisin--) {
+          if (aleatoireUniforme(aleatoire) < parametres->lambda) {
+            suivante[k].state = INCUBE;
+            suivante[k].duree_incube = (uint16_t)parametres->duree_incube;
+            break;
+          }
+        }
+        break;
+      }
+
+      case MALADE:
+        if (parametres->chance_quarantaine > 0 &&
+            aleatoireUniforme(aleatoire) < parametres->chance_quarantaine &&
+            suivante[k].fin_quarantaine <= present + 1) {
+          if (!++hors_memoire->remplissage) {
+            // Numéros épuisés : marques remises à zéro
+            const unsigned long largeur =
+                2 * (unsigned long)parametres->cordon_sanitaire + 1;
+            memset(hors_memoire->passages, 0,
+                   largeur * largeur * sizeof(uint32_t));
+            hors_memoire->remplissage = 1;
+          }
+          quarantaine(hors_memoire, suivante, i, j, i, j,
+                      parametres->cordon_sanitaire, fin);
+        }
+        if (aleatoireUniforme(aleatoire) < parametres->beta) {
+          suivante[k].state = MORT;
+          break;
+        }
+        if (aleatoireUniforme(aleatoire) < parametres->gamma)
+          suivante[k].state = IMMUNISE;
+        break;
+
+      case INCUBE:
+        if (personne->duree_incube == 0)
+          suivante[k].state = MALADE;
+        else
+          suivante[k].duree_incube--;
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+/**
+ * @brief Faire passer la grille du temps t au temps t+1, bande par bande.
+ *
+ * @param hors_memoire Moteur.
+ * @param aleatoire Générateur aléatoire propre à la simulation.
+ */
+void jouerTourHorsMemoire(struct HorsMemoire *hors_memoire,
+                          struct Aleatoire *aleatoire) {
+  const unsigned long cote = hors_memoire->cote;
+  const unsigned long rayon =
+      (unsigned long)hors_memoire->parametres.cordon_sanitaire;
+  const unsigned long bande = hors_memoire->lignes_bande;
+  const size_t ligne = cote * sizeof(struct CaseDisque);
+  struct CaseDisque *grille = hors_memoire->grilles[hors_memoire->courant];
+  struct CaseDisque *suivante =
+      hors_memoire->grilles[1 - hors_memoire->courant];
+  const unsigned long present = hors_memoire->tour;
+  long effectifs[NB_ETATS] = {0};
+  // Ancien contenu du tour t+1 : trous, sans relecture (ignoré si le système
+  // de fichiers ne sait pas)
+  fallocate(hors_memoire->descripteurs[1 - hors_memoire->courant],
+            FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, 0,
+            (off_t)(cote * ligne));
+
+  unsigned long recopiees = 0;  // Lignes du tour t recopiées dans suivante
+  conseillerLignes(hors_memoire, grille, 0, bande + rayon + 1, MADV_WILLNEED);
+  for (unsigned long debut = 0; debut < cote; debut += bande) {
+    const unsigned long fin = debut + bande < cote ? debut + bande : cote;
+    // Bande suivante en lecture anticipée pendant le jeu de celle-ci
+    conseillerLignes(hors_memoire, grille, fin + rayon + 1,
+                     fin + bande + rayon + 1, MADV_WILLNEED);
+    for (unsigned long i = debut; i < fin; i++) {
+      // La quarantaine de la ligne i atteint au plus la ligne i + rayon
+      for (; recopiees < cote && recopiees <= i + rayon; recopiees++)
+        memcpy(suivante + recopiees * cote, grille + recopiees * cote,
+               ligne);
+      jouerLigne(hors_memoire, grille, suivante, i, present, aleatoire);
+      // Etats de la ligne i définitifs (la quarantaine ne change pas d'état)
+      for (unsigned long j = 0; j < cote; j++)
+        effectifs[suivante[i * cote + j].state]++;
+    }
+    // Plus lues : lignes avant fin - 1 du tour t, avant fin - rayon du
+    // tour t+1
+    conseillerLignes(hors_memoire, grille, 0, fin - 1, MADV_DONTNEED);
+    if (fin > rayon)
+      conseillerLignes(hors_memoire, suivante, 0, fin - rayon, MADV_DONTNEED);
+  }
+
+  hors_memoire->tour++;
+  hors_memoire->courant = 1 - hors_memoire->courant;
+  struct Statistique statistique = {
+      effectifs[IMMUNISE], effectifs[SAIN],   effectifs[MORT],
+      effectifs[MALADE],   effectifs[INCUBE], effectifs[VACCINE]};
+  hors_memoire->statistique = statistique;
+}
+
+/**
+ * @brief Grille du tour courant (projetée, cote x cote cases).
+ *
+ * @param hors_memoire Moteur.
+ * @return const struct CaseDisque* Grille.
+ */
+const struct CaseDisque *getGrilleHorsMemoire(
+    const struct HorsMemoire *hors_memoire) {
+  return hors_memoire->grilles[hors_memoire->courant];
+}
+
+/**
+ * @brief Statistique du tour courant, sans parcours de la grille.
+ *
+ * @param hors_memoire Moteur.
+ * @return struct Statistique Statistique.
+ */
+struct Statistique getStatistiqueHorsMemoire(
+    const struct HorsMemoire *hors_memoire) {
+  return hors_memoire->statistique;
+}
+
+/**
+ * @brief Libère le moteur : le fichier garde la grille du dernier tour, le
+ * fichier .suivant est supprimé.
+ *
+ * @param hors_memoire Moteur.
+ */
+void detruireHorsMemoire(struct HorsMemoire *hors_memoire) {
+  const size_t taille =
+      hors_memoire->cote * hors_memoire->cote * sizeof(struct CaseDisque);
+  for (int g = 0; g < 2; g++) {
+    if (!hors_memoire->grilles[g]) continue;
+    munmap(hors_memoire->grilles[g], taille);
+    close(hors_memoire->descripteurs[g]);
+  }
+  if (hors_memoire->grilles[0] && hors_memoire->grilles[1]) {
+    if (hors_memoire->courant)
+      rename(hors_memoire->fichiers[1], hors_memoire->fichiers[0]);
+    else
+      unlink(hors_memoire->fichiers[1]);
+  }
+  free(hors_memoire->fichiers[0]);
+  free(hors_memoire->fichiers[1]);
+  free(hors_memoire->passages);
+  free(hors_memoire->cordons);
+  free(hors_memoire);
+}
@@ -0,0 +1,115 @@
+#if !defined(HORS_MEMOIRE_H)
+#define HORS_MEMOIRE_H
+
+#include <stdint.h>
+
+#include "aleatoire.h"
+#include "jouer_un_tour.h"
+#include "population.h"
+#include "statistique.h"
+
+/**
+ * @brief Fenêtre de lignes par défaut, en octets.
+ */
+#define FENETRE_HORS_MEMOIRE (256UL << 20)
+
+/**
+ * @brief Case d'une grille sur disque (8 octets, sans pointeur).
+ *
+ * Un fichier de grille est la suite des cote x cote cases, ligne par ligne,
+ * sans entête. Un fichier creux (zéros) est une grille SAIN sans quarantaine.
+ */
+struct CaseDisque {
+  /**
+   * @brief enum State.
+   */
+  uint16_t state;
+  /**
+   * @brief Tours d'incubation restants.
+   */
+  uint16_t duree_incube;
+  /**
+   * @brief Tour de levée de la quarantaine (en quarantaine si tour < fin).
+   */
+  uint32_t fin_quarantaine;
+};
+
+/**
+ * @brief Moteur hors mémoire : grilles dans des fichiers projetés (mmap),
+ * parcourues par bandes de lignes.
+ *
+ * Le tour t est lu dans un fichier et le tour t+1 écrit dans l'autre, puis
+ * les rôles sont échangés. Seule une fenêtre de lignes autour de la ligne
+ * jouée est gardée en mémoire : la bande suivante est préchargée, les lignes
+ * déjà jouées sont rendues au noyau Linux.
+ */
+struct HorsMemoire {
+  /**
+   * @brief Paramètres (copie).
+   */
+  struct Parametres parametres;
+  /**
+   * @brief Longueur d'un côté de la grille.
+   */
+  unsigned long cote;
+  /**
+   * @brief Tour courant.
+   */
+  unsigned long tour;
+  /**
+   * @brief Chemins des deux fichiers de grille : fichier, puis
+   * fichier.suivant.
+   */
+  char *fichiers[2];
+  /**
+   * @brief Descripteurs des deux fichiers.
+   */
+  int descripteurs[2];
+  /**
+   * @brief Projections des deux fichiers.
+   */
+  struct CaseDisque *grilles[2];
+  /**
+   * @brief Indice de la grille du tour courant dans grilles.
+   */
+  int courant;
+  /**
+   * @brief Lignes par bande (préchargement et libération).
+   */
+  unsigned long lignes_bande;
+  /**
+   * @brief Marques du remplissage en cours dans la boîte du cordon :
+   * passage vaut remplissage si la case a été mise dans la zone.
+   */
+  uint32_t *passages;
+  /**
+   * @brief Cordon de chaque case de la boîte, valide si passages l'est.
+   */
+  int *cordons;
+  /**
+   * @brief Numéro du remplissage en cours.
+   */
+  uint32_t remplissage;
+  /**
+   * @brief Statistique du tour courant, comptée pendant le parcours.
+   */
+  struct Statistique statistique;
+};
+
+char horsMemoireCompatible(const struct Parametres *parametres);
+struct HorsMemoire *creerHorsMemoire(const char *fichier, unsigned long cote,
+                                     const struct Parametres *parametres,
+                                     unsigned long octets_fenetre);
+void infecterHorsMemoire(struct HorsMemoire *hors_memoire, unsigned long x,
+                         unsigned long y);
+int chargerHorsMemoire(struct HorsMemoire *hors_memoire,
+                       const struct Population *population);
+void jouerTourHorsMemoire(struct HorsMemoire *hors_memoire,
+                          struct Aleatoire *aleatoire);
+const struct CaseDisque *getGrilleHorsMemoire(
+    const struct HorsMemoire *hors_memoire);
+struct Statistique getStatistiqueHorsMemoire(
+    const struct HorsMemoire *hors_memoire);
+void detruireHorsMemoire(struct HorsMemoire *hors_memoire);
+
+#endif  // HORS_MEMOIRE_H
@@ -6,6 +6,8 @@
  * Fonctionnalités :
  * - Détecteur de zombie.
  * - jouerTour lancer un tour.
+ * - jouerTourParametres lancer un tour (réentrant).
+ * - Choisir la variante du noyau selon les extensions utilisées.
  * - Mettre en quarantaine
  *
  * Usage pour jouer un jeu complet:
@@ -58,18 +60,129 @@ char zombiePresent(struct Population *population) {
   unsigned long cote = population->cote;
   for (unsigned long i = 0; i < cote; i++) {
     for (unsigned long j = 0; j < cote; j++) {
-      if (population->grille_de_personnes[i][j]->state == MALADE ||
-          population->grille_de_personnes[i][j]->state == INCUBE)
+      if (population->grille_de_personnes[i][j].state == MALADE ||
+          population->grille_de_personnes[i][j].state == INCUBE)
         return 1;
     }
   }
   return 0;
 }
 
+/**
+ * @brief Marquage du parcours : cordon_sanitaire d'une case déjà mise dans la
+ * zone, 0 sinon.
+ *
+ * Le cordon d'une case hors de la zone est périmé : il n'y a rien à remettre
+ * à zéro avant une nouvelle mise en quarantaine.
+ *
+ * @param personne Personne.
+ * @param zone Zone en cours de mise en quarantaine.
+ * @return int Marque.
+ */
+static inline int marque(const struct Personne *personne, uint32_t zone) {
+  return personne->zone == zone ? personne->cordon_sanitaire : 0;
+}
+
+/**
+ * @brief Partie récursive de mettreEnQuarantaineRaster.
+ *
+ * @param grille_de_personnes Grille de personnes au temps t.
+ * @param x
+ * @param y
+ * @param cote Longueur d'un côté de la grille de personnes
+ * @param cordon_sanitaire Distance entre un malade et la personne.
+ * @param zone Zone de quarantaine (creerZone).
+ * @param raster_quarantaine Raster RASTER_QUARANTAINE, ou NULL.
+ * @param tour Tour écrit dans le raster.
+ */
+static void quarantaineRecurse(struct Personne **grille_de_personnes,
+                               unsigned long x, unsigned long y,
+                               unsigned long cote, int cordon_sanitaire,
+                               uint32_t zone, uint16_t *raster_quarantaine,
+                               uint16_t tour) {
+  if (raster_quarantaine && raster_quarantaine[x * cote + y] == RASTER_JAMAIS)
+    raster_quarantaine[x * cote + y] = tour;
+  grille_de_personnes[x][y].zone = zone;
+  grille_de_personnes[x][y].cordon_sanitaire = cordon_sanitaire;
+
+  // Mettre en quarantaine les personnes adjacentes
+  // NORD
+  if (x > 0 &&
+      marque(&grille_de_personnes[x - 1][y], zone) < cordon_sanitaire) {
+    // Si la personne est MALADE ou MORT, on le met en quarantaine
+    if (grille_de_personnes[x - 1][y].state == MALADE ||
+        grille_de_personnes[x - 1][y].state == MORT)
+      quarantaineRecurse(grille_de_personnes, x - 1, y, cote,
+                         cordon_sanitaire, zone, raster_quarantaine, tour);
+    // La personne est peut-être incubé, on le met dans le cordon_sanitaire
+    else if (cordon_sanitaire > 0)
+      quarantaineRecurse(grille_de_personnes, x - 1, y, cote,
+                         cordon_sanitaire - 1, zone, raster_quarantaine, tour);
+  }
+  // SUD
+  if (x < cote - 1 &&
+      marque(&grille_de_personnes[x + 1][y], zone) < cordon_sanitaire) {
+    if (grille_de_personnes[x + 1][y].state == MALADE ||
+        grille_de_personnes[x + 1][y].state == MORT)
+      quarantaineRecurse(grille_de_personnes, x + 1, y, cote,
+                         cordon_sanitaire, zone, raster_quarantaine, tour);
+    else if (cordon_sanitaire > 0)
+      quarantaineRecurse(grille_de_personnes, x + 1, y, cote,
+                         cordon_sanitaire - 1, zone, raster_quarantaine, tour);
+  }
+  // OUEST
+  if (y > 0 &&
+      marque(&grille_de_personnes[x][y - 1], zone) < cordon_sanitaire) {
+    if (grille_de_personnes[x][y - 1].state == MALADE ||
+        grille_de_personnes[x][y - 1].state == MORT)
+      quarantaineRecurse(grille_de_personnes, x, y - 1, cote,
+                         cordon_sanitaire, zone, raster_quarantaine, tour);
+    else if (cordon_sanitaire > 0)
+      quarantaineRecurse(grille_de_personnes, x, y - 1, cote,
+                         cordon_sanitaire - 1, zone, raster_quarantaine, tour);
+  }
+  // EST
+  if (y < cote - 1 &&
+      marque(&grille_de_personnes[x][y + 1], zone) < cordon_sanitaire) {
+    if (grille_de_personnes[x][y + 1].state == MALADE ||
+        grille_de_personnes[x][y + 1].state == MORT)
+      quarantaineRecurse(grille_de_personnes, x, y + 1, cote,
+                         cordon_sanitaire, zone, raster_quarantaine, tour);
+    else if (cordon_sanitaire > 0)
+      quarantaineRecurse(grille_de_personnes, x, y + 1, cote,
+                         cordon_sanitaire - 1, zone, raster_quarantaine, tour);
+  }
+}
+
+/**
+ * @brief mettreEnQuarantaine, en notant le tour d'entrée dans le raster.
+ *
+ * @param grille_de_personnes Grille de personnes au temps t.
+ * @param x
+ * @param y
+ * @param cote Longueur d'un côté de la grille de personnes
+ * @param cordon_sanitaire Distance entre un malade et la personne.
+ * @param zone Zone de quarantaine neuve (creerZone).
+ * @param raster_quarantaine Raster RASTER_QUARANTAINE, ou NULL.
+ * @param tour Tour écrit dans le raster.
+ */
+void mettreEnQuarantaineRaster(struct Personne **grille_de_personnes,
+                               unsigned long x, unsigned long y,
+                               unsigned long cote, int cordon_sanitaire,
+                               uint32_t zone, uint16_t *raster_quarantaine,
+                               uint16_t tour) {
+  // Zone neuve : aucune case marquée, rien à remettre à zéro
+  quarantaineRecurse(grille_de_personnes, x, y, cote, cordon_sanitaire, zone,
+                     raster_quarantaine, tour);
+}
+
 /**
  * @brief Faire passer la population->grille_de_personnes du temps t au temps
  * t+1.
  *
+ * Tirages reproductibles par srand() : le générateur est ensemencé par
+ * rand() à chaque appel.
+ *
  * Usage pour jouer un jeu complet:
  * ```
  * unsigned long cote = 10;
@@ -110,136 +223,168 @@ void jouerTour(struct Population *population, double beta, double gamma,
                double lambda, double chance_quarantaine,
                double chance_decouverte_vaccin, unsigned int duree_incube,
                int cordon_sanitaire, unsigned int duree_quarantaine) {
-  const long unsigned cote = population->cote;
-  // On va modifier une population->grille_de_personnes tampon pour ne pas
-  // modifier la population->grille_de_personnes originale en cours de
-  // traitement.
-  struct Personne ***grille_tampon = clonerGrillePopulation(population);
-  double nb_aleatoire;
-  int voisin = 0;  // compteur de voisins.
-
-  // Alias
-  struct Personne ***grille = population->grille_de_personnes;
-
-  // Pour chaque case
-  for (long unsigned i = 0; i < cote; i++) {
-    for (long unsigned j = 0; j < cote; j++) {
-      // Réduire la durée de quarantaine
-      if (grille[i][j]->duree_quarantaine)
-        grille_tampon[i][j]->duree_quarantaine--;
+  const struct Parametres parametres = {
+      .beta = beta,
+      .gamma = gamma,
+      .lambda = lambda,
+      .chance_quarantaine = chance_quarantaine,
+      .chance_decouverte_vaccin = chance_decouverte_vaccin,
+      .duree_incube = duree_incube,
+      .cordon_sanitaire = cordon_sanitaire,
+      .duree_quarantaine = duree_quarantaine};
+  // API historique pilotée par srand()/rand() : un générateur local,
+  // ensemencé par rand() à chaque tour, sans état caché entre les appels.
+  struct Aleatoire aleatoire;
+  initAleatoire(&aleatoire, (uint64_t)rand());
+  jouerTourParametres(population, &parametres, &aleatoire);
+}
 
-      switch (grille[i][j]->state) {
-        case SAIN:
-          // Vaccination par découverte du vaccin
-          nb_aleatoire = (double)rand() / RAND_MAX;
-          if (nb_aleatoire < chance_decouverte_vaccin) {
-            grille_tampon[i][j]->state = VACCINE;
-            break;
-          }
+// Une variante du noyau par combinaison d'extensions (le modèle annule les
+// NOYAU_* après usage)
+#define NOYAU_NOM noyau
+#define NOYAU_QUARANTAINE 0
+#define NOYAU_VACCIN 0
+#define NOYAU_INCUBATION 0
+#include "jouer_un_tour_noyau.h"
 
-          // Vaccination par propagation
-          if ((j > 0 && grille[i][j - 1]->state == VACCINE) ||
-              (j < cote - 1 && grille[i][j + 1]->state == VACCINE) ||
-              (i > 0 && grille[i - 1][j]->state == VACCINE) ||
-              (i < cote - 1 && grille[i + 1][j]->state == VACCINE)) {
-            grille_tampon[i][j]->state = VACCINE;
-            break;
-          }
+#define NOYAU_NOM noyauQ
+#define NOYAU_QUARANTAINE 1
+#define NOYAU_VACCIN 0
+#define NOYAU_INCUBATION 0
+#include "jouer_un_tour_noyau.h"
 
-          // Infection
-          // La personne est MALADE s'il remplis :
-          // 1. Ils sont ensemble (en quarantaine ou libre)
-          // 2. Le/les voisins est INCUBE ou MALADE
-          // 3. Il n'a pas de chance.
-          voisin = 0;
-          if (j > 0)
-            voisin += (!grille[i][j - 1]->duree_quarantaine ==
-                       !grille[i][j]->duree_quarantaine) &&  // not XOR
-                      (grille[i][j - 1]->state == MALADE ||
-                       grille[i][j - 1]->state == INCUBE);
-          if (j < cote - 1)
-            voisin += (!grille[i][j + 1]->duree_quarantaine ==
-                       !grille[i][j]->duree_quarantaine) &&  // not XOR
-                      (grille[i][j + 1]->state == MALADE ||
-                       grille[i][j + 1]->state == INCUBE);
-          if (i > 0)
-            voisin += (!grille[i - 1][j]->duree_quarantaine ==
-                       !grille[i][j]->duree_quarantaine) &&  // not XOR
-                      (grille[i - 1][j]->state == MALADE ||
-                       grille[i - 1][j]->state == INCUBE);
-          if (i < cote - 1)
-            voisin += (!grille[i + 1][j]->duree_quarantaine ==
-                       !grille[i][j]->duree_quarantaine) &&  // not XOR
-                      (grille[i + 1][j]->state == MALADE ||
-                       grille[i + 1][j]->state == INCUBE);
-          // On applique la probabilité que l'individu tombe malade pour chaque
-          // voisin.
-          while (voisin > 0 && grille_tampon[i][j]->state != INCUBE) {
-            nb_aleatoire = (double)rand() / RAND_MAX;
-            if (nb_aleatoire < lambda) {
-              grille_tampon[i][j]->state = INCUBE;
-              grille_tampon[i][j]->duree_incube = duree_incube;
-              break;  // On sort de la boucle pour optimiser
-            }
-            voisin--;
-          }
-          break;
+#define NOYAU_NOM noyauV
+#define NOYAU_QUARANTAINE 0
+#define NOYAU_VACCIN 1
+#define NOYAU_INCUBATION 0
+#include "jouer_un_tour_noyau.h"
 
-        case MALADE:
-          // Mettre en QUARANTAINE ainsi que ses voisins
-          nb_aleatoire = (double)rand() / RAND_MAX;
-          if (nb_aleatoire < chance_quarantaine &&
-              !grille_tampon[i][j]->duree_quarantaine) {
-            mettreEnQuarantaine(grille_tampon, i, j, cote, cordon_sanitaire,
-                                duree_quarantaine);
-          }
+#define NOYAU_NOM noyauQV
+#define NOYAU_QUARANTAINE 1
+#define NOYAU_VACCIN 1
+#define NOYAU_INCUBATION 0
+#include "jouer_un_tour_noyau.h"
 
-          // S'il est MALADE, soit IMMUNISE, soit MORT, soit rien
-          nb_aleatoire = (double)rand() / RAND_MAX;
-          if (nb_aleatoire < beta) {
-            grille_tampon[i][j]->state = MORT;
-            break;
-          }
+#define NOYAU_NOM noyauI
+#define NOYAU_QUARANTAINE 0
+#define NOYAU_VACCIN 0
+#define NOYAU_INCUBATION 1
+#include "jouer_un_tour_noyau.h"
 
-          nb_aleatoire = (double)rand() / RAND_MAX;
-          if (nb_aleatoire < gamma) {
-            grille_tampon[i][j]->state = IMMUNISE;
-            break;
-          }
-          break;
+#define NOYAU_NOM noyauQI
+#define NOYAU_QUARANTAINE 1
+#define NOYAU_VACCIN 0
+#define NOYAU_INCUBATION 1
+#include "jouer_un_tour_noyau.h"
 
-        case INCUBE:
-          // S'il est incubé, on diminue le temps incubé de 1 et il devient
-          // malade si t = 0
-          if (grille[i][j]->duree_incube == 0)
-            grille_tampon[i][j]->state = MALADE;
-          else
-            grille_tampon[i][j]->duree_incube--;
-          break;
+#define NOYAU_NOM noyauVI
+#define NOYAU_QUARANTAINE 0
+#define NOYAU_VACCIN 1
+#define NOYAU_INCUBATION 1
+#include "jouer_un_tour_noyau.h"
 
-        case IMMUNISE:
-          // Vaccination par découverte du vaccin
-          nb_aleatoire = (double)rand() / RAND_MAX;
-          if (nb_aleatoire < chance_decouverte_vaccin) {
-            grille_tampon[i][j]->state = VACCINE;
-            break;
-          }
+#define NOYAU_NOM noyauQVI
+#define NOYAU_QUARANTAINE 1
+#define NOYAU_VACCIN 1
+#define NOYAU_INCUBATION 1
+#include "jouer_un_tour_noyau.h"
 
-          // Vaccination par propagation
-          if ((j > 0 && grille[i][j - 1]->state == VACCINE) ||
-              (j < cote - 1 && grille[i][j + 1]->state == VACCINE) ||
-              (i > 0 && grille[i - 1][j]->state == VACCINE) ||
-              (i < cote - 1 && grille[i + 1][j]->state == VACCINE))
-            grille_tampon[i][j]->state = VACCINE;
-          break;
+/**
+ * @brief Variantes du noyau, indexées par leurs extensions.
+ */
+static const struct Noyau NOYAUX[EXTENSIONS_TOUTES + 1] = {
+    {"base", 0, noyau},
+    {"quarantaine", EXTENSION_QUARANTAINE, noyauQ},
+    {"vaccin", EXTENSION_VACCIN, noyauV},
+    {"quarantaine+vaccin", EXTENSION_QUARANTAINE | EXTENSION_VACCIN, noyauQV},
+    {"incubation", EXTENSION_INCUBATION, noyauI},
+    {"quarantaine+incubation", EXTENSION_QUARANTAINE | EXTENSION_INCUBATION,
+     noyauQI},
+    {"vaccin+incubation", EXTENSION_VACCIN | EXTENSION_INCUBATION, noyauVI},
+    {"quarantaine+vaccin+incubation", EXTENSIONS_TOUTES, noyauQVI}};
 
-        default:
-          break;
-      }
-    }
+/**
+ * @brief Extensions nécessaires à une simulation.
+ *
+ * Une extension est nécessaire si son paramètre est non nul ou si la grille
+ * en porte déjà la trace (condition initiale chargée) :
+ * - quarantaine : chance_quarantaine > 0 ou une case en quarantaine ;
+ * - vaccin : chance_decouverte_vaccin > 0 ou un VACCINE ;
+ * - incubation : duree_incube > 0 ou un INCUBE avec duree_incube > 0.
+ *
+ * Le résultat reste valide pour toute la simulation : sans son paramètre,
+ * une extension ne peut que disparaître de la grille.
+ *
+ * @param parametres Paramètres de la simulation.
+ * @param population Population au début de la simulation.
+ * @return unsigned int Combinaison de enum Extension.
+ */
+unsigned int getExtensions(const struct Parametres *parametres,
+                           const struct Population *population) {
+  unsigned int extensions = 0;
+  if (parametres->chance_quarantaine > 0) extensions |= EXTENSION_QUARANTAINE;
+  if (parametres->chance_decouverte_vaccin > 0) extensions |= EXTENSION_VACCIN;
+  if (parametres->duree_incube > 0) extensions |= EXTENSION_INCUBATION;
+  const unsigned long taille = population->cote * population->cote;
+  for (unsigned long k = 0;
+       k < taille && extensions != EXTENSIONS_TOUTES; k++) {
+    const struct Personne *personne = &population->personnes[k];
+    if (enQuarantaine(population, personne))
+      extensions |= EXTENSION_QUARANTAINE;
+    if (personne->state == VACCINE) extensions |= EXTENSION_VACCIN;
+    if (personne->state == INCUBE && personne->duree_incube)
+      extensions |= EXTENSION_INCUBATION;
   }
+  return extensions;
+}
+
+/**
+ * @brief Variante du noyau pour des extensions, à choisir une fois par
+ * simulation.
+ *
+ * Usage:
+ * ```
+ * const struct Noyau *noyau =
+ *     choisirNoyau(getExtensions(&parametres, population));
+ * for (...) noyau->jouer(population, &parametres, &aleatoire);
+ * ```
+ *
+ * @param extensions Combinaison de enum Extension (getExtensions).
+ * @return const struct Noyau* Variante (statique).
+ */
+const struct Noyau *choisirNoyau(unsigned int extensions) {
+  return &NOYAUX[extensions & EXTENSIONS_TOUTES];
+}
 
-  population->grille_de_personnes = grille_tampon;  // Appliquer les changements
+/**
+ * @brief Version réentrante de jouerTour.
+ *
+ * Tout l'état (grille, tampon, générateur aléatoire) appartient à l'appelant :
+ * plusieurs populations peuvent être simulées en parallèle sur des threads
+ * différents sans verrou.
+ *
+ * Joue la variante complète du noyau, valable pour toute grille, sans
+ * parcours préalable : une boucle de simulation choisit plutôt sa variante
+ * une fois avec choisirNoyau (comme creerSimulation). Aucun tirage n'est
+ * fait pour une chance de quarantaine ou de vaccin nulle : même trajectoire
+ * que la variante spécialisée.
+ *
+ * Usage:
+ * ```
+ * struct Parametres parametres = {0.5, 0.1, 1.0, 0.1, 0.001, 4, 5, 20};
+ * struct Aleatoire aleatoire;
+ * initAleatoire(&aleatoire, 42);
+ * jouerTourParametres(population, &parametres, &aleatoire);
+ * ```
+ *
+ * @param population Grille au temps t.
+ * @param parametres Paramètres de la simulation.
+ * @param aleatoire Générateur aléatoire propre à la simulation.
+ */
+void jouerTourParametres(struct Population *population,
+                         const struct Parametres *parametres,
+                         struct Aleatoire *aleatoire) {
+  NOYAUX[EXTENSIONS_TOUTES].jouer(population, parametres, aleatoire);
 }
 
 /**
@@ -250,80 +395,35 @@ void jouerTour(struct Population *population, double beta, double gamma,
  * @param y
  * @param cote Longueur d'un côté de la grille de personnes
  * @param cordon_sanitaire Distance entre un malade et la personne.
- * @param duree_quarantaine Durée de la quarantaine.
+ * @param zone Zone de quarantaine (creerZone).
  */
-void mettreEnQuarantaineRecurse(struct Personne ***grille_de_personnes,
+void mettreEnQuarantaineRecurse(struct Personne **grille_de_personnes,
                                 unsigned long x, unsigned long y,
                                 unsigned long cote, int cordon_sanitaire,
-                                int duree_quarantaine) {
-  grille_de_personnes[x][y]->duree_quarantaine = duree_quarantaine;
-  grille_de_personnes[x][y]->cordon_sanitaire = cordon_sanitaire;
-
-  // Mettre en quarantaine les personnes adjacentes
-  // NORD
-  if (x > 0 &&
-      grille_de_personnes[x - 1][y]->cordon_sanitaire < cordon_sanitaire) {
-    // Si la personne est MALADE ou MORT, on le met en quarantaine
-    if (grille_de_personnes[x - 1][y]->state == MALADE ||
-        grille_de_personnes[x - 1][y]->state == MORT)
-      mettreEnQuarantaineRecurse(grille_de_personnes, x - 1, y, cote,
-                                 cordon_sanitaire, duree_quarantaine);
-    // La personne est peut-être incubé, on le met dans le cordon_sanitaire
-    else if (cordon_sanitaire > 0)
-      mettreEnQuarantaineRecurse(grille_de_personnes, x - 1, y, cote,
-                                 cordon_sanitaire - 1, duree_quarantaine);
-  }
-  // SUD
-  if (x < cote - 1 &&
-      grille_de_personnes[x + 1][y]->cordon_sanitaire < cordon_sanitaire) {
-    if (grille_de_personnes[x + 1][y]->state == MALADE ||
-        grille_de_personnes[x + 1][y]->state == MORT)
-      mettreEnQuarantaineRecurse(grille_de_personnes, x + 1, y, cote,
-                                 cordon_sanitaire, duree_quarantaine);
-    else if (cordon_sanitaire > 0)
-      mettreEnQuarantaineRecurse(grille_de_personnes, x + 1, y, cote,
-                                 cordon_sanitaire - 1, duree_quarantaine);
-  }
-  // OUEST
-  if (y > 0 &&
-      grille_de_personnes[x][y - 1]->cordon_sanitaire < cordon_sanitaire) {
-    if (grille_de_personnes[x][y - 1]->state == MALADE ||
-        grille_de_personnes[x][y - 1]->state == MORT)
-      mettreEnQuarantaineRecurse(grille_de_personnes, x, y - 1, cote,
-                                 cordon_sanitaire, duree_quarantaine);
-    else if (cordon_sanitaire > 0)
-      mettreEnQuarantaineRecurse(grille_de_personnes, x, y - 1, cote,
-                                 cordon_sanitaire - 1, duree_quarantaine);
-  }
-  // EST
-  if (y < cote - 1 &&
-      grille_de_personnes[x][y + 1]->cordon_sanitaire < cordon_sanitaire) {
-    if (grille_de_personnes[x][y + 1]->state == MALADE ||
-        grille_de_personnes[x][y + 1]->state == MORT)
-      mettreEnQuarantaineRecurse(grille_de_personnes, x, y + 1, cote,
-                                 cordon_sanitaire, duree_quarantaine);
-    else if (cordon_sanitaire > 0)
-      mettreEnQuarantaineRecurse(grille_de_personnes, x, y + 1, cote,
-                                 cordon_sanitaire - 1, duree_quarantaine);
-  }
+                                uint32_t zone) {
+  quarantaineRecurse(grille_de_personnes, x, y, cote, cordon_sanitaire, zone,
+                     NULL, 0);
 }
 
 /**
  * @brief Appliquer la mise en quarantaine sur un secteur.
  *
- * NOTE: Si il s'agissait du DFS, cordon_sanitaire représente le marquage.
+ * NOTE: Si il s'agissait du DFS, cordon_sanitaire représente le marquage,
+ * valable seulement pour les cases de la zone.
  *
  * La quarantaine suit ces règles :
  * - Toute personne MALADE entrant dans le cordon passe en quarantaine
  * - Toute personne non MALADE (MORT inclus) entre dans le cordon, mais réduit
  son influence
  *
+ * Les cases reçoivent l'indice de la zone : sa durée est dans la table des
+ * zones, aucune case n'est décomptée à chaque tour.
+ *
  * Usage:
  * ```
- * creerPopulation(7);
- * mettreEnQuarantaine(struct Personne ***grille_de_personnes,
-                         unsigned long x, unsigned long y, unsigned long cote,
-                         int cordon_sanitaire, unsigned duree_quarantaine)
+ * struct Population *population = creerPopulation(7);
+ * mettreEnQuarantaine(population->grille_de_personnes, 0, 0,
+ *                     population->cote, 5, creerZone(population, 20));
  * ```
  *
  * @param grille_de_personnes Grille de personnes au temps t.
@@ -331,15 +431,11 @@ void mettreEnQuarantaineRecurse(struct Personne ***grille_de_personnes,
  * @param y
  * @param cote Longueur d'un côté de la grille de personnes
  * @param cordon_sanitaire Distance entre un malade et la personne.
- * @param duree_quarantaine Durée de la quarantaine.
+ * @param zone Zone de quarantaine neuve (creerZone).
  */
-void mettreEnQuarantaine(struct Personne ***grille_de_personnes,
+void mettreEnQuarantaine(struct Personne **grille_de_personnes,
                          unsigned long x, unsigned long y, unsigned long cote,
-                         int cordon_sanitaire, int duree_quarantaine) {
-  for (unsigned long i = 0; i < cote; i++)
-    for (unsigned long j = 0; j < cote; j++)
-      grille_de_personnes[i][j]->cordon_sanitaire = 0;  // Marquage mise à zero
-
-  mettreEnQuarantaineRecurse(grille_de_personnes, x, y, cote, cordon_sanitaire,
-                             duree_quarantaine);
-}
\ No newline at end of file
+                         int cordon_sanitaire, uint32_t zone) {
+  mettreEnQuarantaineRaster(grille_de_personnes, x, y, cote, cordon_sanitaire,
+                            zone, NULL, 0);
+}
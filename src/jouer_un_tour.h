@@ -1,19 +1,99 @@
 #if !defined(JOUER_UN_TOUR_H)
 #define JOUER_UN_TOUR_H
 
+#include "aleatoire.h"
 #include "population.h"
 
+/**
+ * @brief Paramètres d'un tour de simulation.
+ */
+struct Parametres {
+  /**
+   * @brief Probabilité d'un individu infecté de mourir.
+   */
+  double beta;
+  /**
+   * @brief Probabilité d'un individu infecté de guérir.
+   */
+  double gamma;
+  /**
+   * @brief Probabilité d'un individu sain d'être contaminé par un voisin.
+   */
+  double lambda;
+  /**
+   * @brief Probabilité de déclancher une quarantaine.
+   */
+  double chance_quarantaine;
+  /**
+   * @brief Probabilité de découverte d'un vaccin.
+   */
+  double chance_decouverte_vaccin;
+  /**
+   * @brief Nombre de tours durant lesquels la personne est incubée.
+   */
+  unsigned int duree_incube;
+  /**
+   * @brief Personnes incubé(?) inclus dans la quarantaine.
+   */
+  int cordon_sanitaire;
+  /**
+   * @brief Durée de la quarantaine.
+   */
+  unsigned int duree_quarantaine;
+};
+
+/**
+ * @brief Extensions du modèle, chacune retirable du noyau.
+ */
+enum Extension {
+  EXTENSION_QUARANTAINE = 1,  // Quarantaine et cordon sanitaire
+  EXTENSION_VACCIN = 2,       // Découverte et propagation du vaccin
+  EXTENSION_INCUBATION = 4,   // Incubation de plus d'un tour
+  EXTENSIONS_TOUTES = 7
+};
+
+/**
+ * @brief Variante du noyau d'un tour, spécialisée pour des extensions.
+ */
+struct Noyau {
+  /**
+   * @brief Nom des extensions, ex: "quarantaine+vaccin".
+   */
+  const char *nom;
+  /**
+   * @brief Combinaison de enum Extension.
+   */
+  unsigned int extensions;
+  /**
+   * @brief Joue un tour, comme jouerTourParametres.
+   */
+  void (*jouer)(struct Population *population,
+                const struct Parametres *parametres,
+                struct Aleatoire *aleatoire);
+};
+
 char zombiePresent(struct Population *population);
 void jouerTour(struct Population *population, double beta, double gamma,
                double lambda, double chance_quarantaine,
                double chance_decouverte_vaccin, unsigned int duree_incube,
                int cordon_sanitaire, unsigned int duree_quarantaine);
-void mettreEnQuarantaine(struct Personne ***grille_de_personnes,
+void jouerTourParametres(struct Population *population,
+                         const struct Parametres *parametres,
+                         struct Aleatoire *aleatoire);
+unsigned int getExtensions(const struct Parametres *parametres,
+                           const struct Population *population);
+const struct Noyau *choisirNoyau(unsigned int extensions);
+void mettreEnQuarantaine(struct Personne **grille_de_personnes,
                          unsigned long x, unsigned long y, unsigned long cote,
-                         int cordon_sanitaire, int duree_quarantaine);
-void mettreEnQuarantaineRecurse(struct Personne ***grille_de_personnes,
+                         int cordon_sanitaire, uint32_t zone);
+void mettreEnQuarantaineRaster(struct Personne **grille_de_personnes,
+                               unsigned long x, unsigned long y,
+                               unsigned long cote, int cordon_sanitaire,
+                               uint32_t zone, uint16_t *raster_quarantaine,
+                               uint16_t tour);
+void mettreEnQuarantaineRecurse(struct Personne **grille_de_personnes,
                                 unsigned long x, unsigned long y,
                                 unsigned long cote, int cordon_sanitaire,
-                                int duree_quarantaine);
+                                uint32_t zone);
 
 #endif  // JOUER_UN_TOUR_H
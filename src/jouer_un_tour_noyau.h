@@ -0,0 +1,231 @@
+/**
+ * @file jouer_un_tour_noyau.h
+ *
+ * @brief Modèle du noyau d'un tour, une variante par jeu d'extensions.
+ *
+ * Inclus par jouer_un_tour.c une fois par variante (pas de garde
+ * d'inclusion), après avoir défini :
+ * - NOYAU_NOM : nom de la fonction générée ;
+ * - NOYAU_QUARANTAINE, NOYAU_VACCIN, NOYAU_INCUBATION : 0 ou 1.
+ *
+ * Une extension à 0 est retirée par le préprocesseur : ni test ni tirage
+ * dans la boucle. La variante n'est valide que si getExtensions le permet.
+ * Ces macros sont annulées en fin de fichier.
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+/**
+ * @brief Vrai si la zone de la case (x, y) de la grille est levée.
+ */
+#define LIBRE(x, y) (expirations[grille[x][y].zone] <= present)
+
+/**
+ * @brief Vrai si la case (x, y) et la case (i, j) sont ensemble (toutes deux
+ * en quarantaine ou toutes deux libres), suivi de &&. Vide sans quarantaine.
+ *
+ * Même zone : ensemble sans consulter la table (cas courant, zone libre).
+ */
+#if NOYAU_QUARANTAINE
+#define ENSEMBLE(x, y)                       \
+  (grille[x][y].zone == grille[i][j].zone || \
+   LIBRE(x, y) == LIBRE(i, j)) &&
+#else
+#define ENSEMBLE(x, y)
+#endif
+
+/**
+ * @brief Vrai si la case (x, y) peut infecter.
+ */
+#define CONTAGIEUX(x, y) \
+  (grille[x][y].state == MALADE || grille[x][y].state == INCUBE)
+
+/**
+ * @brief Noyau d'un tour (voir jouerTourParametres), variante NOYAU_NOM.
+ *
+ * @param population Grille au temps t.
+ * @param parametres Paramètres de la simulation.
+ * @param aleatoire Générateur aléatoire propre à la simulation.
+ */
+static void NOYAU_NOM(struct Population *population,
+                      const struct Parametres *parametres,
+                      struct Aleatoire *aleatoire) {
+  const long unsigned cote = population->cote;
+  const double beta = parametres->beta;
+  const double gamma = parametres->gamma;
+  const double lambda = parametres->lambda;
+#if NOYAU_QUARANTAINE
+  const double chance_quarantaine = parametres->chance_quarantaine;
+  const int cordon_sanitaire = parametres->cordon_sanitaire;
+  const unsigned int duree_quarantaine = parametres->duree_quarantaine;
+#endif
+#if NOYAU_VACCIN
+  const double chance_decouverte_vaccin = parametres->chance_decouverte_vaccin;
+#endif
+  const unsigned int duree_incube = parametres->duree_incube;
+  // On va modifier une population->grille_de_personnes tampon pour ne pas
+  // modifier la population->grille_de_personnes originale en cours de
+  // traitement.
+  preparerTampon(population);
+  struct Personne **grille_tampon = population->grille_tampon;
+#if NOYAU_QUARANTAINE
+  // La grille est au tour present, le tampon au tour present + 1 : une zone
+  // est levée quand present atteint son expiration, sans décompte par case
+  const unsigned long present = population->tour;
+  const unsigned long *expirations = population->zones.expirations;
+  // Zones créées à partir d'ici : neuves pendant ce parcours
+  const uint32_t premiere_zone = population->zones.nb_zones;
+  uint32_t raccourcie = 0;
+#endif
+  // Rasters (NULL si désactivés) : écrits au changement d'état seulement, avec
+  // le tour du nouvel état.
+  population->tour++;
+  const uint16_t tour = getTourRaster(population);
+  uint16_t *const raster_infection = population->rasters[RASTER_INFECTION];
+  uint16_t *const raster_mort = population->rasters[RASTER_MORT];
+#if NOYAU_QUARANTAINE
+  uint16_t *const raster_quarantaine = population->rasters[RASTER_QUARANTAINE];
+#endif
+  double nb_aleatoire;
+  int voisin = 0;  // compteur de voisins.
+
+  // Alias
+  struct Personne **grille = population->grille_de_personnes;
+
+  // Pour chaque case
+  for (long unsigned i = 0; i < cote; i++) {
+    for (long unsigned j = 0; j < cote; j++) {
+#if NOYAU_QUARANTAINE
+      // Déjà en quarantaine et remise dans une zone neuve avant son passage :
+      // un tour de moins que la zone (voir raccourcirZone)
+      if (grille_tampon[i][j].zone >= premiere_zone && !LIBRE(i, j)) {
+        grille_tampon[i][j].zone =
+            raccourcirZone(population, grille_tampon[i][j].zone, &raccourcie);
+        expirations = population->zones.expirations;  // Réallouée
+      }
+#endif
+      switch (grille[i][j].state) {
+        case SAIN:
+#if NOYAU_VACCIN
+          // Vaccination par découverte du vaccin (pas de tirage si nulle)
+          if (chance_decouverte_vaccin > 0 &&
+              aleatoireUniforme(aleatoire) < chance_decouverte_vaccin) {
+            grille_tampon[i][j].state = VACCINE;
+            break;
+          }
+
+          // Vaccination par propagation
+          if ((j > 0 && grille[i][j - 1].state == VACCINE) ||
+              (j < cote - 1 && grille[i][j + 1].state == VACCINE) ||
+              (i > 0 && grille[i - 1][j].state == VACCINE) ||
+              (i < cote - 1 && grille[i + 1][j].state == VACCINE)) {
+            grille_tampon[i][j].state = VACCINE;
+            break;
+          }
+#endif
+
+          // Infection
+          // La personne est MALADE s'il remplis :
+          // 1. Ils sont ensemble (en quarantaine ou libre)
+          // 2. Le/les voisins est INCUBE ou MALADE
+          // 3. Il n'a pas de chance.
+          voisin = 0;
+          if (j > 0) voisin += ENSEMBLE(i, j - 1) CONTAGIEUX(i, j - 1);
+          if (j < cote - 1) voisin += ENSEMBLE(i, j + 1) CONTAGIEUX(i, j + 1);
+          if (i > 0) voisin += ENSEMBLE(i - 1, j) CONTAGIEUX(i - 1, j);
+          if (i < cote - 1) voisin += ENSEMBLE(i + 1, j) CONTAGIEUX(i + 1, j);
+          // On applique la probabilité que l'individu tombe malade pour chaque
+          // voisin.
+          while (voisin > 0 && grille_tampon[i][j].state != INCUBE) {
+            nb_aleatoire = aleatoireUniforme(aleatoire);
+            if (nb_aleatoire < lambda) {
+              grille_tampon[i][j].state = INCUBE;
+              grille_tampon[i][j].duree_incube = duree_incube;
+              if (raster_infection) raster_infection[i * cote + j] = tour;
+              break;  // On sort de la boucle pour optimiser
+            }
+            voisin--;
+          }
+          break;
+
+        case MALADE:
+#if NOYAU_QUARANTAINE
+          // Mettre en QUARANTAINE ainsi que ses voisins (pas de tirage si
+          // nulle)
+          if (chance_quarantaine > 0 &&
+              aleatoireUniforme(aleatoire) < chance_quarantaine &&
+              expirations[grille_tampon[i][j].zone] <= present + 1) {
+            const uint32_t zone = creerZone(population, duree_quarantaine);
+            expirations = population->zones.expirations;  // Réallouée
+            if (zone)
+              mettreEnQuarantaineRaster(grille_tampon, i, j, cote,
+                                        cordon_sanitaire, zone,
+                                        raster_quarantaine, tour);
+          }
+#endif
+
+          // S'il est MALADE, soit IMMUNISE, soit MORT, soit rien
+          nb_aleatoire = aleatoireUniforme(aleatoire);
+          if (nb_aleatoire < beta) {
+            grille_tampon[i][j].state = MORT;
+            if (raster_mort) raster_mort[i * cote + j] = tour;
+            break;
+          }
+
+          nb_aleatoire = aleatoireUniforme(aleatoire);
+          if (nb_aleatoire < gamma) {
+            grille_tampon[i][j].state = IMMUNISE;
+            break;
+          }
+          break;
+
+        case INCUBE:
+#if NOYAU_INCUBATION
+          // S'il est incubé, on diminue le temps incubé de 1 et il devient
+          // malade si t = 0
+          if (grille[i][j].duree_incube == 0)
+            grille_tampon[i][j].state = MALADE;
+          else
+            grille_tampon[i][j].duree_incube--;
+#else
+          // Incubation d'un tour : duree_incube est toujours nulle
+          grille_tampon[i][j].state = MALADE;
+#endif
+          break;
+
+#if NOYAU_VACCIN
+        case IMMUNISE:
+          // Vaccination par découverte du vaccin (pas de tirage si nulle)
+          if (chance_decouverte_vaccin > 0 &&
+              aleatoireUniforme(aleatoire) < chance_decouverte_vaccin) {
+            grille_tampon[i][j].state = VACCINE;
+            break;
+          }
+
+          // Vaccination par propagation
+          if ((j > 0 && grille[i][j - 1].state == VACCINE) ||
+              (j < cote - 1 && grille[i][j + 1].state == VACCINE) ||
+              (i > 0 && grille[i - 1][j].state == VACCINE) ||
+              (i < cote - 1 && grille[i + 1][j].state == VACCINE))
+            grille_tampon[i][j].state = VACCINE;
+          break;
+#endif
+
+        default:
+          break;
+      }
+    }
+  }
+
+  echangerTampon(population);  // Appliquer les changements
+}
+
+#undef LIBRE
+#undef ENSEMBLE
+#undef CONTAGIEUX
+#undef NOYAU_NOM
+#undef NOYAU_QUARANTAINE
+#undef NOYAU_VACCIN
+#undef NOYAU_INCUBATION
@@ -24,12 +24,54 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 
+#include "branches.h"
+#include "calibration.h"
+#include "condition_initiale.h"
+#include "film.h"
+#include "graphique_flux.h"
+#include "hors_memoire.h"
 #include "jouer_un_tour.h"
+#include "metriques.h"
+#include "multiechelle.h"
 #include "population.h"
+#include "serie.h"
+#include "sortie.h"
+#include "simulation.h"
 #include "statistique.h"
 
 void printHelp(void);
+struct Serie* simulerMultiechelle(const struct Parametres* parametres,
+                                 unsigned long cote, unsigned long taille_bloc,
+                                 unsigned long x, unsigned long y,
+                                 unsigned long tour_max,
+                                 struct GraphiqueFlux* graph,
+                                 unsigned long graph_direct,
+                                 struct Metriques* metriques);
+struct Serie* simulerHorsMemoire(const struct Parametres* parametres,
+                                const char* fichier, unsigned long cote,
+                                unsigned long x, unsigned long y,
+                                unsigned long tour_max,
+                                struct GraphiqueFlux* graph,
+                                unsigned long graph_direct,
+                                struct Metriques* metriques);
+void lireVariante(const char* texte, struct Parametres* lus);
+void simulerBranches(struct Simulation* simulation,
+                     struct Variante* variantes, unsigned int nb_variantes,
+                     unsigned long tour_prefixe, unsigned long tour_max,
+                     unsigned int nb_paralleles, const char* file_data);
+void calibrerParametres(struct Calibration* calibration,
+                        const char* file_observations,
+                        const char* file_posterieure);
+void exporterRasters(const struct Population* population,
+                     const char* prefixe);
+void afficherTour(struct Sortie* sortie, const struct Population* population,
+                  struct Statistique stats);
+void suivreGraphique(struct GraphiqueFlux* graph, struct Statistique stats,
+                     unsigned long tour, unsigned long graph_direct);
+void mesurerPhase(struct Metriques* metriques, enum PhaseMetriques phase,
+                  double* horloge);
 
 /**
  * @brief Execute la simulation d'une propagation, et sort des statistiques.
@@ -42,7 +84,6 @@ void printHelp(void);
  */
 int main(int argc, char const* argv[]) {
   // Defauts
-  srand(time(NULL));
   unsigned long hauteur = 20;
   unsigned long limite = 80;
   unsigned duree_incube = 4;
@@ -52,10 +93,56 @@ int main(int argc, char const* argv[]) {
   double chance_quarantaine = 0.1;
   double chance_decouverte_vaccin =
       0.001;  // SAIN/IMMUNISE -> VACINE par découverte
-  char* file_graph = "graphique.txt";
-  char* file_data = "data.txt";
-  char* file_tableau = "tableau de bord.txt";
+  const char* file_graph = "graphique.txt";
+  const char* file_data = "data.txt";
+  const char* file_tableau = "tableau de bord.txt";
+  const char* file_init = NULL;  // Raster de la population initiale
+  const char* file_serie = NULL;  // Série compressée
+  const char* prefixe_rasters = NULL;  // Rasters épidémiologiques
+  unsigned long taille_bloc = 0;  // 0 : pas de mode multi-échelle
+  const char* file_hors_memoire = NULL;  // Grille sur disque (mmap)
+  const char* file_classes = NULL;  // Table des classes de risque
+  const char* file_carte_classes = NULL;  // Classe de chaque case
+  struct ParametresContacts contacts = {.nb_contacts = 0,  // 0 : aucun
+                                        .loi = CONTACTS_DISTANCE,
+                                        .exposant = 2,
+                                        .rayon = 0,  // 0 : cote
+                                        .poids = NULL};
+  const char* file_poids_contacts = NULL;  // Loi CONTACTS_POIDS
+  int agents = 0;  // Agents mobiles au lieu de cases fixes
+  struct ParametresAgents parametres_agents = {.mobilite = MOBILITE_MARCHE,
+                                               .chance_pas = 1,
+                                               .distance_travail = 10,
+                                               .periode = 2};
+  const char* file_souches = NULL;  // Table des souches en concurrence
+  struct Introduction* introductions = NULL;  // Souches introduites
+  unsigned int nb_introductions = 0;
+  unsigned long graph_direct = 0;  // Graphique affiché tous les n tours
+  unsigned long capacite_sortie = 0;  // 0 : sorties sur le thread principal
+  const char* file_film = NULL;  // Images PPM/PGM
+  unsigned long film_chaque = 1;  // Une image tous les n tours
+  unsigned long film_reduction = 1;  // Côté d'un bloc par pixel
   unsigned long tour_max = 100;
+  int transitions = 0;  // Tables de transition : un tirage par case
+  int bitboard = 0;  // Plans de bits : 64 cases par opération
+  int voisinage = 0;  // Compteurs de voisins : cases actives seulement
+  unsigned int nb_bandes = 0;  // 0 : plans de bits sur le thread principal
+  unsigned int options_bandes = 0;  // enum OptionBandes
+  int numa = 0;  // Diagnostic NUMA des bandes
+  const char* adresse_metriques = NULL;  // Port TCP ou socket Unix
+  struct Variante* variantes = NULL;  // Branches après le préfixe commun
+  unsigned int nb_variantes = 0;
+  unsigned long tour_prefixe = 0;  // Tours communs avant les branches
+  unsigned int nb_paralleles =  // Processus des branches, threads ABC
+      (unsigned int)sysconf(_SC_NPROCESSORS_ONLN);
+  const char* file_observations = NULL;  // Série observée à calibrer
+  const char* file_posterieure = "posterieure.txt";
+  struct Calibration calibration = {.minimum = {0, 0, 0},
+                                    .maximum = {1, 1, 1},
+                                    .nb_particules = 100,
+                                    .nb_generations = 5,
+                                    .seuil_initial = 0,
+                                    .quantile = 0.5};
   int duree_quarantaine = 20;  // Très grand au tps d'incub
   int cordon_sanitaire = 5;    // Généralement égal au temps d'incubation
 
@@ -94,16 +181,152 @@ int main(int argc, char const* argv[]) {
       sscanf(argv[i + 1], "%lu", &limite);
 
     if (!strcmp(argv[i], "--graph") || !strcmp(argv[i], "-og"))
-      strcpy(file_graph, argv[i + 1]);
+      file_graph = argv[i + 1];
 
     if (!strcmp(argv[i], "--data") || !strcmp(argv[i], "-od"))
-      strcpy(file_data, argv[i + 1]);
+      file_data = argv[i + 1];
+
+    if (!strcmp(argv[i], "--serie") || !strcmp(argv[i], "-os"))
+      file_serie = argv[i + 1];
+
+    if (!strcmp(argv[i], "--rasters") || !strcmp(argv[i], "-or"))
+      prefixe_rasters = argv[i + 1];
+
+    if (!strcmp(argv[i], "-as") || !strcmp(argv[i], "--asynchrone"))
+      sscanf(argv[i + 1], "%lu", &capacite_sortie);
+
+    if (!strcmp(argv[i], "--images") || !strcmp(argv[i], "-oi"))
+      file_film = argv[i + 1];
+
+    if (!strcmp(argv[i], "-ik") || !strcmp(argv[i], "--images-chaque"))
+      sscanf(argv[i + 1], "%lu", &film_chaque);
+
+    if (!strcmp(argv[i], "-ir") || !strcmp(argv[i], "--images-reduction"))
+      sscanf(argv[i + 1], "%lu", &film_reduction);
+
+    if (!strcmp(argv[i], "-i") || !strcmp(argv[i], "--init"))
+      file_init = argv[i + 1];
+
+    if (!strcmp(argv[i], "-gd") || !strcmp(argv[i], "--graph-direct"))
+      sscanf(argv[i + 1], "%lu", &graph_direct);
+
+    if (!strcmp(argv[i], "-me") || !strcmp(argv[i], "--multiechelle"))
+      sscanf(argv[i + 1], "%lu", &taille_bloc);
+
+    if (!strcmp(argv[i], "-hm") || !strcmp(argv[i], "--hors-memoire"))
+      file_hors_memoire = argv[i + 1];
+
+    if (!strcmp(argv[i], "-cl") || !strcmp(argv[i], "--classes"))
+      file_classes = argv[i + 1];
+
+    if (!strcmp(argv[i], "-cm") || !strcmp(argv[i], "--carte-classes"))
+      file_carte_classes = argv[i + 1];
+
+    if (!strcmp(argv[i], "-lc") || !strcmp(argv[i], "--contacts"))
+      sscanf(argv[i + 1], "%u", &contacts.nb_contacts);
+
+    if (!strcmp(argv[i], "-le") || !strcmp(argv[i], "--exposant"))
+      sscanf(argv[i + 1], "%lf", &contacts.exposant);
+
+    if (!strcmp(argv[i], "-lr") || !strcmp(argv[i], "--rayon"))
+      sscanf(argv[i + 1], "%lu", &contacts.rayon);
+
+    if (!strcmp(argv[i], "-lp") || !strcmp(argv[i], "--poids-contacts"))
+      file_poids_contacts = argv[i + 1];
+
+    if (!strcmp(argv[i], "-ag") || !strcmp(argv[i], "--agents")) {
+      agents = 1;
+      // Sans valeur (dernier argument ou option suivante) : marche
+      if (i + 1 < argc && !strcmp(argv[i + 1], "trajet"))
+        parametres_agents.mobilite = MOBILITE_TRAJET;
+      else if (i + 1 < argc && argv[i + 1][0] != '-' &&
+               strcmp(argv[i + 1], "marche")) {
+        printf("Erreur: --agents attend marche ou trajet.\n");
+        exit(1);
+      }
+    }
+
+    if (!strcmp(argv[i], "-ap") || !strcmp(argv[i], "--pas"))
+      sscanf(argv[i + 1], "%lf", &parametres_agents.chance_pas);
+
+    if (!strcmp(argv[i], "-at") || !strcmp(argv[i], "--travail"))
+      sscanf(argv[i + 1], "%lu", &parametres_agents.distance_travail);
+
+    if (!strcmp(argv[i], "-ao") || !strcmp(argv[i], "--periode"))
+      sscanf(argv[i + 1], "%u", &parametres_agents.periode);
+
+    if (!strcmp(argv[i], "-so") || !strcmp(argv[i], "--souches"))
+      file_souches = argv[i + 1];
+
+    if (!strcmp(argv[i], "-si") || !strcmp(argv[i], "--introduire")) {
+      introductions = (struct Introduction*)realloc(
+          introductions, (nb_introductions + 1) * sizeof(struct Introduction));
+      struct Introduction* lue = &introductions[nb_introductions++];
+      if (i + 1 >= argc || sscanf(argv[i + 1], "%u,%lu,%lu,%lu", &lue->souche,
+                                  &lue->x, &lue->y, &lue->tour) != 4) {
+        printf("Erreur: --introduire attend souche,x,y,tour.\n");
+        exit(1);
+      }
+    }
+
+    if (!strcmp(argv[i], "-tt") || !strcmp(argv[i], "--transitions"))
+      transitions = 1;
+
+    if (!strcmp(argv[i], "-bb") || !strcmp(argv[i], "--bitboard"))
+      bitboard = 1;
+
+    if (!strcmp(argv[i], "-vz") || !strcmp(argv[i], "--voisinage"))
+      voisinage = 1;
+
+    if (!strcmp(argv[i], "-bd") || !strcmp(argv[i], "--bandes"))
+      sscanf(argv[i + 1], "%u", &nb_bandes);
+
+    if (!strcmp(argv[i], "-ep") || !strcmp(argv[i], "--epingler"))
+      options_bandes |= BANDES_EPINGLER;
+
+    if (!strcmp(argv[i], "--numa")) numa = 1;
+
+    if (!strcmp(argv[i], "-mx") || !strcmp(argv[i], "--metriques"))
+      adresse_metriques = argv[i + 1];
+
+    if (!strcmp(argv[i], "-br") || !strcmp(argv[i], "--branche")) {
+      variantes = (struct Variante*)realloc(
+          variantes, (nb_variantes + 1) * sizeof(struct Variante));
+      lireVariante(argv[i + 1], &variantes[nb_variantes++].parametres);
+    }
+
+    if (!strcmp(argv[i], "-pf") || !strcmp(argv[i], "--prefixe"))
+      sscanf(argv[i + 1], "%lu", &tour_prefixe);
+
+    if (!strcmp(argv[i], "-pa") || !strcmp(argv[i], "--paralleles"))
+      sscanf(argv[i + 1], "%u", &nb_paralleles);
+
+    if (!strcmp(argv[i], "-ca") || !strcmp(argv[i], "--calibrer"))
+      file_observations = argv[i + 1];
+
+    if (!strcmp(argv[i], "-cn") || !strcmp(argv[i], "--particules"))
+      sscanf(argv[i + 1], "%u", &calibration.nb_particules);
+
+    if (!strcmp(argv[i], "-cg") || !strcmp(argv[i], "--generations"))
+      sscanf(argv[i + 1], "%u", &calibration.nb_generations);
+
+    if (!strcmp(argv[i], "-cs") || !strcmp(argv[i], "--seuil"))
+      sscanf(argv[i + 1], "%lf", &calibration.seuil_initial);
+
+    if (!strcmp(argv[i], "-cb") || !strcmp(argv[i], "--bornes"))
+      sscanf(argv[i + 1], "%lf,%lf,%lf,%lf,%lf,%lf", &calibration.minimum[0],
+             &calibration.maximum[0], &calibration.minimum[1],
+             &calibration.maximum[1], &calibration.minimum[2],
+             &calibration.maximum[2]);
+
+    if (!strcmp(argv[i], "--posterieure") || !strcmp(argv[i], "-oc"))
+      file_posterieure = argv[i + 1];
 
     if (!strcmp(argv[i], "-t") || !strcmp(argv[i], "--tours"))
       sscanf(argv[i + 1], "%lu", &tour_max);
 
     if (!strcmp(argv[i], "--tableau") || !strcmp(argv[i], "-ot"))
-      strcpy(file_tableau, argv[i + 1]);
+      file_tableau = argv[i + 1];
 
     if (!strcmp(argv[i], "-di") || !strcmp(argv[i], "--duree-incube"))
       sscanf(argv[i + 1], "%u", &duree_incube);
@@ -122,37 +345,597 @@ int main(int argc, char const* argv[]) {
   }
 
   // Init
-  struct Statistique stats;
-  struct Data* data = creerData();
-  struct Population* population = creerPopulation(cote);
-  data->population_totale = getTaillePopulation(population);
-  stats = getStatistique(population);
-  appendData(data, stats);
-
-  // Traitement
-  patient_zero(population, x, y);
-  afficherGrillePopulation(population);
-  for (unsigned long i = 0; i < tour_max && zombiePresent(population); i++) {
-    jouerTour(population, beta, gamma, lambda, chance_quarantaine,
-              chance_decouverte_vaccin, duree_incube, cordon_sanitaire,
-              duree_quarantaine);
-    stats = getStatistique(population);
-    afficherGrillePopulation(population);
-    appendData(data, stats);
+  const struct Parametres parametres = {
+      .beta = beta,
+      .gamma = gamma,
+      .lambda = lambda,
+      .chance_quarantaine = chance_quarantaine,
+      .chance_decouverte_vaccin = chance_decouverte_vaccin,
+      .duree_incube = duree_incube,
+      .cordon_sanitaire = cordon_sanitaire,
+      .duree_quarantaine = duree_quarantaine};
+  struct Simulation* simulation = NULL;
+  struct Serie* serie_sans_grille = NULL;  // Multi-échelle ou hors mémoire
+  const struct Serie* serie;
+  struct GraphiqueFlux* graph;
+  struct Sortie* sortie = NULL;
+  struct Metriques* metriques = NULL;
+  if (adresse_metriques) {
+    metriques = creerMetriques(adresse_metriques);
+    if (!metriques) {
+      printf("Erreur: métriques indisponibles sur %s.\n", adresse_metriques);
+      exit(1);
+    }
+  }
+  if (taille_bloc) {
+    // Traitement sans affichage de la grille
+    graph = creerGraphiqueFlux(hauteur, limite, cote * cote);
+    serie = serie_sans_grille =
+        simulerMultiechelle(&parametres, cote, taille_bloc, x, y, tour_max,
+                            graph, graph_direct, metriques);
+  } else if (file_hors_memoire) {
+    // Grille sur disque, sans affichage
+    graph = creerGraphiqueFlux(hauteur, limite, cote * cote);
+    serie = serie_sans_grille =
+        simulerHorsMemoire(&parametres, file_hors_memoire, cote, x, y,
+                           tour_max, graph, graph_direct, metriques);
+  } else {
+    struct Population* population;
+    if (file_init) {
+      population = chargerConditionInitiale(file_init, &parametres);
+      if (!population) {
+        printf("Erreur: %s n'a pas pu être chargé.\n", file_init);
+        exit(1);
+      }
+    } else {
+      population = creerPopulation(cote);
+      patient_zero(population, x, y);
+    }
+    if (file_observations) {
+      calibration.initiale = population;
+      calibration.parametres = parametres;
+      calibration.nb_threads = nb_paralleles;
+      calibration.graine = time(NULL);
+      calibrerParametres(&calibration, file_observations, file_posterieure);
+      detruirePopulation(population);
+      if (metriques) detruireMetriques(metriques);
+      return 0;
+    }
+    if (prefixe_rasters) activerRasters(population);
+    simulation = creerSimulation(&parametres, population, time(NULL));
+    if (transitions) activerTransitionsSimulation(simulation);
+    if (file_carte_classes && !file_classes) {
+      printf("Erreur: --carte-classes demande --classes.\n");
+      exit(1);
+    }
+    if (file_classes) {
+      if (voisinage || bitboard || nb_bandes) {
+        printf("Erreur: --classes est incompatible avec --voisinage, "
+               "--bitboard et --bandes.\n");
+        exit(1);
+      }
+      struct ParametresClasse valeurs[NB_CLASSES_MAX];
+      const int nb_classes = lireTableClasses(file_classes, valeurs);
+      if (nb_classes < 0) {
+        printf("Erreur: %s n'a pas pu être chargé.\n", file_classes);
+        exit(1);
+      }
+      uint8_t* carte =
+          file_carte_classes
+              ? lireCarteClasses(file_carte_classes, population->cote)
+              : (uint8_t*)calloc(population->cote * population->cote, 1);
+      if (!carte) {
+        printf("Erreur: %s n'a pas pu être chargé.\n", file_carte_classes);
+        exit(1);
+      }
+      if (activerClassesSimulation(simulation, valeurs, nb_classes, carte)) {
+        printf("Erreur: %s porte une classe absente de %s.\n",
+               file_carte_classes, file_classes);
+        exit(1);
+      }
+    }
+    if (voisinage && activerVoisinageSimulation(simulation)) {
+      printf("Erreur: --voisinage est incompatible avec la découverte du "
+             "vaccin.\n");
+      exit(1);
+    }
+    if (bitboard && activerBitboardSimulation(simulation)) {
+      printf("Erreur: --bitboard est incompatible avec la quarantaine.\n");
+      exit(1);
+    }
+    if (nb_bandes &&
+        activerBandesSimulation(simulation, nb_bandes, options_bandes)) {
+      printf("Erreur: --bandes est incompatible avec la quarantaine.\n");
+      exit(1);
+    }
+    if (agents) {
+      if (voisinage || bitboard || nb_bandes || file_classes ||
+          contacts.nb_contacts) {
+        printf("Erreur: --agents est incompatible avec --voisinage, "
+               "--bitboard, --bandes, --classes et --contacts.\n");
+        exit(1);
+      }
+      // Comme les contacts : une seule tâche avec --branche
+      if (activerAgentsSimulation(simulation, &parametres_agents,
+                                  nb_variantes ? 1 : nb_paralleles)) {
+        printf("Erreur: --pas doit être dans [0, 1] et --periode au moins "
+               "2.\n");
+        exit(1);
+      }
+    }
+    if (file_souches) {
+      if (voisinage || bitboard || nb_bandes || file_classes ||
+          contacts.nb_contacts || agents) {
+        printf("Erreur: --souches est incompatible avec --voisinage, "
+               "--bitboard, --bandes, --classes, --contacts et --agents.\n");
+        exit(1);
+      }
+      struct ParametresSouche valeurs[NB_SOUCHES_MAX];
+      const int nb_souches = lireTableSouches(file_souches, valeurs);
+      if (nb_souches < 0) {
+        printf("Erreur: %s n'a pas pu être chargé.\n", file_souches);
+        exit(1);
+      }
+      if (activerSouchesSimulation(simulation, valeurs, nb_souches,
+                                   introductions, nb_introductions)) {
+        printf("Erreur: une introduction vise une souche absente de %s ou "
+               "une case hors de la grille.\n",
+               file_souches);
+        exit(1);
+      }
+    } else if (nb_introductions) {
+      printf("Erreur: --introduire demande --souches.\n");
+      exit(1);
+    }
+    free(introductions);
+    if (contacts.nb_contacts) {
+      const unsigned long cote_population = population->cote;
+      uint8_t* poids = NULL;
+      if (!contacts.rayon) contacts.rayon = cote_population;
+      if (file_poids_contacts) {
+        poids = chargerCarteOctets(file_poids_contacts, cote_population);
+        if (!poids) {
+          printf("Erreur: %s n'a pas pu être chargé.\n", file_poids_contacts);
+          exit(1);
+        }
+        contacts.loi = CONTACTS_POIDS;
+        contacts.poids = poids;
+      }
+      // Les variantes sont déjà parallèles, et les threads ne survivent pas
+      // à leur fork : une seule bande
+      struct Contacts* couche = creerContacts(
+          &contacts, cote_population, nb_variantes ? 1 : nb_paralleles);
+      free(poids);
+      if (!couche) {
+        printf("Erreur: aucune case ne peut être visée par un contact.\n");
+        exit(1);
+      }
+      if (activerContactsSimulation(simulation, couche)) {
+        printf("Erreur: --contacts est incompatible avec --voisinage, "
+               "--bitboard et --bandes.\n");
+        exit(1);
+      }
+    }
+    if (numa && getBandesSimulation(simulation))
+      afficherNumaBandes(getBandesSimulation(simulation), stdout);
+    if (metriques) attacherMetriquesSimulation(simulation, metriques);
+    if (nb_variantes) {
+      if (getBandesSimulation(simulation)) {
+        printf("Erreur: --branche est incompatible avec --bandes.\n");
+        exit(1);
+      }
+      for (unsigned int k = 0; k < nb_variantes; k++) {
+        struct Parametres variante = parametres;
+        const struct Parametres* lus = &variantes[k].parametres;
+        if (lus->chance_quarantaine >= 0)
+          variante.chance_quarantaine = lus->chance_quarantaine;
+        if (lus->cordon_sanitaire >= 0)
+          variante.cordon_sanitaire = lus->cordon_sanitaire;
+        if (lus->chance_decouverte_vaccin >= 0)
+          variante.chance_decouverte_vaccin = lus->chance_decouverte_vaccin;
+        variantes[k].parametres = variante;
+      }
+      simulerBranches(simulation, variantes, nb_variantes, tour_prefixe,
+                      tour_max, nb_paralleles, file_data);
+      detruireSimulation(simulation);
+      if (metriques) detruireMetriques(metriques);
+      free(variantes);
+      return 0;
+    }
+    serie = getSerieSimulation(simulation);
+    graph = creerGraphiqueFlux(hauteur, limite, serie->population_totale);
+    ajouterGraphiqueFlux(graph, serie->derniere);
+
+    // Traitement
+    if (capacite_sortie) {
+      sortie = creerSortie(capacite_sortie, population->cote, stdout,
+                           file_data);
+      if (!sortie) {
+        printf("Erreur: le thread d'écriture n'a pas pu être créé.\n");
+        exit(1);
+      }
+    }
+    struct Film* film = NULL;
+    if (file_film) {
+      const size_t longueur = strlen(file_film);
+      film = creerFilm(
+          file_film,
+          longueur >= 4 && !strcmp(file_film + longueur - 4, ".pgm")
+              ? IMAGE_PGM
+              : IMAGE_PPM,
+          population->cote, film_reduction, film_chaque,
+          film_chaque ? tour_max / film_chaque + 1 : 0);
+      if (!film) {
+        printf("Erreur: %s n'a pas pu être créé.\n", file_film);
+        exit(1);
+      }
+      ajouterImageFilm(film, population);
+    }
+    afficherTour(sortie, getPopulationSimulation(simulation),
+                 serie->derniere);
+    for (unsigned long i = 0; i < tour_max && avancerSimulation(simulation, 1);
+         i++) {
+      double horloge = metriques ? horlogeMetriques() : 0;
+      if (film) {
+        ajouterImageFilm(film, getPopulationSimulation(simulation));
+        mesurerPhase(metriques, PHASE_IMAGES, &horloge);
+      }
+      afficherTour(sortie, getPopulationSimulation(simulation),
+                   serie->derniere);
+      mesurerPhase(metriques, PHASE_AFFICHAGE, &horloge);
+      suivreGraphique(graph, serie->derniere, i + 1, graph_direct);
+      mesurerPhase(metriques, PHASE_GRAPHIQUE, &horloge);
+    }
+    if (sortie) terminerSortie(sortie);
+    if (film && fermerFilm(film)) {
+      printf("Erreur: %s n'a pas pu être écrit.\n", file_film);
+      exit(1);
+    }
   }
 
   // Output
   printf("Graphique (colonne = tour, charactère = %%état)\n");
-  graphique(data, file_graph, hauteur, limite);
+  exporterGraphiqueFlux(graph, file_graph);
+  rendreGraphiqueFlux(graph, stdout, 1);
   printf("Exportation...");
-  exporter(data, file_data);
+  // Avec --asynchrone, les données sont écrites par le thread écrivain
+  if (!simulation || !capacite_sortie) exporterSerie(serie, file_data);
+  if (file_serie && ecrireSerie(serie, file_serie)) {
+    printf("Erreur: %s n'a pas pu être écrit.\n", file_serie);
+    exit(1);
+  }
+  if (prefixe_rasters && simulation)
+    exporterRasters(getPopulationSimulation(simulation), prefixe_rasters);
   printf("OK\n");
   printf("Tableau de bord\n");
-  tableau(data, file_tableau);
+  tableauSerie(serie, file_tableau);
+  if (simulation && getClassesSimulation(simulation)) {
+    printf("Classes de risque\n");
+    ecrireClasses(getClassesSimulation(simulation), stdout);
+    FILE* file = fopen(file_tableau, "a");
+    if (!file) {
+      printf("Erreur: %s n'a pas pu être écrit.\n", file_tableau);
+      exit(1);
+    }
+    ecrireClasses(getClassesSimulation(simulation), file);
+    fclose(file);
+  }
+  if (simulation && getSouchesSimulation(simulation)) {
+    printf("Souches\n");
+    ecrireSouches(getSouchesSimulation(simulation), stdout);
+    FILE* file = fopen(file_tableau, "a");
+    if (!file) {
+      printf("Erreur: %s n'a pas pu être écrit.\n", file_tableau);
+      exit(1);
+    }
+    ecrireSouches(getSouchesSimulation(simulation), file);
+    fclose(file);
+  }
 
+  if (simulation) detruireSimulation(simulation);
+  if (metriques) detruireMetriques(metriques);
+  if (serie_sans_grille) detruireSerie(serie_sans_grille);
+  detruireGraphiqueFlux(graph);
   return 0;
 }
 
+/**
+ * @brief Simulation multi-échelle (grilles nationales), sans affichage.
+ *
+ * @param parametres Paramètres de la simulation.
+ * @param cote Longueur d'un côté de la grille, multiple de taille_bloc.
+ * @param taille_bloc Longueur d'un côté d'un bloc.
+ * @param x, y Patient zero.
+ * @param tour_max Tours max de la simulation.
+ * @param graph Graphique alimenté à chaque tour.
+ * @param graph_direct Graphique affiché tous les graph_direct tours (0: non).
+ * @param metriques Métriques publiées à chaque tour, NULL sinon.
+ * @return struct Serie* Statistique de chaque tour.
+ */
+struct Serie* simulerMultiechelle(const struct Parametres* parametres,
+                                 unsigned long cote, unsigned long taille_bloc,
+                                 unsigned long x, unsigned long y,
+                                 unsigned long tour_max,
+                                 struct GraphiqueFlux* graph,
+                                 unsigned long graph_direct,
+                                 struct Metriques* metriques) {
+  struct Multiechelle* multiechelle =
+      creerMultiechelle(parametres, cote, taille_bloc, time(NULL));
+  if (!multiechelle) {
+    printf("Erreur: cote doit être un multiple de la taille des blocs.\n");
+    exit(1);
+  }
+  infecterMultiechelle(multiechelle, x, y);
+  struct Serie* serie = creerSerie(cote * cote);
+  struct Statistique stats = getStatistiqueMultiechelle(multiechelle);
+  ajouterSerie(serie, stats);
+  ajouterGraphiqueFlux(graph, stats);
+  if (metriques) publierTourMetriques(metriques, 0, stats);
+  for (unsigned long i = 0;
+       i < tour_max && (stats.nb_MALADE || stats.nb_INCUBE); i++) {
+    double horloge = metriques ? horlogeMetriques() : 0;
+    jouerTourMultiechelle(multiechelle);
+    mesurerPhase(metriques, PHASE_JEU, &horloge);
+    stats = getStatistiqueMultiechelle(multiechelle);
+    ajouterSerie(serie, stats);
+    mesurerPhase(metriques, PHASE_STATISTIQUE, &horloge);
+    if (metriques) publierTourMetriques(metriques, i + 1, stats);
+    suivreGraphique(graph, stats, i + 1, graph_direct);
+    mesurerPhase(metriques, PHASE_GRAPHIQUE, &horloge);
+  }
+  detruireMultiechelle(multiechelle);
+  return serie;
+}
+
+/**
+ * @brief Simulation hors mémoire (grille plus grande que la RAM), sans
+ * affichage.
+ *
+ * @param parametres Paramètres de la simulation.
+ * @param fichier Fichier de la grille, qui garde le dernier tour.
+ * @param cote Longueur d'un côté de la grille.
+ * @param x, y Patient zero.
+ * @param tour_max Tours max de la simulation.
+ * @param graph Graphique alimenté à chaque tour.
+ * @param graph_direct Graphique affiché tous les graph_direct tours (0: non).
+ * @param metriques Métriques publiées à chaque tour, NULL sinon.
+ * @return struct Serie* Statistique de chaque tour.
+ */
+struct Serie* simulerHorsMemoire(const struct Parametres* parametres,
+                                const char* fichier, unsigned long cote,
+                                unsigned long x, unsigned long y,
+                                unsigned long tour_max,
+                                struct GraphiqueFlux* graph,
+                                unsigned long graph_direct,
+                                struct Metriques* metriques) {
+  struct HorsMemoire* hors_memoire =
+      creerHorsMemoire(fichier, cote, parametres, FENETRE_HORS_MEMOIRE);
+  if (!hors_memoire) {
+    printf("Erreur: %s n'a pas pu être créé.\n", fichier);
+    exit(1);
+  }
+  infecterHorsMemoire(hors_memoire, x, y);
+  struct Aleatoire aleatoire;
+  initAleatoire(&aleatoire, time(NULL));
+  struct Serie* serie = creerSerie(cote * cote);
+  struct Statistique stats = getStatistiqueHorsMemoire(hors_memoire);
+  ajouterSerie(serie, stats);
+  ajouterGraphiqueFlux(graph, stats);
+  if (metriques) publierTourMetriques(metriques, 0, stats);
+  for (unsigned long i = 0;
+       i < tour_max && (stats.nb_MALADE || stats.nb_INCUBE); i++) {
+    double horloge = metriques ? horlogeMetriques() : 0;
+    jouerTourHorsMemoire(hors_memoire, &aleatoire);
+    mesurerPhase(metriques, PHASE_JEU, &horloge);
+    stats = getStatistiqueHorsMemoire(hors_memoire);
+    ajouterSerie(serie, stats);
+    mesurerPhase(metriques, PHASE_STATISTIQUE, &horloge);
+    if (metriques) publierTourMetriques(metriques, i + 1, stats);
+    suivreGraphique(graph, stats, i + 1, graph_direct);
+    mesurerPhase(metriques, PHASE_GRAPHIQUE, &horloge);
+  }
+  detruireHorsMemoire(hors_memoire);
+  return serie;
+}
+
+/**
+ * @brief Lit une variante "q,cordon,vaccin" ; un champ vide vaut -1 (valeur
+ * commune).
+ *
+ * @param texte Argument de --branche.
+ * @param lus Paramètres lus (chance_quarantaine, cordon_sanitaire,
+ * chance_decouverte_vaccin).
+ */
+void lireVariante(const char* texte, struct Parametres* lus) {
+  lus->chance_quarantaine = -1;
+  lus->cordon_sanitaire = -1;
+  lus->chance_decouverte_vaccin = -1;
+  const char* champ = texte;
+  for (int c = 0; c < 3 && champ; c++) {
+    char* fin;
+    const double valeur = strtod(champ, &fin);
+    if (fin != champ) {
+      if (c == 0) lus->chance_quarantaine = valeur;
+      if (c == 1) lus->cordon_sanitaire = (int)valeur;
+      if (c == 2) lus->chance_decouverte_vaccin = valeur;
+    }
+    champ = strchr(champ, ',');
+    if (champ) champ++;
+  }
+}
+
+/**
+ * @brief Simule le préfixe commun une fois, puis chaque variante dans un
+ * processus (copie sur écriture), et compare les variantes.
+ *
+ * Les données de la variante k sont exportées dans branche_<k>_<file_data>.
+ *
+ * @param simulation Simulation initiale.
+ * @param variantes Variantes (fichier_data rempli ici).
+ * @param nb_variantes Nombre de variantes.
+ * @param tour_prefixe Tours du préfixe commun.
+ * @param tour_max Tours max de la simulation, préfixe compris.
+ * @param nb_paralleles Processus simultanés.
+ * @param file_data Nom des données brutes.
+ */
+void simulerBranches(struct Simulation* simulation,
+                     struct Variante* variantes, unsigned int nb_variantes,
+                     unsigned long tour_prefixe, unsigned long tour_max,
+                     unsigned int nb_paralleles, const char* file_data) {
+  if (tour_prefixe > tour_max) tour_prefixe = tour_max;
+  const unsigned long joues = avancerSimulation(simulation, tour_prefixe);
+  char(*fichiers)[4096] =
+      (char(*)[4096])malloc(nb_variantes * sizeof(*fichiers));
+  for (unsigned int k = 0; k < nb_variantes; k++) {
+    snprintf(fichiers[k], sizeof(*fichiers), "branche_%u_%s", k, file_data);
+    variantes[k].fichier_data = fichiers[k];
+  }
+  struct ResultatVariante* resultats = (struct ResultatVariante*)malloc(
+      nb_variantes * sizeof(struct ResultatVariante));
+  if (brancherSimulation(simulation, variantes, nb_variantes, nb_paralleles,
+                         tour_max - joues, time(NULL), resultats)) {
+    printf("Erreur: une branche n'a pas pu être simulée.\n");
+    exit(1);
+  }
+
+  printf("Branches (préfixe de %lu tours, %u processus)\n", joues,
+         nb_paralleles);
+  printf("| branche | quarantaine | cordon | vaccin | tours |       MORT |"
+         " taux d'attaque | pic MALADE |\n");
+  for (unsigned int k = 0; k < nb_variantes; k++) {
+    const struct Parametres* parametres = &variantes[k].parametres;
+    const struct ResultatVariante* resultat = &resultats[k];
+    printf("| %7u | %11.3f | %6d | %6.4f | %5lu | %10ld | %12.2f %% |"
+           " %10ld |\n",
+           k, parametres->chance_quarantaine, parametres->cordon_sanitaire,
+           parametres->chance_decouverte_vaccin, resultat->tours,
+           resultat->finale.nb_MORT, resultat->taux_attaque * 100,
+           resultat->indicateurs.pic_MALADE);
+  }
+  free(resultats);
+  free(fichiers);
+}
+
+/**
+ * @brief Calibre beta, gamma et lambda sur une série observée (ABC-SMC),
+ * affiche la loi a posteriori et l'exporte.
+ *
+ * @param calibration Problème, sans les observations.
+ * @param file_observations Série observée (format de --data).
+ * @param file_posterieure Fichier des particules acceptées.
+ */
+void calibrerParametres(struct Calibration* calibration,
+                        const char* file_observations,
+                        const char* file_posterieure) {
+  struct Data* observations = importer(file_observations);
+  if (!observations) {
+    printf("Erreur: %s n'a pas pu être chargé.\n", file_observations);
+    exit(1);
+  }
+  if (observations->population_totale !=
+      calibration->initiale->cote * calibration->initiale->cote) {
+    printf("Erreur: %s ne correspond pas à la grille.\n", file_observations);
+    exit(1);
+  }
+  calibration->observations = observations;
+  calibration->simulations_max =
+      1000 * (unsigned long)calibration->nb_particules;
+  struct Posterieure* posterieure = calibrer(calibration);
+  if (!posterieure) {
+    printf("Erreur: aucune génération complète (seuil trop bas ?).\n");
+    exit(1);
+  }
+  double moyenne[NB_INCONNUES], ecart_type[NB_INCONNUES];
+  moyennePosterieure(posterieure, moyenne, ecart_type);
+  printf("Calibration (%u générations, seuil %.4f)\n", posterieure->generations,
+         posterieure->seuil);
+  printf("  beta   = %.4f +- %.4f\n", moyenne[INCONNUE_BETA],
+         ecart_type[INCONNUE_BETA]);
+  printf("  gamma  = %.4f +- %.4f\n", moyenne[INCONNUE_GAMMA],
+         ecart_type[INCONNUE_GAMMA]);
+  printf("  lambda = %.4f +- %.4f\n", moyenne[INCONNUE_LAMBDA],
+         ecart_type[INCONNUE_LAMBDA]);
+  printf("  %lu simulations, %lu abandonnées ; %lu tours joués sur %lu\n",
+         posterieure->simulations, posterieure->abandons,
+         posterieure->tours_joues, posterieure->tours_sans_abandon);
+  if (exporterPosterieure(posterieure, file_posterieure)) {
+    printf("Erreur: %s n'a pas pu être écrit.\n", file_posterieure);
+    exit(1);
+  }
+  detruirePosterieure(posterieure);
+  detruireData(observations);
+}
+
+/**
+ * @brief Exporte les rasters sous prefixe_infection.pgm, prefixe_mort.pgm et
+ * prefixe_quarantaine.pgm.
+ *
+ * @param population Population dont les rasters sont activés.
+ * @param prefixe Préfixe des fichiers.
+ */
+void exporterRasters(const struct Population* population,
+                     const char* prefixe) {
+  const char* noms[NB_RASTERS] = {"infection", "mort", "quarantaine"};
+  char fichier[4096];
+  for (int r = 0; r < NB_RASTERS; r++) {
+    snprintf(fichier, sizeof(fichier), "%s_%s.pgm", prefixe, noms[r]);
+    if (exporterRaster(population, (enum Raster)r, fichier)) {
+      printf("Erreur: %s n'a pas pu être écrit.\n", fichier);
+      exit(1);
+    }
+  }
+}
+
+/**
+ * @brief Affiche la grille d'un tour, directement ou via le thread écrivain.
+ *
+ * @param sortie Sortie asynchrone, NULL pour afficher directement.
+ * @param population Population du tour.
+ * @param stats Statistique du tour.
+ */
+void afficherTour(struct Sortie* sortie, const struct Population* population,
+                  struct Statistique stats) {
+  if (!sortie) {
+    afficherGrillePopulation(population);
+    return;
+  }
+  publierGrille(sortie, population);
+  publierStatistique(sortie, stats);
+}
+
+/**
+ * @brief Ajoute un tour au graphique, et l'affiche tous les graph_direct tours.
+ *
+ * @param graph Graphique.
+ * @param stats Statistique du tour.
+ * @param tour Numéro du tour.
+ * @param graph_direct Période d'affichage (0: jamais).
+ */
+void suivreGraphique(struct GraphiqueFlux* graph, struct Statistique stats,
+                     unsigned long tour, unsigned long graph_direct) {
+  ajouterGraphiqueFlux(graph, stats);
+  if (graph_direct && tour % graph_direct == 0) {
+    printf("Graphique (tour %lu)\n", tour);
+    rendreGraphiqueFlux(graph, stdout, 1);
+  }
+}
+
+/**
+ * @brief Ajoute le temps écoulé depuis *horloge à une phase, puis remet
+ * l'horloge à maintenant. Ne fait rien sans métriques.
+ *
+ * @param metriques Métriques, NULL si désactivées.
+ * @param phase Phase mesurée.
+ * @param horloge Horloge du début de la phase (mise à jour).
+ */
+void mesurerPhase(struct Metriques* metriques, enum PhaseMetriques phase,
+                  double* horloge) {
+  if (!metriques) return;
+  const double maintenant = horlogeMetriques();
+  ajouterPhaseMetriques(metriques, phase, maintenant - *horloge);
+  *horloge = maintenant;
+}
+
 /**
  * @brief Affiche l'aide.
  *
@@ -165,20 +948,88 @@ Usage: ProjetS6-MarcNGUYEN-ThomasLARDY <x> <y> <cote> [options...]\n\n\
 Arguments:\n\
   x, y                    coordonnées du premier infecté\n\
   cote	                  taille de la population (grille cote x cote)\n\
+                          (x, y et cote sont ignorés avec --init)\n\
 Population Options:\n\
   -t,  --tours            tours max de la simulation               [défaut: 100]\n\
+  -i,  --init             population initiale (PGM P5 ou octets bruts)\n\
+  -me, --multiechelle     taille des blocs du mode multi-échelle  [défaut: aucun]\n\
+  -hm, --hors-memoire     grille dans ce fichier (mmap), plus grande que la\n\
+                          RAM ; quarantaine bornée au cordon     [défaut: aucun]\n\
+  -tt, --transitions      tables de transition, un tirage par case\n\
+  -bb, --bitboard         plans de bits, 64 cases par opération\n\
+                          (sans quarantaine : avec -q 0)\n\
+  -bd, --bandes           plans de bits en n bandes de lignes, un thread\n\
+                          par bande (sans quarantaine)    [défaut: aucune]\n\
+  -vz, --voisinage        compteurs de voisins contagieux, ne joue que les\n\
+                          cases actives (sans découverte du vaccin : -v 0)\n\
+  -ep, --epingler         épingle le thread de la bande k sur le cœur k\n\
+       --numa             affiche la mémoire des bandes par nœud NUMA\n\
 \n\
 Simulation Options Générales:\n\
   -b,  --mort             [0, 1] proba de mourir par la maladie    [défaut: 0.5]\n\
   -g,  --immunise         [0, 1] proba d'être immunise             [défaut: 0.1]\n\
   -la, --malade --incube  [0, 1] proba de contamination            [défaut: 1.0]\n\
+  -cl, --classes          table \"beta gamma lambda\" par classe de risque\n\
+                          (remplace -b, -g, -la)                [défaut: aucune]\n\
+  -cm, --carte-classes    classe de chaque case (PGM P5 ou octets bruts)\n\
+                                                      [défaut: tout en classe 0]\n\
+\n\
+Contacts lointains (petit monde):\n\
+  -lc, --contacts         contacts lointains par case contagieuse et par\n\
+                          tour, chacun transmet avec lambda      [défaut: aucun]\n\
+  -le, --exposant         case à distance r avec une proba en r^-exposant\n\
+                                                                     [défaut: 2]\n\
+  -lr, --rayon            distance maximale d'un contact          [défaut: cote]\n\
+  -lp, --poids-contacts   case visée selon une carte de poids (PGM P5 ou\n\
+                          octets bruts), au lieu de la distance\n\
+\n\
+Agents mobiles:\n\
+  -ag, --agents           chaque personne est un agent qui se déplace :\n\
+                          marche (aléatoire) ou trajet (domicile-travail)\n\
+                                                                [défaut: marche]\n\
+  -ap, --pas              marche : proba d'un pas par tour           [défaut: 1]\n\
+  -at, --travail          trajet : distance max domicile-travail    [défaut: 10]\n\
+  -ao, --periode          trajet : tours d'un aller-retour           [défaut: 2]\n\
+\n\
+Souches (variants):\n\
+  -so, --souches          table \"beta gamma lambda croisee\" par souche, en\n\
+                          concurrence (remplace -b, -g, -la)    [défaut: aucune]\n\
+  -si, --introduire       souche,x,y,tour : la case devient malade de la\n\
+                          souche à ce tour (répétable)          [défaut: aucune]\n\
 \n\
 Output Options:\n\
   -od, --data             nom de données brutes               [défaut: data.txt]\n\
   -og, --graph            nom du graphique               [défaut: graphique.txt]\n\
   -ot, --tableau          nom du tableau de bord   [défaut: tableau de bord.txt]\n\
+  -os, --serie            série compressée (binaire)            [défaut: aucune]\n\
+  -oi, --images           images PPM (ou PGM si .pgm) concaténées  [défaut: aucun]\n\
+  -ik, --images-chaque    une image tous les n tours                 [défaut: 1]\n\
+  -ir, --images-reduction côté d'un bloc de personnes par pixel      [défaut: 1]\n\
+  -or, --rasters          préfixe des rasters infection/mort/quarantaine\n\
+                          (PGM 16 bits, tour de l'évènement)    [défaut: aucun]\n\
   -li, --limite           limite de char/ligne du graphique ASCII   [défaut: 80]\n\
   -ha, --hauteur          hauteur du graphique ASCII                [défaut: 20]\n\
+  -gd, --graph-direct     affiche le graphique tous les n tours   [défaut: aucun]\n\
+  -as, --asynchrone       grilles et données écrites par un thread,\n\
+                          n instantanés en attente au plus       [défaut: aucun]\n\
+  -mx, --metriques        métriques HTTP (/metrics Prometheus, /json) sur\n\
+                          127.0.0.1:port ou un socket Unix    [défaut: aucune]\n\
+\n\
+Branches (préfixe commun, une variante par processus):\n\
+  -pf, --prefixe          tours communs avant les branches           [défaut: 0]\n\
+  -br, --branche          variante q,cordon,vaccin (répétable, valeur vide :\n\
+                          valeur commune), ex. -br 0.5,3,0.01 -br ,8,\n\
+  -pa, --paralleles       processus (branches) ou threads (calibration,\n\
+                          contacts, agents) simultanés     [défaut: nb de cœurs]\n\
+\n\
+Calibration ABC-SMC de beta, gamma et lambda:\n\
+  -ca, --calibrer         série observée (format de --data)      [défaut: aucune]\n\
+  -cn, --particules       particules acceptées par génération      [défaut: 100]\n\
+  -cg, --generations      générations (1 : rejet simple)             [défaut: 5]\n\
+  -cs, --seuil            seuil de la génération 0 (0 : infini)      [défaut: 0]\n\
+  -cb, --bornes           loi a priori bmin,bmax,gmin,gmax,lmin,lmax\n\
+                                                       [défaut: 0,1,0,1,0,1]\n\
+  -oc, --posterieure      particules acceptées     [défaut: posterieure.txt]\n\
 \n\
 Extension Incubation:\n\
   -di, --duree-incube     durée d'une incubation                     [défaut: 4]\n\
@@ -0,0 +1,387 @@
+/**
+ * @file metriques.c
+ *
+ * @brief Point d'accès local aux métriques d'une longue simulation.
+ *
+ * Fonctionnalités :
+ * - Compteurs publiés à chaque tour (tour, Statistique, temps par phase),
+ *   atomiques et protégés par un numéro de séquence : la boucle de
+ *   simulation n'attend jamais le serveur
+ * - Serveur HTTP sur un thread, sur 127.0.0.1:port ou sur un socket Unix
+ * - GET /metrics : jauges au format texte Prometheus
+ * - GET /json : instantané JSON
+ * - Débit (tours par seconde) et mémoire résidente calculés à la lecture
+ *
+ * Usage:
+ * ```
+ * struct Metriques *metriques = creerMetriques("9100");  // ou un chemin
+ * for (...) {
+ *   jouerTour(...);
+ *   publierTourMetriques(metriques, tour, getStatistique(population));
+ * }
+ * detruireMetriques(metriques);
+ * ```
+ * ```sh
+ * curl localhost:9100/metrics
+ * curl --unix-socket /tmp/epidemie.sock localhost/json
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "metriques.h"
+
+/**
+ * @brief Taille du tampon d'une réponse.
+ */
+#define TAILLE_REPONSE 4096
+
+/**
+ * @brief Attente maximale du serveur entre deux vérifications de l'arrêt (ms).
+ */
+#define ATTENTE_SERVEUR 100
+
+/**
+ * @brief Noms des phases, dans l'ordre de enum PhaseMetriques.
+ */
+static const char *const NOMS_PHASES[NB_PHASES] = {
+    "jeu", "statistique", "affichage", "images", "graphique"};
+
+/**
+ * @brief Noms des états, dans l'ordre de struct Statistique.
+ */
+static const char *const NOMS_ETATS[6] = {"IMMUNISE", "SAIN",   "MORT",
+                                          "MALADE",   "INCUBE", "VACCINE"};
+
+/**
+ * @brief Horloge monotone.
+ *
+ * @return double Secondes.
+ */
+double horlogeMetriques(void) {
+  struct timespec maintenant;
+  clock_gettime(CLOCK_MONOTONIC, &maintenant);
+  return (double)maintenant.tv_sec + (double)maintenant.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Mémoire résidente du processus, lue dans /proc/self/statm.
+ *
+ * @return long Octets, -1 si indisponible.
+ */
+static long lireRss(void) {
+  FILE *statm = fopen("/proc/self/statm", "r");
+  if (!statm) return -1;
+  long taille, residente;
+  const int lus = fscanf(statm, "%ld %ld", &taille, &residente);
+  fclose(statm);
+  return lus == 2 ? residente * sysconf(_SC_PAGESIZE) : -1;
+}
+
+/**
+ * @brief Répond à une requête HTTP, puis ferme la connexion.
+ *
+ * @param metriques Métriques.
+ * @param client Socket de la connexion.
+ */
+static void servir(struct Metriques *metriques, int client) {
+  // Pas de client lent : la requête doit arriver en une seconde
+  const struct timeval delai = {1, 0};
+  setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &delai, sizeof(delai));
+  char requete[1024];
+  const ssize_t lus = recv(client, requete, sizeof(requete) - 1, 0);
+  if (lus <= 0) return;
+  requete[lus] = '\0';
+
+  struct ReleveMetriques releve;
+  releverMetriques(metriques, &releve);
+  char corps[TAILLE_REPONSE];
+  const char *type = "text/plain; version=0.0.4";
+  const char *statut = "200 OK";
+  if (!strncmp(requete, "GET /metrics", 12)) {
+    formaterPrometheus(&releve, corps, sizeof(corps));
+  } else if (!strncmp(requete, "GET /json", 9)) {
+    type = "application/json";
+    formaterJson(&releve, corps, sizeof(corps));
+  } else {
+    statut = "404 Not Found";
+    snprintf(corps, sizeof(corps), "/metrics ou /json\n");
+  }
+  char reponse[TAILLE_REPONSE + 256];
+  const int taille = snprintf(reponse, sizeof(reponse),
+                              "HTTP/1.0 %s\r\nContent-Type: %s\r\n"
+                              "Content-Length: %zu\r\nConnection: close\r\n"
+                              "\r\n%s",
+                              statut, type, strlen(corps), corps);
+  for (int envoyes = 0; envoyes < taille;) {
+    const ssize_t n = send(client, reponse + envoyes,
+                           (size_t)(taille - envoyes), MSG_NOSIGNAL);
+    if (n <= 0) break;
+    envoyes += (int)n;
+  }
+  atomic_fetch_add_explicit(&metriques->requetes, 1, memory_order_relaxed);
+}
+
+/**
+ * @brief Boucle du serveur : une requête à la fois, jusqu'à l'arrêt.
+ *
+ * @param argument struct Metriques*.
+ * @return void* NULL.
+ */
+static void *executerServeur(void *argument) {
+  struct Metriques *metriques = (struct Metriques *)argument;
+  struct pollfd attente = {.fd = metriques->ecoute, .events = POLLIN};
+  while (!atomic_load_explicit(&metriques->arret, memory_order_acquire)) {
+    if (poll(&attente, 1, ATTENTE_SERVEUR) <= 0) continue;
+    const int client = accept(metriques->ecoute, NULL, NULL);
+    if (client < 0) continue;
+    servir(metriques, client);
+    close(client);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Ouvre le socket d'écoute : port TCP sur 127.0.0.1 si l'adresse est
+ * un nombre, socket Unix sinon.
+ *
+ * @param metriques Métriques (ecoute, port, chemin remplis).
+ * @param adresse Port ("9100", "0" pour un port libre) ou chemin.
+ * @return int 0, ou -1 en cas d'échec.
+ */
+static int ouvrirEcoute(struct Metriques *metriques, const char *adresse) {
+  char *fin;
+  const unsigned long port = strtoul(adresse, &fin, 10);
+  if (*adresse && !*fin) {
+    if (port > 65535) return -1;
+    metriques->ecoute = socket(AF_INET, SOCK_STREAM, 0);
+    if (metriques->ecoute < 0) return -1;
+    const int oui = 1;
+    setsockopt(metriques->ecoute, SOL_SOCKET, SO_REUSEADDR, &oui, sizeof(oui));
+    struct sockaddr_in ip = {.sin_family = AF_INET,
+                             .sin_port = htons((unsigned short)port),
+                             .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    socklen_t longueur = sizeof(ip);
+    if (bind(metriques->ecoute, (struct sockaddr *)&ip, sizeof(ip)) ||
+        getsockname(metriques->ecoute, (struct sockaddr *)&ip, &longueur))
+      return -1;
+    metriques->port = ntohs(ip.sin_port);
+  } else {
+    struct sockaddr_un unix_ = {.sun_family = AF_UNIX};
+    if (strlen(adresse) >= sizeof(unix_.sun_path)) return -1;
+    metriques->ecoute = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (metriques->ecoute < 0) return -1;
+    strcpy(unix_.sun_path, adresse);
+    unlink(adresse);  // Socket laissé par une exécution précédente
+    if (bind(metriques->ecoute, (struct sockaddr *)&unix_, sizeof(unix_)))
+      return -1;
+    strcpy(metriques->chemin, adresse);
+  }
+  return listen(metriques->ecoute, 16);
+}
+
+/**
+ * @brief Créer les métriques et démarrer le serveur.
+ *
+ * @param adresse Port TCP sur 127.0.0.1 ("0" : port libre, lu dans
+ * metriques->port) ou chemin d'un socket Unix.
+ * @return struct Metriques* Métriques, NULL si l'écoute a échoué.
+ */
+struct Metriques *creerMetriques(const char *adresse) {
+  struct Metriques *metriques =
+      (struct Metriques *)malloc(sizeof(struct Metriques));
+  atomic_init(&metriques->sequence, 0);
+  atomic_init(&metriques->tour, 0);
+  for (int e = 0; e < 6; e++) atomic_init(&metriques->compteurs[e], 0);
+  for (int p = 0; p < NB_PHASES; p++)
+    atomic_init(&metriques->nanosecondes[p], 0);
+  atomic_init(&metriques->tours_publies, 0);
+  atomic_init(&metriques->requetes, 0);
+  atomic_init(&metriques->arret, 0);
+  metriques->debut = horlogeMetriques();
+  metriques->ecoute = -1;
+  metriques->port = 0;
+  metriques->chemin[0] = '\0';
+  if (ouvrirEcoute(metriques, adresse) ||
+      pthread_create(&metriques->serveur, NULL, executerServeur, metriques)) {
+    if (metriques->ecoute >= 0) close(metriques->ecoute);
+    if (metriques->chemin[0]) unlink(metriques->chemin);
+    free(metriques);
+    return NULL;
+  }
+  return metriques;
+}
+
+/**
+ * @brief Publie le tour et ses Statistique (thread de simulation).
+ *
+ * Sans attente : le serveur relit si une publication l'a interrompu.
+ *
+ * @param metriques Métriques.
+ * @param tour Numéro du tour.
+ * @param stats Statistique du tour.
+ */
+void publierTourMetriques(struct Metriques *metriques, unsigned long tour,
+                          struct Statistique stats) {
+  const long compteurs[6] = {stats.nb_IMMUNISE, stats.nb_SAIN,
+                             stats.nb_MORT,     stats.nb_MALADE,
+                             stats.nb_INCUBE,   stats.nb_VACCINE};
+  const unsigned long sequence =
+      atomic_load_explicit(&metriques->sequence, memory_order_relaxed);
+  atomic_store_explicit(&metriques->sequence, sequence + 1,
+                        memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit(&metriques->tour, tour, memory_order_relaxed);
+  for (int e = 0; e < 6; e++)
+    atomic_store_explicit(&metriques->compteurs[e], compteurs[e],
+                          memory_order_relaxed);
+  atomic_store_explicit(&metriques->sequence, sequence + 2,
+                        memory_order_release);
+  atomic_fetch_add_explicit(&metriques->tours_publies, 1,
+                            memory_order_relaxed);
+}
+
+/**
+ * @brief Ajoute une durée à une phase (thread de simulation).
+ *
+ * @param metriques Métriques.
+ * @param phase Phase.
+ * @param secondes Durée.
+ */
+void ajouterPhaseMetriques(struct Metriques *metriques,
+                           enum PhaseMetriques phase, double secondes) {
+  atomic_fetch_add_explicit(&metriques->nanosecondes[phase],
+                            (unsigned long)(secondes * 1e9),
+                            memory_order_relaxed);
+}
+
+/**
+ * @brief Relevé cohérent : le tour et ses Statistique viennent de la même
+ * publication.
+ *
+ * @param metriques Métriques.
+ * @param releve Relevé rempli.
+ */
+void releverMetriques(struct Metriques *metriques,
+                      struct ReleveMetriques *releve) {
+  long compteurs[6];
+  unsigned long avant, apres;
+  do {
+    avant = atomic_load_explicit(&metriques->sequence, memory_order_acquire);
+    releve->tour = atomic_load_explicit(&metriques->tour, memory_order_relaxed);
+    for (int e = 0; e < 6; e++)
+      compteurs[e] =
+          atomic_load_explicit(&metriques->compteurs[e], memory_order_relaxed);
+    atomic_thread_fence(memory_order_acquire);
+    apres = atomic_load_explicit(&metriques->sequence, memory_order_relaxed);
+  } while (avant != apres || avant % 2);
+  releve->stats = (struct Statistique){compteurs[0], compteurs[1],
+                                       compteurs[2], compteurs[3],
+                                       compteurs[4], compteurs[5]};
+  for (int p = 0; p < NB_PHASES; p++)
+    releve->phases[p] = (double)atomic_load_explicit(
+                            &metriques->nanosecondes[p],
+                            memory_order_relaxed) * 1e-9;
+  releve->secondes = horlogeMetriques() - metriques->debut;
+  const unsigned long tours =
+      atomic_load_explicit(&metriques->tours_publies, memory_order_relaxed);
+  releve->tours_par_seconde =
+      releve->secondes > 0 ? (double)tours / releve->secondes : 0;
+  releve->rss = lireRss();
+}
+
+/**
+ * @brief Met un relevé au format texte Prometheus.
+ *
+ * @param releve Relevé.
+ * @param tampon Tampon de sortie.
+ * @param taille Taille du tampon.
+ * @return size_t Longueur écrite (tronquée à taille - 1).
+ */
+size_t formaterPrometheus(const struct ReleveMetriques *releve, char *tampon,
+                          size_t taille) {
+  const long compteurs[6] = {
+      releve->stats.nb_IMMUNISE, releve->stats.nb_SAIN,
+      releve->stats.nb_MORT,     releve->stats.nb_MALADE,
+      releve->stats.nb_INCUBE,   releve->stats.nb_VACCINE};
+  size_t n = 0;
+#define ECRIRE(...)                                               \
+  if (n < taille) n += (size_t)snprintf(tampon + n, taille - n, __VA_ARGS__)
+  ECRIRE("# HELP epidemie_tour Dernier tour joué.\n"
+         "# TYPE epidemie_tour gauge\nepidemie_tour %lu\n",
+         releve->tour);
+  ECRIRE("# HELP epidemie_personnes Personnes par état au dernier tour.\n"
+         "# TYPE epidemie_personnes gauge\n");
+  for (int e = 0; e < 6; e++)
+    ECRIRE("epidemie_personnes{etat=\"%s\"} %ld\n", NOMS_ETATS[e],
+           compteurs[e]);
+  ECRIRE("# HELP epidemie_tours_par_seconde Débit moyen depuis le début.\n"
+         "# TYPE epidemie_tours_par_seconde gauge\n"
+         "epidemie_tours_par_seconde %.3f\n",
+         releve->tours_par_seconde);
+  ECRIRE("# HELP epidemie_phase_secondes Temps cumulé par phase.\n"
+         "# TYPE epidemie_phase_secondes gauge\n");
+  for (int p = 0; p < NB_PHASES; p++)
+    ECRIRE("epidemie_phase_secondes{phase=\"%s\"} %.6f\n", NOMS_PHASES[p],
+           releve->phases[p]);
+  ECRIRE("# HELP epidemie_secondes Secondes depuis le début.\n"
+         "# TYPE epidemie_secondes gauge\nepidemie_secondes %.3f\n",
+         releve->secondes);
+  ECRIRE("# HELP epidemie_rss_octets Mémoire résidente du processus.\n"
+         "# TYPE epidemie_rss_octets gauge\nepidemie_rss_octets %ld\n",
+         releve->rss);
+#undef ECRIRE
+  return n < taille ? n : taille - 1;
+}
+
+/**
+ * @brief Met un relevé au format JSON.
+ *
+ * @param releve Relevé.
+ * @param tampon Tampon de sortie.
+ * @param taille Taille du tampon.
+ * @return size_t Longueur écrite (tronquée à taille - 1).
+ */
+size_t formaterJson(const struct ReleveMetriques *releve, char *tampon,
+                    size_t taille) {
+  const int n = snprintf(
+      tampon, taille,
+      "{\"tour\": %lu, \"statistique\": {\"IMMUNISE\": %ld, \"SAIN\": %ld, "
+      "\"MORT\": %ld, \"MALADE\": %ld, \"INCUBE\": %ld, \"VACCINE\": %ld}, "
+      "\"tours_par_seconde\": %.3f, \"phases\": {\"%s\": %.6f, \"%s\": %.6f, "
+      "\"%s\": %.6f, \"%s\": %.6f, \"%s\": %.6f}, \"secondes\": %.3f, "
+      "\"rss_octets\": %ld}\n",
+      releve->tour, releve->stats.nb_IMMUNISE, releve->stats.nb_SAIN,
+      releve->stats.nb_MORT, releve->stats.nb_MALADE, releve->stats.nb_INCUBE,
+      releve->stats.nb_VACCINE, releve->tours_par_seconde, NOMS_PHASES[0],
+      releve->phases[0], NOMS_PHASES[1], releve->phases[1], NOMS_PHASES[2],
+      releve->phases[2], NOMS_PHASES[3], releve->phases[3], NOMS_PHASES[4],
+      releve->phases[4], releve->secondes, releve->rss);
+  return (size_t)n < taille ? (size_t)n : taille - 1;
+}
+
+/**
+ * @brief Arrête le serveur, ferme le socket et libère.
+ *
+ * @param metriques Métriques.
+ */
+void detruireMetriques(struct Metriques *metriques) {
+  atomic_store_explicit(&metriques->arret, 1, memory_order_release);
+  pthread_join(metriques->serveur, NULL);
+  close(metriques->ecoute);
+  if (metriques->chemin[0]) unlink(metriques->chemin);
+  free(metriques);
+}
@@ -0,0 +1,125 @@
+#if !defined(METRIQUES_H)
+#define METRIQUES_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+#include "statistique.h"
+
+/**
+ * @brief Phases chronométrées d'un tour.
+ */
+enum PhaseMetriques {
+  PHASE_JEU,           // Règles du tour (noyau, transitions, bitboard...)
+  PHASE_STATISTIQUE,   // Comptage et appendData
+  PHASE_AFFICHAGE,     // Grille ASCII ou publication asynchrone
+  PHASE_IMAGES,        // Film PPM/PGM
+  PHASE_GRAPHIQUE,     // Graphique ASCII
+  NB_PHASES
+};
+
+/**
+ * @brief Relevé cohérent des métriques, pris par le serveur.
+ */
+struct ReleveMetriques {
+  /**
+   * @brief Dernier tour publié.
+   */
+  unsigned long tour;
+  /**
+   * @brief Statistique du dernier tour publié.
+   */
+  struct Statistique stats;
+  /**
+   * @brief Secondes cumulées par phase.
+   */
+  double phases[NB_PHASES];
+  /**
+   * @brief Secondes écoulées depuis creerMetriques.
+   */
+  double secondes;
+  /**
+   * @brief Tours publiés par seconde depuis creerMetriques.
+   */
+  double tours_par_seconde;
+  /**
+   * @brief Mémoire résidente du processus (octets), -1 si inconnue.
+   */
+  long rss;
+};
+
+/**
+ * @brief Point d'accès local aux métriques d'une simulation en cours.
+ *
+ * La simulation publie des compteurs atomiques, protégés par un numéro de
+ * séquence (seqlock) : elle n'attend jamais. Un thread serveur répond en
+ * HTTP sur 127.0.0.1 ou sur un socket Unix : /metrics (Prometheus) et
+ * /json (instantané).
+ */
+struct Metriques {
+  /**
+   * @brief Numéro de séquence, impair pendant une publication.
+   */
+  atomic_ulong sequence;
+  /**
+   * @brief Dernier tour publié.
+   */
+  atomic_ulong tour;
+  /**
+   * @brief Compteurs du dernier tour, dans l'ordre de struct Statistique.
+   */
+  atomic_long compteurs[6];
+  /**
+   * @brief Nanosecondes cumulées par phase.
+   */
+  atomic_ulong nanosecondes[NB_PHASES];
+  /**
+   * @brief Nombre de tours publiés.
+   */
+  atomic_ulong tours_publies;
+  /**
+   * @brief Horloge (s) à la création.
+   */
+  double debut;
+  /**
+   * @brief Socket d'écoute.
+   */
+  int ecoute;
+  /**
+   * @brief Port TCP d'écoute, 0 pour un socket Unix.
+   */
+  unsigned short port;
+  /**
+   * @brief Chemin du socket Unix, supprimé à la destruction ("" en TCP).
+   */
+  char chemin[108];
+  /**
+   * @brief Nombre de requêtes servies (thread serveur).
+   */
+  atomic_ulong requetes;
+  /**
+   * @brief Vrai pour arrêter le serveur.
+   */
+  atomic_int arret;
+  /**
+   * @brief Thread serveur.
+   */
+  pthread_t serveur;
+};
+
+double horlogeMetriques(void);
+struct Metriques *creerMetriques(const char *adresse);
+void publierTourMetriques(struct Metriques *metriques, unsigned long tour,
+                          struct Statistique stats);
+void ajouterPhaseMetriques(struct Metriques *metriques,
+                           enum PhaseMetriques phase, double secondes);
+void releverMetriques(struct Metriques *metriques,
+                      struct ReleveMetriques *releve);
+size_t formaterPrometheus(const struct ReleveMetriques *releve, char *tampon,
+                          size_t taille);
+size_t formaterJson(const struct ReleveMetriques *releve, char *tampon,
+                    size_t taille);
+void detruireMetriques(struct Metriques *metriques);
+
+#endif  // METRIQUES_H
@@ -0,0 +1,572 @@
+/**
+ * @file multiechelle.c
+ *
+ * @brief Grille hybride métapopulation / grille fine.
+ *
+ * La grille est découpée en blocs taille_bloc*taille_bloc. Loin du front de
+ * l'épidémie, un bloc est agrégé : il ne garde que ses effectifs SAIN, MORT,
+ * IMMUNISE et VACCINE, et seule la vaccination y est simulée, à l'échelle du
+ * bloc (tirages binomiaux). Près du front, le bloc est fin : chaque Personne
+ * suit les règles de jouerTour.
+ *
+ * Fonctionnalités :
+ * - Raffiner un bloc quand un bloc voisin contient des MALADE/INCUBE
+ * - Agréger un bloc redevenu calme (ni MALADE, ni INCUBE, ni quarantaine)
+ * - Statistique exactes (les effectifs sont conservés par bloc)
+ *
+ * Approximations :
+ * - Dans un bloc agrégé, la propagation du vaccin est estimée par la taille
+ *   du front (4 * racine des VACCINE) plus l'apport des blocs voisins.
+ * - A l'agrégation, la position des VACCINE/IMMUNISE/MORT est oubliée : un bloc
+ *   raffiné les replace au hasard.
+ * - La quarantaine ne s'étend pas aux blocs agrégés.
+ *
+ * Usage:
+ * ```
+ * struct Multiechelle *multiechelle =
+ *     creerMultiechelle(&parametres, 100000, 100, 42);
+ * infecterMultiechelle(multiechelle, 50000, 50000);
+ * for (int i = 0; i < tour_max; i++) {
+ *   jouerTourMultiechelle(multiechelle);
+ *   struct Statistique stats = getStatistiqueMultiechelle(multiechelle);
+ * }
+ * detruireMultiechelle(multiechelle);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "multiechelle.h"
+
+/**
+ * @brief Nombre de MALADE/INCUBE d'un bloc.
+ */
+static inline long zombiesBloc(const struct Bloc *bloc) {
+  return bloc->stats.nb_MALADE + bloc->stats.nb_INCUBE;
+}
+
+/**
+ * @brief Accès à une Personne par ses coordonnées globales.
+ *
+ * @param multiechelle Grille.
+ * @param x Ligne.
+ * @param y Colonne.
+ * @param tampon Si vrai, lit dans le tampon du tour suivant.
+ * @return struct Personne* Personne, NULL si son bloc est agrégé.
+ */
+static inline struct Personne *cellule(const struct Multiechelle *multiechelle,
+                                       unsigned long x, unsigned long y,
+                                       char tampon) {
+  const unsigned long t = multiechelle->taille_bloc;
+  const struct Bloc *bloc =
+      &multiechelle->blocs[(x / t) * multiechelle->blocs_par_cote + y / t];
+  struct Personne *personnes = tampon ? bloc->tampon : bloc->personnes;
+  if (!personnes) return NULL;
+  return &personnes[(x % t) * t + y % t];
+}
+
+/**
+ * @brief Ajoute une Personne aux effectifs.
+ */
+static inline void compter(struct Statistique *stats, enum State state) {
+  switch (state) {
+    case IMMUNISE:
+      stats->nb_IMMUNISE++;
+      break;
+    case SAIN:
+      stats->nb_SAIN++;
+      break;
+    case MALADE:
+      stats->nb_MALADE++;
+      break;
+    case MORT:
+      stats->nb_MORT++;
+      break;
+    case INCUBE:
+      stats->nb_INCUBE++;
+      break;
+    case VACCINE:
+      stats->nb_VACCINE++;
+      break;
+  }
+}
+
+/**
+ * @brief Matérialise les Personne d'un bloc agrégé.
+ *
+ * Les effectifs sont conservés, les positions sont tirées au hasard.
+ *
+ * @param multiechelle Grille.
+ * @param bloc Bloc agrégé.
+ */
+static void raffinerBloc(struct Multiechelle *multiechelle,
+                         struct Bloc *bloc) {
+  const unsigned long n = multiechelle->taille_bloc * multiechelle->taille_bloc;
+  struct Personne *personnes =
+      (struct Personne *)calloc(n, sizeof(struct Personne));
+  unsigned long k = bloc->stats.nb_SAIN;  // SAIN == 0
+  for (long i = 0; i < bloc->stats.nb_MORT; i++) personnes[k++].state = MORT;
+  for (long i = 0; i < bloc->stats.nb_IMMUNISE; i++)
+    personnes[k++].state = IMMUNISE;
+  for (long i = 0; i < bloc->stats.nb_VACCINE; i++)
+    personnes[k++].state = VACCINE;
+  // Fisher-Yates
+  for (unsigned long i = n - 1; i > 0; i--) {
+    unsigned long j = aleatoireEntier(&multiechelle->aleatoire) % (i + 1);
+    enum State state = personnes[i].state;
+    personnes[i].state = personnes[j].state;
+    personnes[j].state = state;
+  }
+  bloc->personnes = personnes;
+  bloc->tampon = (struct Personne *)malloc(n * sizeof(struct Personne));
+  multiechelle->nb_blocs_fins++;
+}
+
+/**
+ * @brief Oublie les Personne d'un bloc calme, seuls les effectifs restent.
+ *
+ * @param multiechelle Grille.
+ * @param bloc Bloc fin sans MALADE/INCUBE.
+ */
+static void agregerBloc(struct Multiechelle *multiechelle, struct Bloc *bloc) {
+  free(bloc->personnes);
+  free(bloc->tampon);
+  bloc->personnes = NULL;
+  bloc->tampon = NULL;
+  multiechelle->nb_blocs_fins--;
+}
+
+/**
+ * @brief Créer une grille multi-échelle saine, entièrement agrégée.
+ *
+ * @param parametres Paramètres (copiés).
+ * @param cote Longueur d'un côté de la grille, multiple de taille_bloc.
+ * @param taille_bloc Longueur d'un côté d'un bloc.
+ * @param graine Graine du générateur.
+ * @return struct Multiechelle* Grille, NULL si cote n'est pas un multiple de
+ * taille_bloc.
+ */
+struct Multiechelle *creerMultiechelle(const struct Parametres *parametres,
+                                       unsigned long cote,
+                                       unsigned long taille_bloc,
+                                       unsigned long graine) {
+  if (!taille_bloc || !cote || cote % taille_bloc) return NULL;
+  struct Multiechelle *multiechelle =
+      (struct Multiechelle *)malloc(sizeof(struct Multiechelle));
+  multiechelle->cote = cote;
+  multiechelle->taille_bloc = taille_bloc;
+  multiechelle->blocs_par_cote = cote / taille_bloc;
+  const unsigned long nb_blocs =
+      multiechelle->blocs_par_cote * multiechelle->blocs_par_cote;
+  multiechelle->blocs = (struct Bloc *)calloc(nb_blocs, sizeof(struct Bloc));
+  for (unsigned long b = 0; b < nb_blocs; b++)
+    multiechelle->blocs[b].stats.nb_SAIN = taille_bloc * taille_bloc;
+  multiechelle->nb_blocs_fins = 0;
+  multiechelle->parametres = *parametres;
+  initAleatoire(&multiechelle->aleatoire, graine);
+  multiechelle->tour = 0;
+  initZones(&multiechelle->zones);
+  return multiechelle;
+}
+
+/**
+ * @brief Rend MALADE la Personne (x, y), en raffinant son bloc si besoin.
+ *
+ * @param multiechelle Grille.
+ * @param x Ligne.
+ * @param y Colonne.
+ */
+void infecterMultiechelle(struct Multiechelle *multiechelle, unsigned long x,
+                          unsigned long y) {
+  const unsigned long t = multiechelle->taille_bloc;
+  struct Bloc *bloc =
+      &multiechelle->blocs[(x / t) * multiechelle->blocs_par_cote + y / t];
+  if (!bloc->personnes) raffinerBloc(multiechelle, bloc);
+  struct Personne *personne = cellule(multiechelle, x, y, 0);
+  switch (personne->state) {
+    case IMMUNISE:
+      bloc->stats.nb_IMMUNISE--;
+      break;
+    case SAIN:
+      bloc->stats.nb_SAIN--;
+      break;
+    case MALADE:
+      bloc->stats.nb_MALADE--;
+      break;
+    case MORT:
+      bloc->stats.nb_MORT--;
+      break;
+    case INCUBE:
+      bloc->stats.nb_INCUBE--;
+      break;
+    case VACCINE:
+      bloc->stats.nb_VACCINE--;
+      break;
+  }
+  personne->state = MALADE;
+  bloc->stats.nb_MALADE++;
+}
+
+/**
+ * @brief Lit une Personne.
+ *
+ * @param multiechelle Grille.
+ * @param x Ligne.
+ * @param y Colonne.
+ * @return const struct Personne* Personne, NULL si son bloc est agrégé.
+ */
+const struct Personne *getPersonneMultiechelle(
+    const struct Multiechelle *multiechelle, unsigned long x, unsigned long y) {
+  return cellule(multiechelle, x, y, 0);
+}
+
+/**
+ * @brief Vrai si la Personne (x, y) est VACCINE. Dans un bloc agrégé, tiré
+ * selon la proportion de VACCINE du bloc.
+ */
+static char estVaccine(struct Multiechelle *multiechelle, unsigned long x,
+                       unsigned long y) {
+  const struct Personne *personne = cellule(multiechelle, x, y, 0);
+  if (personne) return personne->state == VACCINE;
+  const unsigned long t = multiechelle->taille_bloc;
+  const struct Bloc *bloc =
+      &multiechelle->blocs[(x / t) * multiechelle->blocs_par_cote + y / t];
+  return bloc->stats.nb_VACCINE &&
+         aleatoireUniforme(&multiechelle->aleatoire) <
+             (double)bloc->stats.nb_VACCINE / (t * t);
+}
+
+/**
+ * @brief Vrai si la zone d'une Personne est levée au tour tour.
+ */
+static inline int estLibre(const struct Multiechelle *multiechelle,
+                           const struct Personne *personne,
+                           unsigned long tour) {
+  return multiechelle->zones.expirations[personne->zone] <= tour;
+}
+
+/**
+ * @brief Vrai si la Personne (x, y) peut infecter la Personne cible (toutes
+ * deux en quarantaine ou toutes deux libres). Un bloc agrégé n'infecte
+ * jamais.
+ */
+static inline char estContagieux(const struct Multiechelle *multiechelle,
+                                 unsigned long x, unsigned long y,
+                                 const struct Personne *cible) {
+  const struct Personne *personne = cellule(multiechelle, x, y, 0);
+  return personne &&
+         (personne->state == MALADE || personne->state == INCUBE) &&
+         (personne->zone == cible->zone ||
+          estLibre(multiechelle, personne, multiechelle->tour) ==
+              estLibre(multiechelle, cible, multiechelle->tour));
+}
+
+/**
+ * @brief Partie récursive de mettreEnQuarantaineMultiechelle.
+ *
+ * Même règles que mettreEnQuarantaineRecurse, limitées aux blocs fins. Le
+ * cordon_sanitaire d'une Personne hors de la zone vaut 0 pour le parcours.
+ */
+static void mettreEnQuarantaineMultiechelleRecurse(
+    struct Multiechelle *multiechelle, unsigned long x, unsigned long y,
+    int cordon_sanitaire, uint32_t zone) {
+  struct Personne *personne = cellule(multiechelle, x, y, 1);
+  personne->zone = zone;
+  personne->cordon_sanitaire = cordon_sanitaire;
+
+  const unsigned long cote = multiechelle->cote;
+  const long dx[4] = {-1, 1, 0, 0};  // NORD, SUD, OUEST, EST
+  const long dy[4] = {0, 0, -1, 1};
+  for (int d = 0; d < 4; d++) {
+    if ((dx[d] < 0 && x == 0) || (dx[d] > 0 && x == cote - 1) ||
+        (dy[d] < 0 && y == 0) || (dy[d] > 0 && y == cote - 1))
+      continue;
+    const unsigned long vx = x + dx[d], vy = y + dy[d];
+    struct Personne *voisin = cellule(multiechelle, vx, vy, 1);
+    if (!voisin ||
+        (voisin->zone == zone ? voisin->cordon_sanitaire : 0) >=
+            cordon_sanitaire)
+      continue;
+    if (voisin->state == MALADE || voisin->state == MORT)
+      mettreEnQuarantaineMultiechelleRecurse(multiechelle, vx, vy,
+                                             cordon_sanitaire, zone);
+    else if (cordon_sanitaire > 0)
+      mettreEnQuarantaineMultiechelleRecurse(multiechelle, vx, vy,
+                                             cordon_sanitaire - 1, zone);
+  }
+}
+
+/**
+ * @brief Met en quarantaine le secteur autour de (x, y) dans le tampon, dans
+ * une zone neuve levée après parametres.duree_quarantaine tours.
+ */
+static void mettreEnQuarantaineMultiechelle(struct Multiechelle *multiechelle,
+                                            unsigned long x, unsigned long y) {
+  const uint32_t zone =
+      ajouterZone(&multiechelle->zones,
+                  multiechelle->tour + 1 +
+                      multiechelle->parametres.duree_quarantaine);
+  if (zone)
+    mettreEnQuarantaineMultiechelleRecurse(
+        multiechelle, x, y, multiechelle->parametres.cordon_sanitaire, zone);
+}
+
+/**
+ * @brief Joue un tour pour une Personne d'un bloc fin (règles de jouerTour).
+ *
+ * @return enum State Etat de la Personne au tour suivant.
+ */
+static enum State jouerPersonne(struct Multiechelle *multiechelle,
+                                unsigned long i, unsigned long j) {
+  const struct Parametres *parametres = &multiechelle->parametres;
+  struct Aleatoire *aleatoire = &multiechelle->aleatoire;
+  const unsigned long cote = multiechelle->cote;
+  const struct Personne *personne = cellule(multiechelle, i, j, 0);
+  struct Personne *tampon = cellule(multiechelle, i, j, 1);
+  int voisin;
+
+  switch (personne->state) {
+    case SAIN:
+      // Vaccination par découverte du vaccin
+      if (aleatoireUniforme(aleatoire) < parametres->chance_decouverte_vaccin)
+        return tampon->state = VACCINE;
+      // Vaccination par propagation
+      if ((j > 0 && estVaccine(multiechelle, i, j - 1)) ||
+          (j < cote - 1 && estVaccine(multiechelle, i, j + 1)) ||
+          (i > 0 && estVaccine(multiechelle, i - 1, j)) ||
+          (i < cote - 1 && estVaccine(multiechelle, i + 1, j)))
+        return tampon->state = VACCINE;
+      // Infection
+      voisin = 0;
+      if (j > 0)
+        voisin += estContagieux(multiechelle, i, j - 1, personne);
+      if (j < cote - 1)
+        voisin += estContagieux(multiechelle, i, j + 1, personne);
+      if (i > 0)
+        voisin += estContagieux(multiechelle, i - 1, j, personne);
+      if (i < cote - 1)
+        voisin += estContagieux(multiechelle, i + 1, j, personne);
+      for (; voisin > 0; voisin--) {
+        if (aleatoireUniforme(aleatoire) < parametres->lambda) {
+          tampon->duree_incube = parametres->duree_incube;
+          return tampon->state = INCUBE;
+        }
+      }
+      return SAIN;
+
+    case MALADE:
+      // Mettre en QUARANTAINE ainsi que ses voisins
+      if (aleatoireUniforme(aleatoire) < parametres->chance_quarantaine &&
+          estLibre(multiechelle, tampon, multiechelle->tour + 1))
+        mettreEnQuarantaineMultiechelle(multiechelle, i, j);
+      if (aleatoireUniforme(aleatoire) < parametres->beta)
+        return tampon->state = MORT;
+      if (aleatoireUniforme(aleatoire) < parametres->gamma)
+        return tampon->state = IMMUNISE;
+      return MALADE;
+
+    case INCUBE:
+      if (personne->duree_incube == 0) return tampon->state = MALADE;
+      tampon->duree_incube--;
+      return INCUBE;
+
+    case IMMUNISE:
+      if (aleatoireUniforme(aleatoire) < parametres->chance_decouverte_vaccin)
+        return tampon->state = VACCINE;
+      if ((j > 0 && estVaccine(multiechelle, i, j - 1)) ||
+          (j < cote - 1 && estVaccine(multiechelle, i, j + 1)) ||
+          (i > 0 && estVaccine(multiechelle, i - 1, j)) ||
+          (i < cote - 1 && estVaccine(multiechelle, i + 1, j)))
+        return tampon->state = VACCINE;
+      return IMMUNISE;
+
+    default:
+      return personne->state;
+  }
+}
+
+/**
+ * @brief Vaccination d'un bloc agrégé : découverte (binomiale) et propagation
+ * estimée par la longueur du front.
+ *
+ * @param multiechelle Grille.
+ * @param bx Ligne du bloc.
+ * @param by Colonne du bloc.
+ */
+static void jouerBlocAgrege(struct Multiechelle *multiechelle,
+                            unsigned long bx, unsigned long by) {
+  const unsigned long nb = multiechelle->blocs_par_cote;
+  const unsigned long t = multiechelle->taille_bloc;
+  struct Bloc *bloc = &multiechelle->blocs[bx * nb + by];
+  struct Statistique *stats = &bloc->stats;
+  if (!stats->nb_SAIN && !stats->nb_IMMUNISE) return;
+
+  // Front : bord des zones vaccinées du bloc et des blocs voisins
+  const struct Bloc *blocs = multiechelle->blocs;
+  double front = stats->nb_VACCINE ? 4 * ceil(sqrt(stats->nb_VACCINE)) : 0;
+  if (bx > 0) front += (double)blocs[(bx - 1) * nb + by].stats.nb_VACCINE / t;
+  if (bx < nb - 1)
+    front += (double)blocs[(bx + 1) * nb + by].stats.nb_VACCINE / t;
+  if (by > 0) front += (double)blocs[bx * nb + by - 1].stats.nb_VACCINE / t;
+  if (by < nb - 1)
+    front += (double)blocs[bx * nb + by + 1].stats.nb_VACCINE / t;
+
+  struct Aleatoire *aleatoire = &multiechelle->aleatoire;
+  const double p = multiechelle->parametres.chance_decouverte_vaccin;
+  long vaccines_SAIN = aleatoireBinomial(aleatoire, stats->nb_SAIN, p);
+  long vaccines_IMMUNISE = aleatoireBinomial(aleatoire, stats->nb_IMMUNISE, p);
+  long restants_SAIN = stats->nb_SAIN - vaccines_SAIN;
+  long restants_IMMUNISE = stats->nb_IMMUNISE - vaccines_IMMUNISE;
+  long propagation = (long)front;
+  if (propagation > restants_SAIN + restants_IMMUNISE)
+    propagation = restants_SAIN + restants_IMMUNISE;
+  if (propagation > 0) {
+    long propagation_SAIN = aleatoireBinomial(
+        aleatoire, propagation,
+        (double)restants_SAIN / (restants_SAIN + restants_IMMUNISE));
+    if (propagation_SAIN > restants_SAIN) propagation_SAIN = restants_SAIN;
+    if (propagation - propagation_SAIN > restants_IMMUNISE)
+      propagation_SAIN = propagation - restants_IMMUNISE;
+    vaccines_SAIN += propagation_SAIN;
+    vaccines_IMMUNISE += propagation - propagation_SAIN;
+  }
+  stats->nb_SAIN -= vaccines_SAIN;
+  stats->nb_IMMUNISE -= vaccines_IMMUNISE;
+  stats->nb_VACCINE += vaccines_SAIN + vaccines_IMMUNISE;
+}
+
+/**
+ * @brief Vrai si un des 4 blocs voisins contient des MALADE/INCUBE.
+ */
+static char voisinContagieux(const struct Multiechelle *multiechelle,
+                             unsigned long bx, unsigned long by) {
+  const unsigned long nb = multiechelle->blocs_par_cote;
+  const struct Bloc *blocs = multiechelle->blocs;
+  return (bx > 0 && zombiesBloc(&blocs[(bx - 1) * nb + by])) ||
+         (bx < nb - 1 && zombiesBloc(&blocs[(bx + 1) * nb + by])) ||
+         (by > 0 && zombiesBloc(&blocs[bx * nb + by - 1])) ||
+         (by < nb - 1 && zombiesBloc(&blocs[bx * nb + by + 1]));
+}
+
+/**
+ * @brief Vrai si une Personne du bloc est en quarantaine.
+ */
+static char quarantaineBloc(const struct Multiechelle *multiechelle,
+                            const struct Bloc *bloc) {
+  const unsigned long n = multiechelle->taille_bloc * multiechelle->taille_bloc;
+  for (unsigned long k = 0; k < n; k++)
+    if (!estLibre(multiechelle, &bloc->personnes[k], multiechelle->tour))
+      return 1;
+  return 0;
+}
+
+/**
+ * @brief Faire passer la grille du temps t au temps t+1.
+ *
+ * 1. Raffiner les blocs agrégés voisins d'un bloc contenant des MALADE/INCUBE
+ *    (l'infection avance d'une case par tour au plus).
+ * 2. Jouer les Personne des blocs fins.
+ * 3. Vacciner les blocs agrégés.
+ * 4. Agréger les blocs fins redevenus calmes.
+ *
+ * @param multiechelle Grille au temps t.
+ */
+void jouerTourMultiechelle(struct Multiechelle *multiechelle) {
+  const unsigned long nb = multiechelle->blocs_par_cote;
+  const unsigned long t = multiechelle->taille_bloc;
+  struct Bloc *blocs = multiechelle->blocs;
+
+  // 1. Raffinement
+  for (unsigned long bx = 0; bx < nb; bx++)
+    for (unsigned long by = 0; by < nb; by++)
+      if (!blocs[bx * nb + by].personnes &&
+          voisinContagieux(multiechelle, bx, by))
+        raffinerBloc(multiechelle, &blocs[bx * nb + by]);
+
+  // 2. Blocs fins
+  for (unsigned long b = 0; b < nb * nb; b++)
+    if (blocs[b].personnes)
+      memcpy(blocs[b].tampon, blocs[b].personnes,
+             sizeof(struct Personne) * t * t);
+  for (unsigned long bx = 0; bx < nb; bx++) {
+    for (unsigned long by = 0; by < nb; by++) {
+      struct Bloc *bloc = &blocs[bx * nb + by];
+      if (!bloc->personnes) continue;
+      struct Statistique stats = {0, 0, 0, 0, 0, 0};
+      for (unsigned long i = bx * t; i < (bx + 1) * t; i++)
+        for (unsigned long j = by * t; j < (by + 1) * t; j++)
+          compter(&stats, jouerPersonne(multiechelle, i, j));
+      bloc->stats = stats;
+    }
+  }
+  for (unsigned long b = 0; b < nb * nb; b++) {
+    if (!blocs[b].personnes) continue;
+    struct Personne *personnes = blocs[b].personnes;
+    blocs[b].personnes = blocs[b].tampon;
+    blocs[b].tampon = personnes;
+  }
+  multiechelle->tour++;
+
+  // 3. Blocs agrégés
+  for (unsigned long bx = 0; bx < nb; bx++)
+    for (unsigned long by = 0; by < nb; by++)
+      if (!blocs[bx * nb + by].personnes)
+        jouerBlocAgrege(multiechelle, bx, by);
+
+  // 4. Agrégation
+  for (unsigned long bx = 0; bx < nb; bx++) {
+    for (unsigned long by = 0; by < nb; by++) {
+      struct Bloc *bloc = &blocs[bx * nb + by];
+      if (bloc->personnes && !zombiesBloc(bloc) &&
+          !voisinContagieux(multiechelle, bx, by) &&
+          !quarantaineBloc(multiechelle, bloc))
+        agregerBloc(multiechelle, bloc);
+    }
+  }
+}
+
+/**
+ * @brief Effectifs exacts de la grille (somme des blocs).
+ *
+ * @param multiechelle Grille.
+ * @return struct Statistique Effectifs.
+ */
+struct Statistique getStatistiqueMultiechelle(
+    const struct Multiechelle *multiechelle) {
+  struct Statistique statistique = {0, 0, 0, 0, 0, 0};
+  const unsigned long nb_blocs =
+      multiechelle->blocs_par_cote * multiechelle->blocs_par_cote;
+  for (unsigned long b = 0; b < nb_blocs; b++) {
+    const struct Statistique *stats = &multiechelle->blocs[b].stats;
+    statistique.nb_IMMUNISE += stats->nb_IMMUNISE;
+    statistique.nb_SAIN += stats->nb_SAIN;
+    statistique.nb_MORT += stats->nb_MORT;
+    statistique.nb_MALADE += stats->nb_MALADE;
+    statistique.nb_INCUBE += stats->nb_INCUBE;
+    statistique.nb_VACCINE += stats->nb_VACCINE;
+  }
+  return statistique;
+}
+
+/**
+ * @brief Libère la grille.
+ *
+ * @param multiechelle Grille.
+ */
+void detruireMultiechelle(struct Multiechelle *multiechelle) {
+  const unsigned long nb_blocs =
+      multiechelle->blocs_par_cote * multiechelle->blocs_par_cote;
+  for (unsigned long b = 0; b < nb_blocs; b++) {
+    free(multiechelle->blocs[b].personnes);
+    free(multiechelle->blocs[b].tampon);
+  }
+  free(multiechelle->blocs);
+  libererZones(&multiechelle->zones);
+  free(multiechelle);
+}
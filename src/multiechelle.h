@@ -0,0 +1,85 @@
+#if !defined(MULTIECHELLE_H)
+#define MULTIECHELLE_H
+
+#include "aleatoire.h"
+#include "jouer_un_tour.h"
+#include "population.h"
+#include "statistique.h"
+
+/**
+ * @brief Bloc taille_bloc*taille_bloc de la grille multi-échelle.
+ *
+ * Un bloc est soit fin (personnes allouées, simulées une à une), soit agrégé
+ * (seuls les effectifs SAIN/MORT/IMMUNISE/VACCINE sont conservés).
+ */
+struct Bloc {
+  /**
+   * @brief Personne du bloc, ligne par ligne. NULL si le bloc est agrégé.
+   */
+  struct Personne *personnes;
+  /**
+   * @brief Tampon du tour suivant. NULL si le bloc est agrégé.
+   */
+  struct Personne *tampon;
+  /**
+   * @brief Effectifs du bloc, exacts qu'il soit fin ou agrégé.
+   */
+  struct Statistique stats;
+};
+
+/**
+ * @brief Grille hybride : blocs agrégés loin du front, fins près du front.
+ */
+struct Multiechelle {
+  /**
+   * @brief Longueur d'un côté de la grille (en personnes).
+   */
+  unsigned long cote;
+  /**
+   * @brief Longueur d'un côté d'un bloc (en personnes).
+   */
+  unsigned long taille_bloc;
+  /**
+   * @brief Nombre de blocs sur un côté.
+   */
+  unsigned long blocs_par_cote;
+  /**
+   * @brief Tableau blocs_par_cote*blocs_par_cote de Bloc.
+   */
+  struct Bloc *blocs;
+  /**
+   * @brief Nombre de blocs fins.
+   */
+  unsigned long nb_blocs_fins;
+  /**
+   * @brief Paramètres de la simulation.
+   */
+  struct Parametres parametres;
+  /**
+   * @brief Générateur propre à la grille.
+   */
+  struct Aleatoire aleatoire;
+  /**
+   * @brief Nombre de tours joués.
+   */
+  unsigned long tour;
+  /**
+   * @brief Zones de quarantaine des Personne des blocs fins.
+   */
+  struct Zones zones;
+};
+
+struct Multiechelle *creerMultiechelle(const struct Parametres *parametres,
+                                       unsigned long cote,
+                                       unsigned long taille_bloc,
+                                       unsigned long graine);
+void infecterMultiechelle(struct Multiechelle *multiechelle, unsigned long x,
+                          unsigned long y);
+const struct Personne *getPersonneMultiechelle(
+    const struct Multiechelle *multiechelle, unsigned long x, unsigned long y);
+void jouerTourMultiechelle(struct Multiechelle *multiechelle);
+struct Statistique getStatistiqueMultiechelle(
+    const struct Multiechelle *multiechelle);
+void detruireMultiechelle(struct Multiechelle *multiechelle);
+
+#endif  // MULTIECHELLE_H
@@ -5,10 +5,13 @@
  *
  * Fonctionnalités :
  * - Créer
- * - Cloner
+ * - Cloner, copier
  * - Afficher
  * - Faire le patient zero
  * - Obtenir la taille de la population
+ * - Rasters épidémiologiques (activer, exporter)
+ * - Zones de quarantaine (créer, tester une case)
+ * - Détruire (population, grille clonée)
  *
  * @author Marc NGUYEN
  * @author Thomas LARDY
@@ -17,12 +20,103 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "population.h"
 
+/**
+ * @brief Indexe un tableau contigu de cote*cote Personne sous forme de grille.
+ *
+ * Un pointeur par ligne seulement : cote écritures, quelle que soit la
+ * taille de la grille.
+ *
+ * @param personnes Tableau contigu, ligne par ligne.
+ * @param cote Longueur d'un côté de la grille.
+ * @return struct Personne** grille[i] = &personnes[i * cote].
+ */
+static struct Personne **indexerGrille(struct Personne *personnes,
+                                       const unsigned long cote) {
+  struct Personne **grille =
+      (struct Personne **)malloc(sizeof(struct Personne *) * (cote ? cote : 1));
+  for (unsigned long i = 0; i < cote; i++) grille[i] = personnes + i * cote;
+  return grille;
+}
+
+/**
+ * @brief Initialise une table ne contenant que la zone libre.
+ *
+ * @param zones Table à initialiser.
+ */
+void initZones(struct Zones *zones) {
+  zones->capacite = 16;
+  zones->expirations =
+      (unsigned long *)malloc(sizeof(unsigned long) * zones->capacite);
+  zones->expirations[0] = 0;
+  zones->nb_zones = 1;
+}
+
+/**
+ * @brief Ajoute une zone levée au tour expiration.
+ *
+ * La table double quand elle est pleine : coût amorti constant.
+ *
+ * @param zones Table.
+ * @param expiration Premier tour où la zone n'est plus en quarantaine.
+ * @return uint32_t Indice de la zone, 0 (zone libre) si la table ne peut pas
+ * grandir.
+ */
+uint32_t ajouterZone(struct Zones *zones, unsigned long expiration) {
+  if (zones->nb_zones == zones->capacite) {
+    if (zones->capacite > UINT32_MAX / 2) return 0;
+    unsigned long *expirations = (unsigned long *)realloc(
+        zones->expirations, sizeof(unsigned long) * zones->capacite * 2);
+    if (!expirations) return 0;
+    zones->expirations = expirations;
+    zones->capacite *= 2;
+  }
+  zones->expirations[zones->nb_zones] = expiration;
+  return zones->nb_zones++;
+}
+
+/**
+ * @brief Recopie une table de zones, en agrandissant la destination si besoin.
+ *
+ * @param destination Table initialisée.
+ * @param source Table source.
+ * @return int 0, ou -1 si la destination ne peut pas grandir.
+ */
+int copierZones(struct Zones *destination, const struct Zones *source) {
+  if (destination->capacite < source->nb_zones) {
+    unsigned long *expirations = (unsigned long *)realloc(
+        destination->expirations, sizeof(unsigned long) * source->capacite);
+    if (!expirations) return -1;
+    destination->expirations = expirations;
+    destination->capacite = source->capacite;
+  }
+  memcpy(destination->expirations, source->expirations,
+         sizeof(unsigned long) * source->nb_zones);
+  destination->nb_zones = source->nb_zones;
+  return 0;
+}
+
+/**
+ * @brief Libère une table de zones.
+ *
+ * @param zones Table.
+ */
+void libererZones(struct Zones *zones) {
+  free(zones->expirations);
+  zones->expirations = NULL;
+  zones->nb_zones = zones->capacite = 0;
+}
+
 /**
  * @brief Créer une population dans une grille cote*cote.
  *
+ * Les Personne sont stockées dans un tableau contigu (population->personnes)
+ * obtenu par calloc : aucune page n'est touchée avant d'être écrite. Le
+ * tampon du tour suivant n'est alloué qu'au premier preparerTampon.
+ *
  * Usage:
  * ```
  * struct Population *population = creerPopulation(3);
@@ -33,23 +127,17 @@
  */
 struct Population *creerPopulation(const unsigned long cote) {
   struct Population *population =
-      (struct Population *)malloc(sizeof(struct Personne));
-  struct Personne ***grille_de_personnes =
-      (struct Personne ***)malloc(sizeof(struct Personne **) * cote);
-  // Malloc x et y, la grille de Personne
-  for (unsigned long i = 0; i < cote; i++) {
-    grille_de_personnes[i] =
-        (struct Personne **)malloc(sizeof(struct Personne *) * cote);
-    for (unsigned long j = 0; j < cote; j++) {
-      grille_de_personnes[i][j] =
-          (struct Personne *)malloc(sizeof(struct Personne) * cote);
-
-      grille_de_personnes[i][j]->state = SAIN;
-      grille_de_personnes[i][j]->duree_quarantaine = 0;
-    }
-  }
-  population->grille_de_personnes = grille_de_personnes;
+      (struct Population *)malloc(sizeof(struct Population));
+  // SAIN == 0 : calloc suffit à initialiser la grille
+  population->personnes =
+      (struct Personne *)calloc(cote * cote, sizeof(struct Personne));
+  population->tampon = NULL;
+  population->grille_de_personnes = indexerGrille(population->personnes, cote);
+  population->grille_tampon = NULL;
   population->cote = cote;
+  population->tour = 0;
+  for (int r = 0; r < NB_RASTERS; r++) population->rasters[r] = NULL;
+  initZones(&population->zones);
   return population;
 }
 
@@ -59,34 +147,90 @@ struct Population *creerPopulation(const unsigned long cote) {
  * Usage:
  * ```
  * struct Population *population = creerPopulation(3);
- * struct Personne *** grille_de_personnes = clonerGrillePopulation(population);
+ * struct Personne **grille_de_personnes = clonerGrillePopulation(population);
  * ```
  *
  * @param population_source Population source.
  * @return struct Population* Grille de population destination.
  */
-struct Personne ***clonerGrillePopulation(
+struct Personne **clonerGrillePopulation(
     struct Population *population_source) {
-  struct Personne ***grille_de_personnes = (struct Personne ***)malloc(
-      sizeof(struct Personne **) * population_source->cote);
-  // Malloc x et y, la grille de Personne
-  for (unsigned long i = 0; i < population_source->cote; i++) {
-    grille_de_personnes[i] = (struct Personne **)malloc(
-        sizeof(struct Personne *) * population_source->cote);
-    for (unsigned long j = 0; j < population_source->cote; j++) {
-      grille_de_personnes[i][j] = (struct Personne *)malloc(
-          sizeof(struct Personne) * population_source->cote);
-
-      // Remplissage
-      grille_de_personnes[i][j]->state =
-          population_source->grille_de_personnes[i][j]->state;
-      grille_de_personnes[i][j]->duree_quarantaine =
-          population_source->grille_de_personnes[i][j]->duree_quarantaine;
-      grille_de_personnes[i][j]->duree_incube =
-          population_source->grille_de_personnes[i][j]->duree_incube;
-    }
+  const unsigned long cote = population_source->cote;
+  struct Personne *personnes =
+      (struct Personne *)malloc(sizeof(struct Personne) * cote * cote);
+  memcpy(personnes, population_source->personnes,
+         sizeof(struct Personne) * cote * cote);
+  return indexerGrille(personnes, cote);
+}
+
+/**
+ * @brief Libère une grille renvoyée par clonerGrillePopulation.
+ *
+ * @param grille Grille clonée.
+ * @param cote Longueur d'un côté de la grille.
+ */
+void detruireGrillePopulation(struct Personne **grille, unsigned long cote) {
+  if (cote) free(grille[0]);
+  free(grille);
+}
+
+/**
+ * @brief Recopie la grille, les zones et le tour d'une population dans une
+ * autre.
+ *
+ * Aucune allocation tant que la table des zones de la destination est assez
+ * grande : sert à relancer un réplicat depuis la même condition initiale.
+ * Les rasters actifs de la destination sont réinitialisés.
+ *
+ * @param destination Population de même cote que la source.
+ * @param source Population source.
+ * @return int 0, ou -1 si les cotes diffèrent ou si la table des zones ne
+ * peut pas grandir.
+ */
+int copierPopulation(struct Population *destination,
+                     const struct Population *source) {
+  if (destination->cote != source->cote) return -1;
+  if (copierZones(&destination->zones, &source->zones)) return -1;
+  memcpy(destination->personnes, source->personnes,
+         sizeof(struct Personne) * source->cote * source->cote);
+  destination->tour = source->tour;
+  if (destination->rasters[0]) activerRasters(destination);
+  return 0;
+}
+
+/**
+ * @brief Recopie la grille courante dans le tampon avant un tour.
+ *
+ * Le tampon est alloué au premier appel : une population chargée puis
+ * jouée par un moteur sans tampon (plans de bits) ne le touche jamais.
+ *
+ * @param population Population au temps t.
+ */
+void preparerTampon(struct Population *population) {
+  const unsigned long cote = population->cote;
+  if (!population->tampon) {
+    population->tampon =
+        (struct Personne *)malloc(sizeof(struct Personne) * cote * cote);
+    population->grille_tampon = indexerGrille(population->tampon, cote);
   }
-  return grille_de_personnes;
+  memcpy(population->tampon, population->personnes,
+         sizeof(struct Personne) * cote * cote);
+}
+
+/**
+ * @brief Le tampon devient la grille courante (passage de t à t+1).
+ *
+ * Simple échange de pointeurs : aucune allocation ni copie.
+ *
+ * @param population Population dont le tampon contient le temps t+1.
+ */
+void echangerTampon(struct Population *population) {
+  struct Personne *personnes = population->personnes;
+  struct Personne **grille = population->grille_de_personnes;
+  population->personnes = population->tampon;
+  population->grille_de_personnes = population->grille_tampon;
+  population->tampon = personnes;
+  population->grille_tampon = grille;
 }
 
 /**
@@ -107,28 +251,24 @@ struct Personne ***clonerGrillePopulation(
  *
  * @param population Population à afficher à l'instant t.
  */
-void afficherGrillePopulation(struct Population *population) {
+void afficherGrillePopulation(const struct Population *population) {
   for (unsigned long i = 0; i < population->cote; i++) printf("-");
   printf("\n");
   for (unsigned long i = 0; i < population->cote; i++) {
     for (unsigned long j = 0; j < population->cote; j++) {
-      switch (population->grille_de_personnes[i][j]->state) {
+      const int quarantaine =
+          enQuarantaine(population, &population->grille_de_personnes[i][j]);
+      switch (population->grille_de_personnes[i][j].state) {
         case IMMUNISE:
-          printf(population->grille_de_personnes[i][j]->duree_quarantaine
-                     ? "\e[32m*\e[0m"
-                     : "\e[33m*\e[0m");
+          printf(quarantaine ? "\e[32m*\e[0m" : "\e[33m*\e[0m");
           break;
 
         case MALADE:
-          printf(population->grille_de_personnes[i][j]->duree_quarantaine
-                     ? "\e[32mo\e[0m"
-                     : "\e[31mo\e[0m");
+          printf(quarantaine ? "\e[32mo\e[0m" : "\e[31mo\e[0m");
           break;
 
         case SAIN:
-          printf(population->grille_de_personnes[i][j]->duree_quarantaine
-                     ? "\e[32m.\e[0m"
-                     : ".");
+          printf(quarantaine ? "\e[32m.\e[0m" : ".");
           break;
 
         case MORT:
@@ -136,19 +276,14 @@ void afficherGrillePopulation(struct Population *population) {
           break;
 
         case INCUBE:
-          printf(population->grille_de_personnes[i][j]->duree_quarantaine
-                     ? "\e[32mu\e[0m"
-                     : "\e[35mu\e[0m");
+          printf(quarantaine ? "\e[32mu\e[0m" : "\e[35mu\e[0m");
           break;
 
         case VACCINE:
-          printf(population->grille_de_personnes[i][j]->duree_quarantaine
-                     ? "\e[32m$\e[0m"
-                     : "\e[33m$\e[0m");
+          printf(quarantaine ? "\e[32m$\e[0m" : "\e[33m$\e[0m");
           break;
       }
-      if (population->grille_de_personnes[i][j]->duree_quarantaine)
-        printf("\e[0m");
+      if (quarantaine) printf("\e[0m");
     }
     printf("\n");
   }
@@ -172,7 +307,7 @@ void afficherGrillePopulation(struct Population *population) {
  */
 void patient_zero(struct Population *population, unsigned long x,
                   unsigned long y) {
-  population->grille_de_personnes[x][y]->state = MALADE;
+  population->grille_de_personnes[x][y].state = MALADE;
 }
 
 /**
@@ -184,3 +319,161 @@ void patient_zero(struct Population *population, unsigned long x,
 unsigned long getTaillePopulation(struct Population *population) {
   return population->cote * population->cote;
 }
+
+/**
+ * @brief Créer une zone de quarantaine levée dans duree tours.
+ *
+ * Les cases y entrent en recevant son indice :
+ * ```
+ * personne->zone = creerZone(population, 20);
+ * ```
+ *
+ * @param population Structure Population.
+ * @param duree Nombre de tours de quarantaine à partir du tour courant.
+ * @return uint32_t Indice de la zone, 0 si la table ne peut pas grandir.
+ */
+uint32_t creerZone(struct Population *population, unsigned long duree) {
+  return ajouterZone(&population->zones, population->tour + duree);
+}
+
+/**
+ * @brief Zone d'une case déjà en quarantaine, remise dans une zone neuve
+ * plus tôt dans le parcours du tour.
+ *
+ * Sémantique du décompte par case : une telle case perd encore un tour à son
+ * passage, elle est levée un tour avant sa zone. Les zones neuves d'un même
+ * tour ont toutes la même expiration : une seule zone raccourcie par tour,
+ * créée au premier besoin.
+ *
+ * @param population Structure Population.
+ * @param zone Zone neuve de la case.
+ * @param raccourcie Zone raccourcie du tour, 0 avant le premier besoin.
+ * @return uint32_t Zone raccourcie, zone si la table ne peut pas grandir.
+ */
+uint32_t raccourcirZone(struct Population *population, uint32_t zone,
+                        uint32_t *raccourcie) {
+  if (!*raccourcie)
+    *raccourcie = ajouterZone(&population->zones,
+                              population->zones.expirations[zone] - 1);
+  return *raccourcie ? *raccourcie : zone;
+}
+
+/**
+ * @brief Vrai si une Personne de la grille courante est en quarantaine.
+ *
+ * @param population Structure Population.
+ * @param personne Personne de population->personnes.
+ * @return int 1 si sa zone n'est pas levée au tour courant.
+ */
+int enQuarantaine(const struct Population *population,
+                  const struct Personne *personne) {
+  return population->tour < population->zones.expirations[personne->zone];
+}
+
+/**
+ * @brief Tours de quarantaine restants d'une Personne de la grille courante.
+ *
+ * @param population Structure Population.
+ * @param personne Personne de population->personnes.
+ * @return unsigned long Tours restants, 0 si elle est libre.
+ */
+unsigned long getDureeQuarantaine(const struct Population *population,
+                                  const struct Personne *personne) {
+  const unsigned long expiration =
+      population->zones.expirations[personne->zone];
+  return population->tour < expiration ? expiration - population->tour : 0;
+}
+
+/**
+ * @brief Tour courant, tel qu'écrit dans les rasters.
+ *
+ * @param population Structure Population.
+ * @return uint16_t Tour, saturé à RASTER_JAMAIS - 1.
+ */
+uint16_t getTourRaster(const struct Population *population) {
+  return population->tour < RASTER_JAMAIS ? (uint16_t)population->tour
+                                          : RASTER_JAMAIS - 1;
+}
+
+/**
+ * @brief Active les rasters épidémiologiques.
+ *
+ * Les cases déjà INCUBE/MALADE, MORT ou en quarantaine reçoivent le tour
+ * courant. Ensuite, le noyau écrit dans les rasters au changement d'état :
+ * aucun passage supplémentaire sur la grille.
+ *
+ * Usage:
+ * ```
+ * struct Population *population = creerPopulation(100);
+ * patient_zero(population, 50, 50);
+ * activerRasters(population);
+ * // Traitement ...
+ * exporterRaster(population, RASTER_INFECTION, "infection.pgm");
+ * ```
+ *
+ * @param population Structure Population.
+ */
+void activerRasters(struct Population *population) {
+  const unsigned long taille = population->cote * population->cote;
+  const uint16_t tour = getTourRaster(population);
+  for (int r = 0; r < NB_RASTERS; r++) {
+    if (!population->rasters[r])
+      population->rasters[r] = (uint16_t *)malloc(sizeof(uint16_t) * taille);
+    for (unsigned long k = 0; k < taille; k++)
+      population->rasters[r][k] = RASTER_JAMAIS;
+  }
+  for (unsigned long k = 0; k < taille; k++) {
+    const struct Personne *personne = &population->personnes[k];
+    if (personne->state == MALADE || personne->state == INCUBE)
+      population->rasters[RASTER_INFECTION][k] = tour;
+    if (personne->state == MORT) population->rasters[RASTER_MORT][k] = tour;
+    if (enQuarantaine(population, personne))
+      population->rasters[RASTER_QUARANTAINE][k] = tour;
+  }
+}
+
+/**
+ * @brief Exporte un raster en PGM P5 16 bits (valeurs big-endian).
+ *
+ * @param population Structure Population.
+ * @param raster Raster à exporter.
+ * @param fichier Nom du fichier à écrire.
+ * @return int 0, ou -1 si les rasters sont désactivés ou l'écriture échoue.
+ */
+int exporterRaster(const struct Population *population, enum Raster raster,
+                   const char *fichier) {
+  const unsigned long cote = population->cote;
+  const uint16_t *valeurs = population->rasters[raster];
+  if (!valeurs) return -1;
+  FILE *file = fopen(fichier, "wb");
+  if (!file) return -1;
+
+  fprintf(file, "P5\n%lu %lu\n65535\n", cote, cote);
+  unsigned char *ligne = (unsigned char *)malloc(2 * cote + 1);
+  int ok = 1;
+  for (unsigned long i = 0; ok && i < cote; i++) {
+    for (unsigned long j = 0; j < cote; j++) {
+      ligne[2 * j] = (unsigned char)(valeurs[i * cote + j] >> 8);
+      ligne[2 * j + 1] = (unsigned char)valeurs[i * cote + j];
+    }
+    ok = fwrite(ligne, 2, cote, file) == cote;
+  }
+  free(ligne);
+  if (fclose(file)) ok = 0;
+  return ok ? 0 : -1;
+}
+
+/**
+ * @brief Libère une population et son tampon.
+ *
+ * @param population Structure Population.
+ */
+void detruirePopulation(struct Population *population) {
+  free(population->grille_de_personnes);
+  free(population->grille_tampon);
+  free(population->personnes);
+  free(population->tampon);
+  for (int r = 0; r < NB_RASTERS; r++) free(population->rasters[r]);
+  libererZones(&population->zones);
+  free(population);
+}
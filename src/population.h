@@ -1,13 +1,15 @@
 #if !defined(POPULATION_H)
 #define POPULATION_H
 
+#include <stdint.h>
+
 /**
  * @brief Etats pouvant être une Personne.
  */
 enum State { SAIN, MALADE, MORT, IMMUNISE, INCUBE, VACCINE };
 
 /**
- * @brief Personne ayant un State, une duree_incube et une duree_quarantaine.
+ * @brief Personne ayant un State, une duree_incube et une zone de quarantaine.
  */
 struct Personne {
   /**
@@ -19,34 +21,121 @@ struct Personne {
    */
   int duree_incube;
   /**
-   * @brief Durée d'une quarantaine (secteur bloquant l'infection vers l'ext.).
+   * @brief Zone de quarantaine (secteur bloquant l'infection vers l'ext.),
+   * indice dans struct Zones. 0 : aucune.
    */
-  int duree_quarantaine;
+  uint32_t zone;
   /**
-   * @brief Mesure la distance entre le MALADE et la personne.
+   * @brief Mesure la distance entre le MALADE et la personne, valable
+   * seulement pendant la mise en quarantaine de sa zone.
    */
   int cordon_sanitaire;
 };
 
+/**
+ * @brief Table des zones de quarantaine.
+ *
+ * Chaque mise en quarantaine crée une zone ; ses cases portent son indice
+ * (Personne.zone). Une case est en quarantaine au tour t si
+ * t < expirations[zone] : la zone entière est levée sans toucher ses cases.
+ * Les indices ne sont pas recyclés (une case peut garder l'indice d'une zone
+ * levée).
+ */
+struct Zones {
+  /**
+   * @brief Tour de levée de chaque zone. expirations[0] = 0 : zone libre.
+   */
+  unsigned long *expirations;
+  /**
+   * @brief Nombre de zones, zone libre comprise.
+   */
+  uint32_t nb_zones;
+  /**
+   * @brief Capacité de expirations.
+   */
+  uint32_t capacite;
+};
+
+/**
+ * @brief Rasters épidémiologiques tenus par le noyau.
+ */
+enum Raster { RASTER_INFECTION, RASTER_MORT, RASTER_QUARANTAINE, NB_RASTERS };
+
+/**
+ * @brief Valeur d'une case de raster sans évènement.
+ */
+#define RASTER_JAMAIS 0xFFFF
+
 /**
  * @brief Structure Population.
  */
 struct Population {
   /**
-   * @brief Tableau cote*cote contenant une struct Personne*.
+   * @brief Début de chaque ligne de personnes (cote pointeurs) :
+   * grille_de_personnes[i][j] est personnes[i * cote + j].
    */
-  struct Personne ***grille_de_personnes;
+  struct Personne **grille_de_personnes;
   /**
    * @brief Longueur d'un côté de la grille.
    */
   unsigned long cote;
+  /**
+   * @brief Tableau contigu cote*cote de Personne, ligne par ligne.
+   */
+  struct Personne *personnes;
+  /**
+   * @brief Tampon du tour suivant, même disposition que personnes. NULL
+   * jusqu'au premier preparerTampon.
+   */
+  struct Personne *tampon;
+  /**
+   * @brief Début de chaque ligne du tampon, NULL avec lui.
+   */
+  struct Personne **grille_tampon;
+  /**
+   * @brief Nombre de tours joués.
+   */
+  unsigned long tour;
+  /**
+   * @brief Tour du premier évènement de chaque case, par enum Raster.
+   *
+   * Tableaux cote*cote, ligne par ligne, remplis par le noyau au changement
+   * d'état (RASTER_JAMAIS sinon). NULL tant que activerRasters n'est pas
+   * appelé.
+   */
+  uint16_t *rasters[NB_RASTERS];
+  /**
+   * @brief Zones de quarantaine des cases (grille et tampon).
+   */
+  struct Zones zones;
 };
 
+void initZones(struct Zones *zones);
+uint32_t ajouterZone(struct Zones *zones, unsigned long expiration);
+int copierZones(struct Zones *destination, const struct Zones *source);
+void libererZones(struct Zones *zones);
 struct Population *creerPopulation(const unsigned long cote);
-struct Personne ***clonerGrillePopulation(struct Population *population_source);
-void afficherGrillePopulation(struct Population *population);
+struct Personne **clonerGrillePopulation(struct Population *population_source);
+void detruireGrillePopulation(struct Personne **grille, unsigned long cote);
+int copierPopulation(struct Population *destination,
+                     const struct Population *source);
+void preparerTampon(struct Population *population);
+void echangerTampon(struct Population *population);
+void afficherGrillePopulation(const struct Population *population);
 void patient_zero(struct Population *population, unsigned long x,
                   unsigned long y);
 unsigned long getTaillePopulation(struct Population *population);
+uint32_t creerZone(struct Population *population, unsigned long duree);
+uint32_t raccourcirZone(struct Population *population, uint32_t zone,
+                        uint32_t *raccourcie);
+int enQuarantaine(const struct Population *population,
+                  const struct Personne *personne);
+unsigned long getDureeQuarantaine(const struct Population *population,
+                                  const struct Personne *personne);
+uint16_t getTourRaster(const struct Population *population);
+void activerRasters(struct Population *population);
+int exporterRaster(const struct Population *population, enum Raster raster,
+                   const char *fichier);
+void detruirePopulation(struct Population *population);
 
 #endif  // POPULATION_H
@@ -0,0 +1,609 @@
+/**
+ * @file serie.c
+ *
+ * @brief Stockage compressé et colonnaire des Statistique.
+ *
+ * Alternative à Data pour les longues simulations et les lots de
+ * simulations : environ 5 octets par tour au lieu de 48 octets plus un
+ * malloc. Les blocs sont accessibles au hasard grâce à l'index et les mêmes
+ * octets servent en mémoire et sur disque.
+ *
+ * Contient:
+ * - créer une série et y ajouter des Statistique
+ * - lire un bloc ou une plage de tours
+ * - écrire et charger une série
+ * - exporter, dériver, graphique et tableau de bord, bloc par bloc
+ * - détruire une série
+ *
+ * Usage:
+ * ```
+ * struct Serie *serie = creerSerie(cote * cote);
+ * for (...) {
+ *   jouerTour(...);
+ *   ajouterSerie(serie, getStatistique(population));
+ * }
+ * ecrireSerie(serie, "data.serie");
+ * graphiqueSerie(serie, "graphique.txt", 20, 80);
+ * tableauSerie(serie, "tableau de bord.txt");
+ * detruireSerie(serie);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "graphique_flux.h"
+#include "serie.h"
+
+/**
+ * @brief Signature du format sur disque.
+ */
+#define SIGNATURE_SERIE "EPISERIE"
+
+/**
+ * @brief Taille maximale d'un varint 64 bits.
+ */
+#define TAILLE_VARINT_MAX 10
+
+/**
+ * @brief Taille maximale d'un bloc compressé.
+ */
+#define TAILLE_BLOC_MAX (TOURS_PAR_BLOC * NB_COLONNES * TAILLE_VARINT_MAX)
+
+/**
+ * @brief Position des colonnes stockées dans struct Statistique.
+ */
+static const size_t COLONNES[NB_COLONNES] = {
+    offsetof(struct Statistique, nb_IMMUNISE),
+    offsetof(struct Statistique, nb_MORT),
+    offsetof(struct Statistique, nb_MALADE),
+    offsetof(struct Statistique, nb_INCUBE),
+    offsetof(struct Statistique, nb_VACCINE)};
+
+/**
+ * @brief Accès à la colonne c d'une Statistique.
+ */
+#define COLONNE(stats, c) (*(long *)((char *)(stats) + COLONNES[c]))
+
+/**
+ * @brief Somme des six états d'une Statistique.
+ */
+static long sommeStatistique(const struct Statistique *stats) {
+  return stats->nb_IMMUNISE + stats->nb_SAIN + stats->nb_MORT +
+         stats->nb_MALADE + stats->nb_INCUBE + stats->nb_VACCINE;
+}
+
+/**
+ * @brief Ecrit v en zigzag + varint.
+ *
+ * @param sortie Destination (au moins TAILLE_VARINT_MAX octets).
+ * @param v Valeur signée.
+ * @return unsigned char* Octet suivant.
+ */
+static unsigned char *ecrireVarint(unsigned char *sortie, int64_t v) {
+  uint64_t zigzag = ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+  while (zigzag >= 0x80) {
+    *sortie++ = (unsigned char)(zigzag | 0x80);
+    zigzag >>= 7;
+  }
+  *sortie++ = (unsigned char)zigzag;
+  return sortie;
+}
+
+/**
+ * @brief Lit un varint zigzag.
+ *
+ * @param p Premier octet.
+ * @param fin Fin de la zone lisible.
+ * @param v Valeur signée lue.
+ * @return const unsigned char* Octet suivant, NULL si le varint est tronqué.
+ */
+static const unsigned char *lireVarint(const unsigned char *p,
+                                       const unsigned char *fin, int64_t *v) {
+  uint64_t zigzag = 0;
+  for (unsigned int decalage = 0; p < fin && decalage < 64; decalage += 7) {
+    unsigned char octet = *p++;
+    zigzag |= (uint64_t)(octet & 0x7f) << decalage;
+    if (!(octet & 0x80)) {
+      *v = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+      return p;
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief Compresse nb lignes, colonne par colonne.
+ *
+ * @param lignes Statistique à compresser.
+ * @param nb Nombre de lignes (au plus TOURS_PAR_BLOC).
+ * @param sortie Destination (au moins TAILLE_BLOC_MAX octets).
+ * @param debut Position de sortie dans le flux, pour l'index.
+ * @param index Entrée d'index à remplir.
+ * @return unsigned long Nombre d'octets écrits.
+ */
+static unsigned long encoderBloc(const struct Statistique *lignes,
+                                 unsigned long nb, unsigned char *sortie,
+                                 unsigned long debut,
+                                 struct IndexBloc *index) {
+  unsigned char *p = sortie;
+  for (int c = 0; c < NB_COLONNES; c++) {
+    index->position[c] = debut + (unsigned long)(p - sortie);
+    long precedent = 0;
+    for (unsigned long k = 0; k < nb; k++) {
+      long valeur = COLONNE(&lignes[k], c);
+      p = ecrireVarint(p, valeur - precedent);
+      precedent = valeur;
+    }
+  }
+  index->position[NB_COLONNES] = debut + (unsigned long)(p - sortie);
+  return (unsigned long)(p - sortie);
+}
+
+/**
+ * @brief Décompresse un bloc.
+ *
+ * @param octets Flux de blocs.
+ * @param index Entrée d'index du bloc.
+ * @param nb Nombre de lignes du bloc.
+ * @param somme Somme des états, pour déduire SAIN.
+ * @param sortie Destination (nb lignes).
+ * @return int 0, ou -1 si le bloc est corrompu.
+ */
+static int decoderBloc(const unsigned char *octets,
+                       const struct IndexBloc *index, unsigned long nb,
+                       long somme, struct Statistique *sortie) {
+  for (unsigned long k = 0; k < nb; k++) sortie[k].nb_SAIN = somme;
+  for (int c = 0; c < NB_COLONNES; c++) {
+    const unsigned char *p = octets + index->position[c];
+    const unsigned char *fin = octets + index->position[c + 1];
+    int64_t valeur = 0;
+    for (unsigned long k = 0; k < nb; k++) {
+      int64_t delta;
+      if (!(p = lireVarint(p, fin, &delta))) return -1;
+      valeur += delta;
+      COLONNE(&sortie[k], c) = valeur;
+      sortie[k].nb_SAIN -= valeur;
+    }
+    if (p != fin) return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Compresse le bloc ouvert et l'ajoute au flux.
+ *
+ * @param serie Série dont le bloc ouvert est plein.
+ */
+static void fermerBloc(struct Serie *serie) {
+  if (serie->nb_blocs == serie->capacite_index) {
+    serie->capacite_index = serie->capacite_index ? 2 * serie->capacite_index
+                                                  : 16;
+    serie->index = (struct IndexBloc *)realloc(
+        serie->index, sizeof(struct IndexBloc) * serie->capacite_index);
+  }
+  if (serie->taille_octets + TAILLE_BLOC_MAX > serie->capacite_octets) {
+    serie->capacite_octets = 2 * serie->capacite_octets + TAILLE_BLOC_MAX;
+    serie->octets =
+        (unsigned char *)realloc(serie->octets, serie->capacite_octets);
+  }
+  serie->taille_octets += encoderBloc(
+      serie->ouvert, serie->nb_ouvert, serie->octets + serie->taille_octets,
+      serie->taille_octets, &serie->index[serie->nb_blocs]);
+  serie->nb_blocs++;
+  serie->nb_ouvert = 0;
+}
+
+/**
+ * @brief Vide la série en gardant ses tampons : les ajouts suivants
+ * n'allouent plus tant qu'ils ne dépassent pas la longueur précédente.
+ *
+ * @param serie Série.
+ * @param population_totale Population totale.
+ */
+void viderSerie(struct Serie *serie, unsigned long population_totale) {
+  serie->population_totale = population_totale;
+  serie->somme = 0;
+  serie->tours = 0;
+  serie->taille_octets = 0;
+  serie->nb_blocs = 0;
+  serie->nb_ouvert = 0;
+  memset(&serie->derniere, 0, sizeof(struct Statistique));
+  initIndicateurs(&serie->indicateurs);
+}
+
+/**
+ * @brief Créer une série vide.
+ *
+ * @param population_totale Population totale.
+ * @return struct Serie* Série.
+ */
+struct Serie *creerSerie(unsigned long population_totale) {
+  struct Serie *serie = (struct Serie *)malloc(sizeof(struct Serie));
+  serie->octets = NULL;
+  serie->capacite_octets = 0;
+  serie->index = NULL;
+  serie->capacite_index = 0;
+  viderSerie(serie, population_totale);
+  return serie;
+}
+
+/**
+ * @brief Ajoute une Statistique à la série.
+ *
+ * @param serie Série.
+ * @param stats Donnée à ajouter.
+ * @return int 0, ou -1 si la somme des états diffère des tours précédents.
+ */
+int ajouterSerie(struct Serie *serie, struct Statistique stats) {
+  long somme = sommeStatistique(&stats);
+  if (!serie->tours)
+    serie->somme = somme;
+  else if (somme != serie->somme)
+    return -1;
+
+  ajouterIndicateurs(&serie->indicateurs,
+                     serie->tours ? &serie->derniere : NULL, &stats,
+                     serie->tours);
+  serie->ouvert[serie->nb_ouvert++] = stats;
+  serie->derniere = stats;
+  serie->tours++;
+  if (serie->nb_ouvert == TOURS_PAR_BLOC) fermerBloc(serie);
+  return 0;
+}
+
+/**
+ * @brief Compresse une base de données.
+ *
+ * @param data Base de données.
+ * @return struct Serie* Série, NULL si la somme des états varie.
+ */
+struct Serie *compresserData(const struct Data *data) {
+  struct Serie *serie = creerSerie(data->population_totale);
+  for (unsigned long i = 0; i < data->tours; i++) {
+    if (ajouterSerie(serie, *data->liste_statistiques[i])) {
+      detruireSerie(serie);
+      return NULL;
+    }
+  }
+  return serie;
+}
+
+/**
+ * @brief Décompresse toute la série dans une base de données.
+ *
+ * @param serie Série.
+ * @return struct Data* Base de données (creerData), NULL si un bloc est
+ * corrompu.
+ */
+struct Data *decompresserSerie(const struct Serie *serie) {
+  struct Data *data = creerData();
+  data->population_totale = serie->population_totale;
+  struct Statistique bloc[TOURS_PAR_BLOC];
+  for (unsigned long b = 0; b < getNbBlocsSerie(serie); b++) {
+    const unsigned long nb = lireBlocSerie(serie, b, bloc);
+    if (!nb) {
+      detruireData(data);
+      return NULL;
+    }
+    for (unsigned long k = 0; k < nb; k++) appendData(data, bloc[k]);
+  }
+  return data;
+}
+
+/**
+ * @brief Nombre de blocs, bloc ouvert compris.
+ *
+ * @param serie Série.
+ * @return unsigned long Nombre de blocs.
+ */
+unsigned long getNbBlocsSerie(const struct Serie *serie) {
+  return serie->nb_blocs + (serie->nb_ouvert ? 1 : 0);
+}
+
+/**
+ * @brief Décompresse le bloc numéro bloc.
+ *
+ * Le bloc b contient les tours [b * TOURS_PAR_BLOC, (b + 1) * TOURS_PAR_BLOC).
+ *
+ * @param serie Série.
+ * @param bloc Numéro du bloc.
+ * @param sortie Destination (au moins TOURS_PAR_BLOC cases).
+ * @return unsigned long Nombre de tours lus, 0 si le bloc n'existe pas ou
+ * est corrompu.
+ */
+unsigned long lireBlocSerie(const struct Serie *serie, unsigned long bloc,
+                            struct Statistique *sortie) {
+  if (bloc < serie->nb_blocs)
+    return decoderBloc(serie->octets, &serie->index[bloc], TOURS_PAR_BLOC,
+                       serie->somme, sortie)
+               ? 0
+               : TOURS_PAR_BLOC;
+  if (bloc == serie->nb_blocs && serie->nb_ouvert) {
+    memcpy(sortie, serie->ouvert,
+           sizeof(struct Statistique) * serie->nb_ouvert);
+    return serie->nb_ouvert;
+  }
+  return 0;
+}
+
+/**
+ * @brief Lit les tours [debut, debut + nb) sans décompresser les autres blocs.
+ *
+ * @param serie Série.
+ * @param debut Premier tour.
+ * @param nb Nombre de tours voulus.
+ * @param sortie Destination (nb cases).
+ * @return unsigned long Nombre de tours lus (moins que nb en fin de série
+ * ou avant un bloc corrompu).
+ */
+unsigned long lireSerie(const struct Serie *serie, unsigned long debut,
+                        unsigned long nb, struct Statistique *sortie) {
+  struct Statistique bloc[TOURS_PAR_BLOC];
+  unsigned long lus = 0;
+  while (lus < nb && debut + lus < serie->tours) {
+    unsigned long tour = debut + lus;
+    unsigned long dans_bloc =
+        lireBlocSerie(serie, tour / TOURS_PAR_BLOC, bloc);
+    unsigned long k = tour % TOURS_PAR_BLOC;
+    if (dans_bloc <= k) break;  // Bloc corrompu
+    unsigned long n = dans_bloc - k;
+    if (n > nb - lus) n = nb - lus;
+    memcpy(sortie + lus, bloc + k, sizeof(struct Statistique) * n);
+    lus += n;
+  }
+  return lus;
+}
+
+/**
+ * @brief Ecrit la série dans un fichier binaire.
+ *
+ * Format (entiers 64 bits dans l'ordre des octets de la machine) :
+ * "EPISERIE", population_totale, somme, tours, nombre de blocs, nombre
+ * d'octets, index des blocs, blocs. Le bloc ouvert est écrit compressé.
+ *
+ * @param serie Série.
+ * @param fichier Nom du fichier à écrire.
+ * @return int 0, ou -1 si le fichier n'a pas pu être écrit.
+ */
+int ecrireSerie(const struct Serie *serie, const char *fichier) {
+  FILE *file = fopen(fichier, "wb");
+  if (!file) return -1;
+
+  unsigned char *dernier = (unsigned char *)malloc(TAILLE_BLOC_MAX);
+  struct IndexBloc index_dernier;
+  unsigned long taille_dernier = 0;
+  if (serie->nb_ouvert)
+    taille_dernier = encoderBloc(serie->ouvert, serie->nb_ouvert, dernier,
+                                 serie->taille_octets, &index_dernier);
+
+  uint64_t entete[5] = {serie->population_totale, (uint64_t)serie->somme,
+                        serie->tours, getNbBlocsSerie(serie),
+                        serie->taille_octets + taille_dernier};
+  int ok = fwrite(SIGNATURE_SERIE, 8, 1, file) == 1 &&
+           fwrite(entete, sizeof(entete), 1, file) == 1;
+  for (unsigned long b = 0; ok && b < getNbBlocsSerie(serie); b++) {
+    const struct IndexBloc *index =
+        b < serie->nb_blocs ? &serie->index[b] : &index_dernier;
+    uint64_t position[NB_COLONNES + 1];
+    for (int c = 0; c <= NB_COLONNES; c++) position[c] = index->position[c];
+    ok = fwrite(position, sizeof(position), 1, file) == 1;
+  }
+  if (ok && serie->taille_octets)
+    ok = fwrite(serie->octets, serie->taille_octets, 1, file) == 1;
+  if (ok && taille_dernier)
+    ok = fwrite(dernier, taille_dernier, 1, file) == 1;
+
+  free(dernier);
+  if (fclose(file)) ok = 0;
+  return ok ? 0 : -1;
+}
+
+/**
+ * @brief Charge une série écrite par ecrireSerie.
+ *
+ * Les blocs pleins restent compressés ; chaque bloc est vérifié et les
+ * indicateurs sont recalculés au passage.
+ *
+ * @param fichier Nom du fichier à lire.
+ * @return struct Serie* Série, NULL si le fichier est absent ou invalide.
+ */
+struct Serie *chargerSerie(const char *fichier) {
+  FILE *file = fopen(fichier, "rb");
+  if (!file) return NULL;
+
+  char signature[8];
+  uint64_t entete[5];
+  if (fread(signature, 8, 1, file) != 1 ||
+      memcmp(signature, SIGNATURE_SERIE, 8) ||
+      fread(entete, sizeof(entete), 1, file) != 1) {
+    fclose(file);
+    return NULL;
+  }
+  uint64_t tours = entete[2], nb_blocs = entete[3], taille = entete[4];
+  if (nb_blocs != (tours + TOURS_PAR_BLOC - 1) / TOURS_PAR_BLOC ||
+      taille > nb_blocs * TAILLE_BLOC_MAX) {
+    fclose(file);
+    return NULL;
+  }
+
+  struct Serie *serie = creerSerie(entete[0]);
+  serie->somme = (long)entete[1];
+  serie->capacite_index = nb_blocs;
+  serie->index =
+      (struct IndexBloc *)malloc(sizeof(struct IndexBloc) * (nb_blocs + 1));
+  serie->capacite_octets = taille;
+  serie->octets = (unsigned char *)malloc(taille + 1);
+
+  int ok = 1;
+  uint64_t precedente = 0;
+  for (uint64_t b = 0; ok && b < nb_blocs; b++) {
+    uint64_t position[NB_COLONNES + 1];
+    ok = fread(position, sizeof(position), 1, file) == 1 &&
+         position[0] == precedente;
+    for (int c = 0; ok && c <= NB_COLONNES; c++) {
+      ok = position[c] >= precedente && position[c] <= taille;
+      precedente = position[c];
+      serie->index[b].position[c] = position[c];
+    }
+  }
+  ok = ok && precedente == taille &&
+       (!taille || fread(serie->octets, taille, 1, file) == 1);
+  fclose(file);
+
+  // Vérification et indicateurs, bloc par bloc
+  struct Statistique bloc[TOURS_PAR_BLOC];
+  for (uint64_t b = 0; ok && b < nb_blocs; b++) {
+    unsigned long nb = tours - b * TOURS_PAR_BLOC;
+    if (nb > TOURS_PAR_BLOC) nb = TOURS_PAR_BLOC;
+    ok = !decoderBloc(serie->octets, &serie->index[b], nb, serie->somme,
+                      bloc);
+    for (unsigned long k = 0; ok && k < nb; k++) {
+      ajouterIndicateurs(&serie->indicateurs,
+                         serie->tours ? &serie->derniere : NULL, &bloc[k],
+                         serie->tours);
+      serie->derniere = bloc[k];
+      serie->tours++;
+    }
+    if (ok && nb < TOURS_PAR_BLOC) {
+      // Dernier bloc incomplet : il redevient le bloc ouvert
+      memcpy(serie->ouvert, bloc, sizeof(struct Statistique) * nb);
+      serie->nb_ouvert = nb;
+      taille = serie->index[b].position[0];
+      nb_blocs = b;
+    }
+  }
+  if (!ok) {
+    detruireSerie(serie);
+    return NULL;
+  }
+  serie->nb_blocs = nb_blocs;
+  serie->taille_octets = taille;
+  return serie;
+}
+
+/**
+ * @brief Exporte les données brutes, au même format que exporter.
+ *
+ * @param serie Série.
+ * @param fichier_data Nom du fichier à écrire.
+ */
+void exporterSerie(const struct Serie *serie, const char *fichier_data) {
+  FILE *file = fopen(fichier_data, "w");
+  if (!file) {
+    printf("Erreur: Le fichier n'a pas pu être ouvert.\n");
+    exit(1);
+  }
+
+  fprintf(file, "%lu\n", serie->population_totale);
+  fprintf(file, "%lu\n", serie->tours);
+  struct Statistique bloc[TOURS_PAR_BLOC];
+  unsigned long tour = 0;
+  for (unsigned long b = 0; b < getNbBlocsSerie(serie); b++) {
+    unsigned long nb = lireBlocSerie(serie, b, bloc);
+    for (unsigned long k = 0; k < nb; k++, tour++)
+      fprintf(file, "%lu %li %li %li %li %li %li\n", tour, bloc[k].nb_IMMUNISE,
+              bloc[k].nb_SAIN, bloc[k].nb_MORT, bloc[k].nb_MALADE,
+              bloc[k].nb_INCUBE, bloc[k].nb_VACCINE);
+  }
+
+  fclose(file);
+}
+
+/**
+ * @brief Dérive tel que x(t+1)-x(t), comme deriver.
+ *
+ * @param serie Série source.
+ * @return struct Serie* Série dérivée (somme des états nulle).
+ */
+struct Serie *deriverSerie(const struct Serie *serie) {
+  struct Serie *serie_derive = creerSerie(serie->population_totale);
+  struct Statistique bloc[TOURS_PAR_BLOC];
+  struct Statistique precedente, stats;
+  unsigned long tour = 0;
+  for (unsigned long b = 0; b < getNbBlocsSerie(serie); b++) {
+    unsigned long nb = lireBlocSerie(serie, b, bloc);
+    for (unsigned long k = 0; k < nb; k++, tour++) {
+      if (tour) {
+        stats.nb_IMMUNISE = bloc[k].nb_IMMUNISE - precedente.nb_IMMUNISE;
+        stats.nb_SAIN = bloc[k].nb_SAIN - precedente.nb_SAIN;
+        stats.nb_MORT = bloc[k].nb_MORT - precedente.nb_MORT;
+        stats.nb_MALADE = bloc[k].nb_MALADE - precedente.nb_MALADE;
+        stats.nb_INCUBE = bloc[k].nb_INCUBE - precedente.nb_INCUBE;
+        stats.nb_VACCINE = bloc[k].nb_VACCINE - precedente.nb_VACCINE;
+        ajouterSerie(serie_derive, stats);
+      }
+      precedente = bloc[k];
+    }
+  }
+  return serie_derive;
+}
+
+/**
+ * @brief Affiche et exporte le graphique ASCII de la série.
+ *
+ * Même rendu que GraphiqueFlux, construit bloc par bloc.
+ *
+ * @param serie Série.
+ * @param fichier_graph Nom du fichier à écrire.
+ * @param hauteur Hauteur du graphique.
+ * @param limite Nombre maximum de colonnes.
+ */
+void graphiqueSerie(const struct Serie *serie, const char *fichier_graph,
+                    unsigned long hauteur, unsigned long limite) {
+  struct GraphiqueFlux *graphique =
+      creerGraphiqueFlux(hauteur, limite, serie->population_totale);
+  struct Statistique bloc[TOURS_PAR_BLOC];
+  for (unsigned long b = 0; b < getNbBlocsSerie(serie); b++) {
+    unsigned long nb = lireBlocSerie(serie, b, bloc);
+    for (unsigned long k = 0; k < nb; k++)
+      ajouterGraphiqueFlux(graphique, bloc[k]);
+  }
+  exporterGraphiqueFlux(graphique, fichier_graph);
+  rendreGraphiqueFlux(graphique, stdout, 1);
+  detruireGraphiqueFlux(graphique);
+}
+
+/**
+ * @brief Affiche et exporte le tableau de bord de la série.
+ *
+ * O(1) : les indicateurs sont tenus à jour par ajouterSerie.
+ *
+ * @param serie Série (au moins un tour).
+ * @param fichier_tableau Nom du fichier à exporter.
+ */
+void tableauSerie(const struct Serie *serie, const char *fichier_tableau) {
+  tableauIndicateurs(&serie->indicateurs, &serie->derniere, serie->tours,
+                     serie->population_totale, fichier_tableau);
+}
+
+/**
+ * @brief Taux d'attaque de la série, comme tauxAttaque.
+ *
+ * @param serie Série.
+ * @return double Infections cumulées / population totale (0 si vide).
+ */
+double tauxAttaqueSerie(const struct Serie *serie) {
+  if (!serie->population_totale) return 0;
+  return (double)serie->indicateurs.infections_cumulees /
+         serie->population_totale;
+}
+
+/**
+ * @brief Libère une série.
+ *
+ * @param serie Série.
+ */
+void detruireSerie(struct Serie *serie) {
+  if (!serie) return;
+  free(serie->octets);
+  free(serie->index);
+  free(serie);
+}
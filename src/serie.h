@@ -0,0 +1,114 @@
+#if !defined(SERIE_H)
+#define SERIE_H
+
+#include "statistique.h"
+
+/**
+ * @brief Nombre de tours par bloc compressé.
+ */
+#define TOURS_PAR_BLOC 256
+
+/**
+ * @brief Nombre de colonnes stockées (SAIN est déduit de la somme).
+ */
+#define NB_COLONNES 5
+
+/**
+ * @brief Entrée de l'index des blocs.
+ */
+struct IndexBloc {
+  /**
+   * @brief Début de chaque colonne dans octets, puis fin du bloc.
+   *
+   * Colonnes dans l'ordre IMMUNISE, MORT, MALADE, INCUBE, VACCINE.
+   */
+  unsigned long position[NB_COLONNES + 1];
+};
+
+/**
+ * @brief Série de Statistique compressée, colonne par colonne.
+ *
+ * Les tours sont groupés en blocs de TOURS_PAR_BLOC. Dans un bloc, chaque
+ * colonne est codée en delta + zigzag + varint : une épidémie varie peu d'un
+ * tour à l'autre, la plupart des valeurs tiennent sur un octet. Le dernier
+ * bloc, incomplet, reste en clair dans ouvert.
+ */
+struct Serie {
+  /**
+   * @brief Population totale.
+   */
+  unsigned long population_totale;
+  /**
+   * @brief Somme des six états, identique à chaque tour.
+   *
+   * Fixée par le premier ajout : population_totale pour une simulation, 0
+   * pour une série dérivée.
+   */
+  long somme;
+  /**
+   * @brief Nombre de tours au total.
+   */
+  unsigned long tours;
+  /**
+   * @brief Blocs fermés, compressés.
+   */
+  unsigned char *octets;
+  /**
+   * @brief Nombre d'octets utilisés.
+   */
+  unsigned long taille_octets;
+  /**
+   * @brief Nombre d'octets alloués.
+   */
+  unsigned long capacite_octets;
+  /**
+   * @brief Index des blocs fermés (nb_blocs cases).
+   */
+  struct IndexBloc *index;
+  /**
+   * @brief Nombre de blocs fermés.
+   */
+  unsigned long nb_blocs;
+  /**
+   * @brief Nombre de cases allouées dans index.
+   */
+  unsigned long capacite_index;
+  /**
+   * @brief Bloc en cours de remplissage, en clair.
+   */
+  struct Statistique ouvert[TOURS_PAR_BLOC];
+  /**
+   * @brief Nombre de tours dans ouvert.
+   */
+  unsigned long nb_ouvert;
+  /**
+   * @brief Dernière Statistique ajoutée.
+   */
+  struct Statistique derniere;
+  /**
+   * @brief Indicateurs calculés au fil des ajouts.
+   */
+  struct Indicateurs indicateurs;
+};
+
+struct Serie *creerSerie(unsigned long population_totale);
+void viderSerie(struct Serie *serie, unsigned long population_totale);
+int ajouterSerie(struct Serie *serie, struct Statistique stats);
+struct Serie *compresserData(const struct Data *data);
+struct Data *decompresserSerie(const struct Serie *serie);
+unsigned long getNbBlocsSerie(const struct Serie *serie);
+unsigned long lireBlocSerie(const struct Serie *serie, unsigned long bloc,
+                            struct Statistique *sortie);
+unsigned long lireSerie(const struct Serie *serie, unsigned long debut,
+                        unsigned long nb, struct Statistique *sortie);
+int ecrireSerie(const struct Serie *serie, const char *fichier);
+struct Serie *chargerSerie(const char *fichier);
+void exporterSerie(const struct Serie *serie, const char *fichier_data);
+struct Serie *deriverSerie(const struct Serie *serie);
+void graphiqueSerie(const struct Serie *serie, const char *fichier_graph,
+                    unsigned long hauteur, unsigned long limite);
+void tableauSerie(const struct Serie *serie, const char *fichier_tableau);
+double tauxAttaqueSerie(const struct Serie *serie);
+void detruireSerie(struct Serie *serie);
+
+#endif  // SERIE_H
@@ -0,0 +1,711 @@
+/**
+ * @file simulation.c
+ *
+ * @brief Poignée de simulation réentrante (bibliothèque libepidemie).
+ *
+ * Fonctionnalités :
+ * - Créer une simulation à partir d'une population et de paramètres
+ * - Avancer de n tours
+ * - Relancer un réplicat sans allocation (série vidée, tampons gardés)
+ * - Bifurquer : continuer la même trajectoire avec d'autres paramètres
+ * - Jouer avec des tables de transition (un seul tirage par case)
+ * - Jouer en plans de bits (64 cases par opération, sans quarantaine)
+ * - Jouer les plans de bits en bandes de lignes, un thread par bande
+ * - Ne jouer que les cases actives, compteurs de voisins tenus à jour
+ * - Jouer avec des classes de risque (paramètres par case)
+ * - Ajouter des contacts lointains au tour (petit monde)
+ * - Jouer avec des agents mobiles (marche aléatoire ou domicile-travail)
+ * - Jouer plusieurs souches en concurrence (immunité croisée partielle)
+ * - Publier chaque tour et le temps de ses phases (metriques.h)
+ * - Lire la grille et la série de Statistique (colonnes compressées) sans
+ *   copie
+ * - Détruire
+ *
+ * Usage:
+ * ```
+ * struct Parametres parametres = {0.5, 0.1, 1.0, 0.1, 0.001, 4, 5, 20};
+ * struct Population *population = creerPopulation(100);
+ * patient_zero(population, 50, 50);
+ * struct Simulation *simulation = creerSimulation(&parametres, population, 42);
+ * avancerSimulation(simulation, 100);
+ * const struct Serie *serie = getSerieSimulation(simulation);
+ *
+ * // Réplicats : même condition initiale, autre graine
+ * for (unsigned long r = 1; r < 10000; r++) {
+ *   reinitialiserSimulation(simulation, condition_initiale, 42 + r);
+ *   avancerSimulation(simulation, 100);
+ * }
+ * detruireSimulation(simulation);  // libère aussi la population
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <stdlib.h>
+
+#include "simulation.h"
+
+/**
+ * @brief Etat complet d'une simulation.
+ */
+struct Simulation {
+  /**
+   * @brief Paramètres (copie).
+   */
+  struct Parametres parametres;
+  /**
+   * @brief Population simulée, possédée par la simulation.
+   */
+  struct Population *population;
+  /**
+   * @brief Statistiques de chaque tour (tour 0 inclus), en colonnes
+   * compressées ; vidée à chaque réplicat, tampons gardés.
+   */
+  struct Serie *serie;
+  /**
+   * @brief Générateur propre à la simulation.
+   */
+  struct Aleatoire aleatoire;
+  /**
+   * @brief Variante du noyau, choisie à la création et à chaque réplicat.
+   */
+  const struct Noyau *noyau;
+  /**
+   * @brief Tables de transition, NULL pour jouer avec noyau.
+   */
+  struct TableTransition *transitions;
+  /**
+   * @brief Plans de bits de la population, NULL sinon. Prioritaire sur
+   * transitions et noyau.
+   */
+  struct Bitboard *bitboard;
+  /**
+   * @brief 1 si les plans de bits ont avancé depuis la dernière recopie dans
+   * la grille de population (voir synchroniserSimulation).
+   */
+  char grille_perimee;
+  /**
+   * @brief Plans de bits joués en bandes parallèles, NULL sinon. Remplace
+   * bitboard.
+   */
+  struct Bandes *bandes;
+  /**
+   * @brief Compteurs de voisins contagieux, NULL sinon. Prioritaire sur
+   * transitions et noyau.
+   */
+  struct Voisinage *voisinage;
+  /**
+   * @brief Classes de risque, NULL sinon. Prioritaire sur transitions et
+   * noyau.
+   */
+  struct Classes *classes;
+  /**
+   * @brief Contacts lointains ajoutés au tour, NULL sinon.
+   */
+  struct Contacts *contacts;
+  /**
+   * @brief Agents mobiles, NULL sinon. Exclusif des autres moteurs.
+   */
+  struct Agents *agents;
+  /**
+   * @brief Souches en concurrence, NULL sinon. Exclusif des autres moteurs.
+   */
+  struct Souches *souches;
+  /**
+   * @brief Métriques publiées à chaque tour (non possédées), NULL sinon.
+   */
+  struct Metriques *metriques;
+};
+
+/**
+ * @brief Créer une simulation.
+ *
+ * La simulation prend possession de la population (libérée par
+ * detruireSimulation). Les statistiques du tour 0 sont enregistrées.
+ *
+ * @param parametres Paramètres (copiés).
+ * @param population Population initiale (patient zero déjà placé).
+ * @param graine Graine du générateur aléatoire.
+ * @return struct Simulation* Poignée.
+ */
+struct Simulation *creerSimulation(const struct Parametres *parametres,
+                                   struct Population *population,
+                                   unsigned long graine) {
+  struct Simulation *simulation =
+      (struct Simulation *)malloc(sizeof(struct Simulation));
+  simulation->parametres = *parametres;
+  simulation->population = population;
+  simulation->noyau = choisirNoyau(getExtensions(parametres, population));
+  simulation->transitions = NULL;
+  simulation->bitboard = NULL;
+  simulation->grille_perimee = 0;
+  simulation->bandes = NULL;
+  simulation->voisinage = NULL;
+  simulation->classes = NULL;
+  simulation->contacts = NULL;
+  simulation->agents = NULL;
+  simulation->souches = NULL;
+  simulation->metriques = NULL;
+  initAleatoire(&simulation->aleatoire, graine);
+  simulation->serie = creerSerie(getTaillePopulation(population));
+  ajouterSerie(simulation->serie, getStatistique(population));
+  return simulation;
+}
+
+/**
+ * @brief Recopie les plans de bits dans la grille s'ils ont avancé.
+ *
+ * avancerSimulation ne fait que marquer la grille périmée : un appel par
+ * tour (main.c, equivalence_test.c) ne paie la recopie que si la grille est
+ * lue ensuite (affichage, film, rasters, bifurcation).
+ *
+ * @param simulation Simulation.
+ */
+static void synchroniserSimulation(struct Simulation *simulation) {
+  if (!simulation->grille_perimee) return;
+  synchroniserBitboard(simulation->bandes ? simulation->bandes->bitboard
+                                          : simulation->bitboard);
+  simulation->grille_perimee = 0;
+}
+
+/**
+ * @brief Relance la simulation depuis une condition initiale.
+ *
+ * La grille est recopiée dans la population de la simulation et la série est
+ * vidée. Après le premier réplicat, aucune allocation n'est faite tant
+ * qu'un réplicat ne dépasse pas la longueur des précédents.
+ *
+ * @param simulation Simulation.
+ * @param population Condition initiale, même cote (non modifiée).
+ * @param graine Graine du générateur aléatoire.
+ * @return int 0, ou -1 si les cotes diffèrent.
+ */
+int reinitialiserSimulation(struct Simulation *simulation,
+                            const struct Population *population,
+                            unsigned long graine) {
+  if (copierPopulation(simulation->population, population)) return -1;
+  simulation->grille_perimee = 0;
+  if (simulation->bitboard) {
+    if (bitboardCompatible(&simulation->parametres, population)) {
+      chargerBitboard(simulation->bitboard);
+    } else {
+      detruireBitboard(simulation->bitboard);
+      simulation->bitboard = NULL;
+    }
+  }
+  if (simulation->bandes) {
+    if (bitboardCompatible(&simulation->parametres, population)) {
+      chargerBandes(simulation->bandes, graine);
+    } else {
+      detruireBandes(simulation->bandes);
+      simulation->bandes = NULL;
+    }
+  }
+  if (simulation->voisinage) chargerVoisinage(simulation->voisinage);
+  if (simulation->classes) chargerClasses(simulation->classes);
+  if (simulation->agents) chargerAgents(simulation->agents);
+  if (simulation->souches) chargerSouches(simulation->souches);
+  simulation->noyau =
+      choisirNoyau(getExtensions(&simulation->parametres, population));
+  initAleatoire(&simulation->aleatoire, graine);
+  viderSerie(simulation->serie, getTaillePopulation(simulation->population));
+  ajouterSerie(simulation->serie, getStatistique(simulation->population));
+  if (simulation->metriques)
+    publierTourMetriques(simulation->metriques, 0, simulation->serie->derniere);
+  return 0;
+}
+
+/**
+ * @brief Continue la simulation avec d'autres paramètres et une autre graine.
+ *
+ * La grille et la série sont conservées : les tours suivants
+ * prolongent la même trajectoire (variante d'un préfixe commun, voir
+ * branches.c). Le noyau et les tables de transition sont recalculés ; le
+ * bitboard et les bandes sont rechargés, ou abandonnés si les nouveaux
+ * paramètres activent la quarantaine ; de même pour le voisinage et la
+ * découverte du vaccin. Les classes de risque gardent leurs beta, gamma et
+ * lambda ; les agents gardent leurs positions ; les souches gardent leurs
+ * paramètres, les cases leurs souches et immunités.
+ *
+ * @param simulation Simulation.
+ * @param parametres Paramètres (copiés).
+ * @param graine Graine du générateur aléatoire.
+ */
+void bifurquerSimulation(struct Simulation *simulation,
+                         const struct Parametres *parametres,
+                         unsigned long graine) {
+  synchroniserSimulation(simulation);
+  simulation->parametres = *parametres;
+  const char compatible =
+      bitboardCompatible(parametres, simulation->population);
+  if (simulation->bitboard) {
+    if (compatible) {
+      simulation->bitboard->parametres = *parametres;
+      chargerBitboard(simulation->bitboard);
+    } else {
+      detruireBitboard(simulation->bitboard);
+      simulation->bitboard = NULL;
+    }
+  }
+  if (simulation->bandes) {
+    if (compatible) {
+      simulation->bandes->bitboard->parametres = *parametres;
+      chargerBandes(simulation->bandes, graine);
+    } else {
+      detruireBandes(simulation->bandes);
+      simulation->bandes = NULL;
+    }
+  }
+  if (simulation->voisinage) {
+    if (voisinageCompatible(parametres)) {
+      simulation->voisinage->parametres = *parametres;
+      chargerVoisinage(simulation->voisinage);
+    } else {
+      detruireVoisinage(simulation->voisinage);
+      simulation->voisinage = NULL;
+    }
+  }
+  if (simulation->classes) parametrerClasses(simulation->classes, parametres);
+  if (simulation->agents) parametrerAgents(simulation->agents, parametres);
+  if (simulation->souches) parametrerSouches(simulation->souches, parametres);
+  if (simulation->transitions)
+    initTableTransition(simulation->transitions, parametres);
+  simulation->noyau =
+      choisirNoyau(getExtensions(parametres, simulation->population));
+  initAleatoire(&simulation->aleatoire, graine);
+}
+
+/**
+ * @brief Joue les tours suivants avec des tables de transition.
+ *
+ * Même loi des issues que le noyau, mais au plus un tirage par case : les
+ * trajectoires d'une même graine diffèrent. Reste actif après
+ * reinitialiserSimulation. Sans effet tant qu'un autre moteur (plans de
+ * bits, voisinage, classes, agents, souches) est actif : il est prioritaire
+ * et tire ses propres issues.
+ *
+ * @param simulation Simulation.
+ */
+void activerTransitionsSimulation(struct Simulation *simulation) {
+  if (simulation->transitions) return;
+  simulation->transitions =
+      (struct TableTransition *)malloc(sizeof(struct TableTransition));
+  initTableTransition(simulation->transitions, &simulation->parametres);
+}
+
+/**
+ * @brief Joue les tours suivants en plans de bits (voir bitboard.c).
+ *
+ * Même loi des issues que le noyau, 64 cases par opération. La grille de la
+ * population n'est recopiée que lorsqu'elle est lue (getPopulationSimulation,
+ * bifurquerSimulation). Abandonné
+ * par reinitialiserSimulation si la nouvelle condition initiale porte une
+ * quarantaine.
+ *
+ * @param simulation Simulation.
+ * @return int 0, ou -1 si la quarantaine est active ou si un moteur sur la
+ * grille (classes, contacts, agents, souches) est actif.
+ */
+int activerBitboardSimulation(struct Simulation *simulation) {
+  if (simulation->bitboard || simulation->bandes) return 0;
+  if (simulation->classes || simulation->contacts || simulation->agents ||
+      simulation->souches)
+    return -1;
+  simulation->bitboard =
+      creerBitboard(simulation->population, &simulation->parametres);
+  return simulation->bitboard ? 0 : -1;
+}
+
+/**
+ * @brief Joue les tours suivants en plans de bits, en bandes de lignes
+ * parallèles (voir bandes.c).
+ *
+ * Comme activerBitboardSimulation, mais chaque bande est chargée et jouée
+ * par son thread. Remplace un bitboard déjà actif.
+ *
+ * @param simulation Simulation.
+ * @param nb_bandes Nombre de bandes (et de threads).
+ * @param options Combinaison de enum OptionBandes.
+ * @return int 0, ou -1 si la quarantaine est active ou si un moteur sur la
+ * grille (classes, contacts, agents, souches) est actif.
+ */
+int activerBandesSimulation(struct Simulation *simulation,
+                            unsigned int nb_bandes, unsigned int options) {
+  if (simulation->bandes) return 0;
+  if (simulation->classes || simulation->contacts || simulation->agents ||
+      simulation->souches)
+    return -1;
+  synchroniserSimulation(simulation);
+  simulation->bandes =
+      creerBandes(simulation->population, &simulation->parametres, nb_bandes,
+                  options, aleatoireEntier(&simulation->aleatoire));
+  if (!simulation->bandes) return -1;
+  if (simulation->bitboard) detruireBitboard(simulation->bitboard);
+  simulation->bitboard = NULL;
+  return 0;
+}
+
+/**
+ * @brief Joue les tours suivants en ne visitant que les cases actives (voir
+ * voisinage.c).
+ *
+ * Mêmes tirages que le noyau : même trajectoire pour une même graine. Reste
+ * actif après reinitialiserSimulation. Les plans de bits restent
+ * prioritaires.
+ *
+ * @param simulation Simulation.
+ * @return int 0, ou -1 si la découverte du vaccin est active ou si un moteur
+ * sur la grille (classes, contacts, agents, souches) est actif.
+ */
+int activerVoisinageSimulation(struct Simulation *simulation) {
+  if (simulation->voisinage) return 0;
+  if (simulation->classes || simulation->contacts || simulation->agents ||
+      simulation->souches)
+    return -1;
+  synchroniserSimulation(simulation);
+  simulation->voisinage =
+      creerVoisinage(simulation->population, &simulation->parametres);
+  return simulation->voisinage ? 0 : -1;
+}
+
+/**
+ * @brief Joue les tours suivants avec des classes de risque (voir
+ * classes.c).
+ *
+ * Beta, gamma et lambda de chaque case sont ceux de sa classe ; les
+ * Statistique par classe sont lues avec getClassesSimulation. Reste actif
+ * après reinitialiserSimulation. Incompatible avec les plans de bits et le
+ * voisinage (leurs tirages ignorent les classes).
+ *
+ * @param simulation Simulation.
+ * @param valeurs Paramètres de chaque classe (copiés).
+ * @param nb_classes Nombre de classes (1 à NB_CLASSES_MAX).
+ * @param carte Classe de chaque case (malloc), possédée par la simulation
+ * en cas de succès.
+ * @return int 0, ou -1 si la carte porte une classe inconnue, si des
+ * classes sont déjà actives ou si un autre moteur (plans de bits, voisinage,
+ * agents, souches) est actif.
+ */
+int activerClassesSimulation(struct Simulation *simulation,
+                             const struct ParametresClasse *valeurs,
+                             unsigned int nb_classes, uint8_t *carte) {
+  if (simulation->classes || simulation->bitboard || simulation->bandes ||
+      simulation->voisinage || simulation->agents || simulation->souches)
+    return -1;
+  simulation->classes =
+      creerClasses(simulation->population, &simulation->parametres, valeurs,
+                   nb_classes, carte);
+  return simulation->classes ? 0 : -1;
+}
+
+/**
+ * @brief Ajoute des contacts lointains à chaque tour suivant (voir
+ * contacts.c).
+ *
+ * Tirés sur la grille du tour t avant le tour du moteur, appliqués après.
+ * Chaque contact transmet avec le lambda commun. Incompatible avec les plans
+ * de bits et le voisinage (grilles ou compteurs propres au moteur).
+ *
+ * @param simulation Simulation.
+ * @param contacts Couche (creerContacts), possédée par la simulation en cas
+ * de succès.
+ * @return int 0, ou -1 si les plans de bits, le voisinage, les agents ou les
+ * souches sont actifs.
+ */
+int activerContactsSimulation(struct Simulation *simulation,
+                              struct Contacts *contacts) {
+  if (simulation->contacts || simulation->bitboard || simulation->bandes ||
+      simulation->voisinage || simulation->agents || simulation->souches)
+    return -1;
+  simulation->contacts = contacts;
+  return 0;
+}
+
+/**
+ * @brief Joue les tours suivants avec des agents mobiles (voir agents.c).
+ *
+ * Chaque Personne de la population devient un agent qui se déplace entre
+ * les tours ; la grille montre l'état de chaque agent à son domicile. Même
+ * loi que les tables de transition, Statistique de la population. Reste
+ * actif après reinitialiserSimulation (agents replacés).
+ *
+ * @param simulation Simulation.
+ * @param parametres_agents Paramètres de déplacement (copiés).
+ * @param nb_taches Threads du déplacement et du tri par case.
+ * @return int 0, ou -1 si un autre moteur (plans de bits, voisinage,
+ * classes, contacts, souches) est actif ou si les paramètres sont invalides.
+ */
+int activerAgentsSimulation(struct Simulation *simulation,
+                            const struct ParametresAgents *parametres_agents,
+                            unsigned int nb_taches) {
+  if (simulation->agents || simulation->bitboard || simulation->bandes ||
+      simulation->voisinage || simulation->classes || simulation->contacts ||
+      simulation->souches)
+    return -1;
+  simulation->agents =
+      creerAgents(simulation->population, &simulation->parametres,
+                  parametres_agents, nb_taches, &simulation->aleatoire);
+  return simulation->agents ? 0 : -1;
+}
+
+/**
+ * @brief Joue les tours suivants avec plusieurs souches en concurrence (voir
+ * souches.c).
+ *
+ * Beta, gamma et lambda sont ceux de la souche de chaque infection ; les
+ * Statistique par souche sont lues avec getSouchesSimulation. Les cases
+ * déjà infectées portent la souche 0. Reste actif après
+ * reinitialiserSimulation.
+ *
+ * @param simulation Simulation.
+ * @param valeurs Paramètres de chaque souche (copiés).
+ * @param nb_souches Nombre de souches (1 à NB_SOUCHES_MAX).
+ * @param introductions Introductions des souches (copiées).
+ * @param nb_introductions Nombre d'introductions.
+ * @return int 0, ou -1 si un autre moteur (plans de bits, voisinage,
+ * classes, contacts, agents) est actif ou si une introduction est invalide.
+ */
+int activerSouchesSimulation(struct Simulation *simulation,
+                             const struct ParametresSouche *valeurs,
+                             unsigned int nb_souches,
+                             const struct Introduction *introductions,
+                             unsigned int nb_introductions) {
+  if (simulation->souches || simulation->bitboard || simulation->bandes ||
+      simulation->voisinage || simulation->classes || simulation->contacts ||
+      simulation->agents)
+    return -1;
+  simulation->souches =
+      creerSouches(simulation->population, &simulation->parametres, valeurs,
+                   nb_souches, introductions, nb_introductions);
+  return simulation->souches ? 0 : -1;
+}
+
+/**
+ * @brief Publie chaque tour suivant dans des métriques (voir metriques.c).
+ *
+ * Le dernier tour est publié tout de suite ; ensuite, avancerSimulation
+ * chronomètre le jeu et les Statistique de chaque tour.
+ *
+ * @param simulation Simulation.
+ * @param metriques Métriques (non possédées, doivent survivre à la
+ * simulation ou être détachées avec NULL).
+ */
+void attacherMetriquesSimulation(struct Simulation *simulation,
+                                 struct Metriques *metriques) {
+  simulation->metriques = metriques;
+  if (metriques)
+    publierTourMetriques(metriques, simulation->serie->tours - 1,
+                         simulation->serie->derniere);
+}
+
+/**
+ * @brief Publie le dernier tour et la durée de ses phases.
+ *
+ * @param simulation Simulation dont les métriques sont attachées.
+ * @param debut Horloge avant le jeu.
+ * @param milieu Horloge entre le jeu et les Statistique.
+ */
+static void mesurerTour(struct Simulation *simulation, double debut,
+                        double milieu) {
+  const struct Serie *serie = simulation->serie;
+  ajouterPhaseMetriques(simulation->metriques, PHASE_JEU, milieu - debut);
+  ajouterPhaseMetriques(simulation->metriques, PHASE_STATISTIQUE,
+                        horlogeMetriques() - milieu);
+  publierTourMetriques(simulation->metriques, serie->tours - 1,
+                       serie->derniere);
+}
+
+/**
+ * @brief Renvoie true s'il n'y a plus de MALADE ni d'INCUBE.
+ *
+ * Lu sur la dernière Statistique : aucun parcours de la grille.
+ *
+ * @param simulation Simulation.
+ * @return char Booléen.
+ */
+char simulationTerminee(const struct Simulation *simulation) {
+  const struct Statistique *derniere = &simulation->serie->derniere;
+  return !derniere->nb_MALADE && !derniere->nb_INCUBE;
+}
+
+/**
+ * @brief Joue au plus n_tours, s'arrête plus tôt si l'épidémie est terminée.
+ *
+ * @param simulation Simulation.
+ * @param n_tours Nombre de tours à jouer.
+ * @return unsigned long Nombre de tours réellement joués.
+ */
+unsigned long avancerSimulation(struct Simulation *simulation,
+                                unsigned long n_tours) {
+  unsigned long tour;
+  struct Bitboard *bitboard = simulation->bandes
+                                  ? simulation->bandes->bitboard
+                                  : simulation->bitboard;
+  if (bitboard) {
+    for (tour = 0; tour < n_tours && !simulationTerminee(simulation); tour++) {
+      const double debut = simulation->metriques ? horlogeMetriques() : 0;
+      if (simulation->bandes)
+        jouerTourBandes(simulation->bandes);
+      else
+        jouerTourBitboard(bitboard, &simulation->aleatoire);
+      const double milieu = simulation->metriques ? horlogeMetriques() : 0;
+      ajouterSerie(simulation->serie, getStatistiqueBitboard(bitboard));
+      if (simulation->metriques) mesurerTour(simulation, debut, milieu);
+    }
+    if (tour) simulation->grille_perimee = 1;
+    return tour;
+  }
+  for (tour = 0; tour < n_tours && !simulationTerminee(simulation); tour++) {
+    const double debut = simulation->metriques ? horlogeMetriques() : 0;
+    if (simulation->contacts)
+      collecterContacts(simulation->contacts, simulation->population,
+                        simulation->parametres.lambda,
+                        &simulation->aleatoire);
+    if (simulation->voisinage)
+      jouerTourVoisinage(simulation->voisinage, &simulation->aleatoire);
+    else if (simulation->agents)
+      jouerTourAgents(simulation->agents, &simulation->aleatoire);
+    else if (simulation->souches)
+      jouerTourSouches(simulation->souches, &simulation->aleatoire);
+    else if (simulation->classes)
+      jouerTourClasses(simulation->classes, &simulation->aleatoire);
+    else if (simulation->transitions)
+      jouerTourTransition(simulation->population, simulation->transitions,
+                          &simulation->aleatoire);
+    else
+      simulation->noyau->jouer(simulation->population,
+                               &simulation->parametres, &simulation->aleatoire);
+    if (simulation->contacts &&
+        fusionnerContacts(simulation->contacts, simulation->population,
+                          &simulation->parametres) &&
+        simulation->classes)
+      chargerClasses(simulation->classes);  // Effectifs changés hors du tour
+    const double milieu = simulation->metriques ? horlogeMetriques() : 0;
+    const struct Statistique stats =
+        simulation->voisinage ? getStatistiqueVoisinage(simulation->voisinage)
+        : simulation->classes ? getStatistiqueClasses(simulation->classes)
+        : simulation->souches ? getStatistiqueSouches(simulation->souches)
+                              : getStatistique(simulation->population);
+    ajouterSerie(simulation->serie, stats);
+    if (simulation->metriques) mesurerTour(simulation, debut, milieu);
+  }
+  return tour;
+}
+
+/**
+ * @brief Accès en lecture à la population (sans copie).
+ *
+ * Le pointeur reste valide jusqu'à detruireSimulation, mais la grille
+ * (grille_de_personnes, personnes) change à chaque tour. Avec le bitboard
+ * ou les bandes, la grille n'est recopiée depuis les plans qu'ici, au
+ * premier accès après des tours joués (voir synchroniserSimulation).
+ *
+ * @param simulation Simulation.
+ * @return const struct Population* Population.
+ */
+const struct Population *getPopulationSimulation(
+    const struct Simulation *simulation) {
+  // La recopie ne change pas l'état observable : seul le cache est rafraîchi.
+  synchroniserSimulation((struct Simulation *)simulation);
+  return simulation->population;
+}
+
+/**
+ * @brief Accès en lecture à la série de Statistique (sans copie).
+ *
+ * Dernier tour dans derniere, indicateurs à jour ; les autres tours se lisent
+ * par blocs (lireBlocSerie, lireSerie).
+ *
+ * @param simulation Simulation.
+ * @return const struct Serie* Série, valide jusqu'à detruireSimulation.
+ */
+const struct Serie *getSerieSimulation(const struct Simulation *simulation) {
+  return simulation->serie;
+}
+
+/**
+ * @brief Bandes de la simulation (diagnostic NUMA), NULL si inactives.
+ *
+ * @param simulation Simulation.
+ * @return const struct Bandes* Bandes.
+ */
+const struct Bandes *getBandesSimulation(const struct Simulation *simulation) {
+  return simulation->bandes;
+}
+
+/**
+ * @brief Contacts lointains de la simulation, NULL si inactifs.
+ *
+ * @param simulation Simulation.
+ * @return const struct Contacts* Contacts.
+ */
+const struct Contacts *getContactsSimulation(
+    const struct Simulation *simulation) {
+  return simulation->contacts;
+}
+
+/**
+ * @brief Agents de la simulation, NULL si inactifs.
+ *
+ * @param simulation Simulation.
+ * @return const struct Agents* Agents.
+ */
+const struct Agents *getAgentsSimulation(const struct Simulation *simulation) {
+  return simulation->agents;
+}
+
+/**
+ * @brief Classes de risque de la simulation (Statistique par classe), NULL
+ * si inactives.
+ *
+ * @param simulation Simulation.
+ * @return const struct Classes* Classes.
+ */
+const struct Classes *getClassesSimulation(
+    const struct Simulation *simulation) {
+  return simulation->classes;
+}
+
+/**
+ * @brief Souches de la simulation (Statistique par souche), NULL si
+ * inactives.
+ *
+ * @param simulation Simulation.
+ * @return const struct Souches* Souches.
+ */
+const struct Souches *getSouchesSimulation(
+    const struct Simulation *simulation) {
+  return simulation->souches;
+}
+
+/**
+ * @brief Accès en lecture aux paramètres.
+ *
+ * @param simulation Simulation.
+ * @return const struct Parametres* Paramètres.
+ */
+const struct Parametres *getParametresSimulation(
+    const struct Simulation *simulation) {
+  return &simulation->parametres;
+}
+
+/**
+ * @brief Libère la simulation, sa population et sa série.
+ *
+ * @param simulation Simulation.
+ */
+void detruireSimulation(struct Simulation *simulation) {
+  detruirePopulation(simulation->population);
+  detruireSerie(simulation->serie);
+  free(simulation->transitions);
+  if (simulation->bitboard) detruireBitboard(simulation->bitboard);
+  if (simulation->bandes) detruireBandes(simulation->bandes);
+  if (simulation->voisinage) detruireVoisinage(simulation->voisinage);
+  if (simulation->classes) detruireClasses(simulation->classes);
+  if (simulation->contacts) detruireContacts(simulation->contacts);
+  if (simulation->agents) detruireAgents(simulation->agents);
+  if (simulation->souches) detruireSouches(simulation->souches);
+  free(simulation);
+}
@@ -0,0 +1,74 @@
+#if !defined(SIMULATION_H)
+#define SIMULATION_H
+
+#include "agents.h"
+#include "bandes.h"
+#include "bitboard.h"
+#include "classes.h"
+#include "contacts.h"
+#include "jouer_un_tour.h"
+#include "metriques.h"
+#include "population.h"
+#include "serie.h"
+#include "souches.h"
+#include "statistique.h"
+#include "transition.h"
+#include "voisinage.h"
+
+/**
+ * @brief Simulation complète (poignée opaque).
+ *
+ * Contient la population, les paramètres, le générateur aléatoire et la base
+ * de données. Tout l'état est propre à la poignée : plusieurs simulations
+ * peuvent tourner en même temps sur des threads différents sans verrou.
+ */
+struct Simulation;
+
+struct Simulation *creerSimulation(const struct Parametres *parametres,
+                                   struct Population *population,
+                                   unsigned long graine);
+int reinitialiserSimulation(struct Simulation *simulation,
+                            const struct Population *population,
+                            unsigned long graine);
+void bifurquerSimulation(struct Simulation *simulation,
+                         const struct Parametres *parametres,
+                         unsigned long graine);
+void activerTransitionsSimulation(struct Simulation *simulation);
+int activerBitboardSimulation(struct Simulation *simulation);
+int activerBandesSimulation(struct Simulation *simulation,
+                            unsigned int nb_bandes, unsigned int options);
+int activerVoisinageSimulation(struct Simulation *simulation);
+int activerClassesSimulation(struct Simulation *simulation,
+                             const struct ParametresClasse *valeurs,
+                             unsigned int nb_classes, uint8_t *carte);
+int activerContactsSimulation(struct Simulation *simulation,
+                              struct Contacts *contacts);
+int activerAgentsSimulation(struct Simulation *simulation,
+                            const struct ParametresAgents *parametres_agents,
+                            unsigned int nb_taches);
+int activerSouchesSimulation(struct Simulation *simulation,
+                             const struct ParametresSouche *valeurs,
+                             unsigned int nb_souches,
+                             const struct Introduction *introductions,
+                             unsigned int nb_introductions);
+void attacherMetriquesSimulation(struct Simulation *simulation,
+                                 struct Metriques *metriques);
+unsigned long avancerSimulation(struct Simulation *simulation,
+                                unsigned long n_tours);
+char simulationTerminee(const struct Simulation *simulation);
+const struct Population *getPopulationSimulation(
+    const struct Simulation *simulation);
+const struct Serie *getSerieSimulation(const struct Simulation *simulation);
+const struct Bandes *getBandesSimulation(const struct Simulation *simulation);
+const struct Contacts *getContactsSimulation(
+    const struct Simulation *simulation);
+const struct Agents *getAgentsSimulation(const struct Simulation *simulation);
+const struct Classes *getClassesSimulation(
+    const struct Simulation *simulation);
+const struct Souches *getSouchesSimulation(
+    const struct Simulation *simulation);
+const struct Parametres *getParametresSimulation(
+    const struct Simulation *simulation);
+void detruireSimulation(struct Simulation *simulation);
+
+#endif  // SIMULATION_H
@@ -0,0 +1,242 @@
+/**
+ * @file sortie.c
+ *
+ * @brief Sorties asynchrones sur un thread écrivain.
+ *
+ * La boucle de simulation publie des instantanés (Statistique, grille
+ * encodée) dans un anneau borné sans verrou, un producteur et un
+ * consommateur. Le thread écrivain affiche les grilles, compresse les
+ * Statistique (serie.h) et écrit le fichier de données à la fin. La
+ * simulation ne bloque jamais sur une écriture, seulement quand l'anneau
+ * est plein (contre-pression).
+ *
+ * Usage:
+ * ```
+ * struct Sortie *sortie = creerSortie(64, cote, stdout, "data.txt");
+ * for (...) {
+ *   jouerTour(...);
+ *   publierGrille(sortie, population);
+ *   publierStatistique(sortie, getStatistique(population));
+ * }
+ * terminerSortie(sortie);  // Attend l'écrivain et libère
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "condition_initiale.h"
+#include "sortie.h"
+
+/**
+ * @brief Longueur maximale d'une case rendue ("\e[32m*\e[0m\e[0m").
+ */
+#define TAILLE_CASE 14
+
+/**
+ * @brief Rendu d'une case, comme afficherGrillePopulation.
+ *
+ * PALETTE[quarantaine][state].
+ */
+static const char *const PALETTE[2][6] = {
+    {".", "\e[31mo\e[0m", " ", "\e[33m*\e[0m", "\e[35mu\e[0m",
+     "\e[33m$\e[0m"},
+    {"\e[32m.\e[0m\e[0m", "\e[32mo\e[0m\e[0m", " \e[0m", "\e[32m*\e[0m\e[0m",
+     "\e[32mu\e[0m\e[0m", "\e[32m$\e[0m\e[0m"}};
+
+/**
+ * @brief Rend une grille encodée dans sortie->rendu et l'écrit d'un bloc.
+ *
+ * @param sortie Sortie.
+ * @param grille Grille encodée par encoderPersonne.
+ */
+static void ecrireGrille(struct Sortie *sortie, const unsigned char *grille) {
+  char *p = sortie->rendu;
+  memset(p, '-', sortie->cote);
+  p += sortie->cote;
+  *p++ = '\n';
+  for (unsigned long i = 0; i < sortie->cote; i++) {
+    for (unsigned long j = 0; j < sortie->cote; j++) {
+      unsigned char octet = grille[i * sortie->cote + j];
+      const char *rendu =
+          PALETTE[octet & OCTET_QUARANTAINE ? 1 : 0][octet & 0x7f];
+      while (*rendu) *p++ = *rendu++;
+    }
+    *p++ = '\n';
+  }
+  memset(p, '-', sortie->cote);
+  p += sortie->cote;
+  *p++ = '\n';
+  *p++ = '\n';
+  fwrite(sortie->rendu, 1, (size_t)(p - sortie->rendu), sortie->flux_grille);
+}
+
+/**
+ * @brief Boucle du thread écrivain.
+ *
+ * @param argument struct Sortie*.
+ * @return void* NULL.
+ */
+static void *ecrire(void *argument) {
+  struct Sortie *sortie = (struct Sortie *)argument;
+  const struct timespec pause = {0, 50000};  // 50 us
+  unsigned long queue = 0;
+  for (;;) {
+    unsigned long tete =
+        atomic_load_explicit(&sortie->tete, memory_order_acquire);
+    if (queue == tete) {
+      // fin est publié après le dernier instantané : relire tete
+      if (atomic_load_explicit(&sortie->fin, memory_order_acquire) &&
+          queue == atomic_load_explicit(&sortie->tete, memory_order_acquire))
+        break;
+      nanosleep(&pause, NULL);
+      continue;
+    }
+    for (; queue != tete; queue++) {
+      const unsigned long k = queue & (sortie->capacite - 1);
+      const struct Instantane *instantane = &sortie->anneau[k];
+      if (instantane->type == INSTANTANE_STATISTIQUE)
+        ajouterSerie(sortie->serie, instantane->stats);
+      else
+        ecrireGrille(sortie, sortie->grilles + k * sortie->taille_grille);
+      // La case est rendue à la simulation
+      atomic_store_explicit(&sortie->queue, queue + 1, memory_order_release);
+    }
+  }
+  if (sortie->flux_grille) fflush(sortie->flux_grille);
+  if (sortie->fichier_data && sortie->serie->tours)
+    exporterSerie(sortie->serie, sortie->fichier_data);
+  return NULL;
+}
+
+/**
+ * @brief Créer l'étage de sortie et lancer le thread écrivain.
+ *
+ * @param capacite Nombre d'instantanés en attente au plus (arrondi à une
+ * puissance de 2).
+ * @param cote Longueur d'un côté de la grille.
+ * @param flux_grille Flux des grilles, NULL pour ne pas les afficher.
+ * @param fichier_data Fichier de données écrit à la fin, NULL pour aucun.
+ * @return struct Sortie* Sortie, NULL si le thread n'a pas pu être créé.
+ */
+struct Sortie *creerSortie(unsigned long capacite, unsigned long cote,
+                           FILE *flux_grille, const char *fichier_data) {
+  struct Sortie *sortie = (struct Sortie *)malloc(sizeof(struct Sortie));
+  sortie->capacite = 1;
+  while (sortie->capacite < capacite) sortie->capacite *= 2;
+  sortie->cote = cote;
+  sortie->taille_grille = cote * cote;
+  sortie->anneau = (struct Instantane *)malloc(sizeof(struct Instantane) *
+                                               sortie->capacite);
+  sortie->flux_grille = flux_grille;
+  sortie->grilles = NULL;
+  sortie->rendu = NULL;
+  if (flux_grille) {
+    sortie->grilles =
+        (unsigned char *)malloc(sortie->capacite * sortie->taille_grille);
+    sortie->rendu =
+        (char *)malloc(cote * (cote * TAILLE_CASE + 1) + 2 * (cote + 1) + 1);
+  }
+  sortie->serie = creerSerie(cote * cote);
+  sortie->fichier_data = fichier_data;
+  sortie->attentes = 0;
+  atomic_init(&sortie->tete, 0);
+  atomic_init(&sortie->queue, 0);
+  atomic_init(&sortie->fin, 0);
+  if (pthread_create(&sortie->ecrivain, NULL, ecrire, sortie)) {
+    detruireSerie(sortie->serie);
+    free(sortie->anneau);
+    free(sortie->grilles);
+    free(sortie->rendu);
+    free(sortie);
+    return NULL;
+  }
+  return sortie;
+}
+
+/**
+ * @brief Réserve la prochaine case de l'anneau, en attendant si plein.
+ *
+ * @param sortie Sortie.
+ * @return unsigned long Indice de la case.
+ */
+static unsigned long reserverCase(struct Sortie *sortie) {
+  const unsigned long tete =
+      atomic_load_explicit(&sortie->tete, memory_order_relaxed);
+  if (tete - atomic_load_explicit(&sortie->queue, memory_order_acquire) ==
+      sortie->capacite) {
+    sortie->attentes++;
+    do
+      sched_yield();
+    while (tete - atomic_load_explicit(&sortie->queue, memory_order_acquire) ==
+           sortie->capacite);
+  }
+  return tete & (sortie->capacite - 1);
+}
+
+/**
+ * @brief Rend la case réservée visible par l'écrivain.
+ *
+ * @param sortie Sortie.
+ */
+static void publierCase(struct Sortie *sortie) {
+  atomic_store_explicit(
+      &sortie->tete,
+      atomic_load_explicit(&sortie->tete, memory_order_relaxed) + 1,
+      memory_order_release);
+}
+
+/**
+ * @brief Publie la Statistique d'un tour.
+ *
+ * @param sortie Sortie.
+ * @param stats Statistique du tour.
+ */
+void publierStatistique(struct Sortie *sortie, struct Statistique stats) {
+  const unsigned long k = reserverCase(sortie);
+  sortie->anneau[k].type = INSTANTANE_STATISTIQUE;
+  sortie->anneau[k].stats = stats;
+  publierCase(sortie);
+}
+
+/**
+ * @brief Publie une copie encodée de la grille, affichée par l'écrivain.
+ *
+ * Sans effet si la sortie n'a pas de flux_grille.
+ *
+ * @param sortie Sortie.
+ * @param population Population de même cote que la sortie.
+ */
+void publierGrille(struct Sortie *sortie, const struct Population *population) {
+  if (!sortie->flux_grille) return;
+  const unsigned long k = reserverCase(sortie);
+  unsigned char *grille = sortie->grilles + k * sortie->taille_grille;
+  for (unsigned long n = 0; n < sortie->taille_grille; n++)
+    grille[n] = encoderPersonne(population, &population->personnes[n]);
+  sortie->anneau[k].type = INSTANTANE_GRILLE;
+  publierCase(sortie);
+}
+
+/**
+ * @brief Attend que l'écrivain ait tout écrit, puis libère la sortie.
+ *
+ * @param sortie Sortie.
+ * @return unsigned long Nombre d'attentes de la simulation (anneau plein).
+ */
+unsigned long terminerSortie(struct Sortie *sortie) {
+  const unsigned long attentes = sortie->attentes;
+  atomic_store_explicit(&sortie->fin, 1, memory_order_release);
+  pthread_join(sortie->ecrivain, NULL);
+  detruireSerie(sortie->serie);
+  free(sortie->anneau);
+  free(sortie->grilles);
+  free(sortie->rendu);
+  free(sortie);
+  return attentes;
+}
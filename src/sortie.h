@@ -0,0 +1,106 @@
+#if !defined(SORTIE_H)
+#define SORTIE_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+#include "population.h"
+#include "serie.h"
+#include "statistique.h"
+
+/**
+ * @brief Nature d'un instantané publié.
+ */
+enum TypeInstantane { INSTANTANE_STATISTIQUE, INSTANTANE_GRILLE };
+
+/**
+ * @brief Case de l'anneau : un instantané immuable une fois publié.
+ */
+struct Instantane {
+  /**
+   * @brief Statistique ou grille.
+   */
+  enum TypeInstantane type;
+  /**
+   * @brief Statistique du tour (INSTANTANE_STATISTIQUE).
+   */
+  struct Statistique stats;
+};
+
+/**
+ * @brief Etage de sortie asynchrone.
+ *
+ * La simulation publie des instantanés dans un anneau borné, sans verrou
+ * (un producteur, un consommateur). Un thread écrivain les met en forme et
+ * les écrit. La simulation n'attend que si l'anneau est plein.
+ */
+struct Sortie {
+  /**
+   * @brief Anneau de capacite Instantane.
+   */
+  struct Instantane *anneau;
+  /**
+   * @brief Grille encodée (encoderPersonne) de chaque case de l'anneau.
+   *
+   * capacite * taille_grille octets, NULL si les grilles ne sont pas
+   * affichées.
+   */
+  unsigned char *grilles;
+  /**
+   * @brief Capacité de l'anneau, puissance de 2.
+   */
+  unsigned long capacite;
+  /**
+   * @brief Nombre de Personne d'une grille.
+   */
+  unsigned long taille_grille;
+  /**
+   * @brief Longueur d'un côté de la grille.
+   */
+  unsigned long cote;
+  /**
+   * @brief Nombre d'instantanés publiés (écrit par la simulation).
+   */
+  atomic_ulong tete;
+  /**
+   * @brief Nombre d'instantanés écrits (écrit par l'écrivain).
+   */
+  atomic_ulong queue;
+  /**
+   * @brief Vrai quand la simulation a fini de publier.
+   */
+  atomic_int fin;
+  /**
+   * @brief Nombre de fois où la simulation a attendu l'écrivain.
+   */
+  unsigned long attentes;
+  /**
+   * @brief Flux des grilles (stdout en général), NULL pour ne pas afficher.
+   */
+  FILE *flux_grille;
+  /**
+   * @brief Tampon de rendu d'une grille (thread écrivain).
+   */
+  char *rendu;
+  /**
+   * @brief Statistique reçues, compressées par l'écrivain.
+   */
+  struct Serie *serie;
+  /**
+   * @brief Fichier de données écrit à la fin, NULL pour aucun.
+   */
+  const char *fichier_data;
+  /**
+   * @brief Thread écrivain.
+   */
+  pthread_t ecrivain;
+};
+
+struct Sortie *creerSortie(unsigned long capacite, unsigned long cote,
+                           FILE *flux_grille, const char *fichier_data);
+void publierStatistique(struct Sortie *sortie, struct Statistique stats);
+void publierGrille(struct Sortie *sortie, const struct Population *population);
+unsigned long terminerSortie(struct Sortie *sortie);
+
+#endif  // SORTIE_H
@@ -0,0 +1,502 @@
+/**
+ * @file souches.c
+ *
+ * @brief Moteur multi-souches : variants en concurrence, immunité croisée
+ * partielle.
+ *
+ * Chaque case garde, à côté de sa Personne, la souche de sa dernière
+ * infection (un octet) et ses immunités (un bit par souche, 16 au plus) :
+ * 3 octets par case, aucune grille par souche. Beta, gamma et lambda sont
+ * ceux de chaque souche, les autres paramètres restent communs.
+ *
+ * Une case SAIN ou IMMUNISE est contaminée par un voisin contagieux de la
+ * souche s avec :
+ * - 0 si elle est immunisée contre s ;
+ * - lambda_s (1 - croisee_s) si elle est immunisée contre une autre souche ;
+ * - lambda_s sinon.
+ * La probabilité d'infection 1 - prod (1 - p_s)^k_s est tirée en une fois,
+ * comme dans transition.c ; la souche transmise est choisie, avec le même
+ * tirage, en proportion de k_s p_s. Un MALADE qui guérit gagne l'immunité
+ * contre sa souche et reste IMMUNISE, contaminable par les autres. Avec une
+ * seule souche, mêmes tirages que jouerTourTransition.
+ *
+ * La souche d'une case n'est lue chez un voisin que s'il est contagieux au
+ * tour t, et ne change que pour une case qui ne l'était pas : souches et
+ * immunités sont écrites en place, sans tampon.
+ *
+ * Usage:
+ * ```
+ * struct ParametresSouche valeurs[NB_SOUCHES_MAX];
+ * int nb_souches = lireTableSouches("souches.txt", valeurs);
+ * struct Introduction variant = {.souche = 1, .x = 10, .y = 10, .tour = 30};
+ * struct Souches *souches = creerSouches(population, &parametres, valeurs,
+ *                                        nb_souches, &variant, 1);
+ * for (...) jouerTourSouches(souches, &aleatoire);
+ * struct Statistique delta = getStatistiqueSouche(souches, 1);
+ * detruireSouches(souches);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "souches.h"
+
+/**
+ * @brief Lit la table des souches : une ligne "beta gamma lambda croisee"
+ * par souche, dans l'ordre des indices.
+ *
+ * Les lignes vides et les commentaires (#) sont ignorés.
+ *
+ * Usage:
+ * ```
+ * # beta  gamma  lambda  croisee
+ * 0.05    0.1    0.5     0       # 0 : souche historique
+ * 0.02    0.1    0.9     0.3     # 1 : variant plus contagieux
+ * ```
+ *
+ * @param fichier Nom du fichier.
+ * @param valeurs Paramètres de chaque souche.
+ * @return int Nombre de souches, -1 si le fichier est invalide.
+ */
+int lireTableSouches(const char *fichier,
+                     struct ParametresSouche valeurs[NB_SOUCHES_MAX]) {
+  FILE *file = fopen(fichier, "r");
+  if (!file) return -1;
+  char ligne[256];
+  int nb_souches = 0;
+  while (fgets(ligne, sizeof(ligne), file)) {
+    char *commentaire = strchr(ligne, '#');
+    if (commentaire) *commentaire = '\0';
+    char reste;
+    if (sscanf(ligne, " %c", &reste) != 1) continue;  // Ligne vide
+    struct ParametresSouche lus;
+    if (nb_souches == NB_SOUCHES_MAX ||
+        sscanf(ligne, "%lf %lf %lf %lf %c", &lus.beta, &lus.gamma,
+               &lus.lambda, &lus.croisee, &reste) != 4 ||
+        lus.beta < 0 || lus.beta > 1 || lus.gamma < 0 || lus.gamma > 1 ||
+        lus.lambda < 0 || lus.lambda > 1 || lus.croisee < 0 ||
+        lus.croisee > 1) {
+      fclose(file);
+      return -1;
+    }
+    valeurs[nb_souches++] = lus;
+  }
+  fclose(file);
+  return nb_souches ? nb_souches : -1;
+}
+
+/**
+ * @brief Créer le moteur multi-souches.
+ *
+ * Les cases MALADE et INCUBE de la population portent la souche 0, les
+ * cases IMMUNISE sont immunisées contre toutes les souches.
+ *
+ * @param population Population (non possédée, doit survivre au moteur).
+ * @param parametres Paramètres communs.
+ * @param valeurs Paramètres de chaque souche (copiés).
+ * @param nb_souches Nombre de souches (1 à NB_SOUCHES_MAX).
+ * @param introductions Introductions des autres souches (copiées).
+ * @param nb_introductions Nombre d'introductions.
+ * @return struct Souches* Moteur, NULL si une introduction porte une souche
+ * inconnue ou une case hors de la grille.
+ */
+struct Souches *creerSouches(struct Population *population,
+                             const struct Parametres *parametres,
+                             const struct ParametresSouche *valeurs,
+                             unsigned int nb_souches,
+                             const struct Introduction *introductions,
+                             unsigned int nb_introductions) {
+  if (!nb_souches || nb_souches > NB_SOUCHES_MAX) return NULL;
+  for (unsigned int n = 0; n < nb_introductions; n++)
+    if (introductions[n].souche >= nb_souches ||
+        introductions[n].x >= population->cote ||
+        introductions[n].y >= population->cote)
+      return NULL;
+
+  const unsigned long taille = population->cote * population->cote;
+  struct Souches *souches = (struct Souches *)malloc(sizeof(struct Souches));
+  souches->population = population;
+  souches->nb_souches = nb_souches;
+  memcpy(souches->valeurs, valeurs,
+         nb_souches * sizeof(struct ParametresSouche));
+  souches->nb_introductions = nb_introductions;
+  souches->introductions = (struct Introduction *)malloc(
+      (nb_introductions ? nb_introductions : 1) *
+      sizeof(struct Introduction));
+  if (nb_introductions)
+    memcpy(souches->introductions, introductions,
+           nb_introductions * sizeof(struct Introduction));
+  souches->souches = (uint8_t *)malloc(taille);
+  souches->immunites = (uint16_t *)malloc(taille * sizeof(uint16_t));
+  parametrerSouches(souches, parametres);
+  chargerSouches(souches);
+  return souches;
+}
+
+/**
+ * @brief Recalcule la transition MALADE de chaque souche pour d'autres
+ * paramètres communs (bifurcation).
+ *
+ * @param souches Moteur.
+ * @param parametres Paramètres communs (copiés).
+ */
+void parametrerSouches(struct Souches *souches,
+                       const struct Parametres *parametres) {
+  souches->parametres = *parametres;
+  struct TableTransition table;
+  for (unsigned int s = 0; s < souches->nb_souches; s++) {
+    struct Parametres parametres_souche = *parametres;
+    parametres_souche.beta = souches->valeurs[s].beta;
+    parametres_souche.gamma = souches->valeurs[s].gamma;
+    parametres_souche.lambda = souches->valeurs[s].lambda;
+    initTableTransition(&table, &parametres_souche);
+    souches->malades[s] = table.transitions[MALADE][0][0];
+  }
+}
+
+/**
+ * @brief Compte une case dans les effectifs.
+ *
+ * @param souches Moteur.
+ * @param state Etat de la case au tour suivant.
+ * @param souche Souche de sa dernière infection.
+ * @param immunites Ses immunités.
+ */
+static void compter(struct Souches *souches, enum State state, uint8_t souche,
+                    uint16_t immunites) {
+  souches->totaux[state]++;
+  if ((state == INCUBE || state == MALADE || state == MORT) &&
+      souche != SOUCHE_AUCUNE)
+    souches->effectifs[souche][state]++;
+  if (state == MORT || state == VACCINE) return;
+  for (; immunites; immunites &= immunites - 1)
+    souches->effectifs[__builtin_ctz(immunites)][IMMUNISE]++;
+}
+
+/**
+ * @brief Termine les effectifs d'un tour : SAIN (vivants ni infectés ni
+ * immunisés par la souche), VACCINE et pics.
+ *
+ * @param souches Moteur.
+ */
+static void terminerEffectifs(struct Souches *souches) {
+  const long *totaux = souches->totaux;
+  const long vivants =
+      totaux[SAIN] + totaux[IMMUNISE] + totaux[INCUBE] + totaux[MALADE];
+  for (unsigned int s = 0; s < souches->nb_souches; s++) {
+    long *effectifs = souches->effectifs[s];
+    effectifs[SAIN] =
+        vivants - effectifs[IMMUNISE] - effectifs[INCUBE] - effectifs[MALADE];
+    effectifs[VACCINE] = totaux[VACCINE];
+    if (effectifs[MALADE] > souches->pics[s]) {
+      souches->pics[s] = effectifs[MALADE];
+      souches->tours_pics[s] = souches->population->tour;
+    }
+  }
+}
+
+/**
+ * @brief Recharge souches, immunités et effectifs depuis la population
+ * (condition initiale rechargée).
+ *
+ * @param souches Moteur.
+ */
+void chargerSouches(struct Souches *souches) {
+  const struct Population *population = souches->population;
+  const unsigned long taille = population->cote * population->cote;
+  const uint16_t toutes = (uint16_t)((1u << souches->nb_souches) - 1);
+  memset(souches->effectifs, 0, sizeof(souches->effectifs));
+  memset(souches->totaux, 0, sizeof(souches->totaux));
+  memset(souches->infections, 0, sizeof(souches->infections));
+  memset(souches->pics, 0, sizeof(souches->pics));
+  memset(souches->tours_pics, 0, sizeof(souches->tours_pics));
+  for (unsigned long k = 0; k < taille; k++) {
+    const enum State state = population->personnes[k].state;
+    const int infectee = state == MALADE || state == INCUBE;
+    souches->souches[k] = infectee ? 0 : SOUCHE_AUCUNE;
+    souches->immunites[k] = state == IMMUNISE ? toutes : 0;
+    souches->infections[0] += infectee;
+    compter(souches, state, souches->souches[k], souches->immunites[k]);
+  }
+  terminerEffectifs(souches);
+}
+
+/**
+ * @brief Ajoute une issue de probabilité p (ignorée si nulle), comme
+ * transition.c.
+ *
+ * @param transition Transition en construction.
+ * @param issue Issue.
+ * @param p Probabilité de l'issue.
+ */
+static void ajouterIssue(struct Transition *transition, unsigned char issue,
+                         double p) {
+  if (p <= 0) return;
+  const double cumul =
+      transition->nb_issues ? transition->seuils[transition->nb_issues - 1] : 0;
+  transition->issues[transition->nb_issues] = issue;
+  transition->seuils[transition->nb_issues] = cumul + p;
+  transition->nb_issues++;
+}
+
+/**
+ * @brief Introduit les souches prévues au tour courant.
+ *
+ * Comme une infection : comptée et datée dans le raster d'infection. Une
+ * case déjà infectée (INCUBE, MALADE), MORT ou VACCINE est laissée.
+ *
+ * @param souches Moteur.
+ */
+static void introduire(struct Souches *souches) {
+  struct Population *population = souches->population;
+  uint16_t *const raster_infection = population->rasters[RASTER_INFECTION];
+  for (unsigned int n = 0; n < souches->nb_introductions; n++) {
+    const struct Introduction *introduction = &souches->introductions[n];
+    const unsigned long k =
+        introduction->x * population->cote + introduction->y;
+    const enum State state = population->personnes[k].state;
+    if (introduction->tour != population->tour || state == INCUBE ||
+        state == MALADE || state == MORT || state == VACCINE)
+      continue;
+    population->personnes[k].state = MALADE;
+    souches->souches[k] = (uint8_t)introduction->souche;
+    souches->infections[introduction->souche]++;
+    if (raster_infection) raster_infection[k] = getTourRaster(population);
+  }
+}
+
+/**
+ * @brief Joue un tour : introductions, puis même loi que
+ * jouerTourTransition avec les paramètres de la souche de chaque infection.
+ *
+ * @param souches Moteur.
+ * @param aleatoire Générateur aléatoire propre à la simulation.
+ */
+void jouerTourSouches(struct Souches *souches, struct Aleatoire *aleatoire) {
+  struct Population *population = souches->population;
+  const long unsigned cote = population->cote;
+  const struct Parametres *parametres = &souches->parametres;
+  const struct ParametresSouche *valeurs = souches->valeurs;
+  uint8_t *souche_de = souches->souches;
+  uint16_t *immunites = souches->immunites;
+  introduire(souches);
+  preparerTampon(population);
+  struct Personne **grille_tampon = population->grille_tampon;
+  // Grille au tour present, tampon au tour present + 1
+  const unsigned long present = population->tour;
+  // Zones créées à partir d'ici : neuves pendant ce balayage
+  const uint32_t premiere_zone = population->zones.nb_zones;
+  uint32_t raccourcie = 0;
+  population->tour++;
+  memset(souches->effectifs, 0, sizeof(souches->effectifs));
+  memset(souches->totaux, 0, sizeof(souches->totaux));
+
+  // Alias
+  struct Personne **grille = population->grille_de_personnes;
+  const struct Personne *personnes = population->personnes;
+
+  for (long unsigned i = 0; i < cote; i++) {
+    for (long unsigned j = 0; j < cote; j++) {
+      const unsigned long k = i * cote + j;
+      const struct Personne *personne = &grille[i][j];
+      struct Personne *tampon = &grille_tampon[i][j];
+      const enum State state = personne->state;
+      // Déjà en quarantaine et remise dans une zone neuve avant son passage :
+      // un tour de moins que la zone (voir raccourcirZone)
+      if (tampon->zone >= premiere_zone &&
+          population->zones.expirations[personne->zone] > present)
+        tampon->zone = raccourcirZone(population, tampon->zone, &raccourcie);
+      if (state == INCUBE) {
+        // Décompte déterministe, sans tirage
+        if (personne->duree_incube == 0)
+          tampon->state = MALADE;
+        else
+          tampon->duree_incube--;
+        compter(souches, tampon->state, souche_de[k], immunites[k]);
+        continue;
+      }
+      if (state == MORT || state == VACCINE) {
+        compter(souches, state, souche_de[k], immunites[k]);
+        continue;
+      }
+
+      // Souches des voisins contagieux compatibles, groupées (au plus 4)
+      // avec leur nombre, et voisin VACCINE : SAIN et IMMUNISE seulement
+      struct Transition locale;
+      const struct Transition *transition = &locale;
+      uint8_t groupes[NB_VOISINS];
+      double pressions[NB_VOISINS];
+      int nb_groupes = 0;
+      if (state == MALADE) {
+        transition = &souches->malades[souche_de[k]];
+      } else {
+        const unsigned long *expirations = population->zones.expirations;
+        const int libre = expirations[personne->zone] <= present;
+        unsigned long voisins[NB_VOISINS];
+        int n = 0, vaccin = 0, nombres[NB_VOISINS];
+        if (j > 0) voisins[n++] = k - 1;
+        if (j < cote - 1) voisins[n++] = k + 1;
+        if (i > 0) voisins[n++] = k - cote;
+        if (i < cote - 1) voisins[n++] = k + cote;
+        for (int v = 0; v < n; v++) {
+          const struct Personne *voisin = &personnes[voisins[v]];
+          vaccin |= voisin->state == VACCINE;
+          if ((voisin->state != MALADE && voisin->state != INCUBE) ||
+              (voisin->zone != personne->zone &&
+               (expirations[voisin->zone] <= present) != libre))
+            continue;
+          const uint8_t souche = souche_de[voisins[v]];
+          int g = 0;
+          while (g < nb_groupes && groupes[g] != souche) g++;
+          if (g == nb_groupes) {
+            groupes[nb_groupes++] = souche;
+            nombres[g] = 0;
+          }
+          nombres[g]++;
+        }
+
+        // Survie à tous les voisins, puis issues comme initTableTransition
+        const double p_vaccin =
+            vaccin ? 1 : parametres->chance_decouverte_vaccin;
+        double survie = 1;
+        for (int g = 0; g < nb_groupes; g++) {
+          const struct ParametresSouche *souche = &valeurs[groupes[g]];
+          double p = 0;  // Immunisée contre la souche
+          if (!(immunites[k] >> groupes[g] & 1))
+            p = immunites[k] ? souche->lambda * (1 - souche->croisee)
+                             : souche->lambda;
+          survie *= pow(1 - p, nombres[g]);
+          pressions[g] = (g ? pressions[g - 1] : 0) + nombres[g] * p;
+        }
+        locale.nb_issues = 0;
+        ajouterIssue(&locale, VACCINE, p_vaccin);
+        ajouterIssue(&locale, INCUBE, (1 - p_vaccin) * (1 - survie));
+        if (locale.nb_issues && locale.seuils[locale.nb_issues - 1] < 1)
+          ajouterIssue(&locale, state, 1 - locale.seuils[locale.nb_issues - 1]);
+        if (!locale.nb_issues) ajouterIssue(&locale, state, 1);
+        locale.seuils[locale.nb_issues - 1] = 1;
+      }
+
+      // Une recherche et au plus un tirage
+      unsigned char issue = transition->issues[0];
+      double u = 0;
+      int n = 0;
+      if (transition->nb_issues > 1) {
+        u = aleatoireUniforme(aleatoire);
+        while (n < transition->nb_issues - 1 && u >= transition->seuils[n]) n++;
+        issue = transition->issues[n];
+      }
+
+      // Quarantaine, état et rasters comme balayerTables, puis souche
+      const enum State nouveau =
+          issue == state ? state
+                         : appliquerIssue(population, parametres, i, j, state,
+                                          issue);
+      if (nouveau == INCUBE) {
+        // Souche transmise : même tirage, rapporté à l'issue INCUBE
+        double v;
+        if (transition->nb_issues > 1) {
+          const double debut = n ? transition->seuils[n - 1] : 0;
+          v = (u - debut) / (transition->seuils[n] - debut);
+        } else {
+          v = nb_groupes > 1 ? aleatoireUniforme(aleatoire) : 0;
+        }
+        int g = 0;
+        while (g < nb_groupes - 1 &&
+               v * pressions[nb_groupes - 1] >= pressions[g])
+          g++;
+        souche_de[k] = groupes[g];
+        souches->infections[groupes[g]]++;
+      } else if (nouveau == IMMUNISE && state == MALADE) {
+        immunites[k] |= (uint16_t)(1u << souche_de[k]);
+      }
+      compter(souches, nouveau, souche_de[k], immunites[k]);
+    }
+  }
+
+  echangerTampon(population);  // Appliquer les changements
+  terminerEffectifs(souches);
+}
+
+/**
+ * @brief Statistique d'une souche au tour courant, sans parcours.
+ *
+ * INCUBE, MALADE et MORT de la souche, IMMUNISE contre elle (vivants),
+ * VACCINE de toute la population, SAIN : vivants encore contaminables par
+ * la souche.
+ *
+ * @param souches Moteur.
+ * @param souche Indice de la souche.
+ * @return struct Statistique Statistique de la souche.
+ */
+struct Statistique getStatistiqueSouche(const struct Souches *souches,
+                                        unsigned int souche) {
+  const long *effectifs = souches->effectifs[souche];
+  const struct Statistique statistique = {
+      effectifs[IMMUNISE], effectifs[SAIN],   effectifs[MORT],
+      effectifs[MALADE],   effectifs[INCUBE], effectifs[VACCINE]};
+  return statistique;
+}
+
+/**
+ * @brief Statistique de toute la population au tour courant, sans parcours.
+ *
+ * @param souches Moteur.
+ * @return struct Statistique Effectifs de chaque état, toutes souches.
+ */
+struct Statistique getStatistiqueSouches(const struct Souches *souches) {
+  const long *totaux = souches->totaux;
+  const struct Statistique statistique = {
+      totaux[IMMUNISE], totaux[SAIN],   totaux[MORT],
+      totaux[MALADE],   totaux[INCUBE], totaux[VACCINE]};
+  return statistique;
+}
+
+/**
+ * @brief Ecrit le tableau des souches au tour courant : infections
+ * cumulées, effectifs, pic de MALADE et létalité (MORT parmi les
+ * infections) de chaque souche.
+ *
+ * @param souches Moteur.
+ * @param file Fichier ouvert en écriture.
+ */
+void ecrireSouches(const struct Souches *souches, FILE *file) {
+  fprintf(file,
+          "-------------------------------------------------------------------"
+          "-----------\n"
+          "| S. | Infections | MALADE  |  MORT   |  IMMU   |"
+          " Pic MAL (tour)  | Létalité  |\n"
+          "| -- | ---------- | ------- | ------- | ------- |"
+          " --------------- | --------- |\n");
+  for (unsigned int s = 0; s < souches->nb_souches; s++) {
+    const struct Statistique stats = getStatistiqueSouche(souches, s);
+    const long infections = souches->infections[s];
+    fprintf(file,
+            "| %2u | %10li | %7li | %7li | %7li | %7li (%5lu) |"
+            " %7.2lf %% |\n",
+            s, infections, stats.nb_MALADE, stats.nb_MORT, stats.nb_IMMUNISE,
+            souches->pics[s], souches->tours_pics[s],
+            infections ? (double)stats.nb_MORT * 100 / infections : 0.);
+  }
+  fprintf(file,
+          "-------------------------------------------------------------------"
+          "-----------\n");
+}
+
+/**
+ * @brief Libère le moteur (pas la population).
+ *
+ * @param souches Moteur.
+ */
+void detruireSouches(struct Souches *souches) {
+  free(souches->introductions);
+  free(souches->souches);
+  free(souches->immunites);
+  free(souches);
+}
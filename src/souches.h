@@ -0,0 +1,162 @@
+#if !defined(SOUCHES_H)
+#define SOUCHES_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "aleatoire.h"
+#include "jouer_un_tour.h"
+#include "population.h"
+#include "statistique.h"
+#include "transition.h"
+
+/**
+ * @brief Nombre maximal de souches : une immunité par bit de
+ * Souches.immunites.
+ */
+#define NB_SOUCHES_MAX 16
+
+/**
+ * @brief Souche d'une case jamais infectée.
+ */
+#define SOUCHE_AUCUNE 0xFF
+
+/**
+ * @brief Paramètres propres à une souche (variant).
+ *
+ * Les autres paramètres (quarantaine, vaccin, incubation) sont communs.
+ */
+struct ParametresSouche {
+  /**
+   * @brief Probabilité d'un MALADE de la souche de mourir.
+   */
+  double beta;
+  /**
+   * @brief Probabilité d'un MALADE de la souche de guérir.
+   */
+  double gamma;
+  /**
+   * @brief Probabilité de contamination d'une case sans immunité par un
+   * voisin de la souche.
+   */
+  double lambda;
+  /**
+   * @brief Protection croisée : part de lambda retirée à une case immunisée
+   * contre une autre souche (0 : aucune, 1 : totale).
+   */
+  double croisee;
+};
+
+/**
+ * @brief Introduction d'une souche : la case devient MALADE de la souche au
+ * début du tour donné (si elle n'est ni MORT ni VACCINE).
+ */
+struct Introduction {
+  /**
+   * @brief Indice de la souche.
+   */
+  unsigned int souche;
+  /**
+   * @brief Ligne de la case.
+   */
+  unsigned long x;
+  /**
+   * @brief Colonne de la case.
+   */
+  unsigned long y;
+  /**
+   * @brief Tour de l'introduction.
+   */
+  unsigned long tour;
+};
+
+/**
+ * @brief Moteur multi-souches : une souche et une immunité par souche pour
+ * chaque case, sans grille par souche.
+ *
+ * Même loi que jouerTourTransition pour une souche ; avec plusieurs, chaque
+ * case SAIN ou IMMUNISE est infectée selon les souches de ses voisins
+ * contagieux et ses immunités. Les Statistique par souche sont comptées
+ * pendant le tour.
+ */
+struct Souches {
+  /**
+   * @brief Population jouée (non possédée).
+   */
+  struct Population *population;
+  /**
+   * @brief Paramètres communs (copie) ; beta, gamma et lambda sont ignorés.
+   */
+  struct Parametres parametres;
+  /**
+   * @brief Nombre de souches (1 à NB_SOUCHES_MAX).
+   */
+  unsigned int nb_souches;
+  /**
+   * @brief Paramètres de chaque souche (copie).
+   */
+  struct ParametresSouche valeurs[NB_SOUCHES_MAX];
+  /**
+   * @brief Transition MALADE de chaque souche.
+   */
+  struct Transition malades[NB_SOUCHES_MAX];
+  /**
+   * @brief Introductions (copie).
+   */
+  struct Introduction *introductions;
+  /**
+   * @brief Nombre d'introductions.
+   */
+  unsigned int nb_introductions;
+  /**
+   * @brief Souche de la dernière infection de chaque case, cote*cote octets
+   * ligne par ligne (SOUCHE_AUCUNE : jamais infectée).
+   */
+  uint8_t *souches;
+  /**
+   * @brief Immunités de chaque case, un bit par souche.
+   */
+  uint16_t *immunites;
+  /**
+   * @brief Effectifs [souche][enum State] du tour courant : INCUBE et
+   * MALADE de la souche, MORT de la souche, IMMUNISE contre la souche
+   * (vivants), VACCINE de toute la population, SAIN le reste.
+   */
+  long effectifs[NB_SOUCHES_MAX][VACCINE + 1];
+  /**
+   * @brief Effectifs de toute la population, par enum State.
+   */
+  long totaux[VACCINE + 1];
+  /**
+   * @brief Infections cumulées de chaque souche (introductions comprises).
+   */
+  long infections[NB_SOUCHES_MAX];
+  /**
+   * @brief Pic de MALADE de chaque souche.
+   */
+  long pics[NB_SOUCHES_MAX];
+  /**
+   * @brief Tour du pic de chaque souche.
+   */
+  unsigned long tours_pics[NB_SOUCHES_MAX];
+};
+
+int lireTableSouches(const char *fichier,
+                     struct ParametresSouche valeurs[NB_SOUCHES_MAX]);
+struct Souches *creerSouches(struct Population *population,
+                             const struct Parametres *parametres,
+                             const struct ParametresSouche *valeurs,
+                             unsigned int nb_souches,
+                             const struct Introduction *introductions,
+                             unsigned int nb_introductions);
+void parametrerSouches(struct Souches *souches,
+                       const struct Parametres *parametres);
+void chargerSouches(struct Souches *souches);
+void jouerTourSouches(struct Souches *souches, struct Aleatoire *aleatoire);
+struct Statistique getStatistiqueSouche(const struct Souches *souches,
+                                        unsigned int souche);
+struct Statistique getStatistiqueSouches(const struct Souches *souches);
+void ecrireSouches(const struct Souches *souches, FILE *file);
+void detruireSouches(struct Souches *souches);
+
+#endif  // SOUCHES_H
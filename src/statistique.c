@@ -9,8 +9,9 @@
  * - exporter une base de données
  * - dériver les valeurs de la base de données
  * - obtenir des Statistique
- * - exporter et afficher un graphique
+ * - exporter et afficher un graphique, le détruire
  * - exporter et afficher un tableau de bord
+ * - détruire une base de données
  *
  * Usage:
  * ```
@@ -30,8 +31,13 @@
  * // Out
  * exporter(data, "data.txt");
  * exporter(data_derive, "data_derive.txt");
- * char* graph = graphique(data, "graphique.txt", 100, 80);
+ * char **graph = graphique(data, "graphique.txt", 100, 80);
  * tableau(data, "tableau");
+ *
+ * // Libérer
+ * detruireGraphique(graph, 100);
+ * detruireData(data_derive);
+ * detruireData(data);
  * ```
  *
  * @author Marc NGUYEN
@@ -51,9 +57,12 @@
  */
 struct Data *creerData(void) {
   struct Data *data = (struct Data *)malloc(sizeof(struct Data));
-  struct Statistique **liste_statistiques = (struct Statistique **)malloc(0);
-  data->liste_statistiques = liste_statistiques;
+  data->capacite = 16;
+  data->liste_statistiques = (struct Statistique **)malloc(
+      sizeof(struct Statistique *) * data->capacite);
   data->tours = 0;
+  data->population_totale = 0;
+  initIndicateurs(&data->indicateurs);
   return data;
 }
 
@@ -72,14 +81,18 @@ struct Data *creerData(void) {
  * @param stats Donnée à ajouter.
  */
 void appendData(struct Data *data, struct Statistique stats) {
-  // Nouvelle allocation de mémoire
-  struct Statistique **nouvelle_liste_statistiques =
-      (struct Statistique **)malloc(sizeof(struct Statistique *) * data->tours +
-                                    1);
-  for (unsigned long i = 0; i < data->tours; i++)
-    nouvelle_liste_statistiques[i] = data->liste_statistiques[i];
+  ajouterIndicateurs(&data->indicateurs,
+                     data->tours ? data->liste_statistiques[data->tours - 1]
+                                 : NULL,
+                     &stats, data->tours);
 
-  data->liste_statistiques = nouvelle_liste_statistiques;
+  // Nouvelle allocation de mémoire, capacité doublée (coût amorti constant)
+  if (data->tours == data->capacite) {
+    data->capacite *= 2;
+    data->liste_statistiques = (struct Statistique **)realloc(
+        data->liste_statistiques,
+        sizeof(struct Statistique *) * data->capacite);
+  }
   data->liste_statistiques[data->tours] =
       (struct Statistique *)malloc(sizeof(struct Statistique));
   data->liste_statistiques[data->tours]->nb_IMMUNISE = stats.nb_IMMUNISE;
@@ -91,6 +104,106 @@ void appendData(struct Data *data, struct Statistique stats) {
   data->tours++;
 }
 
+/**
+ * @brief Initialise des indicateurs vides.
+ *
+ * @param indicateurs Indicateurs.
+ */
+void initIndicateurs(struct Indicateurs *indicateurs) {
+  const struct Indicateurs vide = {.vitesse_max = {0, 0, 0, 0, 0, 0},
+                                   .tour_vitesse_max = {0, 0, 0, 0, 0, 0},
+                                   .pic_MALADE = 0,
+                                   .tour_pic_MALADE = 0,
+                                   .pic_INCUBE = 0,
+                                   .tour_pic_INCUBE = 0,
+                                   .infections_cumulees = 0,
+                                   .tour_extinction = -1};
+  *indicateurs = vide;
+}
+
+/**
+ * @brief Met à jour les indicateurs avec la Statistique du tour tour.
+ *
+ * O(1) : le tableau de bord n'a plus besoin de dériver toute la base.
+ *
+ * @param indicateurs Indicateurs.
+ * @param precedente Statistique du tour précédent, NULL au tour 0.
+ * @param stats Statistique du tour.
+ * @param tour Numéro du tour.
+ */
+void ajouterIndicateurs(struct Indicateurs *indicateurs,
+                        const struct Statistique *precedente,
+                        const struct Statistique *stats, unsigned long tour) {
+  const long infectes = stats->nb_INCUBE + stats->nb_MALADE + stats->nb_MORT +
+                        stats->nb_IMMUNISE;
+  if (!precedente) {
+    indicateurs->infections_cumulees = infectes;
+  } else {
+    const long infectes_precedents = precedente->nb_INCUBE +
+                                     precedente->nb_MALADE +
+                                     precedente->nb_MORT +
+                                     precedente->nb_IMMUNISE;
+    if (infectes > infectes_precedents)
+      indicateurs->infections_cumulees += infectes - infectes_precedents;
+
+    // Vitesses max (dérivée x(t) - x(t-1))
+    struct Statistique *vitesse = &indicateurs->vitesse_max;
+    struct Statistique *tour_vitesse = &indicateurs->tour_vitesse_max;
+    if (vitesse->nb_IMMUNISE < stats->nb_IMMUNISE - precedente->nb_IMMUNISE) {
+      vitesse->nb_IMMUNISE = stats->nb_IMMUNISE - precedente->nb_IMMUNISE;
+      tour_vitesse->nb_IMMUNISE = tour;
+    }
+    if (vitesse->nb_SAIN < stats->nb_SAIN - precedente->nb_SAIN) {
+      vitesse->nb_SAIN = stats->nb_SAIN - precedente->nb_SAIN;
+      tour_vitesse->nb_SAIN = tour;
+    }
+    if (vitesse->nb_MORT < stats->nb_MORT - precedente->nb_MORT) {
+      vitesse->nb_MORT = stats->nb_MORT - precedente->nb_MORT;
+      tour_vitesse->nb_MORT = tour;
+    }
+    if (vitesse->nb_MALADE < stats->nb_MALADE - precedente->nb_MALADE) {
+      vitesse->nb_MALADE = stats->nb_MALADE - precedente->nb_MALADE;
+      tour_vitesse->nb_MALADE = tour;
+    }
+    if (vitesse->nb_INCUBE < stats->nb_INCUBE - precedente->nb_INCUBE) {
+      vitesse->nb_INCUBE = stats->nb_INCUBE - precedente->nb_INCUBE;
+      tour_vitesse->nb_INCUBE = tour;
+    }
+    if (vitesse->nb_VACCINE < stats->nb_VACCINE - precedente->nb_VACCINE) {
+      vitesse->nb_VACCINE = stats->nb_VACCINE - precedente->nb_VACCINE;
+      tour_vitesse->nb_VACCINE = tour;
+    }
+  }
+
+  // Pics
+  if (indicateurs->pic_MALADE < stats->nb_MALADE) {
+    indicateurs->pic_MALADE = stats->nb_MALADE;
+    indicateurs->tour_pic_MALADE = tour;
+  }
+  if (indicateurs->pic_INCUBE < stats->nb_INCUBE) {
+    indicateurs->pic_INCUBE = stats->nb_INCUBE;
+    indicateurs->tour_pic_INCUBE = tour;
+  }
+
+  // Extinction
+  if (stats->nb_MALADE || stats->nb_INCUBE)
+    indicateurs->tour_extinction = -1;
+  else if (indicateurs->tour_extinction < 0)
+    indicateurs->tour_extinction = tour;
+}
+
+/**
+ * @brief Taux d'attaque : part de la population infectée au moins une fois.
+ *
+ * @param data Base de données.
+ * @return double Taux dans [0, 1].
+ */
+double tauxAttaque(const struct Data *data) {
+  if (!data->population_totale) return 0;
+  return (double)data->indicateurs.infections_cumulees /
+         data->population_totale;
+}
+
 /**
  * @brief Exporte les données brutes dans un fichier fichier_data.
  *
@@ -100,7 +213,7 @@ void appendData(struct Data *data, struct Statistique stats) {
  * @param data Base de données.
  * @param fichier_data Nom du fichier à écrire.
  */
-void exporter(struct Data *data, const char *fichier_data) {
+void exporter(const struct Data *data, const char *fichier_data) {
   FILE *file = fopen(fichier_data, "w");
   if (!file) {
     printf("Erreur: Le fichier n'a pas pu être ouvert.\n");
@@ -122,13 +235,44 @@ void exporter(struct Data *data, const char *fichier_data) {
   fclose(file);
 }
 
+/**
+ * @brief Importe des données brutes au format de exporter (observations).
+ *
+ * @param fichier_data Nom du fichier à lire.
+ * @return struct Data* Base de données, NULL si le fichier est illisible ou
+ * mal formé.
+ */
+struct Data *importer(const char *fichier_data) {
+  FILE *file = fopen(fichier_data, "r");
+  if (!file) return NULL;
+  struct Data *data = creerData();
+  unsigned long tours;
+  int erreur = fscanf(file, "%lu %lu", &data->population_totale, &tours) != 2;
+  for (unsigned long i = 0; i < tours && !erreur; i++) {
+    unsigned long tour;
+    struct Statistique stats;
+    erreur = fscanf(file, "%lu %li %li %li %li %li %li", &tour,
+                    &stats.nb_IMMUNISE, &stats.nb_SAIN, &stats.nb_MORT,
+                    &stats.nb_MALADE, &stats.nb_INCUBE,
+                    &stats.nb_VACCINE) != 7 ||
+             tour != i;
+    if (!erreur) appendData(data, stats);
+  }
+  fclose(file);
+  if (erreur || !tours) {
+    detruireData(data);
+    return NULL;
+  }
+  return data;
+}
+
 /**
  * @brief Dérive tel que x(t+1)-x(t)
  *
  * @param data Structure Data source
  * @return struct Data* Structure Data avec liste_statistiques dérivée.
  */
-struct Data *deriver(struct Data *data) {
+struct Data *deriver(const struct Data *data) {
   struct Data *data_derive = creerData();
   struct Statistique stats;
 
@@ -173,7 +317,7 @@ struct Statistique getStatistique(struct Population *population) {
   struct Statistique statistique = {0, 0, 0, 0, 0, 0};
   for (long unsigned i = 0; i < population->cote; i++) {
     for (long unsigned j = 0; j < population->cote; j++) {
-      switch (population->grille_de_personnes[i][j]->state) {
+      switch (population->grille_de_personnes[i][j].state) {
         case IMMUNISE:
           statistique.nb_IMMUNISE++;
           break;
@@ -216,7 +360,7 @@ struct Statistique getStatistique(struct Population *population) {
  * @param limite Limite en tour du graphique (permet de compresser le graphique)
  * @return char** Graphique[ligne][charactère]
  */
-char **graphique(struct Data *data, const char *fichier_data,
+char **graphique(const struct Data *data, const char *fichier_data,
                  unsigned long hauteur, unsigned long limite) {
   FILE *file;
 
@@ -330,90 +474,124 @@ char **graphique(struct Data *data, const char *fichier_data,
     printf("\n");
   }
 
+  for (unsigned long i = 0; i < hauteur; i++) free(graphique_terminal[i]);
+  free(graphique_terminal);
   return graphique;
 }
 
 /**
- * @brief Affiche et exporte un tableau de bord.
+ * @brief Libère un graphique renvoyé par graphique().
  *
- * @param data Base de données de Statistique de la Population
- * @param fichier_tableau Nom du fichier à exporter.
+ * @param graphique Graphique[ligne][charactère].
+ * @param hauteur Hauteur du graphique.
  */
-void tableau(struct Data *data, const char *fichier_tableau) {
-  struct Data *data_derivee = deriver(data);
-  long vit_MALADE_max = 0;
-  long vit_IMMUNISE_max = 0;
-  long vit_MORT_max = 0;
-  long vit_INCUBE_max = 0;
-  for (unsigned long i = 0; i < data_derivee->tours; i++) {
-    if (vit_IMMUNISE_max < data_derivee->liste_statistiques[i]->nb_IMMUNISE)
-      vit_IMMUNISE_max = data_derivee->liste_statistiques[i]->nb_IMMUNISE;
-    if (vit_MORT_max < data_derivee->liste_statistiques[i]->nb_MORT)
-      vit_MORT_max = data_derivee->liste_statistiques[i]->nb_MORT;
-    if (vit_INCUBE_max < data_derivee->liste_statistiques[i]->nb_INCUBE)
-      vit_INCUBE_max = data_derivee->liste_statistiques[i]->nb_INCUBE;
-    if (vit_MALADE_max < data_derivee->liste_statistiques[i]->nb_MALADE)
-      vit_MALADE_max = data_derivee->liste_statistiques[i]->nb_MALADE;
-  }
+void detruireGraphique(char **graphique, unsigned long hauteur) {
+  for (unsigned long i = 0; i < hauteur; i++) free(graphique[i]);
+  free(graphique);
+}
 
-  printf(
-      "-----------------------------------------------------------------\n"
-      "| Tours |   SAIN   |   MORT   |   IMMU   |   VACC   |   Total   |\n"
-      "| ----- | -------- | -------- | -------- | -------- | --------- |\n"
-      "| %5lu | %8li | %8li | %8li | %8lu | %9lu |\n",
-      data->tours, data->liste_statistiques[data->tours - 1]->nb_SAIN,
-      data->liste_statistiques[data->tours - 1]->nb_MORT,
-      data->liste_statistiques[data->tours - 1]->nb_IMMUNISE,
-      data->liste_statistiques[data->tours - 1]->nb_VACCINE,
-      data->population_totale);
-  printf(
-      "|       | %6.2lf %% | %6.2lf %% | %6.2lf %% | %6.2lf %% |     100 %% "
-      "|\n",
-      (double)data->liste_statistiques[data->tours - 1]->nb_SAIN * 100 /
-          data->population_totale,
-      (double)data->liste_statistiques[data->tours - 1]->nb_MORT * 100 /
-          data->population_totale,
-      (double)data->liste_statistiques[data->tours - 1]->nb_IMMUNISE * 100 /
-          data->population_totale,
-      (double)data->liste_statistiques[data->tours - 1]->nb_VACCINE * 100 /
-          data->population_totale);
-  printf(
-      "|---------------------------------------------------------------|\n"
-      "| Vit. IMMU max | Vit. INCUB max | Vit. MAL max | Vit. MORT max |\n"
-      "| ------------- | -------------- | ------------ | ------------- |\n"
-      "| %13li | %14li | %12li | %13li |\n",
-      vit_IMMUNISE_max, vit_INCUBE_max, vit_MALADE_max, vit_MORT_max);
-  printf("-----------------------------------------------------------------\n");
+/**
+ * @brief Ecrit le tableau de bord dans file.
+ *
+ * @param file Fichier (stdout pour le terminal).
+ * @param indicateurs Indicateurs de la simulation.
+ * @param derniere Statistique du dernier tour.
+ * @param tours Nombre de tours.
+ * @param population_totale Population totale.
+ */
+static void ecrireTableau(FILE *file, const struct Indicateurs *indicateurs,
+                          const struct Statistique *derniere,
+                          unsigned long tours,
+                          unsigned long population_totale) {
+  char extinction[16] = "en cours";
+  if (indicateurs->tour_extinction >= 0)
+    snprintf(extinction, sizeof(extinction), "%li",
+             indicateurs->tour_extinction);
 
-  FILE *file = fopen(fichier_tableau, "w");
   fprintf(file,
           "-----------------------------------------------------------------\n"
           "| Tours |   SAIN   |   MORT   |   IMMU   |   VACC   |   Total   |\n"
           "| ----- | -------- | -------- | -------- | -------- | --------- |\n"
           "| %5lu | %8li | %8li | %8li | %8lu | %9lu |\n",
-          data->tours, data->liste_statistiques[data->tours - 1]->nb_SAIN,
-          data->liste_statistiques[data->tours - 1]->nb_MORT,
-          data->liste_statistiques[data->tours - 1]->nb_IMMUNISE,
-          data->liste_statistiques[data->tours - 1]->nb_VACCINE,
-          data->population_totale);
+          tours, derniere->nb_SAIN, derniere->nb_MORT, derniere->nb_IMMUNISE,
+          derniere->nb_VACCINE, population_totale);
   fprintf(file,
           "|       | %6.2lf %% | %6.2lf %% | %6.2lf %% | %6.2lf %% |     100 "
           "%% |\n",
-          (double)data->liste_statistiques[data->tours - 1]->nb_SAIN * 100 /
-              data->population_totale,
-          (double)data->liste_statistiques[data->tours - 1]->nb_MORT * 100 /
-              data->population_totale,
-          (double)data->liste_statistiques[data->tours - 1]->nb_IMMUNISE * 100 /
-              data->population_totale,
-          (double)data->liste_statistiques[data->tours - 1]->nb_VACCINE * 100 /
-              data->population_totale);
+          (double)derniere->nb_SAIN * 100 / population_totale,
+          (double)derniere->nb_MORT * 100 / population_totale,
+          (double)derniere->nb_IMMUNISE * 100 / population_totale,
+          (double)derniere->nb_VACCINE * 100 / population_totale);
   fprintf(file,
           "|---------------------------------------------------------------|\n"
           "| Vit. IMMU max | Vit. INCUB max | Vit. MAL max | Vit. MORT max |\n"
           "| ------------- | -------------- | ------------ | ------------- |\n"
           "| %13li | %14li | %12li | %13li |\n",
-          vit_IMMUNISE_max, vit_INCUBE_max, vit_MALADE_max, vit_MORT_max);
+          indicateurs->vitesse_max.nb_IMMUNISE,
+          indicateurs->vitesse_max.nb_INCUBE,
+          indicateurs->vitesse_max.nb_MALADE, indicateurs->vitesse_max.nb_MORT);
+  fprintf(file,
+          "|---------------------------------------------------------------|\n"
+          "| Pic MAL (tour) | Pic INCUB (tour) | Attaque  |   Extinction   |\n"
+          "| -------------- | ---------------- | -------- | -------------- |\n"
+          "| %7li (%4lu) | %9li (%4lu) | %6.2lf %% | %14s |\n",
+          indicateurs->pic_MALADE, indicateurs->tour_pic_MALADE,
+          indicateurs->pic_INCUBE, indicateurs->tour_pic_INCUBE,
+          (double)indicateurs->infections_cumulees * 100 / population_totale,
+          extinction);
   fprintf(
       file,
       "-----------------------------------------------------------------\n");
 }
+
+/**
+ * @brief Affiche et exporte un tableau de bord à partir des indicateurs.
+ *
+ * Utilisable avec toute source de Statistique (Data, série compressée...).
+ *
+ * @param indicateurs Indicateurs de la simulation.
+ * @param derniere Statistique du dernier tour.
+ * @param tours Nombre de tours.
+ * @param population_totale Population totale.
+ * @param fichier_tableau Nom du fichier à exporter.
+ */
+void tableauIndicateurs(const struct Indicateurs *indicateurs,
+                        const struct Statistique *derniere,
+                        unsigned long tours, unsigned long population_totale,
+                        const char *fichier_tableau) {
+  ecrireTableau(stdout, indicateurs, derniere, tours, population_totale);
+
+  FILE *file = fopen(fichier_tableau, "w");
+  if (!file) {
+    printf("Erreur: Le fichier n'a pas pu être ouvert.\n");
+    exit(1);
+  }
+  ecrireTableau(file, indicateurs, derniere, tours, population_totale);
+  fclose(file);
+}
+
+/**
+ * @brief Affiche et exporte un tableau de bord.
+ *
+ * O(1) : les indicateurs sont tenus à jour par appendData.
+ *
+ * @param data Base de données de Statistique de la Population
+ * @param fichier_tableau Nom du fichier à exporter.
+ */
+void tableau(const struct Data *data, const char *fichier_tableau) {
+  tableauIndicateurs(&data->indicateurs,
+                     data->liste_statistiques[data->tours - 1], data->tours,
+                     data->population_totale, fichier_tableau);
+}
+
+/**
+ * @brief Libère une base de données.
+ *
+ * @param data Base de données.
+ */
+void detruireData(struct Data *data) {
+  for (unsigned long i = 0; i < data->tours; i++)
+    free(data->liste_statistiques[i]);
+  free(data->liste_statistiques);
+  free(data);
+}
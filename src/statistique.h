@@ -3,8 +3,6 @@
 
 #include "population.h"
 
-const char *FICHIER_DATA;
-
 /**
  * @brief Structure contenant les chiffres intéressants.
  */
@@ -35,6 +33,47 @@ struct Statistique {
   long nb_VACCINE;
 };
 
+/**
+ * @brief Indicateurs du tableau de bord, mis à jour à chaque appendData.
+ */
+struct Indicateurs {
+  /**
+   * @brief Plus forte hausse x(t) - x(t-1) de chaque état (0 si aucune).
+   */
+  struct Statistique vitesse_max;
+  /**
+   * @brief Tour t de la plus forte hausse de chaque état.
+   */
+  struct Statistique tour_vitesse_max;
+  /**
+   * @brief Nombre maximum de MALADE.
+   */
+  long pic_MALADE;
+  /**
+   * @brief Tour du pic de MALADE.
+   */
+  unsigned long tour_pic_MALADE;
+  /**
+   * @brief Nombre maximum d'INCUBE.
+   */
+  long pic_INCUBE;
+  /**
+   * @brief Tour du pic d'INCUBE.
+   */
+  unsigned long tour_pic_INCUBE;
+  /**
+   * @brief Nombre cumulé de personnes infectées.
+   *
+   * Somme des hausses de INCUBE + MALADE + MORT + IMMUNISE : minorant quand
+   * des IMMUNISE sont vaccinés le même tour.
+   */
+  long infections_cumulees;
+  /**
+   * @brief Premier tour sans MALADE ni INCUBE, -1 si l'épidémie est active.
+   */
+  long tour_extinction;
+};
+
 /**
  * @brief Base de données.
  */
@@ -56,15 +95,35 @@ struct Data {
    * ```
    */
   struct Statistique **liste_statistiques;
+  /**
+   * @brief Nombre de cases allouées dans liste_statistiques.
+   */
+  unsigned long capacite;
+  /**
+   * @brief Indicateurs calculés au fil des appendData.
+   */
+  struct Indicateurs indicateurs;
 };
 
 struct Data *creerData(void);
 struct Statistique getStatistique(struct Population *population);
 void appendData(struct Data *data, struct Statistique stats);
-void exporter(struct Data *data, const char *fichier_data);
-struct Data *deriver(struct Data *data);
-char **graphique(struct Data *data, const char *fichier_data,
+void initIndicateurs(struct Indicateurs *indicateurs);
+void ajouterIndicateurs(struct Indicateurs *indicateurs,
+                        const struct Statistique *precedente,
+                        const struct Statistique *stats, unsigned long tour);
+double tauxAttaque(const struct Data *data);
+void exporter(const struct Data *data, const char *fichier_data);
+struct Data *importer(const char *fichier_data);
+struct Data *deriver(const struct Data *data);
+char **graphique(const struct Data *data, const char *fichier_data,
                  unsigned long hauteur, unsigned long limite);
-void tableau(struct Data *data, const char *fichier_tableau);
+void tableau(const struct Data *data, const char *fichier_tableau);
+void tableauIndicateurs(const struct Indicateurs *indicateurs,
+                        const struct Statistique *derniere,
+                        unsigned long tours, unsigned long population_totale,
+                        const char *fichier_tableau);
+void detruireGraphique(char **graphique, unsigned long hauteur);
+void detruireData(struct Data *data);
 
 #endif  // STATISTIQUE_H
@@ -0,0 +1,299 @@
+/**
+ * @file transition.c
+ *
+ * @brief Moteur à tables de transition : un seul tirage par case.
+ *
+ * Le noyau de jouer_un_tour.c tire un nombre par voisin contagieux pour une
+ * case SAIN, et jusqu'à trois pour une case MALADE. Ici, les issues de chaque
+ * (état, voisins contagieux compatibles, voisin VACCINE) sont précalculées en
+ * probabilités cumulées : une recherche dans la table et au plus un tirage
+ * par case, pour la même loi des issues.
+ *
+ * Usage:
+ * ```
+ * struct TableTransition table;
+ * initTableTransition(&table, &parametres);
+ * for (...) jouerTourTransition(population, &table, &aleatoire);
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <math.h>
+#include <stddef.h>
+
+#include "transition.h"
+
+/**
+ * @brief Ajoute une issue de probabilité p (ignorée si nulle).
+ *
+ * @param transition Transition en construction.
+ * @param issue Issue.
+ * @param p Probabilité de l'issue.
+ */
+static void ajouterIssue(struct Transition *transition, unsigned char issue,
+                         double p) {
+  if (p <= 0) return;
+  const double cumul =
+      transition->nb_issues ? transition->seuils[transition->nb_issues - 1] : 0;
+  transition->issues[transition->nb_issues] = issue;
+  transition->seuils[transition->nb_issues] = cumul + p;
+  transition->nb_issues++;
+}
+
+/**
+ * @brief Termine une transition : le dernier seuil vaut exactement 1.
+ *
+ * Les arrondis des sommes ne laissent ainsi aucun tirage sans issue. Une
+ * transition sans issue reste dans l'état courant.
+ *
+ * @param transition Transition en construction.
+ * @param state Etat courant.
+ */
+static void terminerTransition(struct Transition *transition,
+                               enum State state) {
+  if (!transition->nb_issues) ajouterIssue(transition, state, 1);
+  transition->seuils[transition->nb_issues - 1] = 1;
+}
+
+/**
+ * @brief Précalcule les transitions de chaque état.
+ *
+ * - SAIN : VACCINE (1 avec un voisin VACCINE, sinon découverte), puis
+ *   INCUBE avec 1 - (1 - lambda)^k, sinon SAIN ;
+ * - MALADE : quarantaine (chance_quarantaine) indépendante de MORT (beta),
+ *   IMMUNISE ((1 - beta) gamma) ou rien : 6 issues ;
+ * - IMMUNISE : VACCINE comme SAIN, sinon IMMUNISE ;
+ * - INCUBE (décompte déterministe), MORT, VACCINE : inchangés.
+ *
+ * @param table Table à remplir.
+ * @param parametres Paramètres (copiés).
+ */
+void initTableTransition(struct TableTransition *table,
+                         const struct Parametres *parametres) {
+  const double beta = parametres->beta;
+  const double gamma = parametres->gamma;
+  const double quarantaine = parametres->chance_quarantaine;
+  table->parametres = *parametres;
+
+  for (int state = SAIN; state <= VACCINE; state++) {
+    for (int k = 0; k <= NB_VOISINS; k++) {
+      for (int vaccin = 0; vaccin < 2; vaccin++) {
+        struct Transition *transition = &table->transitions[state][k][vaccin];
+        const double p_vaccin =
+            vaccin ? 1 : parametres->chance_decouverte_vaccin;
+        transition->nb_issues = 0;
+
+        switch (state) {
+          case SAIN:
+            ajouterIssue(transition, VACCINE, p_vaccin);
+            ajouterIssue(transition, INCUBE,
+                         (1 - p_vaccin) *
+                             (1 - pow(1 - parametres->lambda, k)));
+            break;
+
+          case MALADE:
+            for (int q = 1; q >= 0; q--) {
+              const double p_q = q ? quarantaine : 1 - quarantaine;
+              const unsigned char bit = q ? ISSUE_QUARANTAINE : 0;
+              ajouterIssue(transition, bit | MORT, p_q * beta);
+              ajouterIssue(transition, bit | IMMUNISE,
+                           p_q * (1 - beta) * gamma);
+              ajouterIssue(transition, bit | MALADE,
+                           p_q * (1 - beta) * (1 - gamma));
+            }
+            break;
+
+          case IMMUNISE:
+            ajouterIssue(transition, VACCINE, p_vaccin);
+            break;
+
+          default:
+            break;
+        }
+        // Reste : l'état courant
+        if (transition->nb_issues &&
+            transition->seuils[transition->nb_issues - 1] < 1 &&
+            state != MALADE)
+          ajouterIssue(transition, state,
+                       1 - transition->seuils[transition->nb_issues - 1]);
+        terminerTransition(transition, state);
+      }
+    }
+  }
+
+  struct TableCase *compacte = &table->compacte;
+  for (int vaccin = 0; vaccin < 2; vaccin++) {
+    for (int k = 0; k <= NB_VOISINS; k++)
+      compacte->sain[k][vaccin] = table->transitions[SAIN][k][vaccin];
+    compacte->immunise[vaccin] = table->transitions[IMMUNISE][0][vaccin];
+  }
+  compacte->malade = table->transitions[MALADE][0][0];
+}
+
+/**
+ * @brief Applique l'issue tirée pour la case (i, j) : quarantaine s'il y a
+ * lieu, nouvel état dans le tampon, rasters.
+ *
+ * Appelée pendant un balayage, après population->tour++ : la grille est au
+ * tour population->tour - 1, le tampon au tour population->tour. Une
+ * infection reçoit parametres->duree_incube.
+ *
+ * @param population Population en cours de balayage.
+ * @param parametres Incubation, cordon sanitaire et durée de quarantaine.
+ * @param i Ligne.
+ * @param j Colonne.
+ * @param state Etat de la case au tour présent.
+ * @param issue Issue tirée.
+ * @return enum State Nouvel état.
+ */
+enum State appliquerIssue(struct Population *population,
+                          const struct Parametres *parametres,
+                          unsigned long i, unsigned long j, enum State state,
+                          unsigned char issue) {
+  const unsigned long cote = population->cote;
+  struct Personne *tampon = &population->grille_tampon[i][j];
+  const uint16_t tour = getTourRaster(population);
+  if (issue & ISSUE_QUARANTAINE &&
+      population->zones.expirations[tampon->zone] <= population->tour) {
+    const uint32_t zone =
+        creerZone(population, parametres->duree_quarantaine);
+    if (zone)
+      mettreEnQuarantaineRaster(population->grille_tampon, i, j, cote,
+                                parametres->cordon_sanitaire, zone,
+                                population->rasters[RASTER_QUARANTAINE],
+                                tour);
+  }
+  const enum State nouveau = (enum State)(issue & ~ISSUE_QUARANTAINE);
+  if (nouveau == state) return nouveau;
+  tampon->state = nouveau;
+  uint16_t *raster = NULL;
+  if (nouveau == INCUBE) {
+    tampon->duree_incube = parametres->duree_incube;
+    raster = population->rasters[RASTER_INFECTION];
+  } else if (nouveau == MORT) {
+    raster = population->rasters[RASTER_MORT];
+  }
+  if (raster) raster[i * cote + j] = tour;
+  return nouveau;
+}
+
+/**
+ * @brief Joue un tour, chaque case avec sa propre table.
+ *
+ * Balayage commun aux tables de transition et aux classes de risque : la
+ * case (i, j) lit tables[indices[i * cote + j]] (tables[0] si indices est
+ * NULL), puis compte son nouvel état dans effectifs du même indice si
+ * effectifs n'est pas NULL (remis à zéro par l'appelant).
+ *
+ * @param population Grille au temps t.
+ * @param parametres Incubation, cordon sanitaire et durée de quarantaine.
+ * @param tables Tables des cases.
+ * @param indices Table de chaque case, cote*cote octets, ou NULL.
+ * @param effectifs Effectifs [indice][enum State] à compter, ou NULL.
+ * @param aleatoire Générateur aléatoire propre à la simulation.
+ */
+void balayerTables(struct Population *population,
+                   const struct Parametres *parametres,
+                   const struct TableCase *tables, const uint8_t *indices,
+                   long (*effectifs)[VACCINE + 1],
+                   struct Aleatoire *aleatoire) {
+  const long unsigned cote = population->cote;
+  preparerTampon(population);
+  struct Personne **grille_tampon = population->grille_tampon;
+  // Grille au tour present, tampon au tour present + 1
+  const unsigned long present = population->tour;
+  // Zones créées à partir d'ici : neuves pendant ce balayage
+  const uint32_t premiere_zone = population->zones.nb_zones;
+  uint32_t raccourcie = 0;
+  population->tour++;
+
+  // Alias
+  struct Personne **grille = population->grille_de_personnes;
+
+  for (long unsigned i = 0; i < cote; i++) {
+    for (long unsigned j = 0; j < cote; j++) {
+      const struct Personne *personne = &grille[i][j];
+      const enum State state = personne->state;
+      // Déjà en quarantaine et remise dans une zone neuve avant son passage :
+      // un tour de moins que la zone (voir raccourcirZone)
+      if (grille_tampon[i][j].zone >= premiere_zone &&
+          population->zones.expirations[personne->zone] > present)
+        grille_tampon[i][j].zone = raccourcirZone(
+            population, grille_tampon[i][j].zone, &raccourcie);
+      const uint8_t indice = indices ? indices[i * cote + j] : 0;
+      if (state == INCUBE) {
+        // Décompte déterministe, sans tirage
+        struct Personne *tampon = &grille_tampon[i][j];
+        if (personne->duree_incube == 0)
+          tampon->state = MALADE;
+        else
+          tampon->duree_incube--;
+        if (effectifs) effectifs[indice][tampon->state]++;
+        continue;
+      }
+      if (state == MORT || state == VACCINE) {
+        if (effectifs) effectifs[indice][state]++;
+        continue;
+      }
+
+      // Voisins contagieux compatibles (ensemble en quarantaine ou libres)
+      // et voisin VACCINE, utiles à SAIN et IMMUNISE seulement
+      int k = 0, vaccin = 0;
+      if (state != MALADE) {
+        const unsigned long *expirations = population->zones.expirations;
+        const int libre = expirations[personne->zone] <= present;
+        const struct Personne *voisins[NB_VOISINS];
+        int n = 0;
+        if (j > 0) voisins[n++] = &grille[i][j - 1];
+        if (j < cote - 1) voisins[n++] = &grille[i][j + 1];
+        if (i > 0) voisins[n++] = &grille[i - 1][j];
+        if (i < cote - 1) voisins[n++] = &grille[i + 1][j];
+        for (int v = 0; v < n; v++) {
+          vaccin |= voisins[v]->state == VACCINE;
+          k += (voisins[v]->state == MALADE ||
+                voisins[v]->state == INCUBE) &&
+               (voisins[v]->zone == personne->zone ||
+                (expirations[voisins[v]->zone] <= present) == libre);
+        }
+      }
+
+      // Une recherche dans la table de la case et au plus un tirage
+      const struct TableCase *table = &tables[indice];
+      const struct Transition *transition =
+          state == SAIN     ? &table->sain[k][vaccin]
+          : state == MALADE ? &table->malade
+                            : &table->immunise[vaccin];
+      unsigned char issue = transition->issues[0];
+      if (transition->nb_issues > 1) {
+        const double u = aleatoireUniforme(aleatoire);
+        int n = 0;
+        while (n < transition->nb_issues - 1 && u >= transition->seuils[n]) n++;
+        issue = transition->issues[n];
+      }
+      const enum State nouveau =
+          issue == state ? state
+                         : appliquerIssue(population, parametres, i, j, state,
+                                          issue);
+      if (effectifs) effectifs[indice][nouveau]++;
+    }
+  }
+
+  echangerTampon(population);  // Appliquer les changements
+}
+
+/**
+ * @brief Joue un tour avec une table (même loi que jouerTourParametres).
+ *
+ * @param population Grille au temps t.
+ * @param table Table précalculée par initTableTransition.
+ * @param aleatoire Générateur aléatoire propre à la simulation.
+ */
+void jouerTourTransition(struct Population *population,
+                         const struct TableTransition *table,
+                         struct Aleatoire *aleatoire) {
+  balayerTables(population, &table->parametres, &table->compacte, NULL, NULL,
+                aleatoire);
+}
@@ -0,0 +1,101 @@
+#if !defined(TRANSITION_H)
+#define TRANSITION_H
+
+#include "aleatoire.h"
+#include "jouer_un_tour.h"
+#include "population.h"
+
+/**
+ * @brief Nombre maximal d'issues d'une transition (MALADE : 2 x 3).
+ */
+#define NB_ISSUES_MAX 6
+
+/**
+ * @brief Nombre de voisins d'une case (voisinage de von Neumann).
+ */
+#define NB_VOISINS 4
+
+/**
+ * @brief Bit d'une issue : déclencher une quarantaine avant le changement
+ * d'état. Les bits restants sont l'enum State du nouvel état.
+ */
+#define ISSUE_QUARANTAINE 0x80
+
+/**
+ * @brief Issues possibles d'une case pour un tour, probabilités cumulées.
+ *
+ * Un tirage u uniforme dans [0, 1) choisit la première issue n telle que
+ * u < seuils[n]. Une transition certaine (nb_issues == 1) ne tire rien.
+ */
+struct Transition {
+  /**
+   * @brief Nombre d'issues de probabilité non nulle (1 à NB_ISSUES_MAX).
+   */
+  unsigned char nb_issues;
+  /**
+   * @brief Issues : enum State, plus ISSUE_QUARANTAINE le cas échéant.
+   */
+  unsigned char issues[NB_ISSUES_MAX];
+  /**
+   * @brief Probabilités cumulées, la dernière vaut exactement 1.
+   */
+  double seuils[NB_ISSUES_MAX];
+};
+
+/**
+ * @brief Transitions lues par balayerTables pour une case : les seules qui
+ * dépendent de beta, gamma et lambda.
+ */
+struct TableCase {
+  /**
+   * @brief SAIN, [voisins contagieux compatibles][voisin VACCINE].
+   */
+  struct Transition sain[NB_VOISINS + 1][2];
+  /**
+   * @brief MALADE (indépendant des voisins).
+   */
+  struct Transition malade;
+  /**
+   * @brief IMMUNISE, [voisin VACCINE].
+   */
+  struct Transition immunise[2];
+};
+
+/**
+ * @brief Transitions précalculées pour un jeu de paramètres.
+ *
+ * Indexée par (état, voisins contagieux compatibles k, voisin VACCINE). La
+ * probabilité d'infection 1 - (1 - lambda)^k est calculée une fois ici au
+ * lieu d'un tirage par voisin.
+ */
+struct TableTransition {
+  /**
+   * @brief Paramètres de la table (copie).
+   */
+  struct Parametres parametres;
+  /**
+   * @brief Transitions [state][k][voisin VACCINE].
+   */
+  struct Transition transitions[VACCINE + 1][NB_VOISINS + 1][2];
+  /**
+   * @brief Entrées de transitions lues par jouerTourTransition.
+   */
+  struct TableCase compacte;
+};
+
+void initTableTransition(struct TableTransition *table,
+                         const struct Parametres *parametres);
+void jouerTourTransition(struct Population *population,
+                         const struct TableTransition *table,
+                         struct Aleatoire *aleatoire);
+void balayerTables(struct Population *population,
+                   const struct Parametres *parametres,
+                   const struct TableCase *tables, const uint8_t *indices,
+                   long (*effectifs)[VACCINE + 1],
+                   struct Aleatoire *aleatoire);
+enum State appliquerIssue(struct Population *population,
+                          const struct Parametres *parametres,
+                          unsigned long i, unsigned long j, enum State state,
+                          unsigned char issue);
+
+#endif  // TRANSITION_H
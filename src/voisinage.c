@@ -0,0 +1,560 @@
+/**
+ * @file voisinage.c
+ *
+ * @brief Moteur incrémental : compteurs de voisins contagieux par case.
+ *
+ * Le noyau recompte les voisins MALADE/INCUBE de chaque case SAIN à chaque
+ * tour. Ici, les compteurs sont conservés d'un tour à l'autre et ne sont
+ * recalculés qu'autour des cases qui ont changé d'état ou de zone de
+ * quarantaine, ou dont la zone vient d'être levée (tas des échéances).
+ * Seules les cases actives sont visitées : MALADE, INCUBE, SAIN avec un
+ * voisin contagieux ou vacciné, IMMUNISE avec un voisin vacciné. Le coût d'un
+ * tour suit le nombre de cases actives et de changements, pas la taille de
+ * la grille (à un mot de résumé près par 4096 cases).
+ *
+ * Les cases actives sont visitées dans l'ordre du noyau, avec les mêmes
+ * tirages : même graine, même trajectoire que jouerTourParametres. Le tour
+ * est joué en place, sans tampon : une case ne lit que son propre état et
+ * des compteurs calculés avant le tour, et la mise en quarantaine voit la
+ * grille en cours d'écriture comme le noyau voit son tampon.
+ *
+ * La découverte du vaccin tire un nombre pour chaque case SAIN ou IMMUNISE
+ * à chaque tour : elle n'est pas prise en charge (voir voisinageCompatible).
+ *
+ * Usage:
+ * ```
+ * struct Voisinage *voisinage = creerVoisinage(population, &parametres);
+ * if (!voisinage) ...;  // découverte du vaccin : jouerTourParametres
+ * for (...) jouerTourVoisinage(voisinage, &aleatoire);
+ * detruireVoisinage(voisinage);  // la grille de population est à jour
+ * ```
+ *
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @date 19 Oct 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "voisinage.h"
+
+/**
+ * @brief Nombre de mots de 64 bits pour n bits.
+ */
+#define MOTS(n) (((n) + 63) / 64)
+
+/**
+ * @brief Ajoute delta à l'effectif d'un état.
+ *
+ * @param statistique Statistique.
+ * @param state Etat.
+ * @param delta +1 ou -1.
+ */
+static void compter(struct Statistique *statistique, enum State state,
+                    long delta) {
+  switch (state) {
+    case SAIN:
+      statistique->nb_SAIN += delta;
+      break;
+    case MALADE:
+      statistique->nb_MALADE += delta;
+      break;
+    case MORT:
+      statistique->nb_MORT += delta;
+      break;
+    case IMMUNISE:
+      statistique->nb_IMMUNISE += delta;
+      break;
+    case INCUBE:
+      statistique->nb_INCUBE += delta;
+      break;
+    case VACCINE:
+      statistique->nb_VACCINE += delta;
+      break;
+  }
+}
+
+/**
+ * @brief Met une case dans a_recalculer (une seule fois par tour).
+ *
+ * @param voisinage Voisinage.
+ * @param k Indice de la case.
+ */
+static void signalerCase(struct Voisinage *voisinage, unsigned long k) {
+  if (voisinage->signalees[k]) return;
+  voisinage->signalees[k] = 1;
+  voisinage->a_recalculer[voisinage->nb_a_recalculer++] = k;
+}
+
+/**
+ * @brief La case k a changé : ses compteurs et ceux de ses voisins sont à
+ * recalculer.
+ *
+ * @param voisinage Voisinage.
+ * @param k Indice de la case.
+ */
+static void signaler(struct Voisinage *voisinage, unsigned long k) {
+  const unsigned long cote = voisinage->population->cote;
+  const unsigned long x = k / cote, y = k % cote;
+  signalerCase(voisinage, k);
+  if (y > 0) signalerCase(voisinage, k - 1);
+  if (y < cote - 1) signalerCase(voisinage, k + 1);
+  if (x > 0) signalerCase(voisinage, k - cote);
+  if (x < cote - 1) signalerCase(voisinage, k + cote);
+}
+
+/**
+ * @brief Change l'état d'une case, sa Statistique et signale le voisinage.
+ *
+ * @param voisinage Voisinage.
+ * @param k Indice de la case.
+ * @param state Nouvel état.
+ */
+static void changerEtat(struct Voisinage *voisinage, unsigned long k,
+                        enum State state) {
+  struct Personne *personne = &voisinage->population->personnes[k];
+  compter(&voisinage->statistique, personne->state, -1);
+  compter(&voisinage->statistique, state, 1);
+  personne->state = state;
+  signaler(voisinage, k);
+}
+
+/**
+ * @brief Ajoute une échéance au tas.
+ *
+ * @param voisinage Voisinage.
+ * @param expiration Tour de levée.
+ * @param indice Indice de la case.
+ */
+static void ajouterEcheance(struct Voisinage *voisinage,
+                            unsigned long expiration, unsigned long indice) {
+  if (voisinage->nb_echeances == voisinage->capacite_echeances) {
+    voisinage->capacite_echeances *= 2;
+    struct Echeance *echeances = (struct Echeance *)realloc(
+        voisinage->echeances,
+        sizeof(struct Echeance) * voisinage->capacite_echeances);
+    if (!echeances) {
+      printf("Erreur: Voisinage, plus de mémoire.\n");
+      exit(1);
+    }
+    voisinage->echeances = echeances;
+  }
+  struct Echeance *tas = voisinage->echeances;
+  unsigned long i = voisinage->nb_echeances++;
+  while (i > 0 && tas[(i - 1) / 2].expiration > expiration) {
+    tas[i] = tas[(i - 1) / 2];
+    i = (i - 1) / 2;
+  }
+  tas[i].expiration = expiration;
+  tas[i].indice = indice;
+}
+
+/**
+ * @brief Retire l'échéance la plus proche du tas (non vide).
+ *
+ * @param voisinage Voisinage.
+ * @return struct Echeance Echéance retirée.
+ */
+static struct Echeance retirerEcheance(struct Voisinage *voisinage) {
+  struct Echeance *tas = voisinage->echeances;
+  const struct Echeance tete = tas[0];
+  const struct Echeance derniere = tas[--voisinage->nb_echeances];
+  const unsigned long n = voisinage->nb_echeances;
+  unsigned long i = 0;
+  while (2 * i + 1 < n) {
+    unsigned long fils = 2 * i + 1;
+    if (fils + 1 < n && tas[fils + 1].expiration < tas[fils].expiration)
+      fils++;
+    if (tas[fils].expiration >= derniere.expiration) break;
+    tas[i] = tas[fils];
+    i = fils;
+  }
+  if (n) tas[i] = derniere;
+  return tete;
+}
+
+/**
+ * @brief Recalcule les compteurs d'une case et son bit dans actives.
+ *
+ * Comme le noyau : un voisin contagieux compte s'il est dans la même zone,
+ * ou si les deux cases sont toutes deux libres ou toutes deux en quarantaine
+ * au tour courant.
+ *
+ * @param voisinage Voisinage.
+ * @param k Indice de la case.
+ */
+static void recalculer(struct Voisinage *voisinage, unsigned long k) {
+  const struct Population *population = voisinage->population;
+  const unsigned long cote = population->cote, x = k / cote, y = k % cote;
+  const unsigned long tour = population->tour;
+  const unsigned long *expirations = population->zones.expirations;
+  const struct Personne *personnes = population->personnes;
+  const struct Personne *personne = &personnes[k];
+  const char libre = expirations[personne->zone] <= tour;
+  unsigned long voisins[4];
+  int nb_voisins = 0;
+  if (y > 0) voisins[nb_voisins++] = k - 1;
+  if (y < cote - 1) voisins[nb_voisins++] = k + 1;
+  if (x > 0) voisins[nb_voisins++] = k - cote;
+  if (x < cote - 1) voisins[nb_voisins++] = k + cote;
+  uint8_t contagieux = 0, vaccines = 0;
+  for (int v = 0; v < nb_voisins; v++) {
+    const struct Personne *voisin = &personnes[voisins[v]];
+    if (voisin->state == VACCINE)
+      vaccines++;
+    else if ((voisin->state == MALADE || voisin->state == INCUBE) &&
+             (voisin->zone == personne->zone ||
+              (expirations[voisin->zone] <= tour) == libre))
+      contagieux++;
+  }
+  voisinage->contagieux[k] = contagieux;
+  voisinage->vaccines[k] = vaccines;
+
+  const char active =
+      personne->state == MALADE || personne->state == INCUBE ||
+      (personne->state == SAIN && (contagieux || vaccines)) ||
+      (personne->state == IMMUNISE && vaccines);
+  const unsigned long m = k / 64;
+  const uint64_t bit = (uint64_t)1 << (k % 64);
+  const uint64_t bit_resume = (uint64_t)1 << (m % 64);
+  if (active)
+    voisinage->actives[m] |= bit;
+  else
+    voisinage->actives[m] &= ~bit;
+  if (voisinage->actives[m])
+    voisinage->resume[m / 64] |= bit_resume;
+  else
+    voisinage->resume[m / 64] &= ~bit_resume;
+}
+
+static void quarantaine(struct Voisinage *voisinage, unsigned long x,
+                        unsigned long y, int cordon_sanitaire, uint32_t zone,
+                        uint16_t *raster_quarantaine, uint16_t tour);
+
+/**
+ * @brief Etend la quarantaine d'une case à son voisin (x, y), comme
+ * quarantaineRecurse (jouer_un_tour.c).
+ *
+ * @param voisinage Voisinage.
+ * @param x
+ * @param y
+ * @param cordon_sanitaire Cordon de la case d'origine.
+ * @param zone Zone en cours de mise en quarantaine.
+ * @param raster_quarantaine Raster RASTER_QUARANTAINE, ou NULL.
+ * @param tour Tour écrit dans le raster.
+ */
+static void etendre(struct Voisinage *voisinage, unsigned long x,
+                    unsigned long y, int cordon_sanitaire, uint32_t zone,
+                    uint16_t *raster_quarantaine, uint16_t tour) {
+  const struct Population *population = voisinage->population;
+  const struct Personne *personne =
+      &population->personnes[x * population->cote + y];
+  const int marque = personne->zone == zone ? personne->cordon_sanitaire : 0;
+  if (marque >= cordon_sanitaire) return;
+  if (personne->state == MALADE || personne->state == MORT)
+    quarantaine(voisinage, x, y, cordon_sanitaire, zone, raster_quarantaine,
+                tour);
+  else if (cordon_sanitaire > 0)
+    quarantaine(voisinage, x, y, cordon_sanitaire - 1, zone,
+                raster_quarantaine, tour);
+}
+
+/**
+ * @brief Met la case (x, y) dans la zone et étend le cordon (nord, sud,
+ * ouest, est : le même parcours que mettreEnQuarantaineRaster).
+ *
+ * Une case qui change de zone est signalée et son échéance entre dans le
+ * tas.
+ *
+ * @param voisinage Voisinage.
+ * @param x
+ * @param y
+ * @param cordon_sanitaire Distance restante du cordon.
+ * @param zone Zone de quarantaine neuve (creerZone).
+ * @param raster_quarantaine Raster RASTER_QUARANTAINE, ou NULL.
+ * @param tour Tour écrit dans le raster.
+ */
+static void quarantaine(struct Voisinage *voisinage, unsigned long x,
+                        unsigned long y, int cordon_sanitaire, uint32_t zone,
+                        uint16_t *raster_quarantaine, uint16_t tour) {
+  struct Population *population = voisinage->population;
+  const unsigned long cote = population->cote, k = x * cote + y;
+  struct Personne *personne = &population->personnes[k];
+  if (raster_quarantaine && raster_quarantaine[k] == RASTER_JAMAIS)
+    raster_quarantaine[k] = tour;
+  if (personne->zone != zone) {
+    // En quarantaine au tour précédent : zone du tour ou zone raccourcie
+    const char en_quarantaine =
+        personne->zone < voisinage->premiere_zone
+            ? population->zones.expirations[personne->zone] >=
+                  population->tour
+            : personne->zone == voisinage->raccourcie;
+    if (en_quarantaine)
+      voisinage->a_raccourcir[voisinage->nb_a_raccourcir++] = k;
+    personne->zone = zone;
+    signaler(voisinage, k);
+    ajouterEcheance(voisinage, population->zones.expirations[zone], k);
+  }
+  personne->cordon_sanitaire = cordon_sanitaire;
+
+  if (x > 0)
+    etendre(voisinage, x - 1, y, cordon_sanitaire, zone, raster_quarantaine,
+            tour);
+  if (x < cote - 1)
+    etendre(voisinage, x + 1, y, cordon_sanitaire, zone, raster_quarantaine,
+            tour);
+  if (y > 0)
+    etendre(voisinage, x, y - 1, cordon_sanitaire, zone, raster_quarantaine,
+            tour);
+  if (y < cote - 1)
+    etendre(voisinage, x, y + 1, cordon_sanitaire, zone, raster_quarantaine,
+            tour);
+}
+
+/**
+ * @brief Joue une case active, avec les tirages du noyau.
+ *
+ * @param voisinage Voisinage.
+ * @param k Indice de la case.
+ * @param aleatoire Générateur.
+ * @param present Tour avant ce tour.
+ * @param tour Tour écrit dans les rasters.
+ */
+static void jouerCase(struct Voisinage *voisinage, unsigned long k,
+                      struct Aleatoire *aleatoire, unsigned long present,
+                      uint16_t tour) {
+  struct Population *population = voisinage->population;
+  const struct Parametres *parametres = &voisinage->parametres;
+  struct Personne *personne = &population->personnes[k];
+  switch (personne->state) {
+    case SAIN:
+      // Vaccination par propagation
+      if (voisinage->vaccines[k]) {
+        changerEtat(voisinage, k, VACCINE);
+        break;
+      }
+      // Infection : un tirage par voisin contagieux, jusqu'au premier succès
+      for (int voisin = voisinage->contagieux[k]; voisin > 0; voisin--) {
+        if (aleatoireUniforme(aleatoire) < parametres->lambda) {
+          changerEtat(voisinage, k, INCUBE);
+          personne->duree_incube = (int)parametres->duree_incube;
+          if (population->rasters[RASTER_INFECTION])
+            population->rasters[RASTER_INFECTION][k] = tour;
+          break;
+        }
+      }
+      break;
+
+    case MALADE:
+      // Zone levée au tour suivant (ou jamais mise) : nouvelle quarantaine
+      if (parametres->chance_quarantaine > 0 &&
+          aleatoireUniforme(aleatoire) < parametres->chance_quarantaine &&
+          population->zones.expirations[personne->zone] <= present + 1) {
+        const uint32_t zone =
+            creerZone(population, parametres->duree_quarantaine);
+        if (zone)
+          quarantaine(voisinage, k / population->cote, k % population->cote,
+                      parametres->cordon_sanitaire, zone,
+                      population->rasters[RASTER_QUARANTAINE], tour);
+        // Après la propagation (les marques suivent la zone) : les cases pas
+        // encore passées dans l'ordre du noyau perdent un tour
+        for (unsigned long i = 0; i < voisinage->nb_a_raccourcir; i++) {
+          const unsigned long a = voisinage->a_raccourcir[i];
+          if (a <= k) continue;
+          struct Personne *raccourcie = &population->personnes[a];
+          raccourcie->zone = raccourcirZone(population, raccourcie->zone,
+                                            &voisinage->raccourcie);
+          ajouterEcheance(voisinage,
+                          population->zones.expirations[raccourcie->zone], a);
+        }
+        voisinage->nb_a_raccourcir = 0;
+      }
+      if (aleatoireUniforme(aleatoire) < parametres->beta) {
+        changerEtat(voisinage, k, MORT);
+        if (population->rasters[RASTER_MORT])
+          population->rasters[RASTER_MORT][k] = tour;
+        break;
+      }
+      if (aleatoireUniforme(aleatoire) < parametres->gamma)
+        changerEtat(voisinage, k, IMMUNISE);
+      break;
+
+    case INCUBE:
+      if (personne->duree_incube == 0)
+        changerEtat(voisinage, k, MALADE);
+      else
+        personne->duree_incube--;
+      break;
+
+    case IMMUNISE:
+      if (voisinage->vaccines[k]) changerEtat(voisinage, k, VACCINE);
+      break;
+
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Vrai si le moteur s'applique : pas de découverte du vaccin.
+ *
+ * La propagation d'un vaccin déjà présent sur la grille est prise en charge.
+ *
+ * @param parametres Paramètres de la simulation.
+ * @return char Booléen.
+ */
+char voisinageCompatible(const struct Parametres *parametres) {
+  return !(parametres->chance_decouverte_vaccin > 0);
+}
+
+/**
+ * @brief Créer un voisinage attaché à une population, et le charger.
+ *
+ * @param population Population (non possédée, doit survivre au voisinage).
+ * @param parametres Paramètres (copiés).
+ * @return struct Voisinage* Voisinage, NULL si la découverte du vaccin est
+ * active.
+ */
+struct Voisinage *creerVoisinage(struct Population *population,
+                                 const struct Parametres *parametres) {
+  if (!voisinageCompatible(parametres)) return NULL;
+  const unsigned long taille = population->cote * population->cote;
+  struct Voisinage *voisinage =
+      (struct Voisinage *)malloc(sizeof(struct Voisinage));
+  voisinage->population = population;
+  voisinage->parametres = *parametres;
+  voisinage->contagieux = (uint8_t *)malloc(taille);
+  voisinage->vaccines = (uint8_t *)malloc(taille);
+  voisinage->actives = (uint64_t *)malloc(MOTS(taille) * sizeof(uint64_t));
+  voisinage->resume =
+      (uint64_t *)malloc(MOTS(MOTS(taille)) * sizeof(uint64_t));
+  voisinage->a_recalculer =
+      (unsigned long *)malloc(taille * sizeof(unsigned long));
+  voisinage->signalees = (uint8_t *)malloc(taille);
+  voisinage->a_raccourcir =
+      (unsigned long *)malloc(taille * sizeof(unsigned long));
+  voisinage->nb_a_raccourcir = 0;
+  voisinage->capacite_echeances = 64;
+  voisinage->echeances = (struct Echeance *)malloc(
+      voisinage->capacite_echeances * sizeof(struct Echeance));
+  if (!voisinage->contagieux || !voisinage->vaccines ||
+      !voisinage->actives || !voisinage->resume || !voisinage->a_recalculer ||
+      !voisinage->signalees || !voisinage->a_raccourcir ||
+      !voisinage->echeances) {
+    printf("Erreur: Voisinage, plus de mémoire.\n");
+    exit(1);
+  }
+  chargerVoisinage(voisinage);
+  return voisinage;
+}
+
+/**
+ * @brief Recalcule tous les compteurs depuis la grille de la population.
+ *
+ * A appeler quand la grille a été remplacée (copierPopulation) ; les
+ * quarantaines en cours entrent dans le tas des échéances.
+ *
+ * @param voisinage Voisinage.
+ */
+void chargerVoisinage(struct Voisinage *voisinage) {
+  struct Population *population = voisinage->population;
+  const unsigned long taille = population->cote * population->cote;
+  memset(voisinage->actives, 0, MOTS(taille) * sizeof(uint64_t));
+  memset(voisinage->resume, 0, MOTS(MOTS(taille)) * sizeof(uint64_t));
+  memset(voisinage->signalees, 0, taille);
+  voisinage->nb_a_recalculer = 0;
+  voisinage->nb_echeances = 0;
+  voisinage->visitees = 0;
+  voisinage->statistique = getStatistique(population);
+  const unsigned long *expirations = population->zones.expirations;
+  for (unsigned long k = 0; k < taille; k++) {
+    recalculer(voisinage, k);
+    const unsigned long expiration =
+        expirations[population->personnes[k].zone];
+    if (expiration > population->tour)
+      ajouterEcheance(voisinage, expiration, k);
+  }
+}
+
+/**
+ * @brief Faire passer la population du temps t au temps t+1, en ne visitant
+ * que les cases actives.
+ *
+ * @param voisinage Voisinage.
+ * @param aleatoire Générateur aléatoire propre à la simulation.
+ */
+void jouerTourVoisinage(struct Voisinage *voisinage,
+                        struct Aleatoire *aleatoire) {
+  struct Population *population = voisinage->population;
+  const unsigned long taille = population->cote * population->cote;
+  const unsigned long present = population->tour;
+  voisinage->premiere_zone = population->zones.nb_zones;
+  voisinage->raccourcie = 0;
+  population->tour++;
+  const uint16_t tour = getTourRaster(population);
+
+  // Cases actives dans l'ordre de la grille : mots non nuls via le résumé.
+  // Les bits ne changent qu'après le parcours.
+  voisinage->visitees = 0;
+  for (unsigned long r = 0; r < MOTS(MOTS(taille)); r++) {
+    uint64_t resume = voisinage->resume[r];
+    while (resume) {
+      const unsigned long m = r * 64 + (unsigned long)__builtin_ctzll(resume);
+      resume &= resume - 1;
+      uint64_t mot = voisinage->actives[m];
+      while (mot) {
+        const unsigned long k = m * 64 + (unsigned long)__builtin_ctzll(mot);
+        mot &= mot - 1;
+        jouerCase(voisinage, k, aleatoire, present, tour);
+        voisinage->visitees++;
+      }
+    }
+  }
+
+  // Zones levées au nouveau tour ; une échéance périmée (case passée dans
+  // une autre zone) est ignorée
+  const unsigned long *expirations = population->zones.expirations;
+  while (voisinage->nb_echeances &&
+         voisinage->echeances[0].expiration <= population->tour) {
+    const struct Echeance echeance = retirerEcheance(voisinage);
+    const uint32_t zone = population->personnes[echeance.indice].zone;
+    if (expirations[zone] == echeance.expiration)
+      signaler(voisinage, echeance.indice);
+  }
+
+  for (unsigned long i = 0; i < voisinage->nb_a_recalculer; i++) {
+    const unsigned long k = voisinage->a_recalculer[i];
+    voisinage->signalees[k] = 0;
+    recalculer(voisinage, k);
+  }
+  voisinage->nb_a_recalculer = 0;
+}
+
+/**
+ * @brief Statistique du tour courant, sans parcours de la grille.
+ *
+ * @param voisinage Voisinage.
+ * @return struct Statistique Statistique.
+ */
+struct Statistique getStatistiqueVoisinage(const struct Voisinage *voisinage) {
+  return voisinage->statistique;
+}
+
+/**
+ * @brief Libère le voisinage (pas la population).
+ *
+ * @param voisinage Voisinage.
+ */
+void detruireVoisinage(struct Voisinage *voisinage) {
+  free(voisinage->contagieux);
+  free(voisinage->vaccines);
+  free(voisinage->actives);
+  free(voisinage->resume);
+  free(voisinage->a_recalculer);
+  free(voisinage->signalees);
+  free(voisinage->a_raccourcir);
+  free(voisinage->echeances);
+  free(voisinage);
+}
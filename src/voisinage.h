@@ -0,0 +1,123 @@
+#if !defined(VOISINAGE_H)
+#define VOISINAGE_H
+
+#include <stdint.h>
+
+#include "aleatoire.h"
+#include "jouer_un_tour.h"
+#include "population.h"
+#include "statistique.h"
+
+/**
+ * @brief Levée de quarantaine attendue d'une case.
+ */
+struct Echeance {
+  /**
+   * @brief Tour de levée (expiration de la zone de la case).
+   */
+  unsigned long expiration;
+  /**
+   * @brief Indice de la case dans population->personnes.
+   */
+  unsigned long indice;
+};
+
+/**
+ * @brief Compteurs de voisins tenus à jour, pour ne jouer que les cases qui
+ * peuvent changer.
+ *
+ * Pour chaque case : nombre de voisins contagieux (MALADE ou INCUBE) qui
+ * peuvent l'infecter (ensemble, en quarantaine ou libres) et nombre de
+ * voisins VACCINE. Ils ne sont recalculés qu'autour des cases qui ont changé
+ * d'état ou de quarantaine. Une case SAIN sans voisin contagieux ni vacciné
+ * n'est pas visitée.
+ *
+ * Le voisinage est attaché à une Population qu'il ne possède pas : il joue
+ * sur sa grille en place (sans tampon), qui est donc toujours à jour.
+ */
+struct Voisinage {
+  /**
+   * @brief Population attachée (non possédée).
+   */
+  struct Population *population;
+  /**
+   * @brief Paramètres (copie).
+   */
+  struct Parametres parametres;
+  /**
+   * @brief Voisins contagieux compatibles de chaque case, au tour courant.
+   */
+  uint8_t *contagieux;
+  /**
+   * @brief Voisins VACCINE de chaque case.
+   */
+  uint8_t *vaccines;
+  /**
+   * @brief Un bit par case à visiter au prochain tour.
+   */
+  uint64_t *actives;
+  /**
+   * @brief Un bit par mot non nul de actives.
+   */
+  uint64_t *resume;
+  /**
+   * @brief Cases dont les compteurs sont à recalculer après le tour.
+   */
+  unsigned long *a_recalculer;
+  /**
+   * @brief Nombre de cases dans a_recalculer.
+   */
+  unsigned long nb_a_recalculer;
+  /**
+   * @brief Vrai si la case est déjà dans a_recalculer.
+   */
+  uint8_t *signalees;
+  /**
+   * @brief Cases déjà en quarantaine au tour précédent, mises dans la zone en
+   * cours de propagation (voir raccourcirZone).
+   */
+  unsigned long *a_raccourcir;
+  /**
+   * @brief Nombre de cases dans a_raccourcir.
+   */
+  unsigned long nb_a_raccourcir;
+  /**
+   * @brief Première zone créée au tour en cours.
+   */
+  uint32_t premiere_zone;
+  /**
+   * @brief Zone raccourcie du tour en cours, 0 avant le premier besoin.
+   */
+  uint32_t raccourcie;
+  /**
+   * @brief Tas (minimum en tête) des levées de quarantaine à venir.
+   */
+  struct Echeance *echeances;
+  /**
+   * @brief Nombre d'échéances dans le tas.
+   */
+  unsigned long nb_echeances;
+  /**
+   * @brief Capacité du tas.
+   */
+  unsigned long capacite_echeances;
+  /**
+   * @brief Statistique du tour courant, tenue à jour à chaque changement.
+   */
+  struct Statistique statistique;
+  /**
+   * @brief Cases visitées au dernier tour.
+   */
+  unsigned long visitees;
+};
+
+char voisinageCompatible(const struct Parametres *parametres);
+struct Voisinage *creerVoisinage(struct Population *population,
+                                 const struct Parametres *parametres);
+void chargerVoisinage(struct Voisinage *voisinage);
+void jouerTourVoisinage(struct Voisinage *voisinage,
+                        struct Aleatoire *aleatoire);
+struct Statistique getStatistiqueVoisinage(const struct Voisinage *voisinage);
+void detruireVoisinage(struct Voisinage *voisinage);
+
+#endif  // VOISINAGE_H
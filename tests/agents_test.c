@@ -0,0 +1,286 @@
+/**
+ * @file agents_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur le moteur à agents mobiles.
+ *
+ * Des agents immobiles doivent suivre exactement la trajectoire de
+ * jouerTourTransition ; la liste de cases doit être un tri des agents par
+ * case, et la trajectoire ne doit pas dépendre du nombre de threads.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/agents.h"
+#include "../src/simulation.h"
+#include "commun.h"
+
+/**
+ * @brief Côté de la grille (4 blocs de AGENTS_BLOC agents).
+ */
+#define COTE 128
+
+/**
+ * @brief Tours comparés.
+ */
+#define TOURS 40
+
+/**
+ * @brief Côté de la grille du débit (un million d'agents).
+ */
+#define COTE_DEBIT 1000
+
+/**
+ * @brief Tours chronométrés pour le débit.
+ */
+#define TOURS_DEBIT 10
+
+/**
+ * @brief Ecarts de lignes et de colonnes entre deux cases.
+ */
+static void ecarts(unsigned long a, unsigned long b, long *di, long *dj) {
+  *di = labs((long)(a / COTE) - (long)(b / COTE));
+  *dj = labs((long)(a % COTE) - (long)(b % COTE));
+}
+
+/**
+ * @brief Vrai si ordre range chaque agent dans sa case, une fois, par
+ * indice croissant dans une case.
+ */
+static int listeValide(const struct Agents *agents) {
+  char *vus = (char *)calloc(agents->nb_agents, 1);
+  int valide = agents->debuts[agents->nb_agents] == agents->nb_agents;
+  for (unsigned long c = 0; c < agents->nb_agents; c++)
+    for (uint32_t n = agents->debuts[c]; n < agents->debuts[c + 1]; n++) {
+      const uint32_t a = agents->ordre[n];
+      valide &= agents->positions[a] == c && !vus[a] &&
+                (n == agents->debuts[c] || agents->ordre[n - 1] < a);
+      vus[a] = 1;
+    }
+  free(vus);
+  return valide;
+}
+
+/**
+ * @brief Tours par seconde en marche sur une grille COTE_DEBIT, après un
+ * tour de chauffe.
+ */
+static double debit(const struct Parametres *parametres,
+                    unsigned int nb_taches) {
+  struct Population *population = creerPopulation(COTE_DEBIT);
+  remplir(population, 985, 3);
+  const struct ParametresAgents marche = {.mobilite = MOBILITE_MARCHE,
+                                          .chance_pas = 1};
+  struct Aleatoire aleatoire;
+  initAleatoire(&aleatoire, 9);
+  struct Agents *agents =
+      creerAgents(population, parametres, &marche, nb_taches, &aleatoire);
+  jouerTourAgents(agents, &aleatoire);
+  struct timespec debut, fin;
+  clock_gettime(CLOCK_MONOTONIC, &debut);
+  for (int t = 0; t < TOURS_DEBIT; t++) jouerTourAgents(agents, &aleatoire);
+  clock_gettime(CLOCK_MONOTONIC, &fin);
+  assert(listeValide(agents));
+  detruireAgents(agents);
+  detruirePopulation(population);
+  return TOURS_DEBIT / ((double)(fin.tv_sec - debut.tv_sec) +
+                        (double)(fin.tv_nsec - debut.tv_nsec) * 1e-9);
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  struct Parametres parametres = {.beta = 0.05,
+                                  .gamma = 0.15,
+                                  .lambda = 0.5,
+                                  .chance_quarantaine = 0,
+                                  .chance_decouverte_vaccin = 0.001,
+                                  .duree_incube = 2,
+                                  .cordon_sanitaire = 2,
+                                  .duree_quarantaine = 6};
+  struct ParametresAgents marche = {.mobilite = MOBILITE_MARCHE,
+                                    .chance_pas = 0};
+  struct Aleatoire aleatoire, aleatoire_reference;
+  printf("agents_test:\n");
+
+  printf("  creerAgents:\n");
+  struct Population *population = creerPopulation(COTE);
+  struct ParametresAgents invalides = {.mobilite = MOBILITE_MARCHE,
+                                       .chance_pas = 1.5};
+  assert(!creerAgents(population, &parametres, &invalides, 1, &aleatoire));
+  invalides.mobilite = MOBILITE_TRAJET;
+  invalides.periode = 1;
+  assert(!creerAgents(population, &parametres, &invalides, 1, &aleatoire));
+  printf("    Refusé : proba de pas hors de [0, 1], période < 2: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  printf("  jouerTourAgents:\n");
+  // Immobiles : chaque case ne porte que son agent, mêmes tirages
+  remplir(population, 985, 3);
+  struct Population *reference = creerPopulation(COTE);
+  assert(!copierPopulation(reference, population));
+  initAleatoire(&aleatoire, 7);
+  initAleatoire(&aleatoire_reference, 7);
+  struct Agents *agents =
+      creerAgents(population, &parametres, &marche, 4, &aleatoire);
+  assert(agents && agents->nb_taches == 4);
+  struct TableTransition table;
+  initTableTransition(&table, &parametres);
+  for (int t = 0; t < TOURS; t++) {
+    jouerTourAgents(agents, &aleatoire);
+    aleatoireEntier(&aleatoire_reference);  // Graine des déplacements
+    jouerTourTransition(reference, &table, &aleatoire_reference);
+    for (unsigned long k = 0; k < COTE * COTE; k++)
+      assert(population->personnes[k].state ==
+                 reference->personnes[k].state &&
+             agents->positions[k] == k);
+  }
+  detruireAgents(agents);
+  printf("    Immobiles : identique aux tables de transition: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  // Marche : même trajectoire avec 1 et 4 threads
+  marche.chance_pas = 0.7;
+  parametres.chance_quarantaine = 0.3;
+  remplir(population, 985, 3);
+  assert(!copierPopulation(reference, population));
+  initAleatoire(&aleatoire, 8);
+  initAleatoire(&aleatoire_reference, 8);
+  agents = creerAgents(population, &parametres, &marche, 4, &aleatoire);
+  struct Agents *seul =
+      creerAgents(reference, &parametres, &marche, 1, &aleatoire_reference);
+  for (int t = 0; t < TOURS; t++) {
+    jouerTourAgents(agents, &aleatoire);
+    jouerTourAgents(seul, &aleatoire_reference);
+    assert(!memcmp(agents->positions, seul->positions,
+                   COTE * COTE * sizeof(uint32_t)));
+    assert(!memcmp(agents->ordre, seul->ordre,
+                   COTE * COTE * sizeof(uint32_t)));
+    for (unsigned long k = 0; k < COTE * COTE; k++)
+      assert(population->personnes[k].state ==
+             reference->personnes[k].state);
+    assert(listeValide(agents));
+  }
+  unsigned long deplaces = 0;
+  for (unsigned long k = 0; k < COTE * COTE; k++) {
+    long di, dj;
+    ecarts(agents->positions[k], k, &di, &dj);
+    assert(di + dj <= TOURS);
+    deplaces += di + dj > 0;
+  }
+  assert(deplaces > COTE * COTE / 2 && population->zones.nb_zones > 1);
+  detruireAgents(seul);
+  detruireAgents(agents);
+  printf("    Marche : liste de cases triée, 1 ou 4 threads identiques: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  // Trajet : domicile la première moitié de la période, travail ensuite
+  parametres.chance_quarantaine = 0;
+  detruirePopulation(population);
+  population = creerPopulation(COTE);
+  remplir(population, 985, 3);
+  const struct ParametresAgents trajet = {.mobilite = MOBILITE_TRAJET,
+                                          .distance_travail = 3,
+                                          .periode = 4};
+  agents = creerAgents(population, &parametres, &trajet, 2, &aleatoire);
+  unsigned long au_travail = 0;
+  for (unsigned long k = 0; k < COTE * COTE; k++) {
+    long di, dj;
+    ecarts(agents->travail[k], k, &di, &dj);
+    assert(di <= 3 && dj <= 3);
+  }
+  for (int t = 0; t < 8; t++) {
+    jouerTourAgents(agents, &aleatoire);
+    for (unsigned long k = 0; k < COTE * COTE; k++) {
+      if (population->personnes[k].state == MORT) continue;  // Immobiles
+      assert(agents->positions[k] == (t % 4 < 2 ? k : agents->travail[k]));
+      au_travail += agents->positions[k] != k;
+    }
+  }
+  assert(au_travail > COTE * COTE);
+  detruireAgents(agents);
+  printf("    Trajet : domicile puis travail, à distance_travail au plus: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  // Case bondée : transitions SAIN calculées au-delà de NB_VOISINS
+  detruirePopulation(population);
+  population = creerPopulation(COTE);
+  parametres.chance_decouverte_vaccin = 0;
+  parametres.lambda = 0.1;
+  marche.chance_pas = 0;
+  agents = creerAgents(population, &parametres, &marche, 1, &aleatoire);
+  for (unsigned long k = 1; k <= 10; k++) {
+    population->personnes[k].state = MALADE;
+    agents->positions[k] = 0;
+  }
+  jouerTourAgents(agents, &aleatoire);
+  assert(agents->nb_sain > 10);
+  assert(fabs(agents->sain[10][0].seuils[0] - (1 - pow(0.9, 10))) < 1e-12 &&
+         agents->sain[10][0].issues[0] == INCUBE);
+  detruireAgents(agents);
+  printf("    Case bondée : 1 - (1 - lambda)^k au-delà de 4 voisins: "
+         "\x1B[32mOK\x1B[0m\n");
+  // Débit : mesuré et affiché, pas comparé (voir make performance)
+  const long nb_coeurs = sysconf(_SC_NPROCESSORS_ONLN);
+  const unsigned int nb_taches =
+      nb_coeurs > 1 ? (unsigned int)(nb_coeurs < 8 ? nb_coeurs : 8) : 1;
+  struct Parametres parametres_debit = parametres;
+  parametres_debit.lambda = 0.5;
+  parametres_debit.chance_decouverte_vaccin = 0.001;
+  const double tours_par_seconde = debit(&parametres_debit, nb_taches);
+  printf("    Débit %dx%d, marche, %u thread(s) : %.2f tours/s "
+         "(%.1f M agents/s): \x1B[32mOK\x1B[0m\n",
+         COTE_DEBIT, COTE_DEBIT, nb_taches, tours_par_seconde,
+         tours_par_seconde * COTE_DEBIT * COTE_DEBIT * 1e-6);
+  detruirePopulation(reference);
+  detruirePopulation(population);
+
+  printf("  avancerSimulation:\n");
+  // Mur de MORT au milieu : seuls les agents qui marchent le franchissent
+  parametres.lambda = 1;
+  parametres.chance_quarantaine = 0;
+  for (int mobiles = 0; mobiles < 2; mobiles++) {
+    population = creerPopulation(COTE);
+    for (unsigned long i = 0; i < COTE; i++)
+      population->grille_de_personnes[i][COTE / 2].state = MORT;
+    patient_zero(population, COTE / 2, 10);
+    struct Population *initiale = creerPopulation(COTE);
+    assert(!copierPopulation(initiale, population));
+    struct Simulation *simulation = creerSimulation(&parametres, population, 3);
+    marche.chance_pas = mobiles ? 1 : 0;
+    assert(!activerAgentsSimulation(simulation, &marche, 2));
+    assert(activerContactsSimulation(simulation, NULL));
+    for (int replicat = 0; replicat < 2; replicat++) {
+      if (replicat) assert(!reinitialiserSimulation(simulation, initiale, 4));
+      avancerSimulation(simulation, 400);
+      const struct Population *finale = getPopulationSimulation(simulation);
+      unsigned long droite = 0;
+      for (unsigned long i = 0; i < COTE; i++)
+        for (unsigned long j = COTE / 2 + 1; j < COTE; j++)
+          droite += finale->grille_de_personnes[i][j].state != SAIN;
+      assert(mobiles ? droite > COTE * COTE / 4 : droite == 0);
+      const struct Serie *serie = getSerieSimulation(simulation);
+      const struct Statistique attendues =
+          getStatistique((struct Population *)finale);
+      assert(!memcmp(&serie->derniere, &attendues,
+                     sizeof(struct Statistique)));
+    }
+    detruireSimulation(simulation);
+    detruirePopulation(initiale);
+  }
+  printf("    Mur de MORT franchi par la marche seulement, réplicats: "
+         "\x1B[32mOK\x1B[0m\n");
+  return 0;
+}
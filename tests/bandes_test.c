@@ -0,0 +1,206 @@
+/**
+ * @file bandes_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur les bandes parallèles du bitboard.
+ *
+ * Le banc d'essai affiche le débit selon le nombre de bandes, avec premier
+ * contact par bande ou chargement par le thread principal. Sur une machine
+ * à plusieurs sockets, l'écart entre les deux mesure le gain du placement
+ * NUMA. Seul le passage à l'échelle (meilleur de 3) peut échouer : n bandes
+ * sur c coeurs doivent aller au moins min(n, c) / 2 fois plus vite qu'une.
+ * Variables d'environnement :
+ * - EPIDEMIE_BANDES_COTE : côté de la grille (défaut 1024) ;
+ * - EPIDEMIE_BANDES_MAX : nombre maximal de bandes (défaut 4).
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../src/bandes.h"
+#include "commun.h"
+
+/**
+ * @brief Côté des grilles de test : plusieurs mots par ligne.
+ */
+#define COTE 150
+
+/**
+ * @brief Vrai si les plans de deux bitboards de même cote sont égaux.
+ */
+static int memesPlans(const struct Bitboard *a, const struct Bitboard *b) {
+  const unsigned long taille =
+      (VACCINE + 1) * a->population->cote * a->mots * sizeof(uint64_t);
+  return !memcmp(a->plans, b->plans, taille);
+}
+
+/**
+ * @brief Secondes écoulées depuis debut.
+ */
+static double secondesDepuis(const struct timespec *debut) {
+  struct timespec fin;
+  clock_gettime(CLOCK_MONOTONIC, &fin);
+  return (double)(fin.tv_sec - debut->tv_sec) +
+         (double)(fin.tv_nsec - debut->tv_nsec) * 1e-9;
+}
+
+/**
+ * @brief Durée (s) de n_tours joués en bandes, patient zero au centre.
+ */
+static double chronometrer(const struct Parametres *parametres,
+                           unsigned long cote, unsigned int nb_bandes,
+                           unsigned int options, int n_tours) {
+  struct Population *population = creerPopulation(cote);
+  patient_zero(population, cote / 2, cote / 2);
+  struct Bandes *bandes =
+      creerBandes(population, parametres, nb_bandes, options, 1);
+  struct timespec debut;
+  clock_gettime(CLOCK_MONOTONIC, &debut);
+  for (int t = 0; t < n_tours; t++) jouerTourBandes(bandes);
+  const double duree = secondesDepuis(&debut);
+  detruireBandes(bandes);
+  detruirePopulation(population);
+  return duree;
+}
+
+/**
+ * @brief Meilleure durée (s) de 3 essais de chronometrer.
+ */
+static double meilleurDe3(const struct Parametres *parametres,
+                          unsigned long cote, unsigned int nb_bandes,
+                          int n_tours) {
+  double meilleure = chronometrer(parametres, cote, nb_bandes, 0, n_tours);
+  for (int essai = 1; essai < 3; essai++) {
+    const double duree = chronometrer(parametres, cote, nb_bandes, 0, n_tours);
+    if (duree < meilleure) meilleure = duree;
+  }
+  return meilleure;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  struct Parametres parametres = {.beta = 0,
+                                  .gamma = 1,
+                                  .lambda = 1,
+                                  .chance_quarantaine = 0.1,
+                                  .chance_decouverte_vaccin = 0,
+                                  .duree_incube = 3,
+                                  .cordon_sanitaire = 5,
+                                  .duree_quarantaine = 20};
+  printf("bandes_test:\n");
+
+  printf("  creerBandes:\n");
+  struct Population *population = creerPopulation(COTE);
+  assert(!creerBandes(population, &parametres, 2, 0, 1));
+  parametres.chance_quarantaine = 0;
+  printf("    Refusé avec une quarantaine: \x1B[32mOK\x1B[0m\n");
+  remplir(population, 960, 5);
+  struct Population *seule = creerPopulation(COTE);
+  assert(!copierPopulation(seule, population));
+  struct Bitboard *bitboard = creerBitboard(seule, &parametres);
+  struct Bandes *bandes = creerBandes(population, &parametres, 1000, 0, 1);
+  assert(bandes->nb_bandes == COTE);
+  assert(bandes->bande[COTE - 1].fin == COTE);
+  assert(memesPlans(bandes->bitboard, bitboard));
+  detruireBandes(bandes);
+  printf("    Au plus une bande par ligne, chargement identique: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  printf("  jouerTourBandes:\n");
+  // Probabilités 0 ou 1 : les bandes ne tirent rien, plans identiques
+  struct Aleatoire aleatoire;
+  initAleatoire(&aleatoire, 3);
+  const unsigned int nb_bandes[] = {1, 3, 7};
+  for (int n = 0; n < 3; n++) {
+    for (unsigned int options = 0; options <= BANDES_CONTACT_PRINCIPAL;
+         options += BANDES_CONTACT_PRINCIPAL) {
+      assert(!copierPopulation(seule, population));
+      chargerBitboard(bitboard);
+      struct Population *copie = creerPopulation(COTE);
+      assert(!copierPopulation(copie, population));
+      bandes = creerBandes(copie, &parametres, nb_bandes[n],
+                           options | BANDES_EPINGLER, 1);
+      for (int t = 0; t < 30; t++) {
+        jouerTourBitboard(bitboard, &aleatoire);
+        jouerTourBandes(bandes);
+        assert(memesPlans(bandes->bitboard, bitboard));
+      }
+      assert(copie->tour == 30);
+      detruireBandes(bandes);
+      detruirePopulation(copie);
+    }
+  }
+  printf("    Identique au bitboard si déterministe (1, 3, 7 bandes): "
+         "\x1B[32mOK\x1B[0m\n");
+
+  // Un générateur par bande : fréquence de MORT sur toute la grille
+  parametres.beta = 0.3;
+  for (unsigned long k = 0; k < COTE * COTE; k++)
+    population->personnes[k].state = MALADE;
+  bandes = creerBandes(population, &parametres, 4, 0, 5);
+  jouerTourBandes(bandes);
+  const struct Statistique stats = getStatistiqueBitboard(bandes->bitboard);
+  const double sigma = sqrt(0.3 * 0.7 / (COTE * COTE));
+  assert(fabs((double)stats.nb_MORT / (COTE * COTE) - 0.3) <= 4 * sigma);
+  printf("    Fréquence de MORT avec 4 générateurs: \x1B[32mOK\x1B[0m\n");
+
+  printf("  afficherNumaBandes:\n");
+  FILE *flux = tmpfile();
+  afficherNumaBandes(bandes, flux);
+  rewind(flux);
+  char ligne[256];
+  assert(fgets(ligne, sizeof(ligne), flux) && !strncmp(ligne, "NUMA:", 5));
+  fclose(flux);
+  afficherNumaBandes(bandes, stdout);
+  printf("    Diagnostic affiché: \x1B[32mOK\x1B[0m\n");
+  detruireBandes(bandes);
+  detruireBitboard(bitboard);
+  detruirePopulation(seule);
+  detruirePopulation(population);
+
+  // Banc d'essai : débit selon le nombre de bandes et le placement
+  const char *cote_env = getenv("EPIDEMIE_BANDES_COTE");
+  const char *max_env = getenv("EPIDEMIE_BANDES_MAX");
+  const unsigned long cote = cote_env ? strtoul(cote_env, NULL, 10) : 1024;
+  const unsigned int max = max_env ? (unsigned int)atoi(max_env) : 4;
+  parametres.beta = 0.05;
+  parametres.gamma = 0.05;
+  parametres.chance_decouverte_vaccin = 0.001;
+  printf("  Débit (grille %lu, 20 tours, tours/s):\n", cote);
+  double reference = 0;
+  for (unsigned int n = 1; n <= max; n *= 2) {
+    const double principal =
+        chronometrer(&parametres, cote, n, BANDES_CONTACT_PRINCIPAL, 20);
+    const double premier = chronometrer(&parametres, cote, n, 0, 20);
+    if (n == 1) reference = premier;
+    printf("    %u bande(s): %.1f (premier contact), %.1f (thread principal)"
+           ", x%.2f\n",
+           n, 20 / premier, 20 / principal, reference / premier);
+  }
+
+  // Passage à l'échelle : gain attendu borné par les coeurs disponibles
+  const long nb_coeurs = sysconf(_SC_NPROCESSORS_ONLN);
+  const double seule_bande = meilleurDe3(&parametres, cote, 1, 20);
+  for (unsigned int n = 2; n <= max; n *= 2) {
+    const double gain = seule_bande / meilleurDe3(&parametres, cote, n, 20);
+    const unsigned int utiles =
+        nb_coeurs < (long)n ? (unsigned int)nb_coeurs : n;
+    assert(gain >= utiles / 2.0);
+    printf("    Passage à l'échelle, %u bandes sur %ld coeur(s) (x%.2f): "
+           "\x1B[32mOK\x1B[0m\n",
+           n, nb_coeurs, gain);
+  }
+  return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file bitboard_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur le moteur en plans de bits.
+ *
+ * Avec des probabilités 0 ou 1, le tour est déterministe : le bitboard doit
+ * alors donner exactement la grille de jouerTourParametres. Les masques de
+ * Bernoulli sont vérifiés par leurs fréquences, à 4 écarts-types près.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "../src/bitboard.h"
+#include "commun.h"
+
+/**
+ * @brief Côté des grilles : plusieurs mots par ligne, dernier mot partiel.
+ */
+#define COTE 150
+
+/**
+ * @brief Vrai si les grilles (état et compteur d'incubation) sont égales.
+ */
+static int memesGrilles(const struct Population *a,
+                        const struct Population *b) {
+  for (unsigned long k = 0; k < a->cote * a->cote; k++)
+    if (a->personnes[k].state != b->personnes[k].state ||
+        a->personnes[k].duree_incube != b->personnes[k].duree_incube)
+      return 0;
+  return 1;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  struct Parametres parametres = {.beta = 0,
+                                  .gamma = 0,
+                                  .lambda = 1,
+                                  .chance_quarantaine = 0,
+                                  .chance_decouverte_vaccin = 0,
+                                  .duree_incube = 3,
+                                  .cordon_sanitaire = 5,
+                                  .duree_quarantaine = 20};
+  struct Aleatoire aleatoire;
+  initAleatoire(&aleatoire, 7);
+  printf("bitboard_test:\n");
+
+  printf("  bitboardCompatible:\n");
+  struct Population *population = creerPopulation(COTE);
+  assert(bitboardCompatible(&parametres, population));
+  parametres.chance_quarantaine = 0.1;
+  assert(!bitboardCompatible(&parametres, population));
+  assert(!creerBitboard(population, &parametres));
+  parametres.chance_quarantaine = 0;
+  population->personnes[3].zone = creerZone(population, 2);
+  assert(!bitboardCompatible(&parametres, population));
+  population->personnes[3].zone = 0;
+  printf("    Refusé avec une quarantaine: \x1B[32mOK\x1B[0m\n");
+
+  printf("  chargerBitboard/synchroniserBitboard:\n");
+  remplir(population, 960, 7);
+  struct Population *copie = creerPopulation(COTE);
+  assert(!copierPopulation(copie, population));
+  struct Bitboard *bitboard = creerBitboard(copie, &parametres);
+  for (unsigned long k = 0; k < COTE * COTE; k++)
+    copie->personnes[k].state = MORT;
+  synchroniserBitboard(bitboard);
+  assert(memesGrilles(copie, population));
+  printf("    Aller-retour de la grille: \x1B[32mOK\x1B[0m\n");
+  struct Statistique a = getStatistiqueBitboard(bitboard);
+  struct Statistique b = getStatistique(population);
+  assert(a.nb_SAIN == b.nb_SAIN && a.nb_MALADE == b.nb_MALADE &&
+         a.nb_MORT == b.nb_MORT && a.nb_IMMUNISE == b.nb_IMMUNISE &&
+         a.nb_INCUBE == b.nb_INCUBE && a.nb_VACCINE == b.nb_VACCINE);
+  printf("    getStatistiqueBitboard par comptage de bits: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  printf("  jouerTourBitboard:\n");
+  // Probabilités 0 ou 1 : même grille que le noyau à chaque tour
+  const double chances[][3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+  unsigned long tours = 0;
+  for (int c = 0; c < 4; c++) {
+    parametres.beta = chances[c][0];
+    parametres.gamma = chances[c][1];
+    parametres.chance_decouverte_vaccin = chances[c][2];
+    bitboard->parametres = parametres;
+    assert(!copierPopulation(copie, population));
+    chargerBitboard(bitboard);
+    struct Population *noyau = creerPopulation(COTE);
+    assert(!copierPopulation(noyau, population));
+    for (int t = 0; t < 40; t++, tours++) {
+      jouerTourParametres(noyau, &parametres, &aleatoire);
+      jouerTourBitboard(bitboard, &aleatoire);
+      synchroniserBitboard(bitboard);
+      assert(memesGrilles(copie, noyau));
+    }
+    detruirePopulation(noyau);
+  }
+  printf("    Identique au noyau si déterministe (%lu tours): "
+         "\x1B[32mOK\x1B[0m\n",
+         tours);
+  detruireBitboard(bitboard);
+
+  // Fréquences : lignes impaires MALADE, lignes paires SAIN
+  parametres.beta = 0.3;
+  parametres.gamma = 0.2;
+  parametres.lambda = 0.5;
+  parametres.chance_decouverte_vaccin = 0.01;
+  for (unsigned long i = 0; i < COTE; i++)
+    for (unsigned long j = 0; j < COTE; j++)
+      copie->grille_de_personnes[i][j].state = i % 2 ? MALADE : SAIN;
+  copie->tour = 0;
+  activerRasters(copie);
+  bitboard = creerBitboard(copie, &parametres);
+  jouerTourBitboard(bitboard, &aleatoire);
+  synchroniserBitboard(bitboard);
+  unsigned long malades = 0, morts = 0, immunises = 0, sains = 0,
+                infectes = 0, vaccines = 0;
+  for (unsigned long i = 0; i < COTE; i++)
+    for (unsigned long j = 0; j < COTE; j++) {
+      const enum State state = copie->grille_de_personnes[i][j].state;
+      if (i % 2) {
+        malades++;
+        morts += state == MORT;
+        immunises += state == IMMUNISE;
+      } else if (i > 0) {  // Deux voisins contagieux
+        sains++;
+        vaccines += state == VACCINE;
+        infectes += state == INCUBE;
+        assert((state == INCUBE) ==
+               (copie->rasters[RASTER_INFECTION][i * COTE + j] == 1));
+      }
+    }
+  assert(frequenceProche(morts, malades, 0.3));
+  assert(frequenceProche(immunises, malades, 0.7 * 0.2));
+  assert(frequenceProche(vaccines, sains, 0.01));
+  assert(frequenceProche(infectes, sains, 0.99 * (1 - 0.5 * 0.5)));
+  printf("    Fréquences MORT, IMMUNISE, VACCINE, INCUBE: \x1B[32mOK\x1B[0m\n");
+  printf("    Raster d'infection: \x1B[32mOK\x1B[0m\n");
+  detruireBitboard(bitboard);
+  detruirePopulation(copie);
+  detruirePopulation(population);
+  return 0;
+}
@@ -0,0 +1,200 @@
+/**
+ * @file branches_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur les variantes d'un préfixe commun.
+ *
+ * Chaque variante jouée dans un processus fils doit donner exactement le
+ * résultat d'une simulation refaite dans le processus de test : même
+ * préfixe, bifurquerSimulation, puis les tours de la variante.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "../src/branches.h"
+
+/**
+ * @brief Côté de la grille.
+ */
+#define COTE 60
+
+/**
+ * @brief Tours du préfixe commun.
+ */
+#define PREFIXE 15
+
+/**
+ * @brief Tours de chaque variante.
+ */
+#define TOURS 60
+
+/**
+ * @brief Nombre de variantes.
+ */
+#define NB_VARIANTES 4
+
+/**
+ * @brief Simulation après le préfixe, patient zero au centre.
+ */
+static struct Simulation *prefixer(const struct Parametres *parametres,
+                                   int bitboard) {
+  struct Population *population = creerPopulation(COTE);
+  patient_zero(population, COTE / 2, COTE / 2);
+  struct Simulation *simulation = creerSimulation(parametres, population, 7);
+  if (bitboard) assert(!activerBitboardSimulation(simulation));
+  avancerSimulation(simulation, PREFIXE);
+  return simulation;
+}
+
+/**
+ * @brief Vrai si deux Statistique sont égales.
+ */
+static int memesStatistiques(const struct Statistique *a,
+                             const struct Statistique *b) {
+  return !memcmp(a, b, sizeof(struct Statistique));
+}
+
+/**
+ * @brief Vérifie chaque résultat contre la variante rejouée sur place.
+ */
+static void verifier(const struct Parametres *parametres, int bitboard,
+                     const struct Variante *variantes,
+                     const struct ResultatVariante *resultats) {
+  for (int k = 0; k < NB_VARIANTES; k++) {
+    struct Simulation *simulation = prefixer(parametres, bitboard);
+    bifurquerSimulation(simulation, &variantes[k].parametres, 11);
+    avancerSimulation(simulation, TOURS);
+    const struct Serie *serie = getSerieSimulation(simulation);
+    assert(!resultats[k].statut);
+    assert(resultats[k].tours == serie->tours - 1);
+    assert(memesStatistiques(&resultats[k].finale, &serie->derniere));
+    assert(resultats[k].indicateurs.pic_MALADE ==
+           serie->indicateurs.pic_MALADE);
+    assert(resultats[k].taux_attaque == tauxAttaqueSerie(serie));
+    detruireSimulation(simulation);
+  }
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  struct Parametres parametres = {.beta = 0.1,
+                                  .gamma = 0.2,
+                                  .lambda = 0.8,
+                                  .chance_quarantaine = 0,
+                                  .chance_decouverte_vaccin = 0,
+                                  .duree_incube = 3,
+                                  .cordon_sanitaire = 5,
+                                  .duree_quarantaine = 20};
+  const double quarantaines[NB_VARIANTES] = {0, 0.3, 1, 0};
+  const int cordons[NB_VARIANTES] = {5, 2, 8, 5};
+  const double vaccins[NB_VARIANTES] = {0, 0, 0.01, 0.02};
+  const char *fichiers[NB_VARIANTES] = {"branches_test_0.txt", NULL, NULL,
+                                        NULL};
+  struct Variante variantes[NB_VARIANTES];
+  for (int k = 0; k < NB_VARIANTES; k++) {
+    variantes[k].parametres = parametres;
+    variantes[k].parametres.chance_quarantaine = quarantaines[k];
+    variantes[k].parametres.cordon_sanitaire = cordons[k];
+    variantes[k].parametres.chance_decouverte_vaccin = vaccins[k];
+    variantes[k].fichier_data = fichiers[k];
+  }
+  struct ResultatVariante resultats[NB_VARIANTES];
+  printf("branches_test:\n");
+
+  printf("  brancherSimulation:\n");
+  struct Simulation *prefixe = prefixer(&parametres, 0);
+  struct Population *avant = creerPopulation(COTE);
+  assert(!copierPopulation(avant, getPopulationSimulation(prefixe)));
+  const unsigned long tours_avant = getSerieSimulation(prefixe)->tours;
+  assert(!brancherSimulation(prefixe, variantes, NB_VARIANTES, 3, TOURS, 11,
+                             resultats));
+  verifier(&parametres, 0, variantes, resultats);
+  printf("    Chaque variante égale à sa simulation sur place: "
+         "\x1B[32mOK\x1B[0m\n");
+  assert(!memesStatistiques(&resultats[0].finale, &resultats[2].finale));
+  printf("    Les variantes divergent: \x1B[32mOK\x1B[0m\n");
+
+  const struct Population *apres = getPopulationSimulation(prefixe);
+  assert(getSerieSimulation(prefixe)->tours == tours_avant);
+  assert(!memcmp(apres->personnes, avant->personnes,
+                 COTE * COTE * sizeof(struct Personne)));
+  printf("    Préfixe inchangé: \x1B[32mOK\x1B[0m\n");
+
+  // Un autre fils de l'appelant, terminé pendant les variantes
+  const pid_t autre = fork();
+  if (!autre) _exit(7);
+  struct ResultatVariante sequentiels[NB_VARIANTES];
+  assert(!brancherSimulation(prefixe, variantes, NB_VARIANTES, 1, TOURS, 11,
+                             sequentiels));
+  for (int k = 0; k < NB_VARIANTES; k++)
+    assert(sequentiels[k].tours == resultats[k].tours &&
+           memesStatistiques(&sequentiels[k].finale, &resultats[k].finale));
+  printf("    1 ou 3 processus, mêmes résultats: \x1B[32mOK\x1B[0m\n");
+  int statut;
+  assert(waitpid(autre, &statut, 0) == autre && WIFEXITED(statut) &&
+         WEXITSTATUS(statut) == 7);
+  printf("    Autres fils de l'appelant non attendus: \x1B[32mOK\x1B[0m\n");
+
+  FILE *file = fopen("branches_test_0.txt", "r");
+  assert(file);
+  unsigned long population_totale, lignes;
+  assert(fscanf(file, "%lu %lu", &population_totale, &lignes) == 2);
+  assert(population_totale == COTE * COTE &&
+         lignes == resultats[0].tours + 1);
+  fclose(file);
+  printf("    Données exportées avec le préfixe: \x1B[32mOK\x1B[0m\n");
+  detruireSimulation(prefixe);
+  detruirePopulation(avant);
+
+  // Préfixe en plans de bits ; la quarantaine des variantes 1 et 2 le fait
+  // abandonner au profit du noyau
+  prefixe = prefixer(&parametres, 1);
+  assert(!brancherSimulation(prefixe, variantes, NB_VARIANTES, 2, TOURS, 11,
+                             resultats));
+  verifier(&parametres, 1, variantes, resultats);
+  printf("    Préfixe en plans de bits: \x1B[32mOK\x1B[0m\n");
+  detruireSimulation(prefixe);
+
+  prefixe = prefixer(&parametres, 0);
+  assert(!activerBandesSimulation(prefixe, 2, 0));
+  assert(brancherSimulation(prefixe, variantes, NB_VARIANTES, 2, TOURS, 11,
+                            resultats));
+  printf("    Refusé avec des bandes: \x1B[32mOK\x1B[0m\n");
+  detruireSimulation(prefixe);
+
+  const struct ParametresContacts parametres_contacts = {
+      .nb_contacts = 1, .loi = CONTACTS_DISTANCE, .exposant = 2, .rayon = 8};
+  prefixe = prefixer(&parametres, 0);
+  assert(!activerContactsSimulation(
+      prefixe, creerContacts(&parametres_contacts, COTE, 2)));
+  assert(brancherSimulation(prefixe, variantes, NB_VARIANTES, 2, TOURS, 11,
+                            resultats));
+  printf("    Refusé avec des contacts sur 2 threads: \x1B[32mOK\x1B[0m\n");
+  detruireSimulation(prefixe);
+
+  const struct ParametresAgents marche = {MOBILITE_MARCHE, 0.5, 0, 2};
+  prefixe = prefixer(&parametres, 0);
+  assert(!activerAgentsSimulation(prefixe, &marche, 1));
+  assert(!brancherSimulation(prefixe, variantes, NB_VARIANTES, 2, TOURS, 11,
+                             resultats));
+  detruireSimulation(prefixe);
+  prefixe = creerSimulation(&parametres, creerPopulation(2 * COTE), 1);
+  assert(!activerAgentsSimulation(prefixe, &marche, 2));  // 2 blocs d'agents
+  assert(brancherSimulation(prefixe, variantes, NB_VARIANTES, 2, TOURS, 11,
+                            resultats));
+  printf("    Agents : une tâche acceptée, 2 threads refusés: "
+         "\x1B[32mOK\x1B[0m\n");
+  detruireSimulation(prefixe);
+  return 0;
+}
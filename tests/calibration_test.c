@@ -0,0 +1,163 @@
+/**
+ * @file calibration_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur la calibration ABC-SMC.
+ *
+ * Les observations sont simulées avec des paramètres connus : la loi a
+ * posteriori doit les contenir, et les candidats abandonnés doivent
+ * économiser des tours.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/calibration.h"
+
+/**
+ * @brief Côté de la grille.
+ */
+#define COTE 40
+
+/**
+ * @brief Tours observés (tour 0 exclu).
+ */
+#define TOURS 40
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  const struct Parametres verite = {.beta = 0.2,
+                                    .gamma = 0.3,
+                                    .lambda = 0.6,
+                                    .chance_quarantaine = 0,
+                                    .chance_decouverte_vaccin = 0,
+                                    .duree_incube = 2,
+                                    .cordon_sanitaire = 5,
+                                    .duree_quarantaine = 20};
+  printf("calibration_test:\n");
+
+  struct Population *initiale = creerPopulation(COTE);
+  patient_zero(initiale, COTE / 2, COTE / 2);
+  struct Population *population = creerPopulation(COTE);
+  assert(!copierPopulation(population, initiale));
+  struct Simulation *simulation = creerSimulation(&verite, population, 3);
+  avancerSimulation(simulation, TOURS);
+  struct Data *observations =
+      decompresserSerie(getSerieSimulation(simulation));
+  assert(observations && observations->tours == TOURS + 1);
+
+  printf("  distanceCalibration:\n");
+  assert(distanceCalibration(observations, observations) == 0);
+  struct Data *decalee = creerData();
+  decalee->population_totale = observations->population_totale;
+  for (unsigned long t = 0; t < observations->tours; t++) {
+    struct Statistique stats = *observations->liste_statistiques[t];
+    stats.nb_MORT += COTE * COTE / 10;  // 10 % de MORT en plus
+    stats.nb_SAIN -= COTE * COTE / 10;
+    appendData(decalee, stats);
+  }
+  assert(fabs(distanceCalibration(observations, decalee) - 0.1) < 1e-12);
+  detruireData(decalee);
+  struct Data *courte = creerData();
+  courte->population_totale = observations->population_totale;
+  appendData(courte, *observations->liste_statistiques[0]);
+  assert(distanceCalibration(observations, courte) > 0);
+  detruireData(courte);
+  printf("    Nulle sur elle-même, décalage de 10 %%: \x1B[32mOK\x1B[0m\n");
+
+  printf("  calibrer:\n");
+  struct Calibration calibration = {.observations = observations,
+                                    .initiale = initiale,
+                                    .parametres = verite,
+                                    .minimum = {0, 0, 0},
+                                    .maximum = {1, 1, 1},
+                                    .nb_particules = 100,
+                                    .nb_generations = 5,
+                                    .seuil_initial = 0,
+                                    .quantile = 0.5,
+                                    .simulations_max = 0,
+                                    .nb_threads = 2,
+                                    .graine = 11};
+  struct Posterieure *posterieure = calibrer(&calibration);
+  assert(posterieure && posterieure->generations == 5);
+  double moyenne[NB_INCONNUES], ecart_type[NB_INCONNUES];
+  moyennePosterieure(posterieure, moyenne, ecart_type);
+  const double vrais[NB_INCONNUES] = {verite.beta, verite.gamma,
+                                      verite.lambda};
+  for (int d = 0; d < NB_INCONNUES; d++) {
+    printf("    theta[%d] = %.3f +- %.3f (vrai %.2f)\n", d, moyenne[d],
+           ecart_type[d], vrais[d]);
+    assert(fabs(moyenne[d] - vrais[d]) <= 3 * ecart_type[d] + 0.02);
+    assert(ecart_type[d] < sqrt(1.0 / 12));  // Ecart-type a priori
+  }
+  // Seul le rapport de beta et gamma est bien contraint ; lambda l'est
+  assert(ecart_type[INCONNUE_LAMBDA] < 0.15);
+  double somme = 0;
+  for (unsigned int i = 0; i < posterieure->nb_particules; i++) {
+    assert(posterieure->particules[i].distance <= posterieure->seuil);
+    somme += posterieure->particules[i].poids;
+  }
+  assert(fabs(somme - 1) < 1e-9);
+  printf("    Loi a posteriori autour des vrais paramètres: "
+         "\x1B[32mOK\x1B[0m\n");
+  assert(posterieure->abandons > 0 &&
+         posterieure->tours_joues < posterieure->tours_sans_abandon);
+  printf("    Abandon précoce: %lu/%lu candidats, %lu tours sur %lu: "
+         "\x1B[32mOK\x1B[0m\n",
+         posterieure->abandons, posterieure->simulations,
+         posterieure->tours_joues, posterieure->tours_sans_abandon);
+
+  // Même graine : mêmes particules quel que soit le nombre de threads
+  calibration.nb_particules = 30;
+  calibration.nb_generations = 3;
+  calibration.nb_threads = 1;
+  struct Posterieure *un = calibrer(&calibration);
+  calibration.nb_threads = 3;
+  struct Posterieure *trois = calibrer(&calibration);
+  assert(!memcmp(un->particules, trois->particules,
+                 30 * sizeof(struct Particule)));
+  detruirePosterieure(un);
+  detruirePosterieure(trois);
+  printf("    1 ou 3 threads, mêmes particules: \x1B[32mOK\x1B[0m\n");
+
+  // Rejet simple : une génération au seuil donné
+  calibration.nb_generations = 1;
+  calibration.seuil_initial = 0.05;
+  struct Posterieure *rejet = calibrer(&calibration);
+  assert(rejet && rejet->seuil == 0.05);
+  for (unsigned int i = 0; i < rejet->nb_particules; i++)
+    assert(rejet->particules[i].distance <= 0.05);
+  detruirePosterieure(rejet);
+  printf("    Rejet simple au seuil donné: \x1B[32mOK\x1B[0m\n");
+
+  // Seuil inatteignable : budget épuisé, aucune génération complète
+  calibration.seuil_initial = 1e-9;
+  calibration.simulations_max = 50;
+  assert(!calibrer(&calibration));
+  printf("    Budget de simulations épuisé: \x1B[32mOK\x1B[0m\n");
+
+  printf("  exporterPosterieure:\n");
+  assert(!exporterPosterieure(posterieure, "posterieure_test.txt"));
+  FILE *file = fopen("posterieure_test.txt", "r");
+  char ligne[256];
+  unsigned int lignes = 0;
+  while (fgets(ligne, sizeof(ligne), file)) lignes++;
+  fclose(file);
+  assert(lignes == posterieure->nb_particules + 1);
+  printf("    Une ligne par particule: \x1B[32mOK\x1B[0m\n");
+
+  detruirePosterieure(posterieure);
+  detruireSimulation(simulation);
+  detruirePopulation(initiale);
+  detruireData(observations);
+  return 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file classes_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur le moteur à classes de risque.
+ *
+ * Avec une seule classe, le moteur doit donner exactement la trajectoire de
+ * jouerTourTransition ; avec plusieurs, chaque case suit les paramètres de
+ * sa classe et les effectifs par classe égalent un recomptage.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../src/classes.h"
+#include "../src/simulation.h"
+#include "commun.h"
+
+/**
+ * @brief Côté de la grille.
+ */
+#define COTE 60
+
+/**
+ * @brief Tours comparés.
+ */
+#define TOURS 60
+
+/**
+ * @brief Fichier temporaire des tests.
+ */
+#define FICHIER "classes_test.txt"
+
+/**
+ * @brief Ecrit un texte dans FICHIER.
+ */
+static void ecrire(const char *texte) {
+  FILE *file = fopen(FICHIER, "w");
+  fputs(texte, file);
+  fclose(file);
+}
+
+/**
+ * @brief Vrai si les effectifs de chaque classe égalent un recomptage, et
+ * leur somme getStatistique.
+ */
+static int memesEffectifs(const struct Classes *classes) {
+  long recompte[NB_CLASSES_MAX][VACCINE + 1] = {{0}};
+  for (unsigned long k = 0; k < COTE * COTE; k++)
+    recompte[classes->carte[k]][classes->population->personnes[k].state]++;
+  const struct Statistique stats = getStatistiqueClasses(classes);
+  const struct Statistique attendues = getStatistique(classes->population);
+  return !memcmp(recompte, classes->effectifs, sizeof(recompte)) &&
+         !memcmp(&stats, &attendues, sizeof(struct Statistique));
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  struct Parametres parametres = {.beta = 0.05,
+                                  .gamma = 0.15,
+                                  .lambda = 0.5,
+                                  .chance_quarantaine = 0.2,
+                                  .chance_decouverte_vaccin = 0.001,
+                                  .duree_incube = 2,
+                                  .cordon_sanitaire = 2,
+                                  .duree_quarantaine = 6};
+  struct ParametresClasse valeurs[NB_CLASSES_MAX];
+  printf("classes_test:\n");
+
+  printf("  lireTableClasses:\n");
+  ecrire("# beta gamma lambda\n\n0.05 0.15 0.5  # jeunes\n  1 0 0\n");
+  assert(lireTableClasses(FICHIER, valeurs) == 2);
+  assert(valeurs[0].beta == 0.05 && valeurs[0].gamma == 0.15 &&
+         valeurs[0].lambda == 0.5);
+  assert(valeurs[1].beta == 1 && valeurs[1].gamma == 0 &&
+         valeurs[1].lambda == 0);
+  printf("    Commentaires et lignes vides ignorés: \x1B[32mOK\x1B[0m\n");
+  ecrire("0.1 0.2 1.5\n");
+  assert(lireTableClasses(FICHIER, valeurs) == -1);
+  ecrire("0.1 0.2\n");
+  assert(lireTableClasses(FICHIER, valeurs) == -1);
+  ecrire("# vide\n");
+  assert(lireTableClasses(FICHIER, valeurs) == -1);
+  char trop[NB_CLASSES_MAX * 16 + 16] = "";
+  for (int c = 0; c <= NB_CLASSES_MAX; c++) strcat(trop, "0.1 0.1 0.1\n");
+  ecrire(trop);
+  assert(lireTableClasses(FICHIER, valeurs) == -1);
+  assert(lireTableClasses("/inexistant/classes.txt", valeurs) == -1);
+  printf("    Refusé : hors de [0, 1], incomplet, vide, trop de classes: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  printf("  lireCarteClasses:\n");
+  ecrire("P5\n3 3\n255\n\x01\x02\x03\x04\x05\x06\x07\x08\x09");
+  uint8_t *carte = lireCarteClasses(FICHIER, 3);
+  for (int k = 0; k < 9; k++) assert(carte[k] == k + 1);
+  free(carte);
+  assert(!lireCarteClasses(FICHIER, 4));
+  printf("    PGM lu, côté différent refusé: \x1B[32mOK\x1B[0m\n");
+  unlink(FICHIER);
+
+  printf("  creerClasses:\n");
+  struct Population *population = creerPopulation(COTE);
+  carte = (uint8_t *)calloc(COTE * COTE, 1);
+  carte[COTE * COTE - 1] = 2;
+  assert(!creerClasses(population, &parametres, valeurs, 2, carte));
+  assert(!creerClasses(population, &parametres, valeurs, 0, carte));
+  free(carte);
+  printf("    Refusé : classe inconnue sur la carte, aucune classe: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  printf("  jouerTourClasses:\n");
+  // Une classe, mêmes paramètres : même trajectoire que les transitions
+  remplir(population, 985, 3);
+  struct Population *reference = creerPopulation(COTE);
+  assert(!copierPopulation(reference, population));
+  const struct ParametresClasse unique = {parametres.beta, parametres.gamma,
+                                          parametres.lambda};
+  struct Classes *classes =
+      creerClasses(population, &parametres, &unique, 1,
+                   (uint8_t *)calloc(COTE * COTE, 1));
+  assert(classes && memesEffectifs(classes));
+  struct TableTransition table;
+  initTableTransition(&table, &parametres);
+  struct Aleatoire aleatoire, aleatoire_reference;
+  initAleatoire(&aleatoire, 7);
+  initAleatoire(&aleatoire_reference, 7);
+  for (int t = 0; t < TOURS; t++) {
+    jouerTourClasses(classes, &aleatoire);
+    jouerTourTransition(reference, &table, &aleatoire_reference);
+    for (unsigned long k = 0; k < COTE * COTE; k++)
+      assert(population->personnes[k].state ==
+                 reference->personnes[k].state &&
+             enQuarantaine(population, &population->personnes[k]) ==
+                 enQuarantaine(reference, &reference->personnes[k]));
+    assert(memesEffectifs(classes));
+  }
+  assert(population->zones.nb_zones > 10);
+  detruireClasses(classes);
+  detruirePopulation(reference);
+  printf("    Une classe : identique aux tables de transition: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  // Deux classes : la moitié droite n'est pas susceptible, la gauche meurt
+  // au premier tour de maladie
+  const struct ParametresClasse deux[2] = {{1, 0, 0.8}, {0, 1, 0}};
+  parametres.chance_decouverte_vaccin = 0;
+  parametres.chance_quarantaine = 0;
+  parametres.duree_incube = 0;
+  detruirePopulation(population);
+  population = creerPopulation(COTE);
+  carte = (uint8_t *)malloc(COTE * COTE);
+  for (unsigned long i = 0; i < COTE; i++)
+    for (unsigned long j = 0; j < COTE; j++)
+      carte[i * COTE + j] = j >= COTE / 2;
+  patient_zero(population, COTE / 2, COTE / 2 - 1);
+  classes = creerClasses(population, &parametres, deux, 2, carte);
+  for (int t = 0; t < 3 * TOURS; t++) {
+    jouerTourClasses(classes, &aleatoire);
+    assert(memesEffectifs(classes));
+    const struct Statistique droite = getStatistiqueClasse(classes, 1);
+    assert(droite.nb_SAIN == COTE * COTE / 2);
+    assert(!getStatistiqueClasse(classes, 0).nb_IMMUNISE);
+  }
+  const struct Statistique gauche = getStatistiqueClasse(classes, 0);
+  assert(gauche.nb_MORT > COTE * COTE / 4 && !gauche.nb_MALADE);
+  printf("    Deux classes : susceptibilité et mortalité par case, "
+         "effectifs par classe: \x1B[32mOK\x1B[0m\n");
+
+  // Bifurcation : nouvelles chances communes, beta, gamma, lambda gardés
+  parametres.chance_quarantaine = 1;
+  parametrerClasses(classes, &parametres);
+  assert(classes->tables[0].malade.nb_issues == 1 &&
+         classes->tables[0].malade.issues[0] == (ISSUE_QUARANTAINE | MORT));
+  assert(classes->tables[1].malade.issues[0] ==
+         (ISSUE_QUARANTAINE | IMMUNISE));
+  printf("    Paramètres communs changés, classes gardées: "
+         "\x1B[32mOK\x1B[0m\n");
+  detruireClasses(classes);
+  detruirePopulation(population);
+
+  printf("  activerClassesSimulation:\n");
+  parametres.chance_quarantaine = 0;
+  parametres.chance_decouverte_vaccin = 0;
+  for (int moteur = 0; moteur < 2; moteur++) {
+    population = creerPopulation(COTE);
+    remplir(population, 985, 3);
+    struct Simulation *simulation = creerSimulation(&parametres, population, 3);
+    assert(!(moteur ? activerVoisinageSimulation(simulation)
+                    : activerBitboardSimulation(simulation)));
+    uint8_t *carte = (uint8_t *)calloc(COTE * COTE, 1);
+    assert(activerClassesSimulation(simulation, valeurs, 1, carte));
+    free(carte);
+    detruireSimulation(simulation);
+  }
+  population = creerPopulation(COTE);
+  remplir(population, 985, 3);
+  struct Simulation *simulation = creerSimulation(&parametres, population, 3);
+  assert(!activerClassesSimulation(simulation, valeurs, 1,
+                                   (uint8_t *)calloc(COTE * COTE, 1)));
+  assert(activerBitboardSimulation(simulation));
+  assert(activerBandesSimulation(simulation, 2, 0));
+  assert(activerVoisinageSimulation(simulation));
+  detruireSimulation(simulation);
+  printf("    Refusé avec les plans de bits ou le voisinage, dans les deux "
+         "ordres: \x1B[32mOK\x1B[0m\n");
+  return 0;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file commun.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Outils partagés par les tests unitaires.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <math.h>
+
+#include "commun.h"
+
+/**
+ * @brief Vrai si la fréquence n / essais est à 4 écarts-types de p.
+ *
+ * @param n Succès observés.
+ * @param essais Nombre d'essais.
+ * @param p Probabilité attendue.
+ * @return int 1 si proche, 0 sinon.
+ */
+int frequenceProche(unsigned long n, unsigned long essais, double p) {
+  const double sigma = sqrt(p * (1 - p) / essais);
+  return fabs((double)n / essais - p) <= 4 * sigma + 1e-12;
+}
+
+/**
+ * @brief Grille variée et déterministe : quelques VACCINE, MORT, IMMUNISE
+ * et foyers.
+ *
+ * @param population Population.
+ * @param sains Cases SAIN pour mille (le reste est réparti entre les états).
+ * @param duree_max Borne (exclue) du compteur d'incubation des INCUBE.
+ */
+void remplir(struct Population *population, unsigned long sains,
+             int duree_max) {
+  for (unsigned long k = 0; k < population->cote * population->cote; k++) {
+    struct Personne *personne = &population->personnes[k];
+    const unsigned long h = k * 2654435761u % 1000;
+    personne->state = h < sains ? SAIN : (enum State)(h % (VACCINE + 1));
+    personne->duree_incube =
+        personne->state == INCUBE ? (int)(h % duree_max) : 0;
+  }
+}
@@ -0,0 +1,10 @@
+#if !defined(COMMUN_H)
+#define COMMUN_H
+
+#include "../src/population.h"
+
+int frequenceProche(unsigned long n, unsigned long essais, double p);
+void remplir(struct Population *population, unsigned long sains,
+             int duree_max);
+
+#endif  // COMMUN_H
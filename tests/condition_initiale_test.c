@@ -0,0 +1,78 @@
+/**
+ * @file condition_initiale_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur le chargement de la population
+ * initiale.
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../src/condition_initiale.h"
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  const struct Parametres parametres = {.duree_incube = 4,
+                                        .duree_quarantaine = 20};
+  printf("condition_initiale_test:\n");
+
+  printf("  exporterConditionInitiale / chargerConditionInitiale:\n");
+  struct Population *population = creerPopulation(13);
+  patient_zero(population, 0, 0);
+  patient_zero(population, 12, 12);
+  population->grille_de_personnes[5][6].state = VACCINE;
+  population->grille_de_personnes[7][2].state = MORT;
+  population->grille_de_personnes[3][3].state = INCUBE;
+  population->grille_de_personnes[3][4].zone = creerZone(population, 1);
+  assert(!exporterConditionInitiale(population, "condition_test.pgm"));
+  struct Population *chargee =
+      chargerConditionInitiale("condition_test.pgm", &parametres);
+  assert(chargee && chargee->cote == 13);
+  printf("    Cote: \x1B[32mOK\x1B[0m\n");
+  for (unsigned long i = 0; i < 13; i++)
+    for (unsigned long j = 0; j < 13; j++)
+      assert(chargee->grille_de_personnes[i][j].state ==
+             population->grille_de_personnes[i][j].state);
+  printf("    Plusieurs patients zero, VACCINE, MORT: \x1B[32mOK\x1B[0m\n");
+  assert(chargee->grille_de_personnes[3][3].duree_incube == 4);
+  assert(getDureeQuarantaine(chargee, &chargee->grille_de_personnes[3][4]) ==
+         20);
+  assert(!enQuarantaine(chargee, &chargee->grille_de_personnes[3][5]));
+  printf("    Incubation et quarantaine: \x1B[32mOK\x1B[0m\n");
+  detruirePopulation(chargee);
+
+  printf("  Octets bruts:\n");
+  FILE *file = fopen("condition_test.raw", "wb");
+  for (int k = 0; k < 9; k++) fputc(k == 4 ? MALADE : SAIN, file);
+  fclose(file);
+  chargee = chargerConditionInitiale("condition_test.raw", &parametres);
+  assert(chargee && chargee->cote == 3);
+  assert(chargee->grille_de_personnes[1][1].state == MALADE);
+  assert(chargee->grille_de_personnes[0][0].state == SAIN);
+  printf("    Carte 3x3: \x1B[32mOK\x1B[0m\n");
+  detruirePopulation(chargee);
+
+  printf("  Fichiers invalides:\n");
+  assert(!chargerConditionInitiale("inexistant.pgm", &parametres));
+  file = fopen("condition_test.raw", "wb");
+  for (int k = 0; k < 8; k++) fputc(SAIN, file);
+  fclose(file);
+  assert(!chargerConditionInitiale("condition_test.raw", &parametres));
+  printf("    Taille non carrée: \x1B[32mOK\x1B[0m\n");
+  file = fopen("condition_test.raw", "wb");
+  for (int k = 0; k < 4; k++) fputc(42, file);
+  fclose(file);
+  assert(!chargerConditionInitiale("condition_test.raw", &parametres));
+  printf("    Etat inconnu: \x1B[32mOK\x1B[0m\n\n");
+
+  detruirePopulation(population);
+  return 0;
+}
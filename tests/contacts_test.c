@@ -0,0 +1,177 @@
+/**
+ * @file contacts_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur les contacts lointains.
+ *
+ * Les fréquences des tables d'alias et des distances sont comparées aux
+ * poids à 4 écarts-types près ; une épidémie doit franchir un mur de MORT
+ * grâce aux contacts lointains seulement.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/contacts.h"
+#include "../src/simulation.h"
+#include "commun.h"
+
+/**
+ * @brief Nombre de tirages par fréquence mesurée.
+ */
+#define NB_ESSAIS 100000
+
+/**
+ * @brief Côté de la grille.
+ */
+#define COTE 101
+
+/**
+ * @brief Nombre total de cases visées dans les tampons.
+ */
+static unsigned long compterCibles(const struct Contacts *contacts) {
+  unsigned long nb = 0;
+  for (unsigned int b = 0; b < contacts->nb_tampons; b++)
+    nb += contacts->tampons[b].nb_cibles;
+  return nb;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  struct Aleatoire aleatoire;
+  initAleatoire(&aleatoire, 11);
+  printf("contacts_test:\n");
+
+  printf("  initAlias:\n");
+  const double poids[4] = {1, 2, 7, 0};
+  struct Alias alias;
+  assert(!initAlias(&alias, poids, 4));
+  unsigned long tirages[4] = {0};
+  for (int n = 0; n < NB_ESSAIS; n++) tirages[tirerAlias(&alias, &aleatoire)]++;
+  assert(frequenceProche(tirages[0], NB_ESSAIS, 0.1));
+  assert(frequenceProche(tirages[1], NB_ESSAIS, 0.2));
+  assert(frequenceProche(tirages[2], NB_ESSAIS, 0.7));
+  assert(!tirages[3]);
+  libererAlias(&alias);
+  printf("    Fréquences des poids, poids nul jamais tiré: "
+         "\x1B[32mOK\x1B[0m\n");
+  const double nuls[2] = {0, 0};
+  const double negatifs[2] = {1, -1};
+  assert(initAlias(&alias, nuls, 2) && initAlias(&alias, negatifs, 2));
+  printf("    Refusé : poids nuls ou négatifs: \x1B[32mOK\x1B[0m\n");
+
+  printf("  collecterContacts:\n");
+  struct Population *population = creerPopulation(COTE);
+  patient_zero(population, COTE / 2, COTE / 2);
+  struct ParametresContacts parametres_contacts = {
+      .nb_contacts = NB_ESSAIS, .loi = CONTACTS_DISTANCE, .exposant = 0,
+      .rayon = 3};
+  struct Contacts *contacts = creerContacts(&parametres_contacts, COTE, 1);
+  collecterContacts(contacts, population, 1, &aleatoire);
+  assert(compterCibles(contacts) == NB_ESSAIS);
+  unsigned long distances[4] = {0};
+  for (unsigned long c = 0; c < contacts->tampons[0].nb_cibles; c++) {
+    const long cible = (long)contacts->tampons[0].cibles[c];
+    const long di = labs(cible / COTE - COTE / 2);
+    const long dj = labs(cible % COTE - COTE / 2);
+    distances[di > dj ? di : dj]++;
+  }
+  assert(!distances[0]);
+  for (int r = 1; r <= 3; r++)
+    assert(frequenceProche(distances[r], NB_ESSAIS, 8. * r / 48));
+  detruireContacts(contacts);
+  printf("    Exposant 0 : cases uniformes jusqu'au rayon: "
+         "\x1B[32mOK\x1B[0m\n");
+  parametres_contacts.rayon = 0;
+  assert(!creerContacts(&parametres_contacts, COTE, 1));
+  printf("    Refusé : rayon nul: \x1B[32mOK\x1B[0m\n");
+
+  // Carte de poids : une seule case peut être visée
+  uint8_t *carte = (uint8_t *)calloc(COTE * COTE, 1);
+  carte[5 * COTE + 7] = 255;
+  parametres_contacts.loi = CONTACTS_POIDS;
+  parametres_contacts.poids = carte;
+  parametres_contacts.nb_contacts = 10;
+  contacts = creerContacts(&parametres_contacts, COTE, 4);
+  collecterContacts(contacts, population, 1, &aleatoire);
+  assert(compterCibles(contacts) == 10);
+  for (unsigned int b = 0; b < contacts->nb_tampons; b++)
+    for (unsigned long c = 0; c < contacts->tampons[b].nb_cibles; c++)
+      assert(contacts->tampons[b].cibles[c] == 5 * COTE + 7);
+  printf("    Carte de poids, 4 tampons: \x1B[32mOK\x1B[0m\n");
+
+  // Quarantaine : ni source ni cible
+  const uint32_t zone = creerZone(population, 5);
+  population->grille_de_personnes[5][7].zone = zone;
+  collecterContacts(contacts, population, 1, &aleatoire);
+  assert(!compterCibles(contacts));
+  population->grille_de_personnes[5][7].zone = 0;
+  population->grille_de_personnes[COTE / 2][COTE / 2].zone = zone;
+  collecterContacts(contacts, population, 1, &aleatoire);
+  assert(!compterCibles(contacts));
+  population->grille_de_personnes[COTE / 2][COTE / 2].zone = 0;
+  printf("    Aucun contact depuis ou vers une quarantaine: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  printf("  fusionnerContacts:\n");
+  const struct Parametres parametres = {.beta = 0,
+                                        .gamma = 0.3,
+                                        .lambda = 1,
+                                        .chance_quarantaine = 0,
+                                        .chance_decouverte_vaccin = 0,
+                                        .duree_incube = 3,
+                                        .cordon_sanitaire = 0,
+                                        .duree_quarantaine = 0};
+  collecterContacts(contacts, population, 1, &aleatoire);
+  assert(fusionnerContacts(contacts, population, &parametres) == 1);
+  assert(population->grille_de_personnes[5][7].state == INCUBE &&
+         population->grille_de_personnes[5][7].duree_incube == 3);
+  assert(contacts->infections == 1);
+  detruireContacts(contacts);
+  free(carte);
+  detruirePopulation(population);
+  printf("    Cible visée 10 fois infectée une fois: \x1B[32mOK\x1B[0m\n");
+
+  printf("  avancerSimulation:\n");
+  // Mur de MORT au milieu : seuls les contacts lointains le franchissent
+  for (int avec_contacts = 0; avec_contacts < 2; avec_contacts++) {
+    population = creerPopulation(COTE);
+    for (unsigned long i = 0; i < COTE; i++)
+      population->grille_de_personnes[i][COTE / 2].state = MORT;
+    patient_zero(population, COTE / 2, 10);
+    struct Simulation *simulation = creerSimulation(&parametres, population, 3);
+    if (avec_contacts) {
+      parametres_contacts.loi = CONTACTS_DISTANCE;
+      parametres_contacts.exposant = 2;
+      parametres_contacts.rayon = COTE;
+      parametres_contacts.nb_contacts = 1;
+      assert(!activerContactsSimulation(
+          simulation, creerContacts(&parametres_contacts, COTE, 2)));
+    }
+    avancerSimulation(simulation, 400);
+    const struct Population *finale = getPopulationSimulation(simulation);
+    unsigned long droite = 0;
+    for (unsigned long i = 0; i < COTE; i++)
+      for (unsigned long j = COTE / 2 + 1; j < COTE; j++)
+        droite += finale->grille_de_personnes[i][j].state != SAIN;
+    assert(avec_contacts ? droite > COTE * COTE / 4 : droite == 0);
+    const struct Serie *serie = getSerieSimulation(simulation);
+    const struct Statistique attendues =
+        getStatistique((struct Population *)finale);
+    assert(!memcmp(&serie->derniere, &attendues,
+                   sizeof(struct Statistique)));
+    detruireSimulation(simulation);
+  }
+  printf("    Mur de MORT franchi par les contacts seulement: "
+         "\x1B[32mOK\x1B[0m\n");
+  return 0;
+}
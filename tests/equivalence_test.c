@@ -0,0 +1,917 @@
+/**
+ * @file equivalence_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Equivalence des moteurs avec la référence et régression de vitesse.
+ *
+ * Chaque moteur est lancé avec les mêmes graines et la même grille initiale
+ * que le moteur de référence (reference.c) :
+ * - moteur déterministe : grilles et Statistique identiques à chaque tour ;
+ * - moteur stochastique : Statistique finales de même loi (test de
+ *   Kolmogorov-Smirnov à deux échantillons).
+ *
+ * Avec --performance (make performance, compilé en -O2), seule la vitesse
+ * de chaque moteur relative à la référence est mesurée (médiane de 5
+ * rapports, référence et moteur chronométrés côte à côte) et
+ * comparée à tests/performance_reference.txt ; make check ne la mesure
+ * pas. Variables d'environnement :
+ * - EPIDEMIE_PERFORMANCE : fichier de référence des vitesses ;
+ * - EPIDEMIE_TOLERANCE : ralentissement toléré en % (défaut 30) ;
+ * - EPIDEMIE_ECRIRE_PERFORMANCE=1 : réécrire le fichier de référence.
+ *
+ * Ajouter un moteur : l'écrire sous forme de struct Moteur et l'inscrire
+ * dans MOTEURS.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../src/hors_memoire.h"
+#include "../src/multiechelle.h"
+#include "../src/simulation.h"
+#include "reference.h"
+
+/**
+ * @brief Moteur de simulation vu par le banc d'essai.
+ */
+struct Moteur {
+  /**
+   * @brief Nom (clé du fichier de performance).
+   */
+  const char *nom;
+  /**
+   * @brief 1 : identique à la référence tour par tour, 0 : même loi.
+   */
+  char deterministe;
+  /**
+   * @brief 1 : loi approchée, comparée sur les premiers scénarios seulement.
+   */
+  char approche;
+  /**
+   * @brief Vrai si le moteur est exact sur ce scénario (tour par tour ou en
+   * loi), approché sinon ; NULL s'il l'est sur tous.
+   */
+  char (*exact)(const struct Parametres *parametres);
+  /**
+   * @brief Créer un état, patient zero en (x, y).
+   */
+  void *(*creer)(const struct Parametres *parametres, unsigned long cote,
+                 unsigned long x, unsigned long y, unsigned long graine);
+  /**
+   * @brief Jouer un tour.
+   */
+  void (*jouer)(void *etat);
+  /**
+   * @brief Statistique du tour courant.
+   */
+  struct Statistique (*statistique)(const void *etat);
+  /**
+   * @brief Population du tour courant, NULL si le moteur n'en a pas.
+   */
+  const struct Population *(*population)(const void *etat);
+  /**
+   * @brief Libérer l'état.
+   */
+  void (*detruire)(void *etat);
+  /**
+   * @brief Scénario chronométré, NULL pour SCENARIOS[0].
+   */
+  const struct Parametres *chronometre;
+};
+
+/**
+ * @brief Etat des moteurs à base de Population.
+ */
+struct EtatPopulation {
+  struct Population *population;
+  struct Aleatoire aleatoire;
+  struct Parametres parametres;
+};
+
+static void *creerEtatPopulation(const struct Parametres *parametres,
+                                 unsigned long cote, unsigned long x,
+                                 unsigned long y, unsigned long graine) {
+  struct EtatPopulation *etat =
+      (struct EtatPopulation *)malloc(sizeof(struct EtatPopulation));
+  etat->population = creerPopulation(cote);
+  patient_zero(etat->population, x, y);
+  initAleatoire(&etat->aleatoire, graine);
+  etat->parametres = *parametres;
+  return etat;
+}
+
+static void jouerParametres(void *etat) {
+  struct EtatPopulation *e = (struct EtatPopulation *)etat;
+  jouerTourParametres(e->population, &e->parametres, &e->aleatoire);
+}
+
+static struct Statistique statistiqueParametres(const void *etat) {
+  return getStatistique(((const struct EtatPopulation *)etat)->population);
+}
+
+static const struct Population *populationEtat(const void *etat) {
+  return ((const struct EtatPopulation *)etat)->population;
+}
+
+static void detruireEtatPopulation(void *etat) {
+  detruirePopulation(((struct EtatPopulation *)etat)->population);
+  free(etat);
+}
+
+/**
+ * @brief Etat de la référence : la quarantaine y garde un décompte par case
+ * (voir reference.c).
+ */
+struct EtatReference {
+  struct EtatPopulation population;
+  int *duree_quarantaine;
+};
+
+static void *creerEtatReference(const struct Parametres *parametres,
+                                unsigned long cote, unsigned long x,
+                                unsigned long y, unsigned long graine) {
+  struct EtatReference *etat =
+      (struct EtatReference *)malloc(sizeof(struct EtatReference));
+  struct EtatPopulation *population =
+      creerEtatPopulation(parametres, cote, x, y, graine);
+  etat->population = *population;
+  free(population);
+  etat->duree_quarantaine = (int *)calloc(cote * cote, sizeof(int));
+  return etat;
+}
+
+static void jouerReference(void *etat) {
+  struct EtatReference *e = (struct EtatReference *)etat;
+  jouerTourReference(e->population.population, e->duree_quarantaine,
+                     &e->population.parametres, &e->population.aleatoire);
+}
+
+static struct Statistique statistiqueReference(const void *etat) {
+  return getStatistiqueReference(
+      ((const struct EtatReference *)etat)->population.population);
+}
+
+static const struct Population *populationReference(const void *etat) {
+  return ((const struct EtatReference *)etat)->population.population;
+}
+
+/**
+ * @brief Tours de quarantaine restants de la case k de la référence.
+ */
+static unsigned long quarantaineReference(const void *etat, unsigned long k) {
+  return (unsigned long)((const struct EtatReference *)etat)
+      ->duree_quarantaine[k];
+}
+
+static void detruireEtatReference(void *etat) {
+  struct EtatReference *e = (struct EtatReference *)etat;
+  detruirePopulation(e->population.population);
+  free(e->duree_quarantaine);
+  free(e);
+}
+
+static void *creerEtatSimulation(const struct Parametres *parametres,
+                                 unsigned long cote, unsigned long x,
+                                 unsigned long y, unsigned long graine) {
+  struct Population *population = creerPopulation(cote);
+  patient_zero(population, x, y);
+  return creerSimulation(parametres, population, graine);
+}
+
+static void jouerSimulation(void *etat) {
+  avancerSimulation((struct Simulation *)etat, 1);
+}
+
+static struct Statistique statistiqueSimulation(const void *etat) {
+  return getSerieSimulation((const struct Simulation *)etat)->derniere;
+}
+
+static const struct Population *populationSimulation(const void *etat) {
+  return getPopulationSimulation((const struct Simulation *)etat);
+}
+
+static void detruireEtatSimulation(void *etat) {
+  detruireSimulation((struct Simulation *)etat);
+}
+
+static void *creerEtatTransition(const struct Parametres *parametres,
+                                 unsigned long cote, unsigned long x,
+                                 unsigned long y, unsigned long graine) {
+  struct Simulation *simulation =
+      creerEtatSimulation(parametres, cote, x, y, graine);
+  activerTransitionsSimulation(simulation);
+  return simulation;
+}
+
+/**
+ * @brief Etat du moteur en plans de bits, jouerTourParametres si la
+ * quarantaine est active.
+ */
+struct EtatBitboard {
+  struct EtatPopulation population;
+  struct Bitboard *bitboard;
+};
+
+static void *creerEtatBitboard(const struct Parametres *parametres,
+                               unsigned long cote, unsigned long x,
+                               unsigned long y, unsigned long graine) {
+  struct EtatBitboard *etat =
+      (struct EtatBitboard *)malloc(sizeof(struct EtatBitboard));
+  struct EtatPopulation *population =
+      creerEtatPopulation(parametres, cote, x, y, graine);
+  etat->population = *population;
+  free(population);
+  etat->bitboard = creerBitboard(etat->population.population, parametres);
+  return etat;
+}
+
+static void jouerBitboard(void *etat) {
+  struct EtatBitboard *e = (struct EtatBitboard *)etat;
+  if (e->bitboard)
+    jouerTourBitboard(e->bitboard, &e->population.aleatoire);
+  else
+    jouerParametres(&e->population);
+}
+
+static struct Statistique statistiqueBitboard(const void *etat) {
+  const struct EtatBitboard *e = (const struct EtatBitboard *)etat;
+  return e->bitboard ? getStatistiqueBitboard(e->bitboard)
+                     : getStatistique(e->population.population);
+}
+
+static void detruireEtatBitboard(void *etat) {
+  struct EtatBitboard *e = (struct EtatBitboard *)etat;
+  if (e->bitboard) detruireBitboard(e->bitboard);
+  detruirePopulation(e->population.population);
+  free(e);
+}
+
+/**
+ * @brief Scénario par défaut sans quarantaine, chronométré pour le
+ * bitboard.
+ */
+static const struct Parametres SANS_QUARANTAINE = {
+    .beta = 0.5,
+    .gamma = 0.1,
+    .lambda = 1.0,
+    .chance_quarantaine = 0.0,
+    .chance_decouverte_vaccin = 0.001,
+    .duree_incube = 4,
+    .cordon_sanitaire = 1,
+    .duree_quarantaine = 20};
+
+/**
+ * @brief Moteur à compteurs de voisins, noyau si la découverte du vaccin est
+ * active.
+ */
+static void *creerEtatVoisinage(const struct Parametres *parametres,
+                                unsigned long cote, unsigned long x,
+                                unsigned long y, unsigned long graine) {
+  struct Simulation *simulation =
+      creerEtatSimulation(parametres, cote, x, y, graine);
+  activerVoisinageSimulation(simulation);
+  return simulation;
+}
+
+/**
+ * @brief Scénario par défaut sans découverte du vaccin, chronométré pour le
+ * voisinage.
+ */
+static const struct Parametres SANS_DECOUVERTE_VACCIN = {
+    .beta = 0.5,
+    .gamma = 0.1,
+    .lambda = 1.0,
+    .chance_quarantaine = 0.1,
+    .chance_decouverte_vaccin = 0.0,
+    .duree_incube = 4,
+    .cordon_sanitaire = 1,
+    .duree_quarantaine = 20};
+
+/**
+ * @brief Taille des blocs du moteur multi-échelle.
+ */
+#define TAILLE_BLOC 8
+
+static void *creerEtatMultiechelle(const struct Parametres *parametres,
+                                   unsigned long cote, unsigned long x,
+                                   unsigned long y, unsigned long graine) {
+  struct Multiechelle *multiechelle =
+      creerMultiechelle(parametres, cote, TAILLE_BLOC, graine);
+  infecterMultiechelle(multiechelle, x, y);
+  return multiechelle;
+}
+
+static void jouerMultiechelle(void *etat) {
+  jouerTourMultiechelle((struct Multiechelle *)etat);
+}
+
+static struct Statistique statistiqueMultiechelle(const void *etat) {
+  return getStatistiqueMultiechelle((const struct Multiechelle *)etat);
+}
+
+static void detruireEtatMultiechelle(void *etat) {
+  detruireMultiechelle((struct Multiechelle *)etat);
+}
+
+/**
+ * @brief Fichier de grille du moteur hors mémoire.
+ */
+#define FICHIER_HORS_MEMOIRE "equivalence_test.bin"
+
+/**
+ * @brief Etat du moteur hors mémoire, grille convertie en Personne pour la
+ * comparaison.
+ */
+struct EtatHorsMemoire {
+  struct HorsMemoire *hors_memoire;
+  struct Aleatoire aleatoire;
+  struct Population *population;
+};
+
+/**
+ * @brief Vrai sans quarantaine : les moteurs hors mémoire et à agents la
+ * bornent à la boîte du cordon, sans suivre les chaînes de MALADE (voir
+ * hors_memoire.c, agents.c).
+ */
+static char sansQuarantaine(const struct Parametres *parametres) {
+  return parametres->chance_quarantaine == 0.0;
+}
+
+static void *creerEtatHorsMemoire(const struct Parametres *parametres,
+                                  unsigned long cote, unsigned long x,
+                                  unsigned long y, unsigned long graine) {
+  struct EtatHorsMemoire *etat =
+      (struct EtatHorsMemoire *)malloc(sizeof(struct EtatHorsMemoire));
+  // Bandes de 8 lignes : préchargement et pages rendues en cours de tour
+  etat->hors_memoire =
+      creerHorsMemoire(FICHIER_HORS_MEMOIRE, cote, parametres,
+                       8 * 2 * cote * sizeof(struct CaseDisque));
+  assert(etat->hors_memoire);
+  infecterHorsMemoire(etat->hors_memoire, x, y);
+  initAleatoire(&etat->aleatoire, graine);
+  etat->population = creerPopulation(cote);
+  return etat;
+}
+
+static void jouerHorsMemoire(void *etat) {
+  struct EtatHorsMemoire *e = (struct EtatHorsMemoire *)etat;
+  jouerTourHorsMemoire(e->hors_memoire, &e->aleatoire);
+}
+
+static struct Statistique statistiqueHorsMemoire(const void *etat) {
+  return getStatistiqueHorsMemoire(
+      ((const struct EtatHorsMemoire *)etat)->hors_memoire);
+}
+
+/**
+ * @brief Grille convertie, zone libre partout (comparée sans quarantaine
+ * seulement).
+ */
+static const struct Population *populationHorsMemoire(const void *etat) {
+  const struct EtatHorsMemoire *e = (const struct EtatHorsMemoire *)etat;
+  const struct CaseDisque *grille = getGrilleHorsMemoire(e->hors_memoire);
+  for (unsigned long k = 0; k < e->hors_memoire->cote * e->hors_memoire->cote;
+       k++) {
+    e->population->personnes[k].state = (enum State)grille[k].state;
+    e->population->personnes[k].duree_incube = grille[k].duree_incube;
+  }
+  return e->population;
+}
+
+static void detruireEtatHorsMemoire(void *etat) {
+  struct EtatHorsMemoire *e = (struct EtatHorsMemoire *)etat;
+  detruireHorsMemoire(e->hors_memoire);
+  remove(FICHIER_HORS_MEMOIRE);
+  detruirePopulation(e->population);
+  free(e);
+}
+
+/**
+ * @brief Threads des moteurs parallèles.
+ */
+#define NB_THREADS 4
+
+/**
+ * @brief Une seule classe, de paramètres ceux du scénario.
+ */
+static void *creerEtatClasses(const struct Parametres *parametres,
+                              unsigned long cote, unsigned long x,
+                              unsigned long y, unsigned long graine) {
+  struct Simulation *simulation =
+      creerEtatSimulation(parametres, cote, x, y, graine);
+  const struct ParametresClasse valeur = {parametres->beta, parametres->gamma,
+                                          parametres->lambda};
+  uint8_t *carte = (uint8_t *)calloc(cote * cote, sizeof(uint8_t));
+  assert(!activerClassesSimulation(simulation, &valeur, 1, carte));
+  return simulation;
+}
+
+/**
+ * @brief Agents immobiles.
+ */
+static void *creerEtatAgents(const struct Parametres *parametres,
+                             unsigned long cote, unsigned long x,
+                             unsigned long y, unsigned long graine) {
+  struct Simulation *simulation =
+      creerEtatSimulation(parametres, cote, x, y, graine);
+  const struct ParametresAgents immobiles = {MOBILITE_MARCHE, 0.0, 0, 2};
+  assert(!activerAgentsSimulation(simulation, &immobiles, NB_THREADS));
+  return simulation;
+}
+
+/**
+ * @brief Une seule souche, de paramètres ceux du scénario, portée par le
+ * patient zero.
+ */
+static void *creerEtatSouches(const struct Parametres *parametres,
+                              unsigned long cote, unsigned long x,
+                              unsigned long y, unsigned long graine) {
+  struct Simulation *simulation =
+      creerEtatSimulation(parametres, cote, x, y, graine);
+  const struct ParametresSouche valeur = {parametres->beta, parametres->gamma,
+                                          parametres->lambda, 1.0};
+  assert(!activerSouchesSimulation(simulation, &valeur, 1, NULL, 0));
+  return simulation;
+}
+
+/**
+ * @brief Plans de bits en bandes parallèles, jouerTourParametres si la
+ * quarantaine est active. Joué directement, comme le bitboard.
+ */
+struct EtatBandes {
+  struct EtatPopulation population;
+  struct Bandes *bandes;
+};
+
+static void *creerEtatBandes(const struct Parametres *parametres,
+                             unsigned long cote, unsigned long x,
+                             unsigned long y, unsigned long graine) {
+  struct EtatBandes *etat =
+      (struct EtatBandes *)malloc(sizeof(struct EtatBandes));
+  struct EtatPopulation *population =
+      creerEtatPopulation(parametres, cote, x, y, graine);
+  etat->population = *population;
+  free(population);
+  etat->bandes = creerBandes(etat->population.population, parametres,
+                             NB_THREADS, 0, graine);
+  return etat;
+}
+
+static void jouerBandes(void *etat) {
+  struct EtatBandes *e = (struct EtatBandes *)etat;
+  if (e->bandes)
+    jouerTourBandes(e->bandes);
+  else
+    jouerParametres(&e->population);
+}
+
+static struct Statistique statistiqueBandes(const void *etat) {
+  const struct EtatBandes *e = (const struct EtatBandes *)etat;
+  return e->bandes ? getStatistiqueBitboard(e->bandes->bitboard)
+                   : getStatistique(e->population.population);
+}
+
+static void detruireEtatBandes(void *etat) {
+  struct EtatBandes *e = (struct EtatBandes *)etat;
+  if (e->bandes) detruireBandes(e->bandes);
+  detruirePopulation(e->population.population);
+  free(e);
+}
+
+/**
+ * @brief Moteur de référence.
+ */
+static const struct Moteur REFERENCE = {
+    "reference",          1, 0, NULL, creerEtatReference, jouerReference,
+    statistiqueReference, populationReference,    detruireEtatReference,
+    NULL};
+
+/**
+ * @brief Moteurs comparés à la référence.
+ */
+static const struct Moteur MOTEURS[] = {
+    {"jouerTourParametres", 1, 0, NULL, creerEtatPopulation, jouerParametres,
+     statistiqueParametres, populationEtat, detruireEtatPopulation, NULL},
+    {"simulation", 1, 0, NULL, creerEtatSimulation, jouerSimulation,
+     statistiqueSimulation, populationSimulation, detruireEtatSimulation, NULL},
+    {"multiechelle", 0, 1, NULL, creerEtatMultiechelle, jouerMultiechelle,
+     statistiqueMultiechelle, NULL, detruireEtatMultiechelle, NULL},
+    {"transition", 0, 0, NULL, creerEtatTransition, jouerSimulation,
+     statistiqueSimulation, populationSimulation, detruireEtatSimulation, NULL},
+    {"bitboard", 0, 0, NULL, creerEtatBitboard, jouerBitboard,
+     statistiqueBitboard, NULL, detruireEtatBitboard, &SANS_QUARANTAINE},
+    {"voisinage", 1, 0, NULL, creerEtatVoisinage, jouerSimulation,
+     statistiqueSimulation, populationSimulation, detruireEtatSimulation,
+     &SANS_DECOUVERTE_VACCIN},
+    {"hors_memoire", 1, 0, sansQuarantaine, creerEtatHorsMemoire,
+     jouerHorsMemoire, statistiqueHorsMemoire, populationHorsMemoire,
+     detruireEtatHorsMemoire, NULL},
+    {"classes", 0, 0, NULL, creerEtatClasses, jouerSimulation,
+     statistiqueSimulation, populationSimulation, detruireEtatSimulation, NULL},
+    {"agents", 0, 0, sansQuarantaine, creerEtatAgents, jouerSimulation,
+     statistiqueSimulation, populationSimulation, detruireEtatSimulation, NULL},
+    {"souches", 0, 0, NULL, creerEtatSouches, jouerSimulation,
+     statistiqueSimulation, populationSimulation, detruireEtatSimulation, NULL},
+    {"bandes", 0, 0, NULL, creerEtatBandes, jouerBandes, statistiqueBandes,
+     NULL, detruireEtatBandes, &SANS_QUARANTAINE}};
+
+/**
+ * @brief Nombre de moteurs comparés.
+ */
+#define NB_MOTEURS (sizeof(MOTEURS) / sizeof(MOTEURS[0]))
+
+/**
+ * @brief Scénarios : un par variante du noyau (quarantaine, vaccin,
+ * incubation), le premier étant celui par défaut.
+ */
+static const struct Parametres SCENARIOS[] = {
+    {.beta = 0.5,
+     .gamma = 0.1,
+     .lambda = 1.0,
+     .chance_quarantaine = 0.1,
+     .chance_decouverte_vaccin = 0.001,
+     .duree_incube = 4,
+     .cordon_sanitaire = 1,
+     .duree_quarantaine = 20},
+    {.beta = 0.2,
+     .gamma = 0.1,
+     .lambda = 0.5,
+     .chance_quarantaine = 0.3,
+     .chance_decouverte_vaccin = 0.0,
+     .duree_incube = 2,
+     .cordon_sanitaire = 2,
+     .duree_quarantaine = 5},
+    {.beta = 0.1,
+     .gamma = 0.3,
+     .lambda = 0.6,
+     .chance_quarantaine = 0.0,
+     .chance_decouverte_vaccin = 0.01,
+     .duree_incube = 0,
+     .cordon_sanitaire = 0,
+     .duree_quarantaine = 0},
+    {.beta = 0.2,
+     .gamma = 0.2,
+     .lambda = 0.5,
+     .chance_quarantaine = 0.0,
+     .chance_decouverte_vaccin = 0.0,
+     .duree_incube = 0,
+     .cordon_sanitaire = 0,
+     .duree_quarantaine = 0},
+    {.beta = 0.1,
+     .gamma = 0.1,
+     .lambda = 0.4,
+     .chance_quarantaine = 0.0,
+     .chance_decouverte_vaccin = 0.0,
+     .duree_incube = 3,
+     .cordon_sanitaire = 0,
+     .duree_quarantaine = 0},
+    {.beta = 0.3,
+     .gamma = 0.1,
+     .lambda = 0.8,
+     .chance_quarantaine = 0.2,
+     .chance_decouverte_vaccin = 0.0,
+     .duree_incube = 0,
+     .cordon_sanitaire = 1,
+     .duree_quarantaine = 10},
+    {.beta = 0.3,
+     .gamma = 0.1,
+     .lambda = 0.8,
+     .chance_quarantaine = 0.2,
+     .chance_decouverte_vaccin = 0.005,
+     .duree_incube = 0,
+     .cordon_sanitaire = 3,
+     .duree_quarantaine = 10},
+    {.beta = 0.2,
+     .gamma = 0.1,
+     .lambda = 0.5,
+     .chance_quarantaine = 0.0,
+     .chance_decouverte_vaccin = 0.02,
+     .duree_incube = 2,
+     .cordon_sanitaire = 0,
+     .duree_quarantaine = 0}};
+
+/**
+ * @brief Nombre de scénarios.
+ */
+#define NB_SCENARIOS (sizeof(SCENARIOS) / sizeof(SCENARIOS[0]))
+
+/**
+ * @brief Scénarios comparés en loi aux moteurs approchés (les moteurs
+ * stochastiques exacts en loi le sont sur tous les scénarios).
+ *
+ * multiechelle approche la quarantaine et le vaccin (voir multiechelle.c),
+ * hors_memoire et agents la quarantaine : avec 60 réplicats, seul un écart
+ * grossier est détecté, et seulement sur les trois premiers scénarios.
+ */
+#define NB_SCENARIOS_STOCHASTIQUES 3
+
+/**
+ * @brief Côté de la grille des tests d'équivalence.
+ */
+#define COTE 32
+
+/**
+ * @brief Tours max d'une simulation.
+ */
+#define TOURS_MAX 300
+
+/**
+ * @brief Nombre de réplicats par loi comparée.
+ */
+#define NB_REPLICATS 60
+
+/**
+ * @brief c(alpha) du test de Kolmogorov-Smirnov, alpha = 0.001.
+ */
+#define C_ALPHA_KS 1.949
+
+/**
+ * @brief Vrai si le moteur est approché sur le scénario s : comparé en loi
+ * sur les premiers scénarios seulement.
+ */
+static int approcheSur(const struct Moteur *moteur, unsigned long s) {
+  return moteur->approche || (moteur->exact && !moteur->exact(&SCENARIOS[s]));
+}
+
+/**
+ * @brief Vrai si l'épidémie est terminée.
+ */
+static int eteinte(struct Statistique stats) {
+  return !stats.nb_MALADE && !stats.nb_INCUBE;
+}
+
+/**
+ * @brief Compare un moteur déterministe à la référence, tour par tour.
+ *
+ * @return unsigned long Nombre de tours comparés.
+ */
+static unsigned long comparerExactement(const struct Moteur *moteur,
+                                        const struct Parametres *parametres,
+                                        unsigned long graine) {
+  void *reference = REFERENCE.creer(parametres, COTE, COTE / 2, COTE / 3,
+                                    graine);
+  void *etat = moteur->creer(parametres, COTE, COTE / 2, COTE / 3, graine);
+  unsigned long tour = 0;
+  for (;;) {
+    struct Statistique attendu = REFERENCE.statistique(reference);
+    struct Statistique obtenu = moteur->statistique(etat);
+    assert(!memcmp(&attendu, &obtenu, sizeof(struct Statistique)));
+    if (moteur->population)
+      for (unsigned long k = 0; k < COTE * COTE; k++) {
+        const struct Personne *a =
+            &REFERENCE.population(reference)->personnes[k];
+        const struct Population *population = moteur->population(etat);
+        const struct Personne *b = &population->personnes[k];
+        assert(a->state == b->state && a->duree_incube == b->duree_incube &&
+               quarantaineReference(reference, k) ==
+                   getDureeQuarantaine(population, b));
+      }
+    if (eteinte(attendu) || tour == TOURS_MAX) break;
+    REFERENCE.jouer(reference);
+    moteur->jouer(etat);
+    tour++;
+  }
+  REFERENCE.detruire(reference);
+  moteur->detruire(etat);
+  return tour;
+}
+
+/**
+ * @brief Statistique finale d'une simulation complète.
+ */
+static struct Statistique simulerJusquaFin(const struct Moteur *moteur,
+                                           const struct Parametres *parametres,
+                                           unsigned long graine) {
+  void *etat = moteur->creer(parametres, COTE, COTE / 2, COTE / 3, graine);
+  struct Statistique stats = moteur->statistique(etat);
+  for (unsigned long tour = 0; tour < TOURS_MAX && !eteinte(stats); tour++) {
+    moteur->jouer(etat);
+    stats = moteur->statistique(etat);
+  }
+  moteur->detruire(etat);
+  return stats;
+}
+
+static int comparerDouble(const void *a, const void *b) {
+  const double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Statistique D de Kolmogorov-Smirnov à deux échantillons.
+ *
+ * @param a Echantillon (trié en place).
+ * @param n Taille de a.
+ * @param b Echantillon (trié en place).
+ * @param m Taille de b.
+ * @return double sup |Fa - Fb|.
+ */
+static double statistiqueKS(double *a, unsigned long n, double *b,
+                            unsigned long m) {
+  qsort(a, n, sizeof(double), comparerDouble);
+  qsort(b, m, sizeof(double), comparerDouble);
+  unsigned long i = 0, j = 0;
+  double d = 0;
+  while (i < n && j < m) {
+    const double x = a[i] < b[j] ? a[i] : b[j];
+    while (i < n && a[i] <= x) i++;
+    while (j < m && b[j] <= x) j++;
+    const double ecart = fabs((double)i / n - (double)j / m);
+    if (ecart > d) d = ecart;
+  }
+  return d;
+}
+
+/**
+ * @brief Vrai si les Statistique finales de deux moteurs ont même loi.
+ *
+ * Test KS sur MORT, IMMUNISE, VACCINE et SAIN finaux.
+ */
+static int memeLoi(const struct Moteur *moteur_a,
+                   const struct Parametres *parametres_a,
+                   const struct Moteur *moteur_b,
+                   const struct Parametres *parametres_b) {
+  const size_t colonnes[4] = {offsetof(struct Statistique, nb_MORT),
+                              offsetof(struct Statistique, nb_IMMUNISE),
+                              offsetof(struct Statistique, nb_VACCINE),
+                              offsetof(struct Statistique, nb_SAIN)};
+  struct Statistique finales_a[NB_REPLICATS], finales_b[NB_REPLICATS];
+  for (unsigned long r = 0; r < NB_REPLICATS; r++) {
+    finales_a[r] = simulerJusquaFin(moteur_a, parametres_a, r + 1);
+    finales_b[r] = simulerJusquaFin(moteur_b, parametres_b, r + 1001);
+  }
+  const double seuil =
+      C_ALPHA_KS * sqrt(2.0 * NB_REPLICATS / (NB_REPLICATS * NB_REPLICATS));
+  for (int c = 0; c < 4; c++) {
+    double a[NB_REPLICATS], b[NB_REPLICATS];
+    for (unsigned long r = 0; r < NB_REPLICATS; r++) {
+      a[r] = (double)*(const long *)((const char *)&finales_a[r] + colonnes[c]);
+      b[r] = (double)*(const long *)((const char *)&finales_b[r] + colonnes[c]);
+    }
+    if (statistiqueKS(a, NB_REPLICATS, b, NB_REPLICATS) > seuil) return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Durée (s) d'un essai : 60 tours sur une grille 256.
+ */
+static double chronometrer(const struct Moteur *moteur,
+                           const struct Parametres *parametres) {
+  void *etat = moteur->creer(parametres, 256, 128, 128, 42);
+  struct timespec debut, fin;
+  clock_gettime(CLOCK_MONOTONIC, &debut);
+  for (int tour = 0; tour < 60; tour++) {
+    moteur->jouer(etat);
+    moteur->statistique(etat);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &fin);
+  moteur->detruire(etat);
+  return (double)(fin.tv_sec - debut.tv_sec) +
+         (double)(fin.tv_nsec - debut.tv_nsec) * 1e-9;
+}
+
+/**
+ * @brief Vitesse relative à la référence : médiane de 5 rapports, la
+ * référence chronométrée juste avant le moteur à chaque essai pour que la
+ * charge de la machine touche les deux.
+ */
+static double vitesseRelative(const struct Moteur *moteur,
+                              const struct Parametres *parametres) {
+  double rapports[5];
+  for (int essai = 0; essai < 5; essai++)
+    rapports[essai] = chronometrer(&REFERENCE, parametres) /
+                      chronometrer(moteur, parametres);
+  // Tri par insertion des 5 rapports
+  for (int i = 1; i < 5; i++)
+    for (int j = i; j > 0 && rapports[j] < rapports[j - 1]; j--) {
+      const double rapport = rapports[j];
+      rapports[j] = rapports[j - 1];
+      rapports[j - 1] = rapport;
+    }
+  return rapports[2];
+}
+
+/**
+ * @brief Vitesse de référence d'un moteur dans le fichier, -1 si absente.
+ */
+static double lireVitesseReference(const char *fichier, const char *nom) {
+  FILE *file = fopen(fichier, "r");
+  if (!file) return -1;
+  char ligne[256], cle[128];
+  double vitesse, trouvee = -1;
+  while (fgets(ligne, sizeof(ligne), file))
+    if (ligne[0] != '#' && sscanf(ligne, "%127s %lf", cle, &vitesse) == 2 &&
+        !strcmp(cle, nom))
+      trouvee = vitesse;
+  fclose(file);
+  return trouvee;
+}
+
+/**
+ * @brief Compare la vitesse de chaque moteur, relative à la référence, au
+ * fichier de référence (make performance).
+ *
+ * @return int Exit 0.
+ */
+static int verifierPerformance(void) {
+  printf("equivalence_test --performance:\n");
+  printf("  Performance (vitesse relative à la référence):\n");
+  const char *fichier = getenv("EPIDEMIE_PERFORMANCE");
+  if (!fichier) fichier = "tests/performance_reference.txt";
+  const char *tolerance_env = getenv("EPIDEMIE_TOLERANCE");
+  const double tolerance = tolerance_env ? atof(tolerance_env) : 30.0;
+  const char *ecrire = getenv("EPIDEMIE_ECRIRE_PERFORMANCE");
+  FILE *sortie = NULL;
+  if (ecrire && !strcmp(ecrire, "1")) {
+    sortie = fopen(fichier, "w");
+    assert(sortie);
+    fprintf(sortie, "# moteur vitesse_relative (reference = 1)\n");
+  }
+  int lent = 0;
+  for (unsigned long m = 0; m < NB_MOTEURS; m++) {
+    const struct Parametres *scenario =
+        MOTEURS[m].chronometre ? MOTEURS[m].chronometre : &SCENARIOS[0];
+    const double vitesse = vitesseRelative(&MOTEURS[m], scenario);
+    const double attendue = lireVitesseReference(fichier, MOTEURS[m].nom);
+    if (sortie) fprintf(sortie, "%s %.3f\n", MOTEURS[m].nom, vitesse);
+    if (sortie || attendue < 0) {
+      printf("    %s: x%.2f (pas de référence)\n", MOTEURS[m].nom, vitesse);
+    } else if (vitesse < attendue * (1 - tolerance / 100)) {
+      printf("    %s: x%.2f au lieu de x%.2f (-%.0f %% max): "
+             "\x1B[31mLENT\x1B[0m\n",
+             MOTEURS[m].nom, vitesse, attendue, tolerance);
+      lent = 1;
+    } else {
+      printf("    %s: x%.2f (référence x%.2f): \x1B[32mOK\x1B[0m\n",
+             MOTEURS[m].nom, vitesse, attendue);
+    }
+  }
+  if (sortie) fclose(sortie);
+  assert(!lent);
+  return 0;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @param argc Nombre d'arguments.
+ * @param argv --performance pour ne mesurer que la vitesse.
+ * @return int Exit 0.
+ */
+int main(int argc, char *argv[]) {
+  if (argc > 1 && !strcmp(argv[1], "--performance"))
+    return verifierPerformance();
+  printf("equivalence_test:\n");
+  printf("  Moteurs déterministes (identiques à chaque tour):\n");
+  for (unsigned long m = 0; m < NB_MOTEURS; m++) {
+    if (!MOTEURS[m].deterministe) continue;
+    unsigned long tours = 0, en_loi = 0;
+    for (unsigned long s = 0; s < NB_SCENARIOS; s++) {
+      if (approcheSur(&MOTEURS[m], s)) {
+        if (s >= NB_SCENARIOS_STOCHASTIQUES) continue;
+        assert(memeLoi(&REFERENCE, &SCENARIOS[s], &MOTEURS[m], &SCENARIOS[s]));
+        en_loi++;
+        continue;
+      }
+      for (unsigned long graine = 1; graine <= 5; graine++)
+        tours += comparerExactement(&MOTEURS[m], &SCENARIOS[s], graine);
+    }
+    if (en_loi)
+      printf("    %s (%lu tours, %lu scénarios en loi): \x1B[32mOK\x1B[0m\n",
+             MOTEURS[m].nom, tours, en_loi);
+    else
+      printf("    %s (%lu tours): \x1B[32mOK\x1B[0m\n", MOTEURS[m].nom,
+             tours);
+  }
+
+  printf("  Moteurs stochastiques (KS, alpha = 0.001):\n");
+  struct Parametres contagion_faible = SCENARIOS[0];
+  contagion_faible.lambda = 0.3;
+  assert(memeLoi(&REFERENCE, &SCENARIOS[0], &REFERENCE, &SCENARIOS[0]));
+  assert(!memeLoi(&REFERENCE, &SCENARIOS[0], &REFERENCE, &contagion_faible));
+  printf("    Le test distingue lambda = 1 de lambda = 0.3: "
+         "\x1B[32mOK\x1B[0m\n");
+  for (unsigned long m = 0; m < NB_MOTEURS; m++) {
+    if (MOTEURS[m].deterministe) continue;
+    unsigned long nb_scenarios = 0;
+    for (unsigned long s = 0; s < NB_SCENARIOS; s++) {
+      if (approcheSur(&MOTEURS[m], s) && s >= NB_SCENARIOS_STOCHASTIQUES)
+        continue;
+      assert(memeLoi(&REFERENCE, &SCENARIOS[s], &MOTEURS[m], &SCENARIOS[s]));
+      nb_scenarios++;
+    }
+    printf("    %s (%lu scénarios): \x1B[32mOK\x1B[0m\n", MOTEURS[m].nom,
+           nb_scenarios);
+  }
+
+  return 0;
+}
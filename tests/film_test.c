@@ -0,0 +1,108 @@
+/**
+ * @file film_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur l'export d'images.
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/film.h"
+
+/**
+ * @brief Lit un fichier entier.
+ *
+ * @param fichier Nom du fichier.
+ * @param taille Taille lue.
+ * @return unsigned char* Contenu, à libérer.
+ */
+static unsigned char *lireFichier(const char *fichier, long *taille) {
+  FILE *file = fopen(fichier, "rb");
+  fseek(file, 0, SEEK_END);
+  *taille = ftell(file);
+  rewind(file);
+  unsigned char *octets = (unsigned char *)malloc((size_t)*taille + 1);
+  assert(fread(octets, 1, (size_t)*taille, file) == (size_t)*taille);
+  fclose(file);
+  return octets;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  printf("film_test:\n");
+  printf("  creerFilm:\n");
+  assert(!creerFilm("film_test.ppm", IMAGE_PPM, 7, 0, 1, 1));
+  assert(!creerFilm("film_test.ppm", IMAGE_PPM, 7, 1, 0, 1));
+  assert(!creerFilm("film_test.ppm", IMAGE_PPM, 7, 1, 1, 0));
+  assert(!creerFilm("/dossier/absent/film.ppm", IMAGE_PPM, 7, 1, 1, 1));
+  printf("    Paramètres invalides: \x1B[32mOK\x1B[0m\n");
+
+  printf("  ajouterImageFilm (PPM):\n");
+  struct Population *population = creerPopulation(7);
+  patient_zero(population, 0, 1);
+  population->grille_de_personnes[0][2].zone = creerZone(population, 3);
+  struct Film *film = creerFilm("film_test.ppm", IMAGE_PPM, 7, 1, 2, 3);
+  assert(film);
+  assert(film->taille_image == 11 + 3 * 7 * 7);
+  for (int tour = 0; tour <= 4; tour++)
+    assert(ajouterImageFilm(film, population) == (tour % 2 ? 0 : 1));
+  assert(ajouterImageFilm(film, population) == 0);
+  assert(ajouterImageFilm(film, population) == -1);
+  assert(film->nb_images == 3);
+  printf("    Une image tous les 2 tours, film plein: \x1B[32mOK\x1B[0m\n");
+  assert(!fermerFilm(film));
+  long taille;
+  unsigned char *octets = lireFichier("film_test.ppm", &taille);
+  assert(taille == 3 * (11 + 3 * 7 * 7));
+  assert(!memcmp(octets, "P6\n7 7\n255\n", 11));
+  assert(!memcmp(octets + 11 + 3 * 7 * 7, "P6\n7 7\n255\n", 11));
+  const unsigned char *pixels = octets + 11;
+  assert(pixels[0] == 220 && pixels[1] == 220 && pixels[2] == 220);  // SAIN
+  assert(pixels[3] == 205 && pixels[4] == 0 && pixels[5] == 0);  // MALADE
+  assert(pixels[6] == 110 && pixels[7] == 212 && pixels[8] == 110);
+  printf("    Couleurs du terminal, quarantaine en vert: \x1B[32mOK\x1B[0m\n");
+  free(octets);
+
+  printf("  fermerFilm:\n");
+  film = creerFilm("film_test.ppm", IMAGE_PPM, 7, 1, 1, 10);
+  ajouterImageFilm(film, population);
+  assert(!fermerFilm(film));
+  octets = lireFichier("film_test.ppm", &taille);
+  assert(taille == 11 + 3 * 7 * 7);
+  free(octets);
+  printf("    Fichier réduit aux images écrites: \x1B[32mOK\x1B[0m\n");
+
+  printf("  ajouterImageFilm (PGM réduit):\n");
+  detruirePopulation(population);
+  population = creerPopulation(5);
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 2; j++)
+      population->grille_de_personnes[i][j].state = MORT;
+  population->grille_de_personnes[4][3].state = MORT;
+  film = creerFilm("film_test.pgm", IMAGE_PGM, 5, 2, 1, 1);
+  assert(film->largeur == 3);
+  assert(ajouterImageFilm(film, population) == 1);
+  assert(!fermerFilm(film));
+  octets = lireFichier("film_test.pgm", &taille);
+  assert(taille == 11 + 3 * 3);
+  assert(!memcmp(octets, "P5\n3 3\n255\n", 11));
+  pixels = octets + 11;
+  assert(pixels[0] == 0);    // Bloc 2x2 MORT
+  assert(pixels[1] == 220);  // Bloc 2x2 SAIN
+  assert(pixels[7] == 110);  // Bloc 1x2 : un MORT, un SAIN
+  assert(pixels[8] == 220);  // Bloc 1x1 SAIN
+  free(octets);
+  printf("    Moyenne par bloc, bords incomplets: \x1B[32mOK\x1B[0m\n");
+
+  detruirePopulation(population);
+  return 0;
+}
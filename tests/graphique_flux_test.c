@@ -0,0 +1,70 @@
+/**
+ * @file graphique_flux_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur le graphique incrémental.
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/graphique_flux.h"
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  printf("graphique_flux_test:\n");
+  printf("  creerGraphiqueFlux:\n");
+  struct GraphiqueFlux *graphique = creerGraphiqueFlux(10, 8, 100);
+  assert(graphique->nb_colonnes == 0);
+  assert(graphique->tours_par_colonne == 1);
+  printf("    Graphique vide: \x1B[32mOK\x1B[0m\n");
+
+  printf("  ajouterGraphiqueFlux:\n");
+  struct Statistique stats = {0, 50, 0, 30, 20, 0};  // SAIN, MALADE, INCUBE
+  for (int i = 0; i < 8; i++) ajouterGraphiqueFlux(graphique, stats);
+  assert(graphique->nb_colonnes == 8);
+  assert(graphique->tours_par_colonne == 1);
+  printf("    Une colonne par tour: \x1B[32mOK\x1B[0m\n");
+  ajouterGraphiqueFlux(graphique, stats);
+  assert(graphique->nb_colonnes == 5);
+  assert(graphique->tours_par_colonne == 2);
+  assert(graphique->tours_derniere_colonne == 1);
+  assert(graphique->colonnes[0].nb_SAIN == 100);
+  printf("    Fusion deux à deux au-delà de limite: \x1B[32mOK\x1B[0m\n");
+  for (int i = 0; i < 1000; i++) ajouterGraphiqueFlux(graphique, stats);
+  assert(graphique->nb_colonnes <= 8);
+  long somme = 0;
+  for (unsigned long j = 0; j < graphique->nb_colonnes; j++)
+    somme += graphique->colonnes[j].nb_SAIN;
+  assert(somme == 1009 * 50);
+  printf("    Aucun tour perdu après 1009 tours: \x1B[32mOK\x1B[0m\n");
+
+  printf("  rendreGraphiqueFlux:\n");
+  exporterGraphiqueFlux(graphique, "graphique_flux_test.txt");
+  FILE *file = fopen("graphique_flux_test.txt", "r");
+  char ligne[64];
+  const char attendu[] = ".....ou";  // 5 '.' puis 3 'o' puis 2 'u'
+  for (int i = 0; i < 10; i++) {
+    assert(fgets(ligne, sizeof(ligne), file));
+    assert(strlen(ligne) == 9);
+    char etat = attendu[i < 5 ? 0 : i < 8 ? 5 : 6];
+    for (unsigned long j = 0; j < graphique->nb_colonnes; j++)
+      assert(ligne[j] == etat);
+    for (unsigned long j = graphique->nb_colonnes; j < 8; j++)
+      assert(ligne[j] == ' ');
+  }
+  fclose(file);
+  printf("    Empilement SAIN/MALADE/INCUBE: \x1B[32mOK\x1B[0m\n");
+  rendreGraphiqueFlux(graphique, stdout, 1);
+  printf("    Graphique: \x1B[33mVOIR MANUELLEMENT\x1B[0m\n\n");
+
+  detruireGraphiqueFlux(graphique);
+  return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file hors_memoire_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur le moteur hors mémoire.
+ *
+ * Sans quarantaine, le moteur doit donner exactement la grille de
+ * jouerTourParametres à chaque tour, quelle que soit la taille des bandes ;
+ * avec quarantaine, tant qu'elle tient dans la boîte du cordon.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../src/hors_memoire.h"
+#include "commun.h"
+
+/**
+ * @brief Côté de la grille.
+ */
+#define COTE 70
+
+/**
+ * @brief Tours comparés au noyau.
+ */
+#define TOURS 60
+
+/**
+ * @brief Fichier de grille des tests.
+ */
+#define FICHIER "hors_memoire_test.bin"
+
+/**
+ * @brief Vrai si la grille sur disque égale la population (état,
+ * incubation, quarantaine).
+ */
+static int memesGrilles(const struct CaseDisque *grille,
+                        unsigned long tour,
+                        const struct Population *population) {
+  for (unsigned long k = 0; k < COTE * COTE; k++) {
+    const struct Personne *personne = &population->personnes[k];
+    if (grille[k].state != personne->state ||
+        grille[k].duree_incube != personne->duree_incube ||
+        (grille[k].fin_quarantaine > tour) !=
+            enQuarantaine(population, personne))
+      return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Joue tours tours avec le moteur et avec le noyau, même graine.
+ */
+static void comparer(const struct Parametres *parametres,
+                     const struct Population *initiale,
+                     unsigned long octets_fenetre, int tours) {
+  struct Population *noyau = creerPopulation(COTE);
+  assert(!copierPopulation(noyau, initiale));
+  struct HorsMemoire *hors_memoire =
+      creerHorsMemoire(FICHIER, COTE, parametres, octets_fenetre);
+  assert(hors_memoire && !chargerHorsMemoire(hors_memoire, initiale));
+  struct Aleatoire aleatoire, aleatoire_noyau;
+  initAleatoire(&aleatoire, 3);
+  initAleatoire(&aleatoire_noyau, 3);
+  for (int t = 0; t < tours; t++) {
+    jouerTourHorsMemoire(hors_memoire, &aleatoire);
+    jouerTourParametres(noyau, parametres, &aleatoire_noyau);
+    assert(hors_memoire->tour == noyau->tour);
+    assert(memesGrilles(getGrilleHorsMemoire(hors_memoire),
+                        hors_memoire->tour, noyau));
+    const struct Statistique stats = getStatistiqueHorsMemoire(hors_memoire);
+    const struct Statistique attendues = getStatistique(noyau);
+    assert(!memcmp(&stats, &attendues, sizeof(struct Statistique)));
+  }
+  detruireHorsMemoire(hors_memoire);
+
+  // Le fichier garde le dernier tour, le fichier suivant est supprimé
+  assert(access(FICHIER ".suivant", F_OK));
+  struct CaseDisque grille[COTE * COTE];
+  FILE *file = fopen(FICHIER, "rb");
+  assert(file && fread(grille, sizeof(grille), 1, file) == 1);
+  fclose(file);
+  assert(memesGrilles(grille, noyau->tour, noyau));
+  detruirePopulation(noyau);
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  struct Parametres parametres = {.beta = 0.05,
+                                  .gamma = 0.15,
+                                  .lambda = 0.5,
+                                  .chance_quarantaine = 0,
+                                  .chance_decouverte_vaccin = 0.002,
+                                  .duree_incube = 2,
+                                  .cordon_sanitaire = 2,
+                                  .duree_quarantaine = 3};
+  printf("hors_memoire_test:\n");
+
+  printf("  creerHorsMemoire:\n");
+  struct HorsMemoire *hors_memoire =
+      creerHorsMemoire(FICHIER, COTE, &parametres, 0);
+  const struct CaseDisque *grille = getGrilleHorsMemoire(hors_memoire);
+  for (unsigned long k = 0; k < COTE * COTE; k++)
+    assert(grille[k].state == SAIN && !grille[k].fin_quarantaine);
+  infecterHorsMemoire(hors_memoire, 3, 4);
+  assert(grille[3 * COTE + 4].state == MALADE);
+  assert(getStatistiqueHorsMemoire(hors_memoire).nb_MALADE == 1);
+  assert(getStatistiqueHorsMemoire(hors_memoire).nb_SAIN ==
+         COTE * COTE - 1);
+  detruireHorsMemoire(hors_memoire);
+  printf("    Grille SAIN (fichier creux), patient zero: "
+         "\x1B[32mOK\x1B[0m\n");
+  assert(!creerHorsMemoire("/inexistant/grille.bin", COTE, &parametres, 0));
+  parametres.duree_incube = 70000;
+  assert(!horsMemoireCompatible(&parametres));
+  parametres.duree_incube = 2;
+  printf("    Refusé : fichier impossible, incubation > 16 bits: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  printf("  jouerTourHorsMemoire:\n");
+  struct Population *initiale = creerPopulation(COTE);
+  remplir(initiale, 985, 3);
+  comparer(&parametres, initiale, 0, TOURS);
+  comparer(&parametres, initiale, 7 * COTE * sizeof(struct CaseDisque),
+           TOURS);
+  comparer(&parametres, initiale, 1 << 30, TOURS);
+  printf("    Identique au noyau sans quarantaine, bandes de 1, 3 lignes ou "
+         "toute la grille: \x1B[32mOK\x1B[0m\n");
+
+  // MALADE isolés : chaque quarantaine tient dans la boîte du cordon
+  parametres.chance_quarantaine = 1;
+  parametres.chance_decouverte_vaccin = 0;
+  parametres.lambda = 0;
+  parametres.beta = 0;
+  parametres.gamma = 0;
+  for (unsigned long k = 0; k < COTE * COTE; k++)
+    initiale->personnes[k].state = SAIN;
+  for (unsigned long i = 1; i < COTE; i += 9)
+    for (unsigned long j = 2; j < COTE; j += 8)
+      initiale->grille_de_personnes[i][j].state = MALADE;
+  comparer(&parametres, initiale, 0, 12);
+  printf("    Identique au noyau avec quarantaine, levées comprises: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  // Chaîne de MORT : le noyau la suit jusqu'au bout, le moteur s'arrête au
+  // bord de la boîte du cordon
+  for (unsigned long k = 0; k < COTE * COTE; k++)
+    initiale->personnes[k].state = SAIN;
+  initiale->grille_de_personnes[20][30].state = MALADE;
+  for (unsigned long i = 21; i < 40; i++)
+    initiale->grille_de_personnes[i][30].state = MORT;
+  struct Population *noyau = creerPopulation(COTE);
+  assert(!copierPopulation(noyau, initiale));
+  hors_memoire = creerHorsMemoire(FICHIER, COTE, &parametres, 0);
+  assert(!chargerHorsMemoire(hors_memoire, initiale));
+  struct Aleatoire aleatoire;
+  initAleatoire(&aleatoire, 1);
+  jouerTourHorsMemoire(hors_memoire, &aleatoire);
+  initAleatoire(&aleatoire, 1);
+  jouerTourParametres(noyau, &parametres, &aleatoire);
+  grille = getGrilleHorsMemoire(hors_memoire);
+  for (unsigned long i = 20; i < 40; i++) {
+    assert(enQuarantaine(noyau, &noyau->grille_de_personnes[i][30]));
+    assert((grille[i * COTE + 30].fin_quarantaine > hors_memoire->tour) ==
+           (i <= 22));
+  }
+  detruireHorsMemoire(hors_memoire);
+  detruirePopulation(noyau);
+  unlink(FICHIER);
+  printf("    Quarantaine bornée à la boîte du cordon: \x1B[32mOK\x1B[0m\n");
+  detruirePopulation(initiale);
+  return 0;
+}
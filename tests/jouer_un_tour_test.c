@@ -32,17 +32,180 @@ int main(void) {
   printf("    True: \x1B[32mOK\x1B[0m\n");
   printf("  mettreEnQuarantaine:\n");
   mettreEnQuarantaine(population->grille_de_personnes, 0, 0, population->cote,
-                      5, 5);
+                      5, creerZone(population, 5));
   afficherGrillePopulation(population);
-  assert(population->grille_de_personnes[0][0]->duree_quarantaine);
+  assert(enQuarantaine(population, &population->grille_de_personnes[0][0]));
   printf("    Origin 0 quarantine: \x1B[32mOK\x1B[0m\n");
   for (int i = 1; i <= 5; i++) {
     for (int j = 0; j < i; j++)
-      assert(population->grille_de_personnes[i - j - 1][j]->duree_quarantaine);
+      assert(enQuarantaine(population,
+                           &population->grille_de_personnes[i - j - 1][j]));
     printf("    0 -> Range %i quarantine: \x1B[32mOK\x1B[0m\n", i);
   }
   for (int j = 0; j < 7; j++)
-    assert(!population->grille_de_personnes[6 - j][j]->duree_quarantaine);
-  printf("    0 -> Range 6 not quarantine: \x1B[32mOK\x1B[0m\n\n");
+    assert(!enQuarantaine(population,
+                          &population->grille_de_personnes[6 - j][j]));
+  printf("    0 -> Range 6 not quarantine: \x1B[32mOK\x1B[0m\n");
+  // Seconde zone recouvrant la diagonale 4 de la première (cordon 1) : les
+  // marques de la première ne l'arrêtent pas
+  population->grille_de_personnes[6][6].state = MALADE;
+  const uint32_t seconde = creerZone(population, 9);
+  mettreEnQuarantaine(population->grille_de_personnes, 6, 6, population->cote,
+                      8, seconde);
+  for (int j = 0; j <= 4; j++)
+    assert(population->grille_de_personnes[4 - j][j].zone == seconde);
+  assert(population->grille_de_personnes[0][0].zone != seconde);
+  population->tour += 5;  // Première zone levée d'un coup
+  assert(!enQuarantaine(population, &population->grille_de_personnes[0][0]));
+  assert(getDureeQuarantaine(population,
+                             &population->grille_de_personnes[0][6]) == 4);
+  printf("    Zones recouvrantes, levée de la première: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  // Zone neuve au passage de (3, 3) : (6, 6), déjà en quarantaine et pas
+  // encore passée, a un tour de moins ; (5, 5), libre, la durée entière
+  const struct Parametres recouvrement = {0, 0, 0, 1, 0, 0, 12, 8};
+  struct Population* recouverte = creerPopulation(7);
+  recouverte->grille_de_personnes[3][3].state = MALADE;
+  recouverte->grille_de_personnes[6][6].zone = creerZone(recouverte, 5);
+  struct Aleatoire aleatoire_recouvrement;
+  initAleatoire(&aleatoire_recouvrement, 3);
+  jouerTourParametres(recouverte, &recouvrement, &aleatoire_recouvrement);
+  assert(getDureeQuarantaine(recouverte,
+                             &recouverte->grille_de_personnes[5][5]) == 8);
+  assert(getDureeQuarantaine(recouverte,
+                             &recouverte->grille_de_personnes[6][6]) == 7);
+  assert(getDureeQuarantaine(recouverte,
+                             &recouverte->grille_de_personnes[0][0]) == 8);
+  printf("    Case déjà en quarantaine remise plus loin: "
+         "\x1B[32mOK\x1B[0m\n");
+  detruirePopulation(recouverte);
+
+  printf("  jouerTour:\n");
+  struct Population* premiere = creerPopulation(20);
+  struct Population* rejouee = creerPopulation(20);
+  patient_zero(premiere, 10, 10);
+  patient_zero(rejouee, 10, 10);
+  srand(11);
+  for (int tour = 0; tour < 30; tour++)
+    jouerTour(premiere, 0.2, 0.1, 0.5, 0.3, 0.01, 2, 2, 5);
+  srand(11);
+  for (int tour = 0; tour < 30; tour++)
+    jouerTour(rejouee, 0.2, 0.1, 0.5, 0.3, 0.01, 2, 2, 5);
+  for (int k = 0; k < 20 * 20; k++)
+    assert(premiere->personnes[k].state == rejouee->personnes[k].state &&
+           premiere->personnes[k].zone == rejouee->personnes[k].zone);
+  printf("    Même trajectoire après le même srand(): \x1B[32mOK\x1B[0m\n");
+  detruirePopulation(premiere);
+  detruirePopulation(rejouee);
+
+  printf("  jouerTourParametres (rasters):\n");
+  const struct Parametres parametres = {0.2, 0.1, 0.5, 0.3, 0.0, 2, 2, 5};
+  struct Population* avec = creerPopulation(30);
+  struct Population* sans = creerPopulation(30);
+  patient_zero(avec, 15, 15);
+  patient_zero(sans, 15, 15);
+  activerRasters(avec);
+  struct Aleatoire aleatoire_avec, aleatoire_sans;
+  initAleatoire(&aleatoire_avec, 7);
+  initAleatoire(&aleatoire_sans, 7);
+  // Référence : comparaison des grilles complètes à chaque tour
+  uint16_t attendu[NB_RASTERS][30 * 30];
+  for (int r = 0; r < NB_RASTERS; r++)
+    for (int k = 0; k < 30 * 30; k++) attendu[r][k] = RASTER_JAMAIS;
+  attendu[RASTER_INFECTION][15 * 30 + 15] = 0;
+  for (uint16_t tour = 1; tour <= 60; tour++) {
+    struct Personne avant[30 * 30];
+    char avant_quarantaine[30 * 30];
+    for (int k = 0; k < 30 * 30; k++) {
+      avant[k] = sans->personnes[k];
+      avant_quarantaine[k] = enQuarantaine(sans, &sans->personnes[k]);
+    }
+    jouerTourParametres(avec, &parametres, &aleatoire_avec);
+    jouerTourParametres(sans, &parametres, &aleatoire_sans);
+    for (int k = 0; k < 30 * 30; k++) {
+      const struct Personne* apres = &sans->personnes[k];
+      assert(apres->state == avec->personnes[k].state);
+      if (avant[k].state == SAIN && apres->state == INCUBE)
+        attendu[RASTER_INFECTION][k] = tour;
+      if (avant[k].state == MALADE && apres->state == MORT)
+        attendu[RASTER_MORT][k] = tour;
+      if (!avant_quarantaine[k] && enQuarantaine(sans, apres) &&
+          attendu[RASTER_QUARANTAINE][k] == RASTER_JAMAIS)
+        attendu[RASTER_QUARANTAINE][k] = tour;
+    }
+  }
+  printf("    Trajectoire inchangée: \x1B[32mOK\x1B[0m\n");
+  for (int r = 0; r < NB_RASTERS; r++)
+    for (int k = 0; k < 30 * 30; k++)
+      assert(avec->rasters[r][k] == attendu[r][k]);
+  assert(!sans->rasters[RASTER_INFECTION]);
+  printf("    Rasters == différences des grilles: \x1B[32mOK\x1B[0m\n");
+  detruirePopulation(avec);
+  detruirePopulation(sans);
+
+  printf("  getExtensions, choisirNoyau:\n");
+  struct Parametres sans_extension = {.beta = 0.2,
+                                      .gamma = 0.2,
+                                      .lambda = 0.6,
+                                      .chance_quarantaine = 0,
+                                      .chance_decouverte_vaccin = 0,
+                                      .duree_incube = 0,
+                                      .cordon_sanitaire = 2,
+                                      .duree_quarantaine = 5};
+  struct Population* grille = creerPopulation(20);
+  patient_zero(grille, 10, 10);
+  assert(getExtensions(&sans_extension, grille) == 0);
+  struct Parametres une_extension = sans_extension;
+  une_extension.chance_quarantaine = 0.1;
+  assert(getExtensions(&une_extension, grille) == EXTENSION_QUARANTAINE);
+  une_extension = sans_extension;
+  une_extension.chance_decouverte_vaccin = 0.1;
+  assert(getExtensions(&une_extension, grille) == EXTENSION_VACCIN);
+  une_extension = sans_extension;
+  une_extension.duree_incube = 3;
+  assert(getExtensions(&une_extension, grille) == EXTENSION_INCUBATION);
+  printf("    Extensions des paramètres: \x1B[32mOK\x1B[0m\n");
+  // Condition initiale portant les trois extensions
+  grille->grille_de_personnes[0][0].state = VACCINE;
+  grille->grille_de_personnes[5][5].zone = creerZone(grille, 4);
+  grille->grille_de_personnes[15][15].state = INCUBE;
+  grille->grille_de_personnes[15][15].duree_incube = 2;
+  assert(getExtensions(&sans_extension, grille) == EXTENSIONS_TOUTES);
+  printf("    Extensions de la grille: \x1B[32mOK\x1B[0m\n");
+  for (unsigned int e = 0; e <= EXTENSIONS_TOUTES; e++)
+    assert(choisirNoyau(e)->extensions == e);
+  printf("    Une variante par combinaison: \x1B[32mOK\x1B[0m\n");
+  // Variante spécialisée == noyau complet, pour chaque combinaison
+  for (unsigned int e = 0; e <= EXTENSIONS_TOUTES; e++) {
+    struct Parametres choisis = sans_extension;
+    if (e & EXTENSION_QUARANTAINE) choisis.chance_quarantaine = 0.2;
+    if (e & EXTENSION_VACCIN) choisis.chance_decouverte_vaccin = 0.01;
+    if (e & EXTENSION_INCUBATION) choisis.duree_incube = 2;
+    struct Population* specialisee = creerPopulation(20);
+    struct Population* complete = creerPopulation(20);
+    patient_zero(specialisee, 10, 10);
+    patient_zero(complete, 10, 10);
+    const struct Noyau* noyau =
+        choisirNoyau(getExtensions(&choisis, specialisee));
+    assert(noyau->extensions == e);
+    struct Aleatoire aleatoire_specialisee, aleatoire_complete;
+    initAleatoire(&aleatoire_specialisee, 7);
+    initAleatoire(&aleatoire_complete, 7);
+    for (int tour = 0; tour < 40; tour++) {
+      noyau->jouer(specialisee, &choisis, &aleatoire_specialisee);
+      choisirNoyau(EXTENSIONS_TOUTES)
+          ->jouer(complete, &choisis, &aleatoire_complete);
+      for (int k = 0; k < 20 * 20; k++)
+        assert(specialisee->personnes[k].state ==
+                   complete->personnes[k].state &&
+               specialisee->personnes[k].zone ==
+                   complete->personnes[k].zone);
+    }
+    detruirePopulation(specialisee);
+    detruirePopulation(complete);
+  }
+  printf("    Variante == noyau complet: \x1B[32mOK\x1B[0m\n\n");
+  detruirePopulation(grille);
   return 0;
 }
@@ -0,0 +1,122 @@
+/**
+ * @file memoire_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur la durée de vie mémoire.
+ *
+ * Le tas reste plat parce que reinitialiserSimulation réutilise la grille
+ * de la population et les tampons de la Serie, et parce que chaque
+ * creerX a son detruireX.
+ *
+ * Sans AddressSanitizer, le tas est mesuré par mallinfo2. Avec (make asan),
+ * LeakSanitizer vérifie qu'aucune allocation n'est perdue.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <malloc.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/simulation.h"
+
+/**
+ * @brief Nombre de simulations consécutives.
+ */
+#define NB_SIMULATIONS 10000
+
+/**
+ * @brief Octets du tas utilisés, 0 sous AddressSanitizer.
+ */
+static size_t tasUtilise(void) {
+#if defined(__SANITIZE_ADDRESS__)
+  return 0;
+#else
+  return mallinfo2().uordblks;
+#endif
+}
+
+/**
+ * @brief Condition initiale des simulations : patient zero au centre.
+ */
+static struct Population *conditionInitiale(void) {
+  struct Population *population = creerPopulation(16);
+  patient_zero(population, 8, 8);
+  return population;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  const struct Parametres parametres = {.beta = 0.5,
+                                        .gamma = 0.1,
+                                        .lambda = 1.0,
+                                        .chance_quarantaine = 0.1,
+                                        .chance_decouverte_vaccin = 0.001,
+                                        .duree_incube = 4,
+                                        .cordon_sanitaire = 5,
+                                        .duree_quarantaine = 20};
+  printf("memoire_test:\n");
+
+  printf("  reinitialiserSimulation (%d réplicats):\n", NB_SIMULATIONS);
+  struct Population *initiale = conditionInitiale();
+  struct Simulation *simulation =
+      creerSimulation(&parametres, conditionInitiale(), 1);
+  size_t tas_rechauffe = 0, tas_max = 0;
+  unsigned long tours = 0;
+  for (unsigned long r = 0; r < NB_SIMULATIONS; r++) {
+    assert(!reinitialiserSimulation(simulation, initiale, r + 1));
+    tours += avancerSimulation(simulation, 200);
+    if (r == 100) tas_rechauffe = tasUtilise();
+    if (r > 100 && tasUtilise() > tas_max) tas_max = tasUtilise();
+  }
+  struct Population *autre = creerPopulation(8);
+  assert(reinitialiserSimulation(simulation, autre, 1) == -1);
+  detruirePopulation(autre);
+  // Même graine : même trajectoire qu'une simulation neuve
+  struct Simulation *neuve =
+      creerSimulation(&parametres, conditionInitiale(), NB_SIMULATIONS);
+  avancerSimulation(neuve, 200);
+  const struct Serie *s1 = getSerieSimulation(simulation);
+  const struct Serie *s2 = getSerieSimulation(neuve);
+  assert(s1->tours == s2->tours);
+  struct Statistique t1[TOURS_PAR_BLOC], t2[TOURS_PAR_BLOC];
+  for (unsigned long b = 0; b < getNbBlocsSerie(s1); b++) {
+    const unsigned long nb = lireBlocSerie(s1, b, t1);
+    assert(lireBlocSerie(s2, b, t2) == nb &&
+           !memcmp(t1, t2, nb * sizeof(struct Statistique)));
+  }
+  detruireSimulation(neuve);
+  printf("    Même trajectoire qu'une simulation neuve: \x1B[32mOK\x1B[0m\n");
+  // Une fuite d'une Statistique par tour coûterait tours * 48 octets. Les
+  // caches de malloc (tcache) comptent comme utilisés : marge de 64 Kio
+  assert(tas_max <= tas_rechauffe + 64 * 1024);
+  printf("    Tas plat (%lu tours, +%lu octets): \x1B[32mOK\x1B[0m\n", tours,
+         (unsigned long)(tas_max - tas_rechauffe));
+  detruireSimulation(simulation);
+
+  printf("  creerSimulation/detruireSimulation (%d simulations):\n",
+         NB_SIMULATIONS);
+  size_t tas_avant = 0;
+  for (unsigned long r = 0; r < NB_SIMULATIONS; r++) {
+    simulation = creerSimulation(&parametres, conditionInitiale(), r + 1);
+    avancerSimulation(simulation, 200);
+    struct Serie *derivee = deriverSerie(getSerieSimulation(simulation));
+    detruireSerie(derivee);
+    struct Personne **grille = clonerGrillePopulation(initiale);
+    detruireGrillePopulation(grille, initiale->cote);
+    detruireSimulation(simulation);
+    if (r == 100) tas_avant = tasUtilise();
+  }
+  // Les caches de malloc (tcache) comptent comme utilisés : marge de 64 Kio
+  assert(tasUtilise() <= tas_avant + 64 * 1024);
+  printf("    Tas plat (%+ld octets): \x1B[32mOK\x1B[0m\n",
+         (long)tasUtilise() - (long)tas_avant);
+  detruirePopulation(initiale);
+  return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file metriques_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur le point d'accès aux métriques.
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../src/simulation.h"
+
+/**
+ * @brief Chemin du socket Unix de test.
+ */
+#define CHEMIN_SOCKET "metriques_test.sock"
+
+/**
+ * @brief Nombre de publications du test de cohérence.
+ */
+#define NB_PUBLICATIONS 200000
+
+/**
+ * @brief Envoie une requête GET et lit toute la réponse.
+ *
+ * @param metriques Métriques (port TCP si non nul, socket Unix sinon).
+ * @param chemin Chemin HTTP.
+ * @param reponse Tampon de réponse.
+ * @param taille Taille du tampon.
+ */
+static void requeter(const struct Metriques *metriques, const char *chemin,
+                     char *reponse, size_t taille) {
+  int client;
+  if (metriques->port) {
+    client = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in ip = {.sin_family = AF_INET,
+                             .sin_port = htons(metriques->port),
+                             .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+    assert(!connect(client, (struct sockaddr *)&ip, sizeof(ip)));
+  } else {
+    client = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un unix_ = {.sun_family = AF_UNIX};
+    strcpy(unix_.sun_path, metriques->chemin);
+    assert(!connect(client, (struct sockaddr *)&unix_, sizeof(unix_)));
+  }
+  char requete[256];
+  const int longueur =
+      snprintf(requete, sizeof(requete), "GET %s HTTP/1.0\r\n\r\n", chemin);
+  assert(send(client, requete, (size_t)longueur, 0) == longueur);
+  size_t lus = 0;
+  ssize_t n;
+  while (lus < taille - 1 &&
+         (n = recv(client, reponse + lus, taille - 1 - lus, 0)) > 0)
+    lus += (size_t)n;
+  reponse[lus] = '\0';
+  close(client);
+}
+
+/**
+ * @brief Publie des tours dont les compteurs valent tous le numéro du tour.
+ *
+ * @param argument struct Metriques*.
+ * @return void* NULL.
+ */
+static void *publier(void *argument) {
+  struct Metriques *metriques = (struct Metriques *)argument;
+  for (long t = 1; t <= NB_PUBLICATIONS; t++) {
+    const struct Statistique stats = {t, t, t, t, t, t};
+    publierTourMetriques(metriques, (unsigned long)t, stats);
+  }
+  return NULL;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  printf("metriques_test:\n");
+  printf("  creerMetriques:\n");
+  struct Metriques *tcp = creerMetriques("0");
+  assert(tcp && tcp->port);
+  assert(!creerMetriques("70000"));
+  struct Metriques *unix_ = creerMetriques(CHEMIN_SOCKET);
+  assert(unix_ && !unix_->port && !access(CHEMIN_SOCKET, F_OK));
+  printf("    Port TCP libre (%u) et socket Unix: \x1B[32mOK\x1B[0m\n",
+         tcp->port);
+
+  printf("  publierTourMetriques/releverMetriques:\n");
+  pthread_t thread;
+  pthread_create(&thread, NULL, publier, unix_);
+  struct ReleveMetriques releve;
+  unsigned long releves = 0, precedent = 0;
+  do {
+    releverMetriques(unix_, &releve);
+    const long t = (long)releve.tour;
+    assert(releve.stats.nb_IMMUNISE == t && releve.stats.nb_SAIN == t &&
+           releve.stats.nb_MORT == t && releve.stats.nb_MALADE == t &&
+           releve.stats.nb_INCUBE == t && releve.stats.nb_VACCINE == t);
+    assert(releve.tour >= precedent);
+    precedent = releve.tour;
+    releves++;
+  } while (releve.tour < NB_PUBLICATIONS);
+  pthread_join(thread, NULL);
+  printf("    %lu relevés cohérents pendant %d publications: "
+         "\x1B[32mOK\x1B[0m\n",
+         releves, NB_PUBLICATIONS);
+  assert(releve.rss > 0);
+  printf("    Mémoire résidente: \x1B[32mOK\x1B[0m\n");
+
+  printf("  attacherMetriquesSimulation:\n");
+  struct Parametres parametres = {0.1, 0.1, 1.0, 0.1, 0.001, 4, 5, 20};
+  struct Population *population = creerPopulation(50);
+  patient_zero(population, 25, 25);
+  struct Simulation *simulation = creerSimulation(&parametres, population, 1);
+  attacherMetriquesSimulation(simulation, tcp);
+  releverMetriques(tcp, &releve);
+  assert(releve.tour == 0 && releve.stats.nb_MALADE == 1);
+  const unsigned long tours = avancerSimulation(simulation, 10);
+  const struct Serie *serie = getSerieSimulation(simulation);
+  assert(serie->tours == tours + 1);
+  const struct Statistique *derniere = &serie->derniere;
+  releverMetriques(tcp, &releve);
+  assert(releve.tour == tours && releve.stats.nb_SAIN == derniere->nb_SAIN &&
+         releve.stats.nb_MALADE == derniere->nb_MALADE);
+  assert(releve.phases[PHASE_JEU] > 0 && releve.phases[PHASE_STATISTIQUE] > 0);
+  assert(releve.tours_par_seconde > 0);
+  printf("    Dernier tour et temps par phase publiés: \x1B[32mOK\x1B[0m\n");
+
+  printf("  Serveur:\n");
+  char reponse[8192], attendu[128];
+  requeter(tcp, "/metrics", reponse, sizeof(reponse));
+  assert(!strncmp(reponse, "HTTP/1.0 200 OK", 15));
+  snprintf(attendu, sizeof(attendu), "\nepidemie_tour %lu\n", tours);
+  assert(strstr(reponse, attendu));
+  snprintf(attendu, sizeof(attendu),
+           "\nepidemie_personnes{etat=\"SAIN\"} %ld\n", derniere->nb_SAIN);
+  assert(strstr(reponse, attendu));
+  assert(strstr(reponse, "\nepidemie_phase_secondes{phase=\"jeu\"} "));
+  assert(strstr(reponse, "\nepidemie_rss_octets "));
+  printf("    /metrics au format Prometheus (TCP): \x1B[32mOK\x1B[0m\n");
+  requeter(unix_, "/json", reponse, sizeof(reponse));
+  assert(strstr(reponse, "Content-Type: application/json"));
+  snprintf(attendu, sizeof(attendu), "{\"tour\": %d, ", NB_PUBLICATIONS);
+  assert(strstr(reponse, attendu));
+  printf("    /json (socket Unix): \x1B[32mOK\x1B[0m\n");
+  requeter(tcp, "/inconnu", reponse, sizeof(reponse));
+  assert(!strncmp(reponse, "HTTP/1.0 404", 12));
+  assert(atomic_load(&tcp->requetes) == 2);
+  printf("    404 sur un autre chemin: \x1B[32mOK\x1B[0m\n");
+
+  printf("  detruireMetriques:\n");
+  detruireSimulation(simulation);
+  detruireMetriques(tcp);
+  detruireMetriques(unix_);
+  assert(access(CHEMIN_SOCKET, F_OK));
+  printf("    Socket Unix supprimé: \x1B[32mOK\x1B[0m\n");
+  return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file multiechelle_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur la grille multi-échelle.
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "../src/multiechelle.h"
+
+char totalExact(struct Statistique stats, unsigned long population_totale);
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  const struct Parametres parametres = {
+      .beta = 0.5,
+      .gamma = 0.1,
+      .lambda = 1.0,
+      .chance_quarantaine = 0.1,
+      .chance_decouverte_vaccin = 0.001,
+      .duree_incube = 4,
+      .cordon_sanitaire = 5,
+      .duree_quarantaine = 20};
+  printf("multiechelle_test:\n");
+
+  printf("  creerMultiechelle:\n");
+  assert(!creerMultiechelle(&parametres, 100, 30, 42));
+  printf("    cote non multiple de taille_bloc => NULL: \x1B[32mOK\x1B[0m\n");
+  struct Multiechelle *multiechelle = creerMultiechelle(&parametres, 200, 20, 42);
+  assert(multiechelle->nb_blocs_fins == 0);
+  assert(!getPersonneMultiechelle(multiechelle, 100, 100));
+  assert(totalExact(getStatistiqueMultiechelle(multiechelle), 200 * 200));
+  printf("    Grille agrégée et saine: \x1B[32mOK\x1B[0m\n");
+
+  printf("  infecterMultiechelle:\n");
+  infecterMultiechelle(multiechelle, 100, 100);
+  assert(multiechelle->nb_blocs_fins == 1);
+  assert(getPersonneMultiechelle(multiechelle, 100, 100)->state == MALADE);
+  assert(getStatistiqueMultiechelle(multiechelle).nb_MALADE == 1);
+  printf("    Bloc raffiné, patient zero MALADE: \x1B[32mOK\x1B[0m\n");
+
+  printf("  jouerTourMultiechelle:\n");
+  unsigned long max_blocs_fins = 0;
+  struct Statistique stats;
+  for (int tour = 0; tour < 400; tour++) {
+    jouerTourMultiechelle(multiechelle);
+    stats = getStatistiqueMultiechelle(multiechelle);
+    assert(totalExact(stats, 200 * 200));
+    if (multiechelle->nb_blocs_fins > max_blocs_fins)
+      max_blocs_fins = multiechelle->nb_blocs_fins;
+  }
+  printf("    Effectifs exacts à chaque tour: \x1B[32mOK\x1B[0m\n");
+  assert(max_blocs_fins > 1);
+  printf("    Raffinement au passage du front: \x1B[32mOK\x1B[0m\n");
+  assert(!stats.nb_MALADE && !stats.nb_INCUBE);
+  assert(multiechelle->nb_blocs_fins == 0);
+  printf("    Agrégation après l'épidémie: \x1B[32mOK\x1B[0m\n");
+  assert(stats.nb_VACCINE > 0);
+  printf("    Vaccination des blocs agrégés: \x1B[32mOK\x1B[0m\n\n");
+
+  detruireMultiechelle(multiechelle);
+  return 0;
+}
+
+/**
+ * @brief Vrai si les effectifs somment à la population totale.
+ */
+char totalExact(struct Statistique stats, unsigned long population_totale) {
+  return stats.nb_SAIN >= 0 && stats.nb_IMMUNISE >= 0 && stats.nb_VACCINE >= 0 &&
+         stats.nb_MORT >= 0 &&
+         (unsigned long)(stats.nb_SAIN + stats.nb_MALADE + stats.nb_MORT +
+                         stats.nb_IMMUNISE + stats.nb_INCUBE +
+                         stats.nb_VACCINE) == population_totale;
+}
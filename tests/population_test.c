@@ -10,6 +10,7 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "../src/population.h"
 
@@ -27,20 +28,34 @@ int main(void) {
 
   for (unsigned long i = 0; i < population->cote; i++) {
     for (unsigned long j = 0; j < population->cote; j++) {
-      assert(population->grille_de_personnes[i][j]->state == SAIN);
+      assert(population->grille_de_personnes[i][j].state == SAIN);
     }
   }
   printf("    Population grille_de_personnes: \x1B[32mOK\x1B[0m\n");
+  assert(!population->tampon && !population->grille_tampon);
+  printf("    Tampon non alloué avant le premier tour: \x1B[32mOK\x1B[0m\n");
+
+  printf("  preparerTampon, echangerTampon:\n");
+  population->grille_de_personnes[2][3].state = MORT;
+  preparerTampon(population);
+  assert(population->grille_tampon[2][3].state == MORT &&
+         &population->grille_tampon[2][3] == &population->tampon[2 * 7 + 3]);
+  population->grille_tampon[2][3].state = SAIN;
+  echangerTampon(population);
+  assert(population->grille_de_personnes[2][3].state == SAIN &&
+         population->personnes[2 * 7 + 3].state == SAIN);
+  printf("    Tampon alloué au premier tour, lignes échangées: "
+         "\x1B[32mOK\x1B[0m\n");
 
   printf("  clonerGrillePopulation:\n");
-  struct Personne ***grille_clone = clonerGrillePopulation(population);
+  struct Personne **grille_clone = clonerGrillePopulation(population);
   assert(grille_clone != population->grille_de_personnes);
   printf(
       "    Malloc grille_de_personnes Clone != Malloc Population "
       "Source->grille_de_personnes: \x1B[32mOK\x1B[0m\n");
   for (unsigned long i = 0; i < population->cote; i++) {
     for (unsigned long j = 0; j < population->cote; j++) {
-      assert(grille_clone[i][j] != population->grille_de_personnes[i][j]);
+      assert(&grille_clone[i][j] != &population->grille_de_personnes[i][j]);
     }
   }
   printf(
@@ -48,19 +63,20 @@ int main(void) {
       "Source->grille_de_personnes[i][j]: \x1B[32mOK\x1B[0m\n");
   for (unsigned long i = 0; i < population->cote; i++) {
     for (unsigned long j = 0; j < population->cote; j++) {
-      assert(grille_clone[i][j]->state ==
-             population->grille_de_personnes[i][j]->state);
+      assert(grille_clone[i][j].state ==
+             population->grille_de_personnes[i][j].state);
     }
   }
   printf(
       "    State Personne Clone == State Personne Source: \x1B[32mOK\x1B[0m\n");
+  detruireGrillePopulation(grille_clone, population->cote);
   printf("  afficherGrillePopulation:\n");
   afficherGrillePopulation(population);
   printf("    Affichage OK: \x1B[32mOK\x1B[0m\n");
 
   printf("  patient_zero:\n");
   patient_zero(population, 1, 1);
-  assert(population->grille_de_personnes[1][1]->state == MALADE);
+  assert(population->grille_de_personnes[1][1].state == MALADE);
   printf("    State OK: \x1B[32mOK\x1B[0m\n");
 
   printf("  getTaillePopulation:\n");
@@ -68,5 +84,57 @@ int main(void) {
          getTaillePopulation(population));
   printf("    Taille OK: \x1B[32mOK\x1B[0m\n");
 
+  printf("  activerRasters, exporterRaster:\n");
+  assert(exporterRaster(population, RASTER_MORT, "raster_test.pgm") == -1);
+  population->grille_de_personnes[0][1].state = MORT;
+  population->tour = 3;
+  activerRasters(population);
+  assert(population->rasters[RASTER_INFECTION][1 * 7 + 1] == 3);
+  assert(population->rasters[RASTER_MORT][0 * 7 + 1] == 3);
+  assert(population->rasters[RASTER_INFECTION][0] == RASTER_JAMAIS);
+  printf("    Etat initial: \x1B[32mOK\x1B[0m\n");
+  population->rasters[RASTER_MORT][0] = 0x1234;
+  assert(!exporterRaster(population, RASTER_MORT, "raster_test.pgm"));
+  FILE *file = fopen("raster_test.pgm", "rb");
+  char entete[32];
+  unsigned char octets[4];
+  assert(fgets(entete, sizeof(entete), file) && !strcmp(entete, "P5\n"));
+  assert(fgets(entete, sizeof(entete), file) && !strcmp(entete, "7 7\n"));
+  assert(fgets(entete, sizeof(entete), file) && !strcmp(entete, "65535\n"));
+  assert(fread(octets, 1, 4, file) == 4);
+  assert(octets[0] == 0x12 && octets[1] == 0x34);
+  assert(octets[2] == 0x00 && octets[3] == 0x03);
+  fseek(file, 0, SEEK_END);
+  assert(ftell(file) == 13 + 2 * 7 * 7);
+  fclose(file);
+  printf("    PGM 16 bits big-endian: \x1B[32mOK\x1B[0m\n");
+
+  printf("  creerZone, enQuarantaine:\n");
+  const uint32_t zone = creerZone(population, 2);  // Tour 3 : levée au tour 5
+  assert(zone == 1);
+  population->grille_de_personnes[2][2].zone = zone;
+  population->grille_de_personnes[2][3].zone = zone;
+  assert(enQuarantaine(population, &population->grille_de_personnes[2][3]));
+  assert(getDureeQuarantaine(population,
+                             &population->grille_de_personnes[2][2]) == 2);
+  assert(!enQuarantaine(population, &population->grille_de_personnes[0][0]));
+  population->tour = 5;
+  assert(!enQuarantaine(population, &population->grille_de_personnes[2][2]));
+  assert(!getDureeQuarantaine(population,
+                              &population->grille_de_personnes[2][3]));
+  printf("    Zone levée d'un coup à son expiration: \x1B[32mOK\x1B[0m\n");
+  for (uint32_t z = 2; z < 100; z++) assert(creerZone(population, z) == z);
+  assert(population->zones.nb_zones == 100 &&
+         population->zones.expirations[99] == 5 + 99);
+  struct Population *copie = creerPopulation(7);
+  assert(!copierPopulation(copie, population));
+  assert(copie->zones.nb_zones == 100 && copie->tour == 5);
+  copie->tour = 4;
+  assert(enQuarantaine(copie, &copie->grille_de_personnes[2][2]));
+  detruirePopulation(copie);
+  printf("    Table agrandie, copiée par copierPopulation: "
+         "\x1B[32mOK\x1B[0m\n");
+  detruirePopulation(population);
+
   return 0;
 }
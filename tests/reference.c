@@ -0,0 +1,209 @@
+/**
+ * @file reference.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Moteur de référence figé pour les tests d'équivalence.
+ *
+ * Copie volontairement naïve de jouerTour, mettreEnQuarantaine et
+ * getStatistique (sémantique du projet, tirages dans le même ordre ; pas de
+ * tirage de quarantaine ou de vaccin si sa chance est nulle). Ne pas
+ * optimiser : c'est l'oracle auquel les moteurs de src/ sont comparés.
+ *
+ * La quarantaine garde son décompte d'origine, une durée par case
+ * décrémentée à chaque tour (tableau duree_quarantaine tenu par l'appelant),
+ * et non les zones de population.h : les moteurs sont comparés par
+ * getDureeQuarantaine.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "reference.h"
+
+/**
+ * @brief Personne (i, j) d'un tableau cote*cote.
+ */
+#define P(grille, i, j) (&(grille)[(i) * cote + (j)])
+
+/**
+ * @brief Tirage de quarantaine ou de vaccin : aucun tirage si chance est
+ * nulle.
+ */
+static int tirerSiNonNulle(struct Aleatoire *aleatoire, double chance) {
+  return chance > 0 && aleatoireUniforme(aleatoire) < chance;
+}
+
+/**
+ * @brief Partie récursive de la quarantaine de référence.
+ */
+static void quarantaineRecurse(struct Personne *grille, int *durees,
+                               unsigned long x, unsigned long y,
+                               unsigned long cote, int cordon_sanitaire,
+                               int duree_quarantaine) {
+  *P(durees, x, y) = duree_quarantaine;
+  P(grille, x, y)->cordon_sanitaire = cordon_sanitaire;
+
+  const long dx[4] = {-1, 1, 0, 0}, dy[4] = {0, 0, -1, 1};  // N, S, O, E
+  for (int d = 0; d < 4; d++) {
+    if ((dx[d] < 0 && x == 0) || (dx[d] > 0 && x == cote - 1) ||
+        (dy[d] < 0 && y == 0) || (dy[d] > 0 && y == cote - 1))
+      continue;
+    const unsigned long vx = x + dx[d], vy = y + dy[d];
+    if (P(grille, vx, vy)->cordon_sanitaire >= cordon_sanitaire) continue;
+    if (P(grille, vx, vy)->state == MALADE || P(grille, vx, vy)->state == MORT)
+      quarantaineRecurse(grille, durees, vx, vy, cote, cordon_sanitaire,
+                         duree_quarantaine);
+    else if (cordon_sanitaire > 0)
+      quarantaineRecurse(grille, durees, vx, vy, cote, cordon_sanitaire - 1,
+                         duree_quarantaine);
+  }
+}
+
+/**
+ * @brief Vrai si un voisin direct est VACCINE.
+ */
+static int voisinVaccine(const struct Personne *grille, unsigned long i,
+                         unsigned long j, unsigned long cote) {
+  return (j > 0 && P(grille, i, j - 1)->state == VACCINE) ||
+         (j < cote - 1 && P(grille, i, j + 1)->state == VACCINE) ||
+         (i > 0 && P(grille, i - 1, j)->state == VACCINE) ||
+         (i < cote - 1 && P(grille, i + 1, j)->state == VACCINE);
+}
+
+/**
+ * @brief Vrai si le voisin (vi, vj) contamine (i, j).
+ */
+static int voisinContagieux(const struct Personne *grille,
+                            const int *durees, unsigned long i,
+                            unsigned long j, unsigned long vi,
+                            unsigned long vj, unsigned long cote) {
+  return (!*P(durees, vi, vj) == !*P(durees, i, j)) &&
+         (P(grille, vi, vj)->state == MALADE ||
+          P(grille, vi, vj)->state == INCUBE);
+}
+
+/**
+ * @brief Un tour de référence.
+ *
+ * @param population Grille au temps t (seul population->personnes est lu et
+ * écrit).
+ * @param duree_quarantaine Tours de quarantaine restants de chaque case au
+ * temps t (cote * cote, 0 au départ), passés au temps t+1.
+ * @param parametres Paramètres de la simulation.
+ * @param aleatoire Générateur, consommé dans le même ordre que jouerTour.
+ */
+void jouerTourReference(struct Population *population,
+                        int *duree_quarantaine,
+                        const struct Parametres *parametres,
+                        struct Aleatoire *aleatoire) {
+  const unsigned long cote = population->cote;
+  struct Personne *grille = population->personnes;
+  struct Personne *tampon =
+      (struct Personne *)malloc(sizeof(struct Personne) * cote * cote + 1);
+  memcpy(tampon, grille, sizeof(struct Personne) * cote * cote);
+  int *durees = (int *)malloc(sizeof(int) * cote * cote);
+  memcpy(durees, duree_quarantaine, sizeof(int) * cote * cote);
+
+  for (unsigned long i = 0; i < cote; i++) {
+    for (unsigned long j = 0; j < cote; j++) {
+      struct Personne *nouvelle = P(tampon, i, j);
+      if (*P(duree_quarantaine, i, j)) (*P(durees, i, j))--;
+
+      switch (P(grille, i, j)->state) {
+        case SAIN: {
+          if (tirerSiNonNulle(aleatoire,
+                              parametres->chance_decouverte_vaccin)) {
+            nouvelle->state = VACCINE;
+            break;
+          }
+          if (voisinVaccine(grille, i, j, cote)) {
+            nouvelle->state = VACCINE;
+            break;
+          }
+          int voisin = 0;
+          const int *q = duree_quarantaine;
+          if (j > 0)
+            voisin += voisinContagieux(grille, q, i, j, i, j - 1, cote);
+          if (j < cote - 1)
+            voisin += voisinContagieux(grille, q, i, j, i, j + 1, cote);
+          if (i > 0)
+            voisin += voisinContagieux(grille, q, i, j, i - 1, j, cote);
+          if (i < cote - 1)
+            voisin += voisinContagieux(grille, q, i, j, i + 1, j, cote);
+          for (; voisin > 0; voisin--) {
+            if (aleatoireUniforme(aleatoire) < parametres->lambda) {
+              nouvelle->state = INCUBE;
+              nouvelle->duree_incube = (int)parametres->duree_incube;
+              break;
+            }
+          }
+          break;
+        }
+
+        case MALADE:
+          if (tirerSiNonNulle(aleatoire, parametres->chance_quarantaine) &&
+              !*P(durees, i, j)) {
+            for (unsigned long k = 0; k < cote * cote; k++)
+              tampon[k].cordon_sanitaire = 0;
+            quarantaineRecurse(tampon, durees, i, j, cote,
+                               parametres->cordon_sanitaire,
+                               (int)parametres->duree_quarantaine);
+          }
+          if (aleatoireUniforme(aleatoire) < parametres->beta) {
+            nouvelle->state = MORT;
+            break;
+          }
+          if (aleatoireUniforme(aleatoire) < parametres->gamma)
+            nouvelle->state = IMMUNISE;
+          break;
+
+        case INCUBE:
+          if (P(grille, i, j)->duree_incube == 0)
+            nouvelle->state = MALADE;
+          else
+            nouvelle->duree_incube--;
+          break;
+
+        case IMMUNISE:
+          if (tirerSiNonNulle(aleatoire,
+                              parametres->chance_decouverte_vaccin) ||
+              voisinVaccine(grille, i, j, cote))
+            nouvelle->state = VACCINE;
+          break;
+
+        default:
+          break;
+      }
+    }
+  }
+
+  memcpy(grille, tampon, sizeof(struct Personne) * cote * cote);
+  memcpy(duree_quarantaine, durees, sizeof(int) * cote * cote);
+  free(tampon);
+  free(durees);
+}
+
+/**
+ * @brief Statistique de référence, par comptage direct.
+ *
+ * @param population Population.
+ * @return struct Statistique Effectifs de chaque état.
+ */
+struct Statistique getStatistiqueReference(
+    const struct Population *population) {
+  struct Statistique stats = {0, 0, 0, 0, 0, 0};
+  for (unsigned long k = 0; k < population->cote * population->cote; k++) {
+    switch (population->personnes[k].state) {
+      case IMMUNISE: stats.nb_IMMUNISE++; break;
+      case SAIN: stats.nb_SAIN++; break;
+      case MORT: stats.nb_MORT++; break;
+      case MALADE: stats.nb_MALADE++; break;
+      case INCUBE: stats.nb_INCUBE++; break;
+      case VACCINE: stats.nb_VACCINE++; break;
+    }
+  }
+  return stats;
+}
@@ -0,0 +1,15 @@
+#if !defined(REFERENCE_H)
+#define REFERENCE_H
+
+#include "../src/aleatoire.h"
+#include "../src/jouer_un_tour.h"
+#include "../src/population.h"
+#include "../src/statistique.h"
+
+void jouerTourReference(struct Population *population,
+                        int *duree_quarantaine,
+                        const struct Parametres *parametres,
+                        struct Aleatoire *aleatoire);
+struct Statistique getStatistiqueReference(const struct Population *population);
+
+#endif  // REFERENCE_H
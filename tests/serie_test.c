@@ -0,0 +1,166 @@
+/**
+ * @file serie_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur la série compressée.
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../src/serie.h"
+
+/**
+ * @brief Compare deux fichiers texte.
+ *
+ * @return int 1 si identiques.
+ */
+static int memesFichiers(const char *a, const char *b) {
+  FILE *fa = fopen(a, "r"), *fb = fopen(b, "r");
+  int ca, cb;
+  do {
+    ca = fgetc(fa);
+    cb = fgetc(fb);
+  } while (ca == cb && ca != EOF);
+  fclose(fa);
+  fclose(fb);
+  return ca == cb;
+}
+
+/**
+ * @brief Statistique d'une épidémie synthétique de 10000 personnes.
+ */
+static struct Statistique statistiqueTour(unsigned long t) {
+  struct Statistique stats;
+  stats.nb_MORT = (long)(t * 3 / 2);
+  stats.nb_IMMUNISE = (long)t;
+  stats.nb_MALADE = (long)(t % 300);
+  stats.nb_INCUBE = (long)((t * 7) % 50);
+  stats.nb_VACCINE = t > 700 ? (long)(t - 700) : 0;
+  stats.nb_SAIN = 10000 - stats.nb_MORT - stats.nb_IMMUNISE -
+                  stats.nb_MALADE - stats.nb_INCUBE - stats.nb_VACCINE;
+  return stats;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  const unsigned long TOURS = 1000;  // 3 blocs pleins + 1 bloc ouvert
+  printf("serie_test:\n");
+  printf("  ajouterSerie:\n");
+  struct Data *data = creerData();
+  data->population_totale = 10000;
+  struct Serie *serie = creerSerie(10000);
+  for (unsigned long t = 0; t < TOURS; t++) {
+    appendData(data, statistiqueTour(t));
+    assert(!ajouterSerie(serie, statistiqueTour(t)));
+  }
+  assert(serie->tours == TOURS);
+  assert(serie->nb_blocs == TOURS / TOURS_PAR_BLOC);
+  assert(serie->nb_ouvert == TOURS % TOURS_PAR_BLOC);
+  assert(getNbBlocsSerie(serie) == 4);
+  printf("    Blocs fermés et bloc ouvert: \x1B[32mOK\x1B[0m\n");
+  assert(serie->taille_octets <
+         serie->nb_blocs * TOURS_PAR_BLOC * sizeof(struct Statistique) / 4);
+  printf("    Compression (%lu octets pour %lu tours): \x1B[32mOK\x1B[0m\n",
+         serie->taille_octets, serie->nb_blocs * TOURS_PAR_BLOC);
+  struct Statistique faux = statistiqueTour(0);
+  faux.nb_SAIN++;
+  assert(ajouterSerie(serie, faux) == -1);
+  assert(serie->tours == TOURS);
+  printf("    Somme des états incohérente refusée: \x1B[32mOK\x1B[0m\n");
+  assert(!memcmp(&serie->indicateurs, &data->indicateurs,
+                 sizeof(struct Indicateurs)));
+  printf("    Indicateurs identiques à Data: \x1B[32mOK\x1B[0m\n");
+
+  printf("  lireSerie:\n");
+  struct Statistique *lignes =
+      (struct Statistique *)malloc(sizeof(struct Statistique) * TOURS);
+  assert(lireSerie(serie, 0, TOURS, lignes) == TOURS);
+  for (unsigned long t = 0; t < TOURS; t++)
+    assert(!memcmp(&lignes[t], data->liste_statistiques[t],
+                   sizeof(struct Statistique)));
+  printf("    Tous les tours: \x1B[32mOK\x1B[0m\n");
+  assert(lireSerie(serie, 500, 100, lignes) == 100);
+  assert(lignes[0].nb_MORT == 750 && lignes[99].nb_IMMUNISE == 599);
+  assert(lireSerie(serie, 990, 100, lignes) == 10);
+  assert(lireBlocSerie(serie, 4, lignes) == 0);
+  printf("    Accès par plage à travers les blocs: \x1B[32mOK\x1B[0m\n");
+
+  printf("  ecrireSerie, chargerSerie:\n");
+  assert(!ecrireSerie(serie, "serie_test.bin"));
+  struct Serie *chargee = chargerSerie("serie_test.bin");
+  assert(chargee);
+  assert(chargee->tours == TOURS && chargee->nb_ouvert == serie->nb_ouvert);
+  assert(chargee->taille_octets == serie->taille_octets);
+  assert(!memcmp(chargee->octets, serie->octets, serie->taille_octets));
+  assert(!memcmp(&chargee->indicateurs, &serie->indicateurs,
+                 sizeof(struct Indicateurs)));
+  printf("    Aller-retour: \x1B[32mOK\x1B[0m\n");
+  FILE *file = fopen("serie_test.bin", "r+b");
+  fseek(file, -3, SEEK_END);
+  fputc(0xff, file);
+  fclose(file);
+  assert(!chargerSerie("serie_test.bin"));
+  assert(!chargerSerie("serie_test_absent.bin"));
+  printf("    Fichier corrompu ou absent: \x1B[32mOK\x1B[0m\n");
+
+  printf("  exporterSerie, deriverSerie:\n");
+  exporterSerie(chargee, "serie_test_data.txt");
+  exporter(data, "serie_test_data_ref.txt");
+  assert(memesFichiers("serie_test_data.txt", "serie_test_data_ref.txt"));
+  printf("    Même export que exporter: \x1B[32mOK\x1B[0m\n");
+  struct Serie *serie_derive = deriverSerie(serie);
+  struct Data *data_derive = deriver(data);
+  exporterSerie(serie_derive, "serie_test_data.txt");
+  exporter(data_derive, "serie_test_data_ref.txt");
+  assert(memesFichiers("serie_test_data.txt", "serie_test_data_ref.txt"));
+  assert(serie_derive->somme == 0);
+  printf("    Même dérivée que deriver: \x1B[32mOK\x1B[0m\n");
+
+  printf("  graphiqueSerie, tableauSerie:\n");
+  graphiqueSerie(serie, "serie_test_graphique.txt", 10, 40);
+  tableauSerie(chargee, "serie_test_tableau.txt");
+  tableau(data, "serie_test_tableau_ref.txt");
+  assert(memesFichiers("serie_test_tableau.txt", "serie_test_tableau_ref.txt"));
+  printf("    Même tableau que tableau: \x1B[32mOK\x1B[0m\n");
+
+  printf("  decompresserSerie, viderSerie:\n");
+  struct Data *decompressee = decompresserSerie(serie);
+  assert(decompressee && decompressee->tours == TOURS);
+  for (unsigned long t = 0; t < TOURS; t++)
+    assert(!memcmp(decompressee->liste_statistiques[t],
+                   data->liste_statistiques[t], sizeof(struct Statistique)));
+  assert(tauxAttaqueSerie(serie) == tauxAttaque(data));
+  printf("    Même historique que Data: \x1B[32mOK\x1B[0m\n");
+  serie->octets[serie->index[1].position[1] - 1] |= 0x80;
+  assert(lireBlocSerie(serie, 1, lignes) == 0);
+  assert(lireSerie(serie, 0, TOURS, lignes) == TOURS_PAR_BLOC);
+  assert(!decompresserSerie(serie));
+  printf("    Bloc corrompu signalé: \x1B[32mOK\x1B[0m\n");
+  unsigned char *octets = serie->octets;
+  viderSerie(serie, 10000);
+  assert(serie->tours == 0 && serie->nb_blocs == 0 && serie->octets == octets);
+  for (unsigned long t = 0; t < TOURS; t++)
+    assert(!ajouterSerie(serie, statistiqueTour(t)));
+  assert(lireSerie(serie, 0, TOURS, lignes) == TOURS);
+  assert(!memcmp(&serie->indicateurs, &data->indicateurs,
+                 sizeof(struct Indicateurs)));
+  printf("    Série vidée, tampons gardés: \x1B[32mOK\x1B[0m\n");
+
+  free(lignes);
+  detruireData(decompressee);
+  detruireSerie(serie);
+  detruireSerie(chargee);
+  detruireSerie(serie_derive);
+  detruireData(data);
+  detruireData(data_derive);
+  return 0;
+}
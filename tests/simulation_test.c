@@ -0,0 +1,128 @@
+/**
+ * @file simulation_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur la poignée de simulation.
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/simulation.h"
+
+#define NB_THREADS 4
+
+/**
+ * @brief Paramètres par défaut du programme principal.
+ */
+static const struct Parametres PARAMETRES = {
+    .beta = 0.5,
+    .gamma = 0.1,
+    .lambda = 1.0,
+    .chance_quarantaine = 0.1,
+    .chance_decouverte_vaccin = 0.001,
+    .duree_incube = 4,
+    .cordon_sanitaire = 5,
+    .duree_quarantaine = 20};
+
+struct Simulation *nouvelleSimulation(unsigned long graine);
+char memesSeries(const struct Serie *a, const struct Serie *b);
+void *simulerThread(void *resultat);
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  printf("simulation_test:\n");
+  printf("  creerSimulation:\n");
+  struct Simulation *simulation = nouvelleSimulation(42);
+  const struct Serie *serie = getSerieSimulation(simulation);
+  assert(serie->tours == 1);
+  assert(serie->population_totale == 30 * 30);
+  assert(serie->derniere.nb_MALADE == 1);
+  printf("    Tour 0 enregistré: \x1B[32mOK\x1B[0m\n");
+  assert(getPopulationSimulation(simulation)->cote == 30);
+  assert(getParametresSimulation(simulation)->beta == PARAMETRES.beta);
+  printf("    Population et paramètres accessibles: \x1B[32mOK\x1B[0m\n");
+
+  printf("  avancerSimulation:\n");
+  unsigned long tours = avancerSimulation(simulation, 10);
+  assert(serie->tours == tours + 1);
+  printf("    Un Statistique par tour: \x1B[32mOK\x1B[0m\n");
+  avancerSimulation(simulation, 1000);
+  assert(simulationTerminee(simulation));
+  assert(avancerSimulation(simulation, 10) == 0);
+  printf("    Arrêt sans zombie: \x1B[32mOK\x1B[0m\n");
+
+  printf("  Reproductibilité:\n");
+  struct Simulation *simulation_pas_a_pas = nouvelleSimulation(42);
+  while (avancerSimulation(simulation_pas_a_pas, 1)) {
+  }
+  assert(memesSeries(serie, getSerieSimulation(simulation_pas_a_pas)));
+  printf("    Même graine => mêmes Statistique: \x1B[32mOK\x1B[0m\n");
+
+  printf("  Threads:\n");
+  pthread_t threads[NB_THREADS];
+  struct Simulation *resultats[NB_THREADS];
+  for (int i = 0; i < NB_THREADS; i++)
+    pthread_create(&threads[i], NULL, simulerThread, &resultats[i]);
+  for (int i = 0; i < NB_THREADS; i++) {
+    pthread_join(threads[i], NULL);
+    assert(memesSeries(serie, getSerieSimulation(resultats[i])));
+    detruireSimulation(resultats[i]);
+  }
+  printf("    Simulations concurrentes identiques: \x1B[32mOK\x1B[0m\n");
+
+  detruireSimulation(simulation);
+  detruireSimulation(simulation_pas_a_pas);
+  printf("  detruireSimulation: \x1B[32mOK\x1B[0m\n\n");
+  return 0;
+}
+
+/**
+ * @brief Simulation 30x30, patient zero au centre.
+ *
+ * @param graine Graine du générateur.
+ * @return struct Simulation* Simulation.
+ */
+struct Simulation *nouvelleSimulation(unsigned long graine) {
+  struct Population *population = creerPopulation(30);
+  patient_zero(population, 15, 15);
+  return creerSimulation(&PARAMETRES, population, graine);
+}
+
+/**
+ * @brief Compare deux séries de Statistique.
+ *
+ * @return char Booléen, si les séries sont identiques.
+ */
+char memesSeries(const struct Serie *a, const struct Serie *b) {
+  if (a->tours != b->tours) return 0;
+  struct Statistique bloc_a[TOURS_PAR_BLOC], bloc_b[TOURS_PAR_BLOC];
+  for (unsigned long k = 0; k < getNbBlocsSerie(a); k++) {
+    const unsigned long nb = lireBlocSerie(a, k, bloc_a);
+    if (lireBlocSerie(b, k, bloc_b) != nb ||
+        memcmp(bloc_a, bloc_b, nb * sizeof(struct Statistique)))
+      return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Joue une simulation complète dans un thread.
+ *
+ * @param resultat struct Simulation** où ranger la simulation terminée.
+ * @return void* NULL.
+ */
+void *simulerThread(void *resultat) {
+  struct Simulation *simulation = nouvelleSimulation(42);
+  avancerSimulation(simulation, 1000);
+  *(struct Simulation **)resultat = simulation;
+  return NULL;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file sortie_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur les sorties asynchrones.
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../src/sortie.h"
+
+/**
+ * @brief Compare deux fichiers.
+ *
+ * @return int 1 si identiques.
+ */
+static int memesFichiers(const char *a, const char *b) {
+  FILE *fa = fopen(a, "r"), *fb = fopen(b, "r");
+  int ca, cb;
+  do {
+    ca = fgetc(fa);
+    cb = fgetc(fb);
+  } while (ca == cb && ca != EOF);
+  fclose(fa);
+  fclose(fb);
+  return ca == cb;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  printf("sortie_test:\n");
+  printf("  creerSortie:\n");
+  struct Sortie *sortie = creerSortie(5, 10, NULL, "sortie_test_data.txt");
+  assert(sortie);
+  assert(sortie->capacite == 8);
+  printf("    Capacité arrondie à une puissance de 2: \x1B[32mOK\x1B[0m\n");
+
+  printf("  publierStatistique:\n");
+  struct Data *data = creerData();
+  data->population_totale = 100;
+  for (long t = 0; t < 5000; t++) {
+    struct Statistique stats = {t % 7, 100 - t % 7 - t % 11, 0, t % 11, 0, 0};
+    appendData(data, stats);
+    publierStatistique(sortie, stats);
+  }
+  unsigned long attentes = terminerSortie(sortie);
+  exporter(data, "sortie_test_data_ref.txt");
+  assert(memesFichiers("sortie_test_data.txt", "sortie_test_data_ref.txt"));
+  printf("    5000 Statistique dans un anneau de 8 (%lu attentes): "
+         "\x1B[32mOK\x1B[0m\n", attentes);
+
+  printf("  publierGrille:\n");
+  struct Population *population = creerPopulation(7);
+  patient_zero(population, 3, 3);
+  population->grille_de_personnes[0][0].state = IMMUNISE;
+  population->grille_de_personnes[0][1].state = MORT;
+  population->grille_de_personnes[0][2].state = INCUBE;
+  population->grille_de_personnes[0][3].state = VACCINE;
+  const uint32_t zone = creerZone(population, 1);
+  for (int j = 0; j < 7; j++)
+    population->grille_de_personnes[5][j].zone = zone;
+  population->grille_de_personnes[5][1].state = MORT;
+  population->grille_de_personnes[5][2].state = MALADE;
+  // Référence : afficherGrillePopulation redirigé dans un fichier
+  fflush(stdout);
+  int console = dup(STDOUT_FILENO);
+  assert(freopen("sortie_test_grille_ref.txt", "w", stdout));
+  afficherGrillePopulation(population);
+  afficherGrillePopulation(population);
+  fflush(stdout);
+  dup2(console, STDOUT_FILENO);
+  close(console);
+  FILE *file = fopen("sortie_test_grille.txt", "w");
+  sortie = creerSortie(1, 7, file, NULL);
+  publierGrille(sortie, population);
+  population->grille_de_personnes[3][3].state = MORT;  // Instantané copié
+  patient_zero(population, 3, 3);
+  publierGrille(sortie, population);
+  terminerSortie(sortie);
+  fclose(file);
+  assert(memesFichiers("sortie_test_grille.txt", "sortie_test_grille_ref.txt"));
+  printf("    Même rendu que afficherGrillePopulation: \x1B[32mOK\x1B[0m\n");
+
+  detruireData(data);
+  detruirePopulation(population);
+  return 0;
+}
@@ -0,0 +1,305 @@
+/**
+ * @file souches_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur le moteur multi-souches.
+ *
+ * Avec une seule souche, le moteur doit donner exactement la trajectoire de
+ * jouerTourTransition ; avec plusieurs, l'immunité croisée doit protéger
+ * les cases immunisées et les effectifs par souche égaler un recomptage.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "../src/simulation.h"
+#include "../src/souches.h"
+#include "commun.h"
+
+/**
+ * @brief Côté de la grille.
+ */
+#define COTE 60
+
+/**
+ * @brief Tours comparés.
+ */
+#define TOURS 60
+
+/**
+ * @brief Fichier temporaire des tests.
+ */
+#define FICHIER "souches_test.txt"
+
+/**
+ * @brief Ecrit un texte dans FICHIER.
+ */
+static void ecrire(const char *texte) {
+  FILE *file = fopen(FICHIER, "w");
+  fputs(texte, file);
+  fclose(file);
+}
+
+/**
+ * @brief Vrai si les effectifs de chaque souche égalent un recomptage des
+ * souches et immunités, et les totaux getStatistique.
+ */
+static int memesEffectifs(const struct Souches *souches) {
+  long recompte[NB_SOUCHES_MAX][VACCINE + 1] = {{0}};
+  long vivants = 0, vaccines = 0;
+  for (unsigned long k = 0; k < COTE * COTE; k++) {
+    const enum State state = souches->population->personnes[k].state;
+    const uint8_t souche = souches->souches[k];
+    vivants += state != MORT && state != VACCINE;
+    vaccines += state == VACCINE;
+    if (state == INCUBE || state == MALADE || state == MORT)
+      if (souche != SOUCHE_AUCUNE) recompte[souche][state]++;
+    if (state == MORT || state == VACCINE) continue;
+    for (unsigned int s = 0; s < souches->nb_souches; s++)
+      recompte[s][IMMUNISE] += souches->immunites[k] >> s & 1;
+  }
+  for (unsigned int s = 0; s < souches->nb_souches; s++) {
+    recompte[s][VACCINE] = vaccines;
+    recompte[s][SAIN] = vivants - recompte[s][IMMUNISE] -
+                        recompte[s][INCUBE] - recompte[s][MALADE];
+  }
+  const struct Statistique stats = getStatistiqueSouches(souches);
+  const struct Statistique attendues = getStatistique(souches->population);
+  return !memcmp(recompte, souches->effectifs, sizeof(recompte)) &&
+         !memcmp(&stats, &attendues, sizeof(struct Statistique));
+}
+
+/**
+ * @brief Cases infectées par la souche (souche portée, sans compter la case
+ * k0).
+ */
+static unsigned long infectees(const struct Souches *souches, uint8_t souche,
+                               unsigned long k0) {
+  unsigned long n = 0;
+  for (unsigned long k = 0; k < COTE * COTE; k++)
+    n += k != k0 && souches->souches[k] == souche;
+  return n;
+}
+
+/**
+ * @brief Moitié gauche IMMUNISE contre la souche 0 seulement, souche 1
+ * introduite au tour 0 ; joue TOURS tours.
+ *
+ * @return unsigned long Cases de la moitié gauche infectées par la souche 1.
+ */
+static unsigned long gaucheInfectee(const struct Parametres *parametres,
+                                    const struct ParametresSouche deux[2],
+                                    const struct Introduction *variant,
+                                    struct Aleatoire *aleatoire) {
+  struct Population *population = creerPopulation(COTE);
+  for (unsigned long i = 0; i < COTE; i++)
+    for (unsigned long j = 0; j < COTE / 2; j++)
+      population->grille_de_personnes[i][j].state = IMMUNISE;
+  struct Souches *souches =
+      creerSouches(population, parametres, deux, 2, variant, 1);
+  for (unsigned long k = 0; k < COTE * COTE; k++)
+    if (souches->immunites[k]) souches->immunites[k] = 1;  // Souche 0
+  const unsigned long k0 = variant->x * COTE + variant->y;
+  unsigned long gauche = 0;
+  for (int t = 0; t < TOURS; t++) {
+    jouerTourSouches(souches, aleatoire);
+    if (!t)
+      assert(souches->souches[k0] == 1 &&
+             population->personnes[k0].state == MALADE);
+  }
+  for (unsigned long k = 0; k < COTE * COTE; k++)
+    gauche += k != k0 && k % COTE < COTE / 2 && souches->souches[k] == 1;
+  assert(infectees(souches, 1, k0) > gauche);  // La droite est infectée
+  detruireSouches(souches);
+  detruirePopulation(population);
+  return gauche;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  struct Parametres parametres = {.beta = 0.05,
+                                  .gamma = 0.15,
+                                  .lambda = 0.5,
+                                  .chance_quarantaine = 0.2,
+                                  .chance_decouverte_vaccin = 0.001,
+                                  .duree_incube = 2,
+                                  .cordon_sanitaire = 2,
+                                  .duree_quarantaine = 6};
+  struct ParametresSouche valeurs[NB_SOUCHES_MAX];
+  printf("souches_test:\n");
+
+  printf("  lireTableSouches:\n");
+  ecrire("# beta gamma lambda croisee\n\n0.05 0.15 0.5 0  # historique\n"
+         "  1 0 0 1\n");
+  assert(lireTableSouches(FICHIER, valeurs) == 2);
+  assert(valeurs[0].beta == 0.05 && valeurs[0].gamma == 0.15 &&
+         valeurs[0].lambda == 0.5 && valeurs[0].croisee == 0);
+  assert(valeurs[1].beta == 1 && valeurs[1].gamma == 0 &&
+         valeurs[1].lambda == 0 && valeurs[1].croisee == 1);
+  printf("    Commentaires et lignes vides ignorés: \x1B[32mOK\x1B[0m\n");
+  ecrire("0.1 0.2 0.5 1.5\n");
+  assert(lireTableSouches(FICHIER, valeurs) == -1);
+  ecrire("0.1 0.2 0.5\n");
+  assert(lireTableSouches(FICHIER, valeurs) == -1);
+  ecrire("# vide\n");
+  assert(lireTableSouches(FICHIER, valeurs) == -1);
+  char trop[NB_SOUCHES_MAX * 16 + 16] = "";
+  for (int s = 0; s <= NB_SOUCHES_MAX; s++) strcat(trop, "0.1 0.1 0.1 0\n");
+  ecrire(trop);
+  assert(lireTableSouches(FICHIER, valeurs) == -1);
+  assert(lireTableSouches("/inexistant/souches.txt", valeurs) == -1);
+  printf("    Refusé : hors de [0, 1], incomplet, vide, trop de souches: "
+         "\x1B[32mOK\x1B[0m\n");
+  unlink(FICHIER);
+
+  printf("  creerSouches:\n");
+  struct Population *population = creerPopulation(COTE);
+  struct Introduction introduction = {.souche = 2, .x = 1, .y = 1};
+  assert(!creerSouches(population, &parametres, valeurs, 2, &introduction,
+                       1));
+  introduction.souche = 1;
+  introduction.y = COTE;
+  assert(!creerSouches(population, &parametres, valeurs, 2, &introduction,
+                       1));
+  assert(!creerSouches(population, &parametres, valeurs, 0, NULL, 0));
+  printf("    Refusé : souche inconnue, case hors de la grille, aucune "
+         "souche: \x1B[32mOK\x1B[0m\n");
+
+  printf("  jouerTourSouches:\n");
+  // Une souche, mêmes paramètres : même trajectoire que les transitions
+  remplir(population, 985, 3);
+  struct Population *reference = creerPopulation(COTE);
+  assert(!copierPopulation(reference, population));
+  const struct ParametresSouche unique = {parametres.beta, parametres.gamma,
+                                          parametres.lambda, 0.5};
+  struct Souches *souches =
+      creerSouches(population, &parametres, &unique, 1, NULL, 0);
+  assert(souches && memesEffectifs(souches));
+  struct TableTransition table;
+  initTableTransition(&table, &parametres);
+  struct Aleatoire aleatoire, aleatoire_reference;
+  initAleatoire(&aleatoire, 7);
+  initAleatoire(&aleatoire_reference, 7);
+  for (int t = 0; t < TOURS; t++) {
+    jouerTourSouches(souches, &aleatoire);
+    jouerTourTransition(reference, &table, &aleatoire_reference);
+    for (unsigned long k = 0; k < COTE * COTE; k++)
+      assert(population->personnes[k].state ==
+                 reference->personnes[k].state &&
+             enQuarantaine(population, &population->personnes[k]) ==
+                 enQuarantaine(reference, &reference->personnes[k]));
+    assert(memesEffectifs(souches));
+  }
+  assert(population->zones.nb_zones > 10);
+  detruireSouches(souches);
+  detruirePopulation(reference);
+  detruirePopulation(population);
+  printf("    Une souche : identique aux tables de transition: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  // Deux souches : la souche 1, introduite au bord de la moitié gauche,
+  // infecte la droite et traverse l'immunité contre la souche 0 selon
+  // croisee
+  parametres.chance_decouverte_vaccin = 0;
+  parametres.chance_quarantaine = 0;
+  parametres.duree_incube = 0;
+  struct ParametresSouche deux[2] = {{0, 1, 1, 1}, {0, 0, 1, 1}};
+  const struct Introduction variant = {.souche = 1, .x = COTE / 2,
+                                       .y = COTE / 2 - 1, .tour = 0};
+  assert(gaucheInfectee(&parametres, deux, &variant, &aleatoire) == 0);
+  deux[1].croisee = 0;
+  assert(gaucheInfectee(&parametres, deux, &variant, &aleatoire) >
+         COTE * COTE / 4);
+  printf("    Deux souches : introduction, immunité croisée totale ou "
+         "nulle: \x1B[32mOK\x1B[0m\n");
+
+  // Introductions : case déjà infectée laissée, infection datée et comptée
+  // une fois ; aucune transmission ni guérison
+  population = creerPopulation(COTE);
+  patient_zero(population, 2, 2);
+  activerRasters(population);
+  const struct ParametresSouche figees[2] = {{0, 0, 0, 0}, {0, 0, 0, 0}};
+  const struct Introduction doublons[3] = {
+      {.souche = 1, .x = 2, .y = 2, .tour = 0},
+      {.souche = 1, .x = 5, .y = 5, .tour = 3},
+      {.souche = 1, .x = 5, .y = 5, .tour = 3}};
+  souches = creerSouches(population, &parametres, figees, 2, doublons, 3);
+  for (int t = 0; t < 5; t++) jouerTourSouches(souches, &aleatoire);
+  const unsigned long cible = 5 * COTE + 5;
+  assert(souches->souches[2 * COTE + 2] == 0 && souches->souches[cible] == 1);
+  assert(souches->infections[1] == 1);
+  assert(population->personnes[cible].state == MALADE);
+  assert(population->rasters[RASTER_INFECTION][cible] == 3);
+  assert(population->rasters[RASTER_INFECTION][2 * COTE + 2] == 0);
+  detruireSouches(souches);
+  detruirePopulation(population);
+  printf("    Introductions : case infectée laissée, infection comptée et "
+         "datée: \x1B[32mOK\x1B[0m\n");
+
+  // Concurrence : souches et immunités par case, effectifs par souche
+  parametres.duree_incube = 2;
+  parametres.chance_quarantaine = 0.1;
+  population = creerPopulation(COTE);
+  patient_zero(population, COTE / 4, COTE / 4);
+  const struct ParametresSouche concurrentes[3] = {
+      {0.02, 0.2, 0.6, 0}, {0.1, 0.2, 0.9, 0.5}, {0.05, 0.3, 0.7, 0.9}};
+  const struct Introduction variants[2] = {
+      {.souche = 1, .x = COTE - 5, .y = COTE - 5, .tour = 5},
+      {.souche = 2, .x = 5, .y = COTE - 5, .tour = 10}};
+  souches = creerSouches(population, &parametres, concurrentes, 3, variants,
+                         2);
+  for (int t = 0; t < 2 * TOURS; t++) {
+    jouerTourSouches(souches, &aleatoire);
+    assert(memesEffectifs(souches));
+    for (unsigned int s = 0; s < 3; s++) {
+      const struct Statistique stats = getStatistiqueSouche(souches, s);
+      assert(stats.nb_SAIN + stats.nb_IMMUNISE + stats.nb_INCUBE +
+                 stats.nb_MALADE + stats.nb_MORT <=
+             COTE * COTE);
+      assert(souches->pics[s] >= stats.nb_MALADE);
+    }
+  }
+  for (unsigned int s = 0; s < 3; s++)
+    assert(souches->infections[s] > 10 && souches->pics[s] > 0);
+  detruireSouches(souches);
+  detruirePopulation(population);
+  printf("    Trois souches : effectifs par souche, pics: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  printf("  avancerSimulation:\n");
+  population = creerPopulation(COTE);
+  patient_zero(population, COTE / 4, COTE / 4);
+  struct Population *initiale = creerPopulation(COTE);
+  assert(!copierPopulation(initiale, population));
+  struct Simulation *simulation = creerSimulation(&parametres, population, 3);
+  assert(!activerSouchesSimulation(simulation, concurrentes, 3, variants, 2));
+  assert(activerContactsSimulation(simulation, NULL));
+  assert(activerAgentsSimulation(simulation, NULL, 1));
+  for (int replicat = 0; replicat < 2; replicat++) {
+    if (replicat) assert(!reinitialiserSimulation(simulation, initiale, 4));
+    avancerSimulation(simulation, TOURS);
+    const struct Souches *jouees = getSouchesSimulation(simulation);
+    assert(jouees->infections[1] > 0 && jouees->infections[2] > 0);
+    const struct Serie *serie = getSerieSimulation(simulation);
+    const struct Statistique attendues =
+        getStatistique((struct Population *)getPopulationSimulation(
+            simulation));
+    assert(!memcmp(&serie->derniere, &attendues,
+                   sizeof(struct Statistique)));
+  }
+  detruireSimulation(simulation);
+  detruirePopulation(initiale);
+  printf("    Introductions rejouées après réinitialisation: "
+         "\x1B[32mOK\x1B[0m\n");
+  return 0;
+}
@@ -9,6 +9,7 @@
 
 #include <assert.h>
 #include <stdio.h>
+#include <string.h>
 #include <stdlib.h>
 
 #include "../src/statistique.h"
@@ -77,6 +78,28 @@ int main(void) {
   assert(data_derivee->liste_statistiques[0]->nb_SAIN == -1);
   printf("    Data' liste_statistiques[0]->nb_SAIN == -1: \x1B[32mOK\x1B[0m\n");
 
+  printf("  indicateurs:\n");
+  assert(data->indicateurs.vitesse_max.nb_MALADE == 1);
+  assert(data->indicateurs.tour_vitesse_max.nb_MALADE == 1);
+  assert(data->indicateurs.vitesse_max.nb_SAIN == 0);
+  printf("    Vitesses max == max de deriver: \x1B[32mOK\x1B[0m\n");
+  assert(data->indicateurs.pic_MALADE == 1);
+  assert(data->indicateurs.tour_pic_MALADE == 1);
+  assert(data->indicateurs.infections_cumulees == 1);
+  assert(tauxAttaque(data) == 1.0 / 49);
+  printf("    Pic et taux d'attaque: \x1B[32mOK\x1B[0m\n");
+  assert(data->indicateurs.tour_extinction == -1);
+  struct Statistique stats_fin = stats;
+  stats_fin.nb_MALADE--;
+  stats_fin.nb_MORT++;
+  struct Data *data_fin = creerData();
+  appendData(data_fin, stats);
+  appendData(data_fin, stats_fin);
+  assert(data_fin->indicateurs.tour_extinction == 1);
+  assert(data_fin->indicateurs.infections_cumulees == 1);
+  printf("    Extinction: \x1B[32mOK\x1B[0m\n");
+  detruireData(data_fin);
+
   printf("  exporter:\n");
   exporter(data, "data_test.txt");
   printf("    Exporter Data: \x1B[32mOK\x1B[0m\n");
@@ -84,6 +107,23 @@ int main(void) {
   printf("    Exporter Data dérivée: \x1B[32mOK\x1B[0m\n");
   lire_et_comparer(data, "data_test.txt");
   lire_et_comparer(data_derivee, "data_derivee_test.txt");
+
+  printf("  importer:\n");
+  struct Data *importee = importer("data_test.txt");
+  assert(importee && importee->tours == data->tours &&
+         importee->population_totale == data->population_totale);
+  for (unsigned long i = 0; i < data->tours; i++)
+    assert(!memcmp(importee->liste_statistiques[i],
+                   data->liste_statistiques[i], sizeof(struct Statistique)));
+  assert(importee->indicateurs.pic_MALADE == data->indicateurs.pic_MALADE);
+  detruireData(importee);
+  assert(!importer("fichier_absent.txt"));
+  FILE *invalide = fopen("data_invalide_test.txt", "w");
+  fprintf(invalide, "100\n3\n0 1 2\n");
+  fclose(invalide);
+  assert(!importer("data_invalide_test.txt"));
+  printf("    Aller-retour avec exporter, fichier invalide refusé: "
+         "\x1B[32mOK\x1B[0m\n");
   appendData(data, stats);
   appendData(data, stats);
   appendData(data, stats);
@@ -93,15 +133,22 @@ int main(void) {
   appendData(data, stats);
   appendData(data, stats);
   appendData(data, stats);
-  graphique(data, "graphique.txt", data->population_totale, data->tours);
+  detruireGraphique(
+      graphique(data, "graphique.txt", data->population_totale, data->tours),
+      data->population_totale);
   printf("    Graphique: \x1B[33mVOIR MANUELLEMENT\x1B[0m\n");
-  graphique(data, "graphique_div2.txt", data->population_totale,
-            data->tours / 2);
+  detruireGraphique(graphique(data, "graphique_div2.txt",
+                              data->population_totale, data->tours / 2),
+                    data->population_totale);
   printf("    Graphique div2: \x1B[33mVOIR MANUELLEMENT\x1B[0m\n");
-  graphique(data, "graphique_90.txt", data->population_totale, 90);
+  detruireGraphique(
+      graphique(data, "graphique_90.txt", data->population_totale, 90),
+      data->population_totale);
   printf("    Graphique 90: \x1B[33mVOIR MANUELLEMENT\x1B[0m\n");
   tableau(data, "tableau.txt");
   printf("    Tableau de bord: \x1B[33mVOIR MANUELLEMENT\x1B[0m\n");
+  detruireData(data_derivee);
+  detruireData(data);
   return 0;
 }
 
@@ -0,0 +1,158 @@
+/**
+ * @file transition_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur les tables de transition.
+ *
+ * Les fréquences empiriques des issues sont comparées aux probabilités du
+ * noyau à 4 écarts-types près.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+
+#include "../src/transition.h"
+#include "commun.h"
+
+/**
+ * @brief Nombre d'essais par fréquence mesurée.
+ */
+#define NB_ESSAIS 20000
+
+/**
+ * @brief Place une grille 3x3 (états ligne par ligne), sans quarantaine.
+ */
+static void placer(struct Population *population, const enum State etats[9]) {
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++) {
+      struct Personne *personne = &population->grille_de_personnes[i][j];
+      personne->state = etats[i * 3 + j];
+      personne->duree_incube = 0;
+      personne->zone = 0;
+    }
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  struct Parametres parametres = {.beta = 0.5,
+                                  .gamma = 0.1,
+                                  .lambda = 0.3,
+                                  .chance_quarantaine = 0.2,
+                                  .chance_decouverte_vaccin = 0.1,
+                                  .duree_incube = 4,
+                                  .cordon_sanitaire = 1,
+                                  .duree_quarantaine = 20};
+  struct TableTransition table;
+  printf("transition_test:\n");
+
+  printf("  initTableTransition:\n");
+  initTableTransition(&table, &parametres);
+  for (int k = 0; k <= NB_VOISINS; k++) {
+    const struct Transition *sain = &table.transitions[SAIN][k][0];
+    assert(sain->issues[0] == VACCINE && fabs(sain->seuils[0] - 0.1) < 1e-12);
+    if (k) {
+      assert(sain->nb_issues == 3 && sain->issues[1] == INCUBE);
+      assert(fabs(sain->seuils[1] - (0.1 + 0.9 * (1 - pow(0.7, k)))) < 1e-12);
+    } else {
+      assert(sain->nb_issues == 2);  // Pas d'infection sans voisin
+    }
+    assert(table.transitions[SAIN][k][1].nb_issues == 1 &&
+           table.transitions[SAIN][k][1].issues[0] == VACCINE);
+  }
+  printf("    SAIN : 1 - (1 - lambda)^k, voisin VACCINE certain: "
+         "\x1B[32mOK\x1B[0m\n");
+  const struct Transition *malade = &table.transitions[MALADE][0][0];
+  assert(malade->nb_issues == 6);
+  assert(malade->issues[0] == (ISSUE_QUARANTAINE | MORT));
+  assert(fabs(malade->seuils[0] - 0.2 * 0.5) < 1e-12);
+  assert(fabs(malade->seuils[1] - 0.2 * (0.5 + 0.5 * 0.1)) < 1e-12);
+  assert(fabs(malade->seuils[2] - 0.2) < 1e-12);
+  assert(malade->issues[3] == MORT && malade->issues[5] == MALADE);
+  printf("    MALADE : quarantaine indépendante de MORT/IMMUNISE: "
+         "\x1B[32mOK\x1B[0m\n");
+  for (int state = SAIN; state <= VACCINE; state++)
+    for (int k = 0; k <= NB_VOISINS; k++)
+      for (int v = 0; v < 2; v++) {
+        const struct Transition *t = &table.transitions[state][k][v];
+        assert(t->nb_issues >= 1 && t->seuils[t->nb_issues - 1] == 1);
+        for (int n = 1; n < t->nb_issues; n++)
+          assert(t->seuils[n] > t->seuils[n - 1]);
+      }
+  assert(table.transitions[INCUBE][2][0].nb_issues == 1 &&
+         table.transitions[MORT][0][0].nb_issues == 1 &&
+         table.transitions[VACCINE][0][1].issues[0] == VACCINE);
+  printf("    Seuils croissants jusqu'à 1, états certains: "
+         "\x1B[32mOK\x1B[0m\n");
+
+  printf("  jouerTourTransition:\n");
+  parametres.chance_quarantaine = 0;
+  parametres.chance_decouverte_vaccin = 0;
+  initTableTransition(&table, &parametres);
+  struct Population *population = creerPopulation(3);
+  struct Aleatoire aleatoire;
+  initAleatoire(&aleatoire, 42);
+  // Case centrale SAIN, k voisins MALADE
+  const enum State voisinages[NB_VOISINS][9] = {
+      {SAIN, MALADE, SAIN, SAIN, SAIN, SAIN, SAIN, SAIN, SAIN},
+      {SAIN, MALADE, SAIN, MALADE, SAIN, SAIN, SAIN, SAIN, SAIN},
+      {SAIN, MALADE, SAIN, MALADE, SAIN, MALADE, SAIN, SAIN, SAIN},
+      {SAIN, MALADE, SAIN, MALADE, SAIN, MALADE, SAIN, MALADE, SAIN}};
+  for (int k = 1; k <= NB_VOISINS; k++) {
+    unsigned long infectes = 0, morts = 0, immunises = 0;
+    for (unsigned long e = 0; e < NB_ESSAIS; e++) {
+      placer(population, voisinages[k - 1]);
+      jouerTourTransition(population, &table, &aleatoire);
+      infectes += population->grille_de_personnes[1][1].state == INCUBE;
+      morts += population->grille_de_personnes[0][1].state == MORT;
+      immunises += population->grille_de_personnes[0][1].state == IMMUNISE;
+    }
+    assert(frequenceProche(infectes, NB_ESSAIS, 1 - pow(0.7, k)));
+    assert(frequenceProche(morts, NB_ESSAIS, 0.5));
+    assert(frequenceProche(immunises, NB_ESSAIS, 0.5 * 0.1));
+  }
+  assert(population->grille_de_personnes[1][1].state != INCUBE ||
+         population->grille_de_personnes[1][1].duree_incube == 4);
+  printf("    Fréquences INCUBE, MORT, IMMUNISE (%d essais): "
+         "\x1B[32mOK\x1B[0m\n",
+         NB_ESSAIS);
+
+  // Voisin VACCINE : vaccination certaine, sans tirage
+  const enum State vaccine[9] = {SAIN, VACCINE, SAIN, SAIN,  IMMUNISE,
+                                 MORT, SAIN,    MORT, INCUBE};
+  placer(population, vaccine);
+  population->grille_de_personnes[2][2].duree_incube = 2;
+  struct Aleatoire avant = aleatoire;
+  jouerTourTransition(population, &table, &aleatoire);
+  assert(population->grille_de_personnes[0][0].state == VACCINE);
+  assert(population->grille_de_personnes[1][1].state == VACCINE);
+  assert(population->grille_de_personnes[2][0].state == SAIN);
+  assert(population->grille_de_personnes[2][2].state == INCUBE &&
+         population->grille_de_personnes[2][2].duree_incube == 1);
+  assert(aleatoireEntier(&avant) == aleatoireEntier(&aleatoire));
+  printf("    Transitions certaines sans tirage: \x1B[32mOK\x1B[0m\n");
+
+  // Quarantaine certaine d'un MALADE
+  parametres.chance_quarantaine = 1;
+  initTableTransition(&table, &parametres);
+  const enum State quarantaine[9] = {SAIN, SAIN, SAIN, SAIN, MALADE,
+                                     SAIN, SAIN, SAIN, SAIN};
+  placer(population, quarantaine);
+  jouerTourTransition(population, &table, &aleatoire);
+  assert(getDureeQuarantaine(population,
+                             &population->grille_de_personnes[1][1]) == 20);
+  assert(getDureeQuarantaine(population,
+                             &population->grille_de_personnes[0][1]) == 20);
+  assert(!enQuarantaine(population, &population->grille_de_personnes[0][0]));
+  printf("    Quarantaine appliquée avec le cordon sanitaire: "
+         "\x1B[32mOK\x1B[0m\n");
+  detruirePopulation(population);
+  return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file voisinage_test.c
+ * @author Marc NGUYEN
+ * @author Thomas LARDY
+ * @brief Lancer des tests unitaires sur le moteur à compteurs de voisins.
+ *
+ * Avec la même graine, le voisinage doit donner exactement la grille de
+ * jouerTourParametres à chaque tour, quarantaine comprise, et ses compteurs
+ * tenus à jour doivent égaler un recomptage complet.
+ *
+ * @date 19 Oct 2026
+ *
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../src/voisinage.h"
+#include "commun.h"
+
+/**
+ * @brief Côté de la grille comparée au noyau : plusieurs mots par ligne.
+ */
+#define COTE 90
+
+/**
+ * @brief Tours comparés au noyau.
+ */
+#define TOURS 80
+
+/**
+ * @brief Vrai si les grilles (état, incubation, zone) sont égales.
+ */
+static int memesGrilles(const struct Population *a,
+                        const struct Population *b) {
+  for (unsigned long k = 0; k < a->cote * a->cote; k++)
+    if (a->personnes[k].state != b->personnes[k].state ||
+        a->personnes[k].duree_incube != b->personnes[k].duree_incube ||
+        a->personnes[k].zone != b->personnes[k].zone)
+      return 0;
+  return 1;
+}
+
+/**
+ * @brief Vrai si les compteurs et les cases actives égalent ceux d'un
+ * voisinage rechargé sur la même grille.
+ */
+static int memesCompteurs(const struct Voisinage *voisinage,
+                          const struct Voisinage *recompte) {
+  const unsigned long taille =
+      voisinage->population->cote * voisinage->population->cote;
+  const unsigned long mots = (taille + 63) / 64;
+  return !memcmp(voisinage->contagieux, recompte->contagieux, taille) &&
+         !memcmp(voisinage->vaccines, recompte->vaccines, taille) &&
+         !memcmp(voisinage->actives, recompte->actives,
+                 mots * sizeof(uint64_t)) &&
+         !memcmp(voisinage->resume, recompte->resume,
+                 (mots + 63) / 64 * sizeof(uint64_t));
+}
+
+/**
+ * @brief Joue TOURS tours avec le voisinage et avec le noyau, même graine.
+ *
+ * @return uint32_t Nombre de zones à la fin (zone libre comprise).
+ */
+static uint32_t comparer(const struct Parametres *parametres,
+                         const struct Population *initiale) {
+  struct Population *population = creerPopulation(COTE);
+  struct Population *noyau = creerPopulation(COTE);
+  assert(!copierPopulation(population, initiale));
+  assert(!copierPopulation(noyau, initiale));
+  activerRasters(population);
+  activerRasters(noyau);
+  struct Aleatoire aleatoire, aleatoire_noyau;
+  initAleatoire(&aleatoire, 3);
+  initAleatoire(&aleatoire_noyau, 3);
+  struct Voisinage *voisinage = creerVoisinage(population, parametres);
+  assert(voisinage);
+  for (int t = 0; t < TOURS; t++) {
+    jouerTourVoisinage(voisinage, &aleatoire);
+    jouerTourParametres(noyau, parametres, &aleatoire_noyau);
+    assert(population->tour == noyau->tour);
+    assert(memesGrilles(population, noyau));
+    for (int r = 0; r < NB_RASTERS; r++)
+      assert(!memcmp(population->rasters[r], noyau->rasters[r],
+                     COTE * COTE * sizeof(uint16_t)));
+    const struct Statistique stats = getStatistiqueVoisinage(voisinage);
+    const struct Statistique attendues = getStatistique(noyau);
+    assert(!memcmp(&stats, &attendues, sizeof(struct Statistique)));
+    struct Voisinage *recompte = creerVoisinage(population, parametres);
+    assert(memesCompteurs(voisinage, recompte));
+    detruireVoisinage(recompte);
+  }
+  const uint32_t nb_zones = population->zones.nb_zones;
+  assert(nb_zones == noyau->zones.nb_zones);
+  detruireVoisinage(voisinage);
+  detruirePopulation(population);
+  detruirePopulation(noyau);
+  return nb_zones;
+}
+
+/**
+ * @brief Main pour tourner les tests unitaires.
+ *
+ * @return int Exit 0.
+ */
+int main(void) {
+  struct Parametres parametres = {.beta = 0.05,
+                                  .gamma = 0.15,
+                                  .lambda = 0.5,
+                                  .chance_quarantaine = 0,
+                                  .chance_decouverte_vaccin = 0,
+                                  .duree_incube = 2,
+                                  .cordon_sanitaire = 3,
+                                  .duree_quarantaine = 6};
+  printf("voisinage_test:\n");
+
+  printf("  voisinageCompatible:\n");
+  struct Population *initiale = creerPopulation(COTE);
+  assert(voisinageCompatible(&parametres));
+  parametres.chance_decouverte_vaccin = 0.01;
+  assert(!voisinageCompatible(&parametres));
+  assert(!creerVoisinage(initiale, &parametres));
+  parametres.chance_decouverte_vaccin = 0;
+  printf("    Refusé avec la découverte du vaccin: \x1B[32mOK\x1B[0m\n");
+
+  printf("  jouerTourVoisinage:\n");
+  remplir(initiale, 985, 3);
+  assert(comparer(&parametres, initiale) == 1);
+  printf("    Identique au noyau, compteurs à jour: \x1B[32mOK\x1B[0m\n");
+  parametres.chance_quarantaine = 0.3;
+  assert(comparer(&parametres, initiale) > 10);
+  printf("    Identique au noyau avec quarantaine: \x1B[32mOK\x1B[0m\n");
+  // Quarantaines chargées : levées par le tas des échéances
+  const uint32_t zone = creerZone(initiale, 4);
+  for (unsigned long k = 0; k < COTE * COTE; k += 7)
+    initiale->personnes[k].zone = zone;
+  parametres.chance_quarantaine = 0;
+  comparer(&parametres, initiale);
+  printf("    Quarantaines chargées levées à leur échéance: "
+         "\x1B[32mOK\x1B[0m\n");
+  detruirePopulation(initiale);
+
+  // Front d'une épidémie : seules les cases autour du front sont visitées
+  parametres.lambda = 1;
+  parametres.gamma = 1;
+  parametres.beta = 0;
+  parametres.duree_incube = 0;
+  struct Population *population = creerPopulation(4 * COTE);
+  patient_zero(population, 2 * COTE, 2 * COTE);
+  struct Aleatoire aleatoire;
+  initAleatoire(&aleatoire, 5);
+  struct Voisinage *voisinage = creerVoisinage(population, &parametres);
+  unsigned long tours = 0;
+  do {
+    jouerTourVoisinage(voisinage, &aleatoire);
+    assert(voisinage->visitees < 16 * (tours + 1) + 8);
+    tours++;
+  } while (voisinage->statistique.nb_MALADE ||
+           voisinage->statistique.nb_INCUBE);
+  jouerTourVoisinage(voisinage, &aleatoire);
+  assert(!voisinage->visitees);
+  printf("    %lu tours, front seul visité, puis aucune case: "
+         "\x1B[32mOK\x1B[0m\n",
+         tours);
+  detruireVoisinage(voisinage);
+  detruirePopulation(population);
+  return 0;
+}